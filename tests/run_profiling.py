@@ -4,20 +4,31 @@
 from __future__ import print_function
 import os
 import argparse
-from collections import namedtuple
+from collections import namedtuple, OrderedDict
+import json
 import psutil
+import shlex
+import shutil
 import string
 import subprocess
 from subprocess import check_call
 import datetime
 import getpass
 import socket
+import tempfile
 import time
 
 import numpy as np
 
+from tonic.io import read_configobj
 from tonic.models.vic.vic import VIC
 
+from test_utils import replace_global_values, setup_test_dirs
+from test_performance import (run_perf_test, perf_time_reference,
+                              perf_results_header, add_perf_metrics,
+                              read_perf_baseline)
+from synthetic_domain import OPTIONS, make_synthetic_domain
+
 host_config = namedtuple('host_config',
                          ('profile', 'template', 'submit', 'mpiexec'))
 
@@ -27,7 +38,7 @@ def log2_range(m):
     make an array of integers that increase by 2^n with maximum value of m
     '''
     n = int(np.floor(np.log2(m))) + 1
-    return np.exp2(np.arange(n)).astype(np.int)
+    return np.exp2(np.arange(n)).astype(int)
 
 
 table_header = '''----------------- START VIC SCALING PROFILE -----------------
@@ -46,6 +57,17 @@ Cores | Time (Seconds)
 ----------------------
 '''
 
+# phases of the image driver timers (PHASE_TIMERS) that move data between
+# the files and the processes, and those that compute on the local domain
+io_phases = ('force_read', 'force_scatter', 'output_gather', 'output_write')
+compute_phases = ('update_step_vars', 'vic_run', 'put_data', 'agg_data')
+
+synthetic_timing_options = '''
+PHASE_TIMERS  TRUE
+TIMING_TRACE  {trace}
+LOG_DIR       {log_dir}
+'''
+
 
 hosts = {
     'local': host_config(profile=[dict(np=np) for np in
@@ -124,6 +146,19 @@ This is the VIC Profiling Test Suite. There are 2 main test types:
         gprof. This test requires building your VIC executable with the
         flags `-pg`.
     2. Scaling: This test will generate a MPI scaling timing table.
+    3. Bench: This test will time the vic_run physics kernels with the
+        vic_bench executable (`make bench` in the classic driver) in the
+        regimes of profiling/bench.cfg and write the results as JSON.
+    4. Synthetic: This test will run the image driver on generated domains
+        (synthetic_domain.py) of a fixed size (strong scaling) and of a
+        fixed size per process (weak scaling) and write the scaling and the
+        split between I/O and computation as JSON.
+    5. Baseline: This test will run the performance tests of run_tests.py
+        (performance/performance.cfg) for one driver and write their metrics
+        as the baseline the performance tests are compared with.
+    6. Ascii: This test will time the fast ASCII output formatter against
+        snprintf with the vic_bench_ascii executable (`make bench_ascii` in
+        the classic driver) and write the results as JSON.
 -------------------------------------------------------------------------------
 '''
 
@@ -151,10 +186,12 @@ def main():
                                      formatter_class=CustomFormatter)
 
     parser.add_argument('vic_exe', type=str,
-                        help='VIC executable to test')
+                        help='VIC executable to test (vic_bench for bench, '
+                             'vic_bench_ascii for ascii)')
     parser.add_argument('--kind', type=str,
                         help='Specify which type of test should be run',
-                        choices=['scaling', 'profile'],
+                        choices=['scaling', 'profile', 'bench',
+                                 'synthetic', 'baseline', 'ascii'],
                         default='scaling')
     parser.add_argument('--host', type=str,
                         help='Host machine to run test on, if not specified, '
@@ -170,9 +207,78 @@ def main():
                         help='Clean up run files')
     parser.add_argument('--test', action='store_true',
                         help='Test the setup but do not run VIC')
+    parser.add_argument('--bench_config', type=str,
+                        default=os.path.join(os.path.dirname(
+                            os.path.abspath(__file__)), 'profiling',
+                            'bench.cfg'),
+                        help='regimes of the kernel microbenchmark')
+    parser.add_argument('--data_dir', type=str,
+                        help='directory to find test data',
+                        default='./samples/VIC_sample_data')
+    parser.add_argument('--warm_forcing', type=str,
+                        help='prefix of forcing files starting on '
+                             '1949-07-01 for the warm regime')
+    parser.add_argument('--lake_param_file', type=str,
+                        help='lake parameter file for the lake regime')
+    parser.add_argument('--carbon_veglib_file', type=str,
+                        help='vegetation library with photosynthesis '
+                             'parameters for the carbon regime')
+    parser.add_argument('--output', '-o', type=str,
+                        help='path to kernel microbenchmark, synthetic '
+                             'scaling or baseline results (default: '
+                             'vic_<kind>_<date>.json)')
+    parser.add_argument('--performance_config', type=str,
+                        default=os.path.join(os.path.dirname(
+                            os.path.abspath(__file__)), 'performance',
+                            'performance.cfg'),
+                        help='matrix of the performance tests')
+    parser.add_argument('--driver', type=str,
+                        help='driver of the VIC executable for baseline',
+                        choices=['classic', 'image'], default='classic')
+    parser.add_argument('--portable', action='store_true',
+                        help='record only the metrics that do not depend on '
+                             'the machine (solver statistics and time '
+                             'ratios), not the times of this host')
+    parser.add_argument('--scaling', type=str,
+                        help='synthetic scaling runs to make',
+                        choices=['strong', 'weak', 'both'], default='both')
+    parser.add_argument('--ncells', type=int, default=4096,
+                        help='active grid cells of the strong scaling '
+                             'domain')
+    parser.add_argument('--cells_per_proc', type=int, default=256,
+                        help='active grid cells per process of the weak '
+                             'scaling domains')
+    parser.add_argument('--options', type=str, default='',
+                        help='comma separated options of the synthetic '
+                             'domains from: {}'.format(', '.join(OPTIONS)))
+    parser.add_argument('--days', type=int, default=2,
+                        help='number of days of the synthetic runs')
+    parser.add_argument('--seed', type=int, default=0,
+                        help='seed of the synthetic domains (of the '
+                             'formatted values for ascii if given)')
+    parser.add_argument('--values', type=int, default=100000,
+                        help='values per format of the ascii benchmark')
+    parser.add_argument('--passes', type=int, default=10,
+                        help='timed passes of the ascii benchmark')
 
     args = parser.parse_args()
 
+    if args.output is None:
+        args.output = 'vic_{}_{}.json'.format(args.kind, ymd)
+
+    if args.kind == 'bench':
+        run_bench(args)
+        return
+    elif args.kind == 'synthetic':
+        run_synthetic(args)
+        return
+    elif args.kind == 'baseline':
+        run_baseline(args)
+        return
+    elif args.kind == 'ascii':
+        run_bench_ascii(args)
+        return
+
     if args.global_param is None:
         raise ValueError('Global Parameter option is required')
 
@@ -191,6 +297,312 @@ def run_profiling(args):
     check_call(cmd, shell=True)
 
 
+def run_bench(args):
+    '''wrapper function for the vic_run kernel microbenchmark'''
+    config = read_configobj(args.bench_config)
+    config_dir = os.path.dirname(os.path.abspath(args.bench_config))
+    run_dir = tempfile.mkdtemp(prefix='vic_bench_')
+
+    templates = dict(test_data_dir=os.path.abspath(args.data_dir),
+                     result_dir=run_dir)
+    if args.warm_forcing:
+        templates['warm_forcing'] = os.path.abspath(args.warm_forcing)
+    if args.lake_param_file:
+        templates['lake_param_file'] = os.path.abspath(args.lake_param_file)
+    if args.carbon_veglib_file:
+        templates['carbon_veglib_file'] = os.path.abspath(
+            args.carbon_veglib_file)
+
+    header = get_header_info(args.vic_exe, args.bench_config)
+    results = OrderedDict()
+    results['date'] = header['date'].isoformat()
+    results['hostname'] = header['hostname']
+    results['user'] = header['user']
+    results['git_version'] = header['git_version'].strip()
+    results['vic_exe'] = args.vic_exe
+    results['regimes'] = OrderedDict()
+
+    for regime, regime_config in config.items():
+        with open(os.path.join(config_dir,
+                               regime_config['global_parameter_file'])) as f:
+            global_param = f.read()
+        replacements = OrderedDict(regime_config.get('options', {}))
+        global_param = ''.join(replace_global_values(global_param,
+                                                     replacements))
+        global_param = string.Template(global_param).safe_substitute(
+            **templates)
+        if '$' in global_param:
+            print('Skipping regime {}: {}'.format(
+                regime, 'not all of its templates were given'))
+            continue
+
+        global_file = os.path.join(run_dir, 'global_{}.txt'.format(regime))
+        with open(global_file, 'w') as f:
+            f.write(global_param)
+        json_file = os.path.join(run_dir, '{}.json'.format(regime))
+
+        cmd = [args.vic_exe, '-g', global_file, '-r', regime,
+               '-s', str(regime_config['spinup_steps']),
+               '-n', str(regime_config['steps']),
+               '-p', str(regime_config['passes']),
+               '-o', json_file]
+        print(' '.join(cmd))
+        if not args.test:
+            check_call(cmd)
+            with open(json_file) as f:
+                results['regimes'][regime] = json.load(
+                    f, object_pairs_hook=OrderedDict)
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2)
+
+
+def run_bench_ascii(args):
+    '''wrapper function for the ASCII output formatter benchmark'''
+    run_dir = tempfile.mkdtemp(prefix='vic_bench_ascii_')
+    json_file = os.path.join(run_dir, 'ascii.json')
+
+    header = get_header_info(args.vic_exe, None)
+    results = OrderedDict()
+    results['date'] = header['date'].isoformat()
+    results['hostname'] = header['hostname']
+    results['user'] = header['user']
+    results['git_version'] = header['git_version'].strip()
+    results['vic_exe'] = args.vic_exe
+
+    cmd = [args.vic_exe, '-n', str(args.values), '-p', str(args.passes),
+           '-o', json_file]
+    if args.seed:
+        cmd.extend(['-s', str(args.seed)])
+    print(' '.join(cmd))
+    if not args.test:
+        check_call(cmd)
+        with open(json_file) as f:
+            results['ascii'] = json.load(f, object_pairs_hook=OrderedDict)
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2)
+    print('See %s for formatter timings' % args.output)
+
+    if args.clean:
+        shutil.rmtree(run_dir)
+
+
+def run_baseline(args):
+    '''wrapper function for recording the baseline of the performance
+    tests'''
+    config = read_configobj(args.performance_config)
+    config_dir = os.path.dirname(os.path.abspath(args.performance_config))
+    run_dir = tempfile.mkdtemp(prefix='vic_baseline_')
+    vic_exe = os.path.abspath(args.vic_exe)
+
+    # the metrics of the other driver, and the times of the other hosts, are
+    # kept
+    baseline = read_perf_baseline(args.output)
+    results = perf_results_header([(args.driver, vic_exe)],
+                                  portable=args.portable)
+    if baseline is not None:
+        def other_driver(testname):
+            return config.get(testname, {}).get('driver') != args.driver
+
+        for dr, exe in baseline['vic_exe'].items():
+            results['vic_exe'].setdefault(dr, exe)
+        for testname, metrics in baseline['configs'].items():
+            if other_driver(testname):
+                results['configs'][testname] = metrics
+        for hostname, host in baseline['hosts'].items():
+            if hostname not in results['hosts']:
+                results['hosts'][hostname] = host
+                continue
+            for dr, exe in host['vic_exe'].items():
+                results['hosts'][hostname]['vic_exe'].setdefault(dr, exe)
+            for testname, metrics in host['configs'].items():
+                if other_driver(testname):
+                    results['hosts'][hostname]['configs'][testname] = metrics
+
+    ran = OrderedDict()
+    for testname, test_dict in config.items():
+        if test_dict['driver'] != args.driver:
+            continue
+        print('Running {}'.format(testname))
+        if args.test:
+            continue
+        dirs = setup_test_dirs(testname, run_dir,
+                               mkdirs=['results', 'state', 'logs'])
+        # a baseline without a test of the matrix fails that test, so a
+        # test that cannot run stops the recording
+        metrics = run_perf_test(vic_exe, args.driver, test_dict, config_dir,
+                                os.path.abspath(args.data_dir), dirs,
+                                testname, perf_time_reference(test_dict, ran))
+        ran[testname] = dirs
+        add_perf_metrics(results, testname, metrics)
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2)
+        f.write('\n')
+    print('See %s for the performance baseline' % args.output)
+
+    if args.clean:
+        shutil.rmtree(run_dir)
+
+
+def run_synthetic(args):
+    '''wrapper function for the scaling tests on synthetic domains'''
+    config = hosts[args.host]
+    if config.template:
+        raise ValueError('synthetic scaling runs are only supported on '
+                         'hosts without a batch template (e.g. local)')
+    mpiexec = shlex.split(config.mpiexec)
+    options = [o for o in args.options.split(',') if o]
+    run_dir = tempfile.mkdtemp(prefix='vic_synthetic_')
+
+    header = get_header_info(args.vic_exe, None)
+    results = OrderedDict()
+    results['date'] = header['date'].isoformat()
+    results['hostname'] = header['hostname']
+    results['user'] = header['user']
+    results['git_version'] = header['git_version'].strip()
+    results['vic_exe'] = args.vic_exe
+    results['mpiexec'] = config.mpiexec
+    results['options'] = options
+    results['days'] = args.days
+    results['seed'] = args.seed
+
+    kinds = ['strong', 'weak'] if args.scaling == 'both' else [args.scaling]
+    for kind in kinds:
+        runs = []
+        for kwargs in config.profile:
+            n = int(kwargs['np'])
+            ncells = args.ncells if kind == 'strong' else \
+                args.cells_per_proc * n
+            # the strong scaling runs share one domain
+            name = '{}_{}'.format(kind, n if kind == 'weak' else ncells)
+            domain_dir = os.path.join(run_dir, name)
+            if not os.path.isdir(domain_dir):
+                print('Writing synthetic domain of {} grid cells to '
+                      '{}'.format(ncells, domain_dir))
+                make_synthetic_domain(domain_dir, ncells, options=options,
+                                      days=args.days, seed=args.seed)
+            global_file = write_synthetic_global_param(
+                domain_dir, '{}_np{}'.format(kind, n))
+
+            cmd = mpiexec + ['-np', str(n), args.vic_exe, '-g', global_file]
+            print(' '.join(cmd))
+            if args.test:
+                continue
+            start = time.time()
+            # the timing profile is written to the log destination, which
+            # is stderr by the time the run is finalized
+            stdout = subprocess.check_output(
+                cmd, stderr=subprocess.STDOUT).decode()
+            run = OrderedDict([('np', n), ('ncells', ncells),
+                               ('wall_time', time.time() - start)])
+            run.update(parse_timing_profile(stdout))
+            runs.append(run)
+        add_scaling_metrics(runs, kind)
+        results[kind] = runs
+
+    with open(args.output, 'w') as f:
+        json.dump(results, f, indent=2)
+    print_synthetic_table(results, kinds)
+    print('See %s for synthetic scaling results' % args.output)
+
+    if args.clean:
+        shutil.rmtree(run_dir)
+
+
+def write_synthetic_global_param(domain_dir, name):
+    '''copy the global parameter file of a synthetic domain with the phase
+    timers on and the logs of each run in their own directory'''
+    log_dir = os.path.join(domain_dir, 'logs_{}'.format(name))
+    os.makedirs(log_dir, exist_ok=True)
+    with open(os.path.join(domain_dir, 'global_param.txt')) as f:
+        global_param = f.read()
+    global_param += synthetic_timing_options.format(
+        trace=os.path.join(log_dir, 'trace.csv'), log_dir=log_dir + os.sep)
+    global_file = os.path.join(domain_dir, 'global_{}.txt'.format(name))
+    with open(global_file, 'w') as f:
+        f.write(global_param)
+    return global_file
+
+
+def parse_timing_profile(stdout):
+    '''parse the timing and phase tables of the VIC timing profile'''
+    timers = OrderedDict()
+    phases = OrderedDict()
+    table = None
+    for line in stdout.splitlines():
+        if line.strip().startswith('Timing Table'):
+            table = timers
+        elif line.strip().startswith('Phase Timing Table'):
+            table = phases
+        elif table is not None and line.startswith('|') and \
+                not line.startswith('|--'):
+            cells = [c.strip() for c in line.strip('|').split('|')]
+            try:
+                values = [float(c) for c in cells[1:]]
+            except ValueError:
+                continue  # column headings
+            if table is timers:
+                timers[cells[0]] = OrderedDict([('wall', values[0]),
+                                                ('cpu', values[1])])
+            else:
+                phases[cells[0]] = OrderedDict([('min', values[0]),
+                                                ('mean', values[1]),
+                                                ('max', values[2])])
+        elif not line.strip():
+            table = None
+    if not timers or not phases:
+        raise ValueError('no timing profile with phase timers in the VIC '
+                         'output')
+
+    # the slowest process sets the pace of every phase
+    split = OrderedDict()
+    split['init'] = timers['Init Time']['wall']
+    split['io'] = sum(phases[p]['max'] for p in io_phases)
+    split['compute'] = sum(phases[p]['max'] for p in compute_phases)
+    split['other'] = max(timers['Run Time']['wall'] - split['io'] -
+                         split['compute'], 0.)
+    split['io_fraction'] = (split['init'] + split['io']) / \
+        timers['Total Time']['wall']
+    return OrderedDict([('timers', timers), ('phases', phases),
+                        ('split', split)])
+
+
+def add_scaling_metrics(runs, kind):
+    '''add the speedup and parallel efficiency of the run time relative to
+    the run with the fewest processes'''
+    if not runs:
+        return
+    base = runs[0]
+    for run in runs:
+        ratio = base['timers']['Run Time']['wall'] / \
+            run['timers']['Run Time']['wall']
+        if kind == 'strong':
+            run['speedup'] = ratio * base['np']
+            run['efficiency'] = ratio * base['np'] / run['np']
+        else:
+            # scaled speedup: the work grows with the number of processes
+            run['speedup'] = ratio * run['np'] / base['np']
+            run['efficiency'] = ratio
+
+
+def print_synthetic_table(results, kinds):
+    '''print a summary table of the synthetic scaling runs'''
+    row = '{:>5} | {:>8} | {:>10} | {:>10} | {:>10} | {:>8} | {:>6}'
+    for kind in kinds:
+        print('{} scaling'.format(kind).center(OUT_WIDTH))
+        print(row.format('Cores', 'Cells', 'Run (s)', 'I/O (s)', 'Comp. (s)',
+                         'Speedup', 'Eff.'))
+        for run in results.get(kind, []):
+            print(row.format(run['np'], run['ncells'],
+                             '%.3f' % run['timers']['Run Time']['wall'],
+                             '%.3f' % run['split']['io'],
+                             '%.3f' % run['split']['compute'],
+                             '%.2f' % run['speedup'],
+                             '%.2f' % run['efficiency']))
+
+
 def run_scaling(args):
     '''wrapper function for scaling tests'''
     config = hosts[args.host]
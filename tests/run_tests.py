@@ -8,6 +8,7 @@ import glob
 import argparse
 import datetime
 from collections import OrderedDict
+import json
 import string
 import warnings
 
@@ -24,16 +25,23 @@ from test_utils import (
     test_classic_driver_no_output_file_nans,
     find_global_param_value,
     check_multistream_classic,
+    check_output_container_classic,
     setup_subdirs_and_fill_in_global_param_driver_match_test,
     check_drivers_match_fluxes,
     plot_science_tests)
 from test_image_driver import (test_image_driver_no_output_file_nans,
                                setup_subdirs_and_fill_in_global_param_mpi_test,
-                               check_mpi_fluxes, check_mpi_states)
+                               check_mpi_fluxes, check_mpi_states,
+                               make_synthetic_test_domain,
+                               check_adaptive_snow_step_image)
 from test_restart import (prepare_restart_run_periods,
                           setup_subdirs_and_fill_in_global_param_restart_test,
                           check_exact_restart_fluxes,
                           check_exact_restart_states)
+from test_performance import (run_perf_test, perf_time_reference,
+                              perf_results_header, add_perf_metrics,
+                              read_perf_baseline, perf_baseline_metrics,
+                              compare_perf_metrics, format_perf_changes)
 
 test_dir = os.path.dirname(os.path.abspath(__file__))
 
@@ -64,6 +72,10 @@ This is the VIC Test Suite. There are six main test types:
     4. examples: a set of examples that users may download and run.
     5. release: longer, full domain simulations performed prior to release
             demonstrating model output for a final release.
+    6. performance: a fixed matrix of configurations whose wall time,
+            vic_run time, peak memory and solver iterations are compared
+            with a stored baseline.  Not part of `all`, because the
+            baseline is only valid on the machine that recorded it.
 -------------------------------------------------------------------------------
 '''
 
@@ -124,7 +136,7 @@ def main():
     parser.add_argument('tests', type=str,
                         help='Test sets to run',
                         choices=['all', 'unit', 'system', 'science',
-                                 'examples', 'release'],
+                                 'examples', 'release', 'performance'],
                         default=['unit', 'system'], nargs='+')
     parser.add_argument('--system', type=str,
                         help='system tests configuration file',
@@ -140,6 +152,14 @@ def main():
     parser.add_argument('--release', type=str,
                         help='release tests configuration file',
                         default=os.path.join(test_dir, 'release/release.cfg'))
+    parser.add_argument('--performance', type=str,
+                        help='performance tests configuration file',
+                        default=os.path.join(test_dir,
+                                             'performance/performance.cfg'))
+    parser.add_argument('--perf_baseline', type=str,
+                        help='baseline of the performance tests',
+                        default=os.path.join(test_dir,
+                                             'performance/baseline.json'))
     parser.add_argument('--classic', type=str,
                         help='classic driver executable to test')
     parser.add_argument('--image', type=str,
@@ -170,8 +190,9 @@ def main():
         raise VICTestError('directory for science test data does not exist or '
                            'has not been defined')
 
-    # Validate input directories
-    if not (len(args.tests) == 1 and args.tests[0] == 'unit'):
+    # Validate input directories; the unit and performance tests need no
+    # sample data
+    if set(args.tests) - set(['unit', 'performance']):
         for d in [data_dir, test_dir]:
             if not os.path.exists(d):
                 raise VICTestError('Directory: {0} does not exist'.format(d))
@@ -230,6 +251,11 @@ def main():
     # release
     if any(i in ['all', 'release'] for i in args.tests):
         test_results['release'] = run_release(args.release)
+    # performance
+    if 'performance' in args.tests:
+        test_results['performance'] = run_performance(
+            args.performance, args.perf_baseline, dict_drivers, data_dir,
+            os.path.join(out_dir, 'performance'))
 
     # Print test results
     summary = OrderedDict()
@@ -366,8 +392,15 @@ def run_system(config_file, dict_drivers, test_data_dir, out_dir):
         dict_global_param = {}
         # --- if single driver --- #
         if len(dict_drivers) == 1:
-            infile = os.path.join(test_dir, 'system',
-                                  test_dict['global_parameter_file'])
+            # tests on a synthetic domain start from the global parameter
+            # file written with the domain
+            if 'synthetic' in test_dict:
+                infile = make_synthetic_test_domain(
+                    test_dict['synthetic'],
+                    os.path.join(dirs['test'], 'synthetic'), dirs['results'])
+            else:
+                infile = os.path.join(test_dir, 'system',
+                                      test_dict['global_parameter_file'])
             with open(infile, 'r') as global_file:
                 dict_global_param[driver] = global_file.read()
         # --- if multiple drivers --- #
@@ -520,6 +553,34 @@ def run_system(config_file, dict_drivers, test_data_dir, out_dir):
             with open(test_global_file, mode='w') as f:
                 for line in global_param:
                     f.write(line)
+            # second run writing output containers instead of per-cell files
+            if 'output_container' in test_dict['check']:
+                container_dir = os.path.join(dirs['test'], 'container')
+                if not os.path.isdir(container_dir):
+                    os.makedirs(container_dir)
+                container_global_file = os.path.join(
+                    dirs['test'],
+                    '{0}_globalparam_container.txt'.format(testname))
+                with open(container_global_file, mode='w') as f:
+                    for line in replace_global_values(
+                            ''.join(global_param),
+                            OrderedDict([('RESULT_DIR', container_dir),
+                                         ('OUTPUT_CONTAINER', 'TRUE')])):
+                        f.write(line)
+            # second run with single snow steps, for the balance check
+            if 'adaptive_snow_step' in test_dict['check']:
+                reference_dir = os.path.join(dirs['test'], 'reference')
+                if not os.path.isdir(reference_dir):
+                    os.makedirs(reference_dir)
+                reference_global_file = os.path.join(
+                    dirs['test'],
+                    '{0}_globalparam_reference.txt'.format(testname))
+                with open(reference_global_file, mode='w') as f:
+                    for line in replace_global_values(
+                            ''.join(global_param),
+                            OrderedDict([('RESULT_DIR', reference_dir),
+                                         ('ADAPTIVE_SNOW_STEP', 'FALSE')])):
+                        f.write(line)
 
         # Get optional kwargs for run executable
         run_kwargs = pop_run_kwargs(test_dict)
@@ -579,6 +640,16 @@ def run_system(config_file, dict_drivers, test_data_dir, out_dir):
                 # Check return code
                 check_returncode(vic_exe,
                                  test_dict.pop('expected_retval', 0))
+                if 'output_container' in test_dict['check']:
+                    returncode = vic_exe.run(container_global_file,
+                                             logdir=dirs['logs'],
+                                             **run_kwargs)
+                    check_returncode(vic_exe, 0)
+                if 'adaptive_snow_step' in test_dict['check']:
+                    returncode = vic_exe.run(reference_global_file,
+                                             logdir=dirs['logs'],
+                                             **run_kwargs)
+                    check_returncode(vic_exe, 0)
 
             test_complete = True
 
@@ -641,6 +712,22 @@ def run_system(config_file, dict_drivers, test_data_dir, out_dir):
                         warnings.warn('Skipping multistream image driver test')
                         # TODO: check_multistream_image(fnames)
 
+                # check that output containers match the per-cell output
+                if 'output_container' in test_dict['check']:
+                    if driver != 'classic':
+                        raise ValueError('output_container check only '
+                                         'supports classic driver')
+                    check_output_container_classic(vic_exe, dirs['results'],
+                                                   container_dir)
+
+                # check the balance of adaptive snow steps
+                if 'adaptive_snow_step' in test_dict['check']:
+                    if driver != 'image':
+                        raise ValueError('adaptive_snow_step check only '
+                                         'supports image driver')
+                    check_adaptive_snow_step_image(dirs['results'],
+                                                   reference_dir)
+
                 # check for mpi multiprocessor results
                 if 'mpi' in test_dict['check']:
                     check_mpi_fluxes(dirs['results'], list_n_proc)
@@ -966,6 +1053,142 @@ def run_examples(config_file, vic_exe, test_data_dir, out_dir, driver):
     return test_results
 
 
+def run_performance(config_file, baseline_file, dict_drivers, test_data_dir,
+                    out_dir):
+    '''Run performance tests from config file
+
+    Parameters
+    ----------
+    config_file : str
+        Configuration file for performance tests.
+    baseline_file : str
+        Baseline of the performance tests (JSON).
+    dict_drivers : dict
+        Keys: driver names {'classic', 'image'}
+        Content: corresponding VIC executable object (see tonic documentation)
+    test_data_dir : str
+        Path to test data sets.
+    out_dir : str
+        Path to output location
+
+    Returns
+    -------
+    test_results : dict
+        Test results for all tests in config_file.
+
+    See Also
+    --------
+    run_unit_tests
+    run_system
+    run_science
+    run_examples
+    '''
+
+    # Print test set welcome
+    print('\n-'.ljust(OUTPUT_WIDTH + 1, '-'))
+    print('Running Performance Tests')
+    print('-'.ljust(OUTPUT_WIDTH, '-'))
+
+    # Get setup
+    config = read_configobj(config_file)
+    config_dir = os.path.dirname(os.path.abspath(config_file))
+    baseline = read_perf_baseline(baseline_file)
+    hostname = os.uname()[1]
+    host_baseline = None
+    if baseline is None:
+        print('No baseline in {}: the tests are run, and fail, so that '
+              'their metrics can be recorded as a baseline'.format(
+                  baseline_file))
+    elif hostname in baseline['hosts']:
+        host_baseline = baseline['hosts'][hostname]
+    else:
+        print('The performance baseline has no times of {}: only the '
+              'solver statistics and the time ratios of the tests with a '
+              'time_reference are compared'.format(hostname))
+
+    # drop tests of drivers that were not given
+    config = OrderedDict((k, v) for k, v in config.items()
+                         if v['driver'] in dict_drivers)
+
+    results = perf_results_header(
+        (dr, exe.executable) for dr, exe in dict_drivers.items())
+    test_results = OrderedDict()
+    ran = OrderedDict()
+
+    # Run individual tests
+    for i, (testname, test_dict) in enumerate(config.items()):
+
+        # print out status info
+        print('Running test {0}/{1}: {2}'.format(i + 1, len(config.items()),
+                                                 testname))
+
+        # Setup directories for test
+        dirs = setup_test_dirs(testname, out_dir,
+                               mkdirs=['results', 'state', 'logs'])
+
+        driver = test_dict['driver']
+        test_complete = False
+        test_passed = False
+        test_comment = ''
+        error_message = ''
+
+        try:
+            metrics = run_perf_test(dict_drivers[driver].executable, driver,
+                                    test_dict, config_dir, test_data_dir,
+                                    dirs, testname,
+                                    perf_time_reference(test_dict, ran))
+            ran[testname] = dirs
+            add_perf_metrics(results, testname, metrics)
+            test_complete = True
+
+            # a test that is missing from the baseline fails, so that the
+            # baseline is updated with the matrix
+            if baseline is None:
+                test_comment = 'no baseline file'
+            elif testname not in baseline['configs']:
+                test_comment = 'not in the baseline'
+            elif host_baseline is not None and \
+                    testname not in host_baseline['configs']:
+                test_comment = 'not in the baseline of {}'.format(hostname)
+            else:
+                regressions, improvements = compare_perf_metrics(
+                    metrics, perf_baseline_metrics(baseline, testname),
+                    test_dict.get('thresholds'))
+                if regressions:
+                    test_comment = 'regression: {}'.format(
+                        format_perf_changes(regressions))
+                else:
+                    test_passed = True
+                    if improvements:
+                        test_comment = 'faster than baseline: {}'.format(
+                            format_perf_changes(improvements))
+
+        # Handle errors
+        except Exception as e:
+            test_comment = 'Test failed during simulation'
+            error_message = str(e)
+
+        # record the test results
+        test_results[testname] = TestResults(testname,
+                                             test_complete=test_complete,
+                                             passed=test_passed,
+                                             comment=test_comment,
+                                             error_message=error_message)
+
+    # the results have the layout of the baseline, so that they can replace
+    # it
+    results_file = os.path.join(out_dir, 'performance.json')
+    with open(results_file, 'w') as f:
+        json.dump(results, f, indent=2)
+    print('See {} for the performance metrics'.format(results_file))
+
+    print('-'.ljust(OUTPUT_WIDTH, '-'))
+    print('Finished testing performance tests.')
+    print('-'.ljust(OUTPUT_WIDTH, '-'))
+
+    return test_results
+
+
 def run_release(config_file):
     '''Run release from config file
 
@@ -0,0 +1,824 @@
+#!/usr/bin/env python
+'''Synthetic domain, parameter and forcing files for the VIC drivers
+
+Writes a domain file, a parameter file, yearly forcing files and a global
+parameter file for a domain of any number of active grid cells, so that the
+image driver can be profiled at scale without downloading data.  The files
+follow the layout read by get_global_domain, vic_init and vic_force.  For the
+classic driver the same grid cells are written as ASCII soil, vegetation,
+snow band and forcing files instead.  The parameters and forcings are smooth
+functions of latitude and elevation plus seeded noise: the physics is
+plausible but not real, and a given seed always gives the same files.
+'''
+
+from __future__ import print_function
+import os
+import argparse
+import datetime
+from collections import OrderedDict
+
+import numpy as np
+import netCDF4
+
+OPTIONS = ('lakes', 'frozen_soil', 'snow_bands', 'carbon')
+DRIVERS = ('image', 'classic')
+
+# options the classic files support
+CLASSIC_OPTIONS = ('frozen_soil', 'snow_bands')
+
+NLAYER = 3
+N_ROOT_ZONES = 3
+N_SNOW_BANDS = 5
+N_LAKE_NODES = 5
+MONTHS_PER_YEAR = 12
+STEPS_PER_DAY = 24
+
+# damping depth (m) and number of soil thermal nodes; frozen soil uses the
+# exponential node grid, which needs Nnode >= 5 * ln(dp + 1) + 1
+DAMPING_DEPTH = 4.
+NODES = 3
+NODES_FROZEN_SOIL = 10
+
+# vegetation library: name, overstory, rarc (s/m), rmin (s/m), height (m),
+# monthly LAI range, albedo, RGL (W/m2), root fractions.  The last class is
+# bare soil.
+VEG_LIBRARY = (
+    ('evergreen needleleaf', 1, 60., 250., 20., (3.4, 4.4), 0.12, 30.,
+     (0.1, 0.5, 0.4)),
+    ('deciduous broadleaf', 1, 60., 125., 20., (0.5, 5.0), 0.18, 30.,
+     (0.1, 0.5, 0.4)),
+    ('grassland', 0, 2., 120., 0.5, (0.5, 2.5), 0.2, 100.,
+     (0.4, 0.5, 0.1)),
+    ('cropland', 0, 2., 100., 1., (0.1, 3.0), 0.1, 100.,
+     (0.4, 0.5, 0.1)),
+    ('bare soil', 0, 100., 0., 0., (0., 0.), 0.2, 0.,
+     (0.4, 0.5, 0.1)))
+
+ROOT_DEPTHS = (0.1, 0.5, 1.0)
+
+FORCING_VARS = OrderedDict([('AIR_TEMP', ('tas', 'C')),
+                            ('PREC', ('prcp', 'mm/step')),
+                            ('PRESSURE', ('pres', 'kPa')),
+                            ('SWDOWN', ('dswrf', 'W/m2')),
+                            ('LWDOWN', ('dlwrf', 'W/m2')),
+                            ('VP', ('vp', 'kPa')),
+                            ('WIND', ('wind', 'm/s'))])
+LAKE_FORCING_VARS = OrderedDict([('CHANNEL_IN', ('channel_in', 'm3'))])
+CARBON_FORCING_VARS = OrderedDict([('CATM', ('catm', 'mol/mol')),
+                                   ('FDIR', ('fdir', 'fraction')),
+                                   ('PAR', ('par', 'W/m2'))])
+
+OUTVARS = ('OUT_PREC', 'OUT_EVAP', 'OUT_RUNOFF', 'OUT_BASEFLOW', 'OUT_SWE',
+           'OUT_SOIL_MOIST', 'OUT_SURF_TEMP', 'OUT_SENSIBLE', 'OUT_LATENT',
+           'OUT_WATER_ERROR', 'OUT_ENERGY_ERROR')
+
+global_template = '''\
+# Synthetic domain of {ncells} active grid cells ({ny} x {nx}), options: {opts}
+# Written by synthetic_domain.py with seed {seed}
+
+MODEL_STEPS_PER_DAY   {steps_per_day}
+SNOW_STEPS_PER_DAY    {steps_per_day}
+RUNOFF_STEPS_PER_DAY  {steps_per_day}
+
+STARTYEAR     {start:%Y}
+STARTMONTH    {start:%m}
+STARTDAY      {start:%d}
+ENDYEAR       {end:%Y}
+ENDMONTH      {end:%m}
+ENDDAY        {end:%d}
+CALENDAR      PROLEPTIC_GREGORIAN
+
+FULL_ENERGY   TRUE
+FROZEN_SOIL   {frozen_soil}
+NODES         {nodes}
+CARBON        {carbon}
+VEGLIB_PHOTO  {carbon}
+RC_MODE       {rc_mode}
+
+DOMAIN        {domain}
+DOMAIN_TYPE   LAT     lat
+DOMAIN_TYPE   LON     lon
+DOMAIN_TYPE   MASK    mask
+DOMAIN_TYPE   AREA    area
+DOMAIN_TYPE   FRAC    frac
+DOMAIN_TYPE   YDIM    lat
+DOMAIN_TYPE   XDIM    lon
+
+FORCING1      {forcing_prefix}
+{force_types}
+WIND_H        10.0
+
+PARAMETERS    {params}
+SNOW_BAND     {snow_band}
+LAKES         {lakes}
+LAKE_PROFILE  {lakes}
+
+RESULT_DIR    {result_dir}
+'''
+
+output_template = '''
+OUTFILE       fluxes
+COMPRESS      FALSE
+OUT_FORMAT    NETCDF4
+AGGFREQ       NDAYS   1
+{outvars}
+'''
+
+classic_global_template = '''\
+# Synthetic domain of {ncells} active grid cells ({ny} x {nx}), options: {opts}
+# Written by synthetic_domain.py with seed {seed}
+
+NLAYER        {nlayer}
+NODES         {nodes}
+MODEL_STEPS_PER_DAY   {steps_per_day}
+SNOW_STEPS_PER_DAY    {steps_per_day}
+RUNOFF_STEPS_PER_DAY  {steps_per_day}
+
+STARTYEAR     {start:%Y}
+STARTMONTH    {start:%m}
+STARTDAY      {start:%d}
+ENDYEAR       {end:%Y}
+ENDMONTH      {end:%m}
+ENDDAY        {end:%d}
+CALENDAR      PROLEPTIC_GREGORIAN
+
+FULL_ENERGY   TRUE
+FROZEN_SOIL   {frozen_soil}
+
+FORCING1      {forcing_prefix}
+FORCE_FORMAT  ASCII
+{force_types}
+FORCE_STEPS_PER_DAY   {steps_per_day}
+FORCEYEAR     {start:%Y}
+FORCEMONTH    {start:%m}
+FORCEDAY      {start:%d}
+GRID_DECIMAL  {grid_decimal}
+WIND_H        10.0
+
+SOIL          {soil}
+BASEFLOW      ARNO
+JULY_TAVG_SUPPLIED    FALSE
+ORGANIC_FRACT FALSE
+VEGLIB        {veglib}
+VEGPARAM      {vegparam}
+ROOT_ZONES    {root_zones}
+VEGPARAM_LAI  FALSE
+LAI_SRC       FROM_VEGLIB
+{snow_band}
+RESULT_DIR    {result_dir}
+'''
+
+classic_output_template = '''
+OUTFILE       fluxes
+AGGFREQ       NDAYS   1
+{outvars}
+'''
+
+# digits of the latitude and longitude in the names of the forcing files
+GRID_DECIMAL = 4
+
+
+def grid_shape(ncells, land_fraction):
+    '''number of rows and columns of a grid with at least
+    ncells / land_fraction grid cells, as close to square as possible'''
+    ntotal = int(np.ceil(ncells / land_fraction))
+    nx = int(np.ceil(np.sqrt(ntotal)))
+    ny = int(np.ceil(ntotal / nx))
+    return ny, nx
+
+
+class SyntheticGrid(object):
+    '''coordinates, mask and the fields the parameters and forcings are
+    derived from'''
+
+    def __init__(self, ncells, land_fraction=1., resolution=0.0625,
+                 seed=0):
+        self.ncells = ncells
+        self.ny, self.nx = grid_shape(ncells, land_fraction)
+        self.seed = seed
+        self.rng = np.random.RandomState(seed)
+
+        # keep the domain between 35N and 60N so that the forcings give a
+        # mix of snow, rain and frozen soil
+        resolution = min(resolution, 25. / self.ny, 60. / self.nx)
+        self.resolution = resolution
+        self.lats = 35. + resolution * (np.arange(self.ny) + 0.5)
+        self.lons = -125. + resolution * (np.arange(self.nx) + 0.5)
+        self.lat2d, self.lon2d = np.meshgrid(self.lats, self.lons,
+                                             indexing='ij')
+
+        # the ncells cells with the smallest noise are land, so that every
+        # grid has exactly ncells active cells
+        noise = self.rng.uniform(size=(self.ny, self.nx)).ravel()
+        self.mask = np.zeros(self.ny * self.nx, dtype=np.int32)
+        self.mask[np.argsort(noise, kind='mergesort')[:ncells]] = 1
+        self.mask = self.mask.reshape(self.ny, self.nx)
+
+        # elevation: a few smooth ridges plus noise (m)
+        x = np.radians(self.lon2d) * 8.
+        y = np.radians(self.lat2d) * 8.
+        self.elev = (1200. + 800. * np.sin(x) * np.cos(y) +
+                     300. * np.sin(3. * x + 1.) +
+                     100. * self.rng.uniform(-1., 1., size=self.lat2d.shape))
+
+        # annual mean air temperature (C)
+        self.t_mean = 28. - 0.6 * self.lat2d - 6.5e-3 * self.elev
+
+    def field(self, low, high):
+        '''uniform noise between low and high on the grid'''
+        return self.rng.uniform(low, high, size=(self.ny, self.nx))
+
+    def area(self):
+        '''area of the grid cells (m2)'''
+        radius = 6371000.
+        dlat = np.radians(self.resolution)
+        return (radius ** 2 * dlat * dlat *
+                np.cos(np.radians(self.lat2d)))
+
+
+def add_coords(nc, grid):
+    '''define the lat and lon dimensions and coordinate variables'''
+    nc.createDimension('lat', grid.ny)
+    nc.createDimension('lon', grid.nx)
+    lat = nc.createVariable('lat', 'f8', ('lat',))
+    lat.units = 'degrees_north'
+    lat.standard_name = 'latitude'
+    lat[:] = grid.lats
+    lon = nc.createVariable('lon', 'f8', ('lon',))
+    lon.units = 'degrees_east'
+    lon.standard_name = 'longitude'
+    lon[:] = grid.lons
+
+
+def write_domain(path, grid):
+    '''write the domain file'''
+    with netCDF4.Dataset(path, 'w', format='NETCDF4_CLASSIC') as nc:
+        add_coords(nc, grid)
+        nc.createVariable('mask', 'i4', ('lat', 'lon'))[:] = grid.mask
+        nc.createVariable('area', 'f8', ('lat', 'lon'))[:] = grid.area()
+        nc.createVariable('frac', 'f8', ('lat', 'lon'))[:] = \
+            grid.mask.astype(np.float64)
+
+
+def cover_fractions(grid, nveg):
+    '''cover fraction of each vegetation class: nveg vegetated classes per
+    cell, picked at random, and bare soil, which is always present'''
+    nclasses = len(VEG_LIBRARY)
+    cv = np.zeros((nclasses, grid.ny, grid.nx))
+    keys = grid.rng.uniform(size=(nclasses - 1, grid.ny, grid.nx))
+    chosen = np.argsort(keys, axis=0)[:nveg]
+    weights = grid.rng.uniform(1., 3., size=(nveg + 1, grid.ny, grid.nx))
+    weights /= weights.sum(axis=0)
+    jj, ii = np.indices((grid.ny, grid.nx))
+    for k in range(nveg):
+        cv[chosen[k], jj, ii] = weights[k]
+    cv[-1] = weights[-1]
+    return cv
+
+
+def synthetic_params(grid, options, nveg):
+    '''the parameters of the grid cells, as an ordered dict of name:
+    (dimensions, values, dtype) in the layout of the image driver parameter
+    file'''
+    nclasses = len(VEG_LIBRARY)
+    nbands = N_SNOW_BANDS if 'snow_bands' in options else 1
+    shape = (grid.ny, grid.nx)
+    params = OrderedDict()
+
+    def put(name, dims, values, dtype='f8'):
+        params[name] = (dims, values, dtype)
+
+    d2 = ('lat', 'lon')
+    put('run_cell', d2, grid.mask, 'i4')
+    put('gridcell', d2, np.arange(grid.ny * grid.nx).reshape(shape) + 1,
+        'i4')
+
+    # soil
+    put('infilt', d2, grid.field(0.05, 0.35))
+    put('Ds', d2, grid.field(0.001, 0.1))
+    put('Dsmax', d2, grid.field(5., 25.))
+    put('Ws', d2, grid.field(0.6, 0.9))
+    put('c', d2, np.full(shape, 2.))
+    put('elev', d2, grid.elev)
+    put('avg_T', d2, grid.t_mean)
+    put('dp', d2, np.full(shape, DAMPING_DEPTH))
+    put('off_gmt', d2, grid.lon2d / 15.)
+    put('rough', d2, np.full(shape, 0.001))
+    put('snow_rough', d2, np.full(shape, 0.0005))
+    put('annual_prec', d2, grid.field(300., 2000.))
+    put('fs_active', d2, np.full(shape, int('frozen_soil' in options)),
+        'i4')
+    put('max_snow_distrib_slope', d2, np.full(shape, 0.5))
+    put('frost_slope', d2, np.full(shape, 0.5))
+
+    d3 = ('nlayer', 'lat', 'lon')
+    depth = np.empty((NLAYER,) + shape)
+    depth[0] = 0.1
+    depth[1] = grid.field(0.3, 0.6)
+    depth[2] = grid.field(1.0, 2.0)
+    bulk_density = grid.rng.uniform(1300., 1600., size=depth.shape)
+    soil_density = np.full(depth.shape, 2685.)
+    porosity = 1. - bulk_density / soil_density
+    put('depth', d3, depth)
+    put('expt', d3, grid.rng.uniform(10., 25., size=depth.shape))
+    put('Ksat', d3, grid.rng.uniform(100., 1000., size=depth.shape))
+    put('phi_s', d3, np.full(depth.shape, -999.))
+    put('init_moist', d3, 0.6 * depth * porosity * 1000.)
+    put('bubble', d3, grid.rng.uniform(10., 40., size=depth.shape))
+    put('quartz', d3, grid.rng.uniform(0.2, 0.7, size=depth.shape))
+    put('bulk_density', d3, bulk_density)
+    put('soil_density', d3, soil_density)
+    put('Wcr_FRACT', d3, grid.rng.uniform(0.6, 0.75, size=depth.shape))
+    put('Wpwp_FRACT', d3, grid.rng.uniform(0.3, 0.45, size=depth.shape))
+    put('resid_moist', d3, np.zeros(depth.shape))
+
+    # elevation bands: equal areas spread around the mean elevation
+    d3 = ('snow_band', 'lat', 'lon')
+    offsets = np.linspace(-1., 1., nbands) if nbands > 1 else \
+        np.zeros(1)
+    spread = grid.field(100., 600.)
+    put('AreaFract', d3, np.full((nbands,) + shape, 1. / nbands))
+    put('elevation', d3, grid.elev + offsets[:, None, None] * spread)
+    put('Pfactor', d3, np.full((nbands,) + shape, 1. / nbands))
+
+    # vegetation library
+    d3 = ('veg_class', 'lat', 'lon')
+    d4 = ('veg_class', 'month', 'lat', 'lon')
+
+    def per_class(values, dtype='f8'):
+        return np.broadcast_to(
+            np.asarray(values, dtype=dtype)[:, None, None],
+            (nclasses,) + shape)
+
+    def per_month(values):
+        values = np.asarray(values, dtype='f8')
+        return np.broadcast_to(values[:, :, None, None],
+                               values.shape + shape)
+
+    months = np.arange(MONTHS_PER_YEAR)
+    season = 0.5 - 0.5 * np.cos(2. * np.pi * (months - 0.5) / 12.)
+    lai = [lo + (hi - lo) * season for v in VEG_LIBRARY
+           for lo, hi in [v[5]]]
+    height = np.array([v[4] for v in VEG_LIBRARY])
+    put('overstory', d3, per_class([v[1] for v in VEG_LIBRARY], 'i4'), 'i4')
+    put('rarc', d3, per_class([v[2] for v in VEG_LIBRARY]))
+    put('rmin', d3, per_class([v[3] for v in VEG_LIBRARY]))
+    put('wind_h', d3, per_class(np.maximum(height + 10., 10.)))
+    put('RGL', d3, per_class([v[7] for v in VEG_LIBRARY]))
+    put('rad_atten', d3, per_class([0.5] * nclasses))
+    put('wind_atten', d3, per_class([0.5] * nclasses))
+    put('trunk_ratio', d3, per_class([0.2] * nclasses))
+    put('LAI', d4, per_month(lai))
+    put('albedo', d4, per_month([[v[6]] * MONTHS_PER_YEAR
+                                 for v in VEG_LIBRARY]))
+    put('veg_rough', d4, per_month([[0.123 * h] * MONTHS_PER_YEAR
+                                    for h in height]))
+    put('displacement', d4, per_month([[0.67 * h] * MONTHS_PER_YEAR
+                                       for h in height]))
+    put('fcanopy', d4, per_month([[1.] * MONTHS_PER_YEAR] * nclasses))
+    if 'carbon' in options:
+        # all classes use the C3 pathway
+        put('Ctype', d3, per_class([0] * nclasses, 'i4'), 'i4')
+        put('MaxCarboxRate', d3, per_class([6.e-5] * nclasses))
+        put('MaxiE_or_CO2Spec', d3, per_class([1.2e-4] * nclasses))
+        put('LUE', d3, per_class([0.055] * nclasses))
+        put('Nscale', d3, per_class([v[1] for v in VEG_LIBRARY], 'i4'),
+            'i4')
+        put('Wnpp_inhib', d3, per_class([0.7] * nclasses))
+        put('NPPfactor_sat', d3, per_class([0.1] * nclasses))
+
+    # vegetation tiles
+    cv = cover_fractions(grid, nveg)
+    put('Nveg', d2, np.full(shape, nveg, dtype=np.int32), 'i4')
+    put('Cv', d3, cv)
+    d4 = ('veg_class', 'root_zone', 'lat', 'lon')
+    put('root_depth', d4, per_month([ROOT_DEPTHS] * nclasses))
+    put('root_fract', d4, per_month([v[8] for v in VEG_LIBRARY]))
+
+    if 'lakes' in options:
+        params.update(lake_params(grid, cv))
+    return params
+
+
+def write_params(path, grid, options, params):
+    '''write the parameter file'''
+    with netCDF4.Dataset(path, 'w', format='NETCDF4_CLASSIC') as nc:
+        add_coords(nc, grid)
+        nc.createDimension('nlayer', NLAYER)
+        nc.createDimension('veg_class', len(VEG_LIBRARY))
+        nc.createDimension('month', MONTHS_PER_YEAR)
+        nc.createDimension('root_zone', N_ROOT_ZONES)
+        nc.createDimension('snow_band', params['AreaFract'][1].shape[0])
+        if 'lakes' in options:
+            nc.createDimension('lake_node', N_LAKE_NODES)
+        for name, (dims, values, dtype) in params.items():
+            nc.createVariable(name, dtype, dims)[:] = values
+
+
+def lake_params(grid, cv):
+    '''lakes fill the first vegetation tile of half of the grid cells'''
+    d2 = ('lat', 'lon')
+    d3 = ('lake_node', 'lat', 'lon')
+    has_lake = grid.field(0., 1.) < 0.5
+    # the first tile holds the vegetation class with the lowest index
+    first = cv[:-1] > 0
+    first_cv = np.where(first.any(axis=0),
+                        np.choose(np.argmax(first, axis=0), cv[:-1]), 0.)
+
+    lake_idx = np.where(has_lake, 0, -1).astype(np.int32)
+    numnod = np.where(has_lake, N_LAKE_NODES, 0).astype(np.int32)
+    max_depth = np.where(has_lake, grid.field(2., 20.), 0.)
+    mindepth = 0.05 * max_depth
+
+    nodes = np.arange(N_LAKE_NODES)[:, None, None]
+    frac = 1. - nodes / float(N_LAKE_NODES)
+    basin_depth = max_depth * frac
+    basin_area = np.where(has_lake, first_cv, 0.) * frac ** 2
+
+    params = OrderedDict()
+    params['lake_idx'] = (d2, lake_idx, 'i4')
+    params['numnod'] = (d2, numnod, 'i4')
+    params['mindepth'] = (d2, mindepth, 'f8')
+    params['wfrac'] = (d2, np.where(has_lake, 0.01, 0.), 'f8')
+    params['depth_in'] = (d2, 0.5 * max_depth, 'f8')
+    params['rpercent'] = (d2, np.where(has_lake, 0.1, 0.), 'f8')
+    params['basin_depth'] = (d3, basin_depth, 'f8')
+    params['basin_area'] = (d3, basin_area, 'f8')
+    return params
+
+
+def svp(t):
+    '''saturated vapor pressure (kPa) at air temperature t (C)'''
+    return 0.61078 * np.exp(17.269 * t / (237.3 + t))
+
+
+def forcing_step(grid, options, when, base):
+    '''forcings of one time step'''
+    doy = when.timetuple().tm_yday
+    hour = when.hour + 0.5
+
+    season = -np.cos(2. * np.pi * (doy - 15.) / 365.)
+    t = (grid.t_mean + 12. * season +
+         5. * np.sin(2. * np.pi * (hour - 9.) / 24.) +
+         grid.rng.normal(0., 1., size=base['wet'].shape))
+
+    # clear sky shortwave from the solar elevation
+    decl = np.radians(23.45) * np.sin(2. * np.pi * (284. + doy) / 365.)
+    hour_angle = np.radians(15. * (hour - 12.) + grid.lon2d + 120.)
+    lat = np.radians(grid.lat2d)
+    cos_zen = (np.sin(lat) * np.sin(decl) +
+               np.cos(lat) * np.cos(decl) * np.cos(hour_angle))
+    cloud = grid.rng.uniform(0.4, 1., size=t.shape)
+    sw = np.maximum(cos_zen, 0.) * 1000. * cloud
+
+    wet = grid.rng.uniform(size=t.shape) < base['wet']
+    prec = np.where(wet, grid.rng.exponential(1.5, size=t.shape), 0.)
+
+    values = OrderedDict()
+    values['AIR_TEMP'] = t
+    values['PREC'] = prec
+    values['PRESSURE'] = base['pressure']
+    values['SWDOWN'] = sw
+    values['LWDOWN'] = (0.75 + 0.15 * (1. - cloud)) * 5.67e-8 * \
+        (t + 273.15) ** 4
+    values['VP'] = grid.rng.uniform(0.5, 0.9, size=t.shape) * svp(t)
+    values['WIND'] = grid.rng.uniform(1., 5., size=t.shape)
+    if 'lakes' in options:
+        values['CHANNEL_IN'] = np.zeros(t.shape)
+    if 'carbon' in options:
+        # the model expects a mixing ratio, not ppm
+        values['CATM'] = np.full(t.shape, 3.8e-4)
+        values['FDIR'] = 0.2 + 0.6 * (cloud - 0.4) / 0.6
+        values['PAR'] = 0.45 * sw
+    return values
+
+
+def forcing_vars(options):
+    '''forcing variable names and units, by forcing type'''
+    names = OrderedDict(FORCING_VARS)
+    if 'lakes' in options:
+        names.update(LAKE_FORCING_VARS)
+    if 'carbon' in options:
+        names.update(CARBON_FORCING_VARS)
+    return names
+
+
+def write_forcings(prefix, grid, options, start, days,
+                   steps_per_day=STEPS_PER_DAY):
+    '''write one forcing file per calendar year from start for days days.
+    Each file holds one step more than the run needs from it: vic_force
+    reads the lake channel inflow one step ahead.'''
+    names = forcing_vars(options)
+    dt = datetime.timedelta(days=1. / steps_per_day)
+    end = start + datetime.timedelta(days=days)
+    base = {'wet': grid.field(0.05, 0.3),
+            'pressure': 101.3 * np.exp(-grid.elev / 8400.)}
+
+    paths = []
+    year_start = start
+    while year_start < end:
+        year_end = min(end, datetime.datetime(year_start.year + 1, 1, 1))
+        nsteps = int(round((year_end - year_start).total_seconds() /
+                           dt.total_seconds())) + 1
+        path = '{}{:4d}.nc'.format(prefix, year_start.year)
+        with netCDF4.Dataset(path, 'w', format='NETCDF4_CLASSIC') as nc:
+            add_coords(nc, grid)
+            nc.createDimension('time', None)
+            time = nc.createVariable('time', 'f8', ('time',))
+            time.units = 'hours since {:%Y-%m-%d %H:%M:%S}'.format(
+                year_start)
+            time.calendar = 'proleptic_gregorian'
+            time[:] = np.arange(nsteps) * 24. / steps_per_day
+            variables = OrderedDict()
+            for key, (name, units) in names.items():
+                var = nc.createVariable(name, 'f4', ('time', 'lat', 'lon'),
+                                        chunksizes=(1, grid.ny, grid.nx))
+                var.units = units
+                var.long_name = key
+                variables[key] = var
+            for step in range(nsteps):
+                values = forcing_step(grid, options, year_start + step * dt,
+                                      base)
+                for key, var in variables.items():
+                    var[step] = values[key]
+        paths.append(path)
+        year_start = year_end
+    return paths
+
+
+def write_global_param(path, grid, options, files, start, days, result_dir,
+                       output=True):
+    '''write a global parameter file for the synthetic files'''
+    names = forcing_vars(options)
+    end = start + datetime.timedelta(days=days - 1)
+
+    def flag(option):
+        return 'TRUE' if option in options else 'FALSE'
+
+    text = global_template.format(
+        ncells=grid.ncells, ny=grid.ny, nx=grid.nx, seed=grid.seed,
+        opts=', '.join(sorted(options)) or 'none',
+        steps_per_day=STEPS_PER_DAY, start=start, end=end,
+        frozen_soil=flag('frozen_soil'), carbon=flag('carbon'),
+        rc_mode='RC_PHOTO' if 'carbon' in options else 'RC_JARVIS',
+        nodes=NODES_FROZEN_SOIL if 'frozen_soil' in options else NODES,
+        domain=files['domain'], forcing_prefix=files['forcing_prefix'],
+        force_types='\n'.join('FORCE_TYPE    {:<12}{}'.format(key, name)
+                              for key, (name, _) in names.items()),
+        params=files['params'], snow_band=flag('snow_bands'),
+        lakes=flag('lakes'), result_dir=result_dir)
+    if output:
+        text += output_template.format(
+            outvars='\n'.join('OUTVAR        {}'.format(v) for v in OUTVARS))
+    with open(path, 'w') as f:
+        f.write(text)
+    return path
+
+
+def active_cells(grid):
+    '''row and column indices of the active grid cells'''
+    return list(zip(*np.nonzero(grid.mask)))
+
+
+def write_classic_soil(path, grid, params):
+    '''write the soil parameter file of the classic driver: one line per
+    active grid cell'''
+    columns = (('run_cell', 'gridcell'), ('lat', 'lon'),
+               ('infilt', 'Ds', 'Dsmax', 'Ws', 'c', 'expt', 'Ksat', 'phi_s',
+                'init_moist', 'elev', 'depth', 'avg_T', 'dp', 'bubble',
+                'quartz', 'bulk_density', 'soil_density', 'off_gmt',
+                'Wcr_FRACT', 'Wpwp_FRACT', 'rough', 'snow_rough',
+                'annual_prec', 'resid_moist', 'fs_active'))
+    coords = {'lat': grid.lat2d, 'lon': grid.lon2d}
+    with open(path, 'w') as f:
+        for j, i in active_cells(grid):
+            row = ['{:d}'.format(int(params[name][1][j, i]))
+                   for name in columns[0]]
+            row += ['{:.6f}'.format(coords[name][j, i])
+                    for name in columns[1]]
+            for name in columns[2]:
+                values = np.atleast_1d(params[name][1][..., j, i])
+                row += ['{:.6g}'.format(v) for v in values]
+            f.write(' '.join(row) + '\n')
+
+
+def write_classic_veglib(path, params):
+    '''write the vegetation library of the classic driver'''
+    with open(path, 'w') as f:
+        f.write('# synthetic vegetation library\n')
+        for k, veg in enumerate(VEG_LIBRARY):
+            row = [k + 1, params['overstory'][1][k, 0, 0],
+                   params['rarc'][1][k, 0, 0], params['rmin'][1][k, 0, 0]]
+            for name in ('LAI', 'albedo', 'veg_rough', 'displacement'):
+                row += list(params[name][1][k, :, 0, 0])
+            for name in ('wind_h', 'RGL', 'rad_atten', 'wind_atten',
+                         'trunk_ratio'):
+                row.append(params[name][1][k, 0, 0])
+            f.write(' '.join('{:.6g}'.format(v) for v in row) +
+                    ' {}\n'.format(veg[0].replace(' ', '_')))
+
+
+def write_classic_vegparam(path, grid, params):
+    '''write the vegetation parameter file of the classic driver.  Bare
+    soil, the last class, is the part of the cell that no tile covers.'''
+    cv = params['Cv'][1]
+    root_depth = params['root_depth'][1]
+    root_fract = params['root_fract'][1]
+    with open(path, 'w') as f:
+        for j, i in active_cells(grid):
+            classes = [k for k in range(len(VEG_LIBRARY) - 1)
+                       if cv[k, j, i] > 0]
+            f.write('{:d} {:d}\n'.format(int(params['gridcell'][1][j, i]),
+                                         len(classes)))
+            for k in classes:
+                row = ['{:d}'.format(k + 1), '{:.6f}'.format(cv[k, j, i])]
+                for z in range(N_ROOT_ZONES):
+                    row += ['{:.6g}'.format(root_depth[k, z, j, i]),
+                            '{:.6g}'.format(root_fract[k, z, j, i])]
+                f.write('    ' + ' '.join(row) + '\n')
+
+
+def write_classic_snowband(path, grid, params):
+    '''write the snow band file of the classic driver'''
+    with open(path, 'w') as f:
+        for j, i in active_cells(grid):
+            row = ['{:d}'.format(int(params['gridcell'][1][j, i]))]
+            for name in ('AreaFract', 'elevation', 'Pfactor'):
+                row += ['{:.6g}'.format(v) for v in params[name][1][:, j, i]]
+            f.write(' '.join(row) + '\n')
+
+
+def classic_forcing_file(prefix, grid, j, i):
+    '''name of the forcing file of a grid cell'''
+    return '{0}{1:.{3}f}_{2:.{3}f}'.format(prefix, grid.lat2d[j, i],
+                                           grid.lon2d[j, i], GRID_DECIMAL)
+
+
+def write_classic_forcings(prefix, grid, options, start, days,
+                           steps_per_day=STEPS_PER_DAY):
+    '''write one ASCII forcing file per active grid cell, holding the
+    forcings of the image driver from start for days days'''
+    names = forcing_vars(options)
+    dt = datetime.timedelta(days=1. / steps_per_day)
+    base = {'wet': grid.field(0.05, 0.3),
+            'pressure': 101.3 * np.exp(-grid.elev / 8400.)}
+    nsteps = days * steps_per_day
+    data = np.empty((nsteps, len(names), grid.ny, grid.nx))
+    for step in range(nsteps):
+        values = forcing_step(grid, options, start + step * dt, base)
+        for k, key in enumerate(names):
+            data[step, k] = values[key]
+    paths = []
+    for j, i in active_cells(grid):
+        path = classic_forcing_file(prefix, grid, j, i)
+        np.savetxt(path, data[:, :, j, i], fmt='%.4f')
+        paths.append(path)
+    return paths
+
+
+def write_classic_global_param(path, grid, options, files, start, days,
+                               result_dir, output=True):
+    '''write a global parameter file of the classic driver for the
+    synthetic files'''
+    names = forcing_vars(options)
+    end = start + datetime.timedelta(days=days - 1)
+    if 'snow_bands' in options:
+        snow_band = 'SNOW_BAND     {}  {}'.format(N_SNOW_BANDS,
+                                                  files['snowband'])
+    else:
+        snow_band = ''
+
+    text = classic_global_template.format(
+        ncells=grid.ncells, ny=grid.ny, nx=grid.nx, seed=grid.seed,
+        opts=', '.join(sorted(options)) or 'none', nlayer=NLAYER,
+        nodes=NODES_FROZEN_SOIL if 'frozen_soil' in options else NODES,
+        steps_per_day=STEPS_PER_DAY, start=start, end=end,
+        frozen_soil='TRUE' if 'frozen_soil' in options else 'FALSE',
+        forcing_prefix=files['forcing_prefix'],
+        force_types='\n'.join('FORCE_TYPE    {}'.format(key)
+                              for key in names),
+        grid_decimal=GRID_DECIMAL, soil=files['soil'],
+        veglib=files['veglib'], vegparam=files['vegparam'],
+        root_zones=N_ROOT_ZONES, snow_band=snow_band,
+        result_dir=result_dir)
+    if output:
+        text += classic_output_template.format(
+            outvars='\n'.join('OUTVAR        {}'.format(v) for v in OUTVARS))
+    with open(path, 'w') as f:
+        f.write(text)
+    return path
+
+
+def make_classic_files(out_dir, grid, options, params, start, days,
+                       result_dir, output=True):
+    '''write the input files of the classic driver into out_dir'''
+    files = OrderedDict()
+    files['soil'] = os.path.join(out_dir, 'soil.txt')
+    files['veglib'] = os.path.join(out_dir, 'veglib.txt')
+    files['vegparam'] = os.path.join(out_dir, 'vegparam.txt')
+    files['forcing_prefix'] = os.path.join(out_dir, 'forcings', 'data_')
+    os.makedirs(os.path.dirname(files['forcing_prefix']), exist_ok=True)
+    write_classic_soil(files['soil'], grid, params)
+    write_classic_veglib(files['veglib'], params)
+    write_classic_vegparam(files['vegparam'], grid, params)
+    if 'snow_bands' in options:
+        files['snowband'] = os.path.join(out_dir, 'snowband.txt')
+        write_classic_snowband(files['snowband'], grid, params)
+    files['forcings'] = write_classic_forcings(files['forcing_prefix'], grid,
+                                               options, start, days)
+    files['global_param'] = write_classic_global_param(
+        os.path.join(out_dir, 'global_param.txt'), grid, options, files,
+        start, days, result_dir, output=output)
+    return files
+
+
+def make_synthetic_domain(out_dir, ncells, options=(), nveg=3,
+                          land_fraction=1.,
+                          start=datetime.datetime(2000, 1, 1), days=2,
+                          seed=0, output=True, result_dir=None,
+                          driver='image'):
+    '''write a synthetic domain of ncells active grid cells for driver into
+    out_dir.  The model output goes to result_dir (default: out_dir/results).
+    Returns the paths of the files, including the global parameter file.'''
+    options = set(options)
+    if driver not in DRIVERS:
+        raise ValueError('unknown driver: {}'.format(driver))
+    unknown = options - set(OPTIONS if driver == 'image' else
+                            CLASSIC_OPTIONS)
+    if unknown:
+        raise ValueError('unknown options for the {} driver: {}'.format(
+            driver, ', '.join(unknown)))
+    if not 1 <= nveg < len(VEG_LIBRARY):
+        raise ValueError('nveg must be between 1 and {}'.format(
+            len(VEG_LIBRARY) - 1))
+    if not 0. < land_fraction <= 1.:
+        raise ValueError('land_fraction must be in (0, 1]')
+
+    out_dir = os.path.abspath(out_dir)
+    os.makedirs(out_dir, exist_ok=True)
+    if result_dir is None:
+        result_dir = os.path.join(out_dir, 'results')
+    result_dir = os.path.abspath(result_dir)
+    os.makedirs(result_dir, exist_ok=True)
+
+    grid = SyntheticGrid(ncells, land_fraction=land_fraction, seed=seed)
+    params = synthetic_params(grid, options, nveg)
+    if driver == 'classic':
+        return make_classic_files(out_dir, grid, options, params, start,
+                                  days, result_dir, output=output)
+
+    files = OrderedDict()
+    files['domain'] = os.path.join(out_dir, 'domain.nc')
+    files['params'] = os.path.join(out_dir, 'params.nc')
+    files['forcing_prefix'] = os.path.join(out_dir, 'forcings.')
+    write_domain(files['domain'], grid)
+    write_params(files['params'], grid, options, params)
+    files['forcings'] = write_forcings(files['forcing_prefix'], grid,
+                                       options, start, days)
+    files['global_param'] = write_global_param(
+        os.path.join(out_dir, 'global_param.txt'), grid, options, files,
+        start, days, result_dir, output=output)
+    return files
+
+
+def main():
+    '''command line interface'''
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('out_dir', type=str,
+                        help='directory to write the files to')
+    parser.add_argument('--ncells', type=int, default=10000,
+                        help='number of active grid cells')
+    parser.add_argument('--driver', type=str, default='image',
+                        choices=DRIVERS,
+                        help='driver to write the files for')
+    parser.add_argument('--options', type=str, default='',
+                        help='comma separated options from: {} (classic: '
+                             '{})'.format(', '.join(OPTIONS),
+                                          ', '.join(CLASSIC_OPTIONS)))
+    parser.add_argument('--nveg', type=int, default=3,
+                        help='number of vegetation tiles per grid cell, '
+                             'besides bare soil')
+    parser.add_argument('--land_fraction', type=float, default=1.,
+                        help='fraction of the grid cells that are active')
+    parser.add_argument('--start', type=str, default='2000-01-01',
+                        help='first day of the run (YYYY-MM-DD)')
+    parser.add_argument('--days', type=int, default=2,
+                        help='number of days to run')
+    parser.add_argument('--seed', type=int, default=0,
+                        help='seed of the random fields')
+    parser.add_argument('--no_output', action='store_true',
+                        help='write no model output')
+    args = parser.parse_args()
+
+    files = make_synthetic_domain(
+        args.out_dir, args.ncells,
+        options=[o for o in args.options.split(',') if o],
+        nveg=args.nveg, land_fraction=args.land_fraction,
+        start=datetime.datetime.strptime(args.start, '%Y-%m-%d'),
+        days=args.days, seed=args.seed, output=not args.no_output,
+        driver=args.driver)
+    print('Wrote {}'.format(files['global_param']))
+
+
+if __name__ == '__main__':
+    main()
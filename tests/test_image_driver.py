@@ -2,6 +2,7 @@
 ''' VIC Image Driver testing '''
 import os
 import re
+import datetime
 
 import xarray as xr
 import pandas as pd
@@ -10,6 +11,17 @@ import numpy.testing as npt
 import glob
 import warnings
 
+from synthetic_domain import make_synthetic_domain
+
+# balance tolerances of the adaptive_snow_step check: the largest water
+# balance error (mm) of a grid cell and output interval, the increase of the
+# mean absolute energy balance error (fraction of the error with single snow
+# steps) and the largest difference in snow water equivalent (mm) from the run
+# with single snow steps
+ADAPTIVE_SNOW_WATER_ERROR_TOL = 1e-6
+ADAPTIVE_SNOW_ENERGY_ERROR_RTOL = 0.25
+ADAPTIVE_SNOW_SWE_ATOL = 2.
+
 
 def test_image_driver_no_output_file_nans(fnames, domain_file):
     '''
@@ -54,6 +66,70 @@ def assert_nan_equal(ds_domain, ds_output):
                                np.isnan(ds_domain['mask']))
 
 
+def make_synthetic_test_domain(synthetic, out_dir, result_dir,
+                               driver='image'):
+    '''write the synthetic domain of the [[synthetic]] section of a test for
+    driver into out_dir and return the path of its global parameter file'''
+    options = synthetic.get('options', [])
+    if not isinstance(options, list):
+        options = [o for o in options.split(',') if o]
+    files = make_synthetic_domain(
+        out_dir, int(synthetic.get('ncells', 8)), options=options,
+        nveg=int(synthetic.get('nveg', 3)),
+        start=datetime.datetime.strptime(synthetic.get('start', '2000-01-01'),
+                                         '%Y-%m-%d'),
+        days=int(synthetic.get('days', 2)),
+        seed=int(synthetic.get('seed', 0)), result_dir=result_dir,
+        driver=driver)
+    return files['global_param']
+
+
+def check_adaptive_snow_step_image(result_dir, reference_dir):
+    '''
+    Test the water and energy balance of a run with ADAPTIVE_SNOW_STEP
+    against a run of the same configuration with single snow steps
+    '''
+    fnames = sorted(glob.glob(os.path.join(result_dir, '*.nc')))
+    if not fnames:
+        raise ValueError('no output in {}'.format(result_dir))
+    swe_differs = False
+    for fname in fnames:
+        ds = xr.open_dataset(fname)
+        ds_ref = xr.open_dataset(os.path.join(reference_dir,
+                                              os.path.basename(fname)))
+
+        # water balance: closed to round-off in every cell and interval
+        water_error = np.nanmax(np.abs(ds['OUT_WATER_ERROR'].values))
+        if water_error > ADAPTIVE_SNOW_WATER_ERROR_TOL:
+            raise AssertionError('{}: water balance error of {:.3g} mm with '
+                                 'ADAPTIVE_SNOW_STEP'.format(fname,
+                                                             water_error))
+
+        # energy balance: not much larger than with single snow steps
+        energy_error = np.nanmean(np.abs(ds['OUT_ENERGY_ERROR'].values))
+        energy_error_ref = np.nanmean(
+            np.abs(ds_ref['OUT_ENERGY_ERROR'].values))
+        if energy_error > (1. + ADAPTIVE_SNOW_ENERGY_ERROR_RTOL) * \
+                energy_error_ref:
+            raise AssertionError('{}: mean energy balance error of {:.3g} '
+                                 'W/m2 with ADAPTIVE_SNOW_STEP and {:.3g} '
+                                 'W/m2 without'.format(fname, energy_error,
+                                                       energy_error_ref))
+
+        npt.assert_allclose(ds['OUT_SWE'].values, ds_ref['OUT_SWE'].values,
+                            rtol=0., atol=ADAPTIVE_SNOW_SWE_ATOL,
+                            err_msg='{}: OUT_SWE'.format(fname))
+        swe_differs |= not np.array_equal(ds['OUT_SWE'].values,
+                                          ds_ref['OUT_SWE'].values,
+                                          equal_nan=True)
+
+    # identical output means that no snow steps were merged and the test
+    # did not exercise the option
+    if not swe_differs:
+        raise AssertionError('output with ADAPTIVE_SNOW_STEP is identical '
+                             'to the output with single snow steps')
+
+
 def check_multistream_image(fnames):
     '''
     Test the multistream aggregation in the image driver
@@ -0,0 +1,338 @@
+'''Performance regression tests: run a configuration, measure its cost and
+compare it with a stored baseline'''
+
+from __future__ import print_function
+import os
+import glob
+import json
+import string
+import subprocess
+import time
+from collections import OrderedDict
+
+import numpy as np
+import psutil
+import xarray as xr
+
+from test_utils import replace_global_values
+from test_image_driver import make_synthetic_test_domain
+
+# version of the layout of the baseline and results files; bump it when the
+# metrics or their meaning change, so that old baselines are not compared
+PERF_BASELINE_VERSION = 2
+
+# solver call sites of OUT_SOLVER_*, in the order of their elements
+SOLVER_SITES = ('surf_energy_bal', 'canopy_energy_bal', 'atmos_energy_bal',
+                'snow_pack_energy_bal', 'ice_energy_bal', 'soil_thermal',
+                'soil_thermal_node', 'heat_eqn_implicit', 'grnd_flux_iter',
+                'canopy_iter')
+
+# metrics compared with the baseline, and the default relative increase
+# over the baseline that is flagged as a regression.  Solver evaluations do
+# not depend on the machine, so their threshold is tight.  The time ratio is
+# compared across machines, whose caches and compilers change the relative
+# cost of the tests, so its threshold is loose.
+PERF_THRESHOLDS = OrderedDict([('wall_time', 0.15),
+                               ('vic_run_time', 0.15),
+                               ('peak_rss', 0.10),
+                               ('solver_evals', 0.02),
+                               ('vic_run_time_ratio', 0.25)])
+
+# metrics that do not depend on the machine, which the baseline keeps for all
+# hosts, and metrics that are only comparable on the host that measured them,
+# which the baseline keeps by hostname
+PERF_PORTABLE_METRICS = ('solver_calls', 'solver_evals',
+                         'solver_evals_by_site', 'vic_run_time_ratio')
+PERF_HOST_METRICS = ('wall_time', 'vic_run_time', 'peak_rss', 'repeat')
+
+# output stream added to each run: daily sums of the time spent in vic_run
+# and of the solver statistics
+perf_output_stream = '''
+OUTFILE     perf
+AGGFREQ     NDAYS   1
+OUTVAR      OUT_TIME_VICRUN_WALL  %.6f  *  *  AGG_TYPE_SUM
+OUTVAR      OUT_SOLVER_CALLS      %.0f
+OUTVAR      OUT_SOLVER_EVALS      %.0f
+'''
+
+
+def write_perf_global_param(test_dict, config_dir, global_file,
+                            synthetic_dir=None, **templates):
+    '''write the global parameter file of a performance test with the
+    performance output stream.  Tests with a [[synthetic]] section start from
+    the global parameter file of a synthetic domain written to
+    synthetic_dir.'''
+    if 'synthetic' in test_dict:
+        infile = make_synthetic_test_domain(test_dict['synthetic'],
+                                            synthetic_dir,
+                                            templates['result_dir'],
+                                            driver=test_dict['driver'])
+    else:
+        infile = os.path.join(config_dir, test_dict['global_parameter_file'])
+    with open(infile) as f:
+        global_param = f.read()
+    replacements = OrderedDict(test_dict.get('options', {}))
+    global_param = ''.join(replace_global_values(global_param, replacements))
+    global_param = string.Template(global_param).safe_substitute(**templates)
+    with open(global_file, 'w') as f:
+        f.write(global_param)
+        f.write(perf_output_stream)
+    return global_file
+
+
+def sample_peak_rss(proc):
+    '''peak resident set size (bytes) of a running process so far, or its
+    current resident set size where the peak is not available'''
+    try:
+        with open('/proc/{}/status'.format(proc.pid)) as f:
+            for line in f:
+                if line.startswith('VmHWM:'):
+                    return int(line.split()[1]) * 1024
+    except (IOError, OSError, ValueError):
+        pass
+    try:
+        return proc.memory_info().rss
+    except psutil.Error:
+        return 0
+
+
+def run_measured(args, log_file, interval=0.005):
+    '''run a command, returning its return code, its wall time (s) and its
+    peak resident set size (MB).
+
+    The peak is sampled every `interval` seconds while the command runs:
+    ru_maxrss of the child cannot be used, because it includes the memory of
+    this Python process, from which the child is forked.'''
+    peak_rss = 0
+    with open(log_file, 'w') as f:
+        start = time.time()
+        proc = psutil.Popen(args, stdout=f, stderr=subprocess.STDOUT)
+        while proc.poll() is None:
+            peak_rss = max(peak_rss, sample_peak_rss(proc))
+            time.sleep(interval)
+        wall_time = time.time() - start
+    return proc.returncode, wall_time, peak_rss / 1024. ** 2
+
+
+def read_perf_output(result_dir, driver):
+    '''sum the time spent in vic_run and the solver statistics of the
+    performance output stream over all grid cells and output intervals'''
+    vic_run_time = 0.
+    calls = np.zeros(len(SOLVER_SITES))
+    evals = np.zeros(len(SOLVER_SITES))
+    if driver == 'classic':
+        fnames = glob.glob(os.path.join(result_dir, 'perf_*.txt'))
+        for fname in fnames:
+            with open(fname) as f:
+                lines = [line for line in f if not line.startswith('#')]
+            columns = [c.strip() for c in lines[0].split('\t')]
+            data = np.loadtxt(lines[1:], ndmin=2)
+            totals = dict(zip(columns, data.sum(axis=0)))
+            vic_run_time += totals['OUT_TIME_VICRUN_WALL']
+            for i in range(len(SOLVER_SITES)):
+                calls[i] += totals['OUT_SOLVER_CALLS_{}'.format(i)]
+                evals[i] += totals['OUT_SOLVER_EVALS_{}'.format(i)]
+    elif driver == 'image':
+        fnames = glob.glob(os.path.join(result_dir, 'perf.*.nc'))
+        for fname in fnames:
+            with xr.open_dataset(fname) as ds:
+                vic_run_time += float(ds['OUT_TIME_VICRUN_WALL'].sum())
+                dims = [d for d in ds['OUT_SOLVER_EVALS'].dims
+                        if d != 'solver_site']
+                calls += ds['OUT_SOLVER_CALLS'].sum(dim=dims).values
+                evals += ds['OUT_SOLVER_EVALS'].sum(dim=dims).values
+    else:
+        raise ValueError('unknown driver')
+    if not fnames:
+        raise ValueError('no performance output in {}'.format(result_dir))
+
+    metrics = OrderedDict()
+    metrics['vic_run_time'] = vic_run_time
+    metrics['solver_calls'] = float(calls.sum())
+    metrics['solver_evals'] = float(evals.sum())
+    metrics['solver_evals_by_site'] = OrderedDict(
+        (site, float(n)) for site, n in zip(SOLVER_SITES, evals))
+    return metrics
+
+
+def perf_global_file(dirs, testname):
+    '''path of the global parameter file of a performance test'''
+    return os.path.join(dirs['test'], '{}_globalparam.txt'.format(testname))
+
+
+def run_perf_once(vic_exe, driver, global_file, dirs, log_file):
+    '''run VIC once and return the wall time, the peak RSS and the metrics
+    of the performance output stream'''
+    for fname in glob.glob(os.path.join(dirs['results'], '*')):
+        os.remove(fname)
+    returncode, wall_time, peak_rss = run_measured(
+        [vic_exe, '-g', global_file], log_file)
+    if returncode != 0:
+        raise RuntimeError('VIC return code ({}) was not 0 when running '
+                           '{} (see {})'.format(returncode, global_file,
+                                                log_file))
+    metrics = OrderedDict()
+    metrics['wall_time'] = wall_time
+    metrics.update(read_perf_output(dirs['results'], driver))
+    metrics['peak_rss'] = peak_rss
+    return metrics
+
+
+def perf_time_reference(test_dict, ran):
+    '''name and directories of the `time_reference` test of a test, or None
+    if it has none.  ran maps the tests that have run to their
+    directories.'''
+    reference = test_dict.get('time_reference')
+    if reference is None:
+        return None
+    if reference not in ran:
+        raise RuntimeError('the time reference {} of this test did not '
+                           'run'.format(reference))
+    return reference, ran[reference]
+
+
+def run_perf_test(vic_exe, driver, test_dict, config_dir, test_data_dir,
+                  dirs, testname, reference=None):
+    '''run a performance test `repeat` times and collect its metrics.
+    Times are the fastest of the repeats, the peak RSS the largest.
+
+    reference is the name and directories of the `time_reference` test,
+    which must have run.  It is run again before each repeat, so that both
+    run under the same load, and vic_run_time_ratio is the median of the
+    ratios of their vic_run times.  Unlike the times, the ratio can be
+    compared with a baseline recorded on another machine.'''
+    global_file = write_perf_global_param(
+        test_dict, config_dir, perf_global_file(dirs, testname),
+        synthetic_dir=os.path.join(dirs['test'], 'synthetic'),
+        test_data_dir=test_data_dir, result_dir=dirs['results'],
+        state_dir=dirs['state'])
+
+    metrics = OrderedDict()
+    ratios = []
+    repeat = int(test_dict.get('repeat', 3))
+    for i in range(repeat):
+        if reference is not None:
+            ref_name, ref_dirs = reference
+            ref_run = run_perf_once(
+                vic_exe, driver, perf_global_file(ref_dirs, ref_name),
+                ref_dirs, os.path.join(dirs['logs'], '{}_reference_{}.txt'
+                                       .format(testname, i)))
+        run = run_perf_once(vic_exe, driver, global_file, dirs,
+                            os.path.join(dirs['logs'],
+                                         '{}_{}.txt'.format(testname, i)))
+        if reference is not None:
+            ratios.append(run['vic_run_time'] / ref_run['vic_run_time'])
+        if not metrics:
+            metrics.update(run)
+        else:
+            metrics['wall_time'] = min(metrics['wall_time'],
+                                       run['wall_time'])
+            metrics['vic_run_time'] = min(metrics['vic_run_time'],
+                                          run['vic_run_time'])
+            metrics['peak_rss'] = max(metrics['peak_rss'], run['peak_rss'])
+    if ratios:
+        metrics['vic_run_time_ratio'] = float(np.median(ratios))
+    metrics['repeat'] = repeat
+    return metrics
+
+
+def portable_perf_metrics(metrics):
+    '''the metrics of a test that do not depend on the machine'''
+    return OrderedDict((k, v) for k, v in metrics.items()
+                       if k in PERF_PORTABLE_METRICS)
+
+
+def host_perf_metrics(metrics):
+    '''the metrics of a test that are only comparable on the machine that
+    measured them'''
+    return OrderedDict((k, v) for k, v in metrics.items()
+                       if k in PERF_HOST_METRICS)
+
+
+def perf_results_header(vic_exes, portable=False):
+    '''header of a baseline or results file.  The metrics of the tests that
+    do not depend on the machine go to `configs`, the others to the
+    `configs` of this host in `hosts`.  A portable baseline has no hosts.'''
+    vic_exes = list(vic_exes)
+    header = OrderedDict()
+    header['format_version'] = PERF_BASELINE_VERSION
+    header['date'] = time.strftime('%Y-%m-%dT%H:%M:%S')
+    try:
+        header['git_version'] = subprocess.check_output(
+            ['git', 'describe', '--abbrev=4', '--dirty', '--always',
+             '--tags']).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        header['git_version'] = None
+    header['vic_exe'] = OrderedDict((dr, os.path.basename(exe))
+                                    for dr, exe in vic_exes)
+    header['configs'] = OrderedDict()
+    header['hosts'] = OrderedDict()
+    if not portable:
+        host = OrderedDict()
+        host['date'] = header['date']
+        host['vic_exe'] = OrderedDict(vic_exes)
+        host['configs'] = OrderedDict()
+        header['hosts'][os.uname()[1]] = host
+    return header
+
+
+def add_perf_metrics(results, testname, metrics):
+    '''add the metrics of a test to a baseline or results file; the times
+    and memory use only if it has a section for this host'''
+    results['configs'][testname] = portable_perf_metrics(metrics)
+    host = results['hosts'].get(os.uname()[1])
+    if host is not None:
+        host['configs'][testname] = host_perf_metrics(metrics)
+
+
+def perf_baseline_metrics(baseline, testname, hostname=None):
+    '''the baseline metrics of a test: those that do not depend on the
+    machine and, if the baseline has them, the times and memory use of the
+    test on host hostname (default: this host)'''
+    metrics = OrderedDict(baseline['configs'][testname])
+    host = baseline['hosts'].get(hostname or os.uname()[1])
+    if host is not None:
+        metrics.update(host['configs'].get(testname, {}))
+    return metrics
+
+
+def read_perf_baseline(baseline_file):
+    '''read a baseline file, or return None if it does not exist'''
+    if not os.path.isfile(baseline_file):
+        return None
+    with open(baseline_file) as f:
+        baseline = json.load(f, object_pairs_hook=OrderedDict)
+    if baseline.get('format_version') != PERF_BASELINE_VERSION:
+        raise ValueError('baseline {} has format version {}, expected '
+                         '{}'.format(baseline_file,
+                                     baseline.get('format_version'),
+                                     PERF_BASELINE_VERSION))
+    return baseline
+
+
+def compare_perf_metrics(metrics, baseline_metrics, thresholds=None):
+    '''compare the metrics of a test with those of its baseline.
+
+    Returns the regressions and the improvements beyond the thresholds, as
+    lists of (metric, baseline, current, relative change).'''
+    limits = PERF_THRESHOLDS.copy()
+    if thresholds:
+        limits.update((k, float(v)) for k, v in thresholds.items())
+    regressions = []
+    improvements = []
+    for metric, limit in limits.items():
+        base = baseline_metrics.get(metric)
+        if not base or metric not in metrics:
+            continue
+        change = (metrics[metric] - base) / base
+        if change > limit:
+            regressions.append((metric, base, metrics[metric], change))
+        elif change < -limit:
+            improvements.append((metric, base, metrics[metric], change))
+    return regressions, improvements
+
+
+def format_perf_changes(changes):
+    '''one line summary of the changes returned by compare_perf_metrics'''
+    return ', '.join('{} {:.4g} -> {:.4g} ({:+.1%})'.format(*c)
+                     for c in changes)
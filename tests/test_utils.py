@@ -2,6 +2,8 @@
 import os
 import re
 import glob
+import struct
+import subprocess
 import traceback
 import warnings
 from collections import OrderedDict, namedtuple
@@ -26,6 +28,14 @@ from tonic.testing import check_completed, check_for_nans, VICTestError
 OUTPUT_WIDTH = 100
 ERROR_TAIL = 20  # lines
 
+# output container cell directory of the classic driver
+# (container_header_struct and container_entry_struct)
+CONTAINER_MAGIC = b'VICCELLS'
+CONTAINER_VERSION = 2
+CONTAINER_HEADER = struct.Struct('@8sIIQQ')
+CONTAINER_ENTRY = struct.Struct('@IIddQQ')
+CONTAINER_READER = 'vic_container_cell.exe'
+
 VICOutFile = namedtuple('vic_out_file',
                         ('dirpath', 'prefix', 'lat', 'lon', 'suffix'))
 
@@ -98,10 +108,13 @@ def replace_global_values(gp, replace):
 
     if replace:
         for key, val in replace.items():
-            try:
-                value = ' '.join(val)
-            except:
+            if isinstance(val, str):
                 value = val
+            else:
+                try:
+                    value = ' '.join(val)
+                except:
+                    value = val
             gpl.append('{0: <20} {1}\n'.format(key, value))
 
     return gpl
@@ -347,6 +360,73 @@ def check_multistream_classic(fnames):
                             'failed comparison' % (key, freq, how))
 
 
+def read_container_directory(dirname):
+    '''read the cell directory of a classic driver output container.
+
+    Returns an OrderedDict of (lat, lng, offset, nbytes) keyed by grid cell
+    number; when a cell appears more than once the last entry is kept.'''
+    with open(dirname, 'rb') as f:
+        magic, version, entry_size, _, _ = CONTAINER_HEADER.unpack(
+            f.read(CONTAINER_HEADER.size))
+        if magic != CONTAINER_MAGIC or version != CONTAINER_VERSION or \
+                entry_size != CONTAINER_ENTRY.size:
+            raise VICTestError('{} is not a version {} container '
+                               'directory'.format(dirname, CONTAINER_VERSION))
+        entries = OrderedDict()
+        for buf in iter(lambda: f.read(CONTAINER_ENTRY.size), b''):
+            cellid, _, lat, lng, offset, nbytes = CONTAINER_ENTRY.unpack(buf)
+            entries[cellid] = (lat, lng, offset, nbytes)
+    return entries
+
+
+def check_output_container_classic(vic_exe, result_dir, container_dir):
+    '''Check that the block of each grid cell in the output containers of
+    container_dir, read back with the container reader of the classic driver
+    (`make container_cell`), is identical to the per-cell output file of the
+    same stream and grid cell in result_dir'''
+    reader = os.path.join(os.path.dirname(vic_exe.executable),
+                          CONTAINER_READER)
+    if not os.path.isfile(reader):
+        raise VICTestError('{} not found; build it with `make '
+                           'container_cell`'.format(reader))
+
+    # per-cell output files: <prefix>_<lat>_<lng>.<ext>
+    cell_files = {}
+    for fname in glob.glob(os.path.join(result_dir, '*')):
+        m = re.match(r'(.+)_(-?[0-9.]+)_(-?[0-9.]+)(\..+)$',
+                     os.path.basename(fname))
+        if m:
+            cell_files.setdefault((m.group(1), m.group(4)), []).append(
+                (float(m.group(2)), float(m.group(3)), fname))
+
+    dirnames = glob.glob(os.path.join(container_dir, '*_container.idx'))
+    if not dirnames:
+        raise VICTestError('no output containers in {}'.format(container_dir))
+    for dirname in dirnames:
+        prefix = os.path.basename(dirname)[:-len('_container.idx')]
+        dataname = [f for f in glob.glob(dirname[:-len('.idx')] + '.*')
+                    if f != dirname][0]
+        ext = os.path.basename(dataname)[len(prefix) + len('_container'):]
+        files = cell_files.get((prefix, ext), [])
+        entries = read_container_directory(dirname)
+        if len(entries) != len(files):
+            raise VICTestError('{} has {} grid cells, {} has {} output files '
+                               'of stream {}'.format(dataname, len(entries),
+                                                     result_dir, len(files),
+                                                     prefix))
+        for cellid, (lat, lng, offset, nbytes) in entries.items():
+            # the file names hold the location rounded to GRID_DECIMAL
+            fname = min(files,
+                        key=lambda f: abs(f[0] - lat) + abs(f[1] - lng))[2]
+            block = subprocess.check_output([reader, '-c', str(cellid),
+                                             dataname])
+            with open(fname, 'rb') as f:
+                expected = f.read()
+            if len(block) != nbytes or block != expected:
+                raise VICTestError('grid cell {} of {} differs from '
+                                   '{}'.format(cellid, dataname, fname))
+
+
 def setup_subdirs_and_fill_in_global_param_driver_match_test(
         dict_s, result_basedir, state_basedir, test_data_dir):
     ''' Fill in global parameter output directories for multiple driver runs
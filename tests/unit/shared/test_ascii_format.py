@@ -0,0 +1,108 @@
+import ctypes
+import numpy as np
+from vic import lib as vic_lib
+from vic import ffi
+
+ASCII_FAST_MAX_PRECISION = 9
+ASCII_FAST_MAX_WIDTH = 32
+ASCII_FAST_MAX_LEN = 64
+
+libc = ctypes.CDLL(None)
+libc.snprintf.restype = ctypes.c_int
+
+
+def c_snprintf(fmt, value):
+    buf = ctypes.create_string_buffer(512)
+    n = libc.snprintf(buf, ctypes.c_size_t(512), fmt, ctypes.c_double(value))
+    return n, buf.value
+
+
+def sprint_ascii(fmt, value):
+    parsed = ffi.new('ascii_format_struct *')
+    cfmt = ffi.new('char []', fmt)
+    vic_lib.parse_ascii_format(cfmt, parsed)
+    buf = ffi.new('char []', 512)
+    n = vic_lib.sprint_ascii_value(buf, 512, cfmt, parsed, value)
+    return n, ffi.string(buf)
+
+
+def check_formats(formats, values):
+    for fmt in formats:
+        for value in values:
+            expected = c_snprintf(fmt, value)
+            assert sprint_ascii(fmt, value) == expected, (fmt, value)
+
+
+def sweep_values():
+    rng = np.random.RandomState(42)
+    values = [0., -0., 1., -1., 0.5, -0.5, 1.5, 2.5, 0.125, 0.375, -0.125,
+              1.0005, 2.675, 1e-10, -1e-10, 9.9999999, 99.99995, 1e15,
+              1e15 - 1, 123456789.123456789, 1e300, -1e300, 5e-324,
+              float('nan'), float('-nan'), float('inf'), float('-inf')]
+    # values between ties of every precision, and the ties themselves
+    for p in range(ASCII_FAST_MAX_PRECISION + 1):
+        for k in (1, 5, 15, 25, 12345):
+            values.append((k + 0.5) / 10 ** p)
+            values.append(-(k + 0.5) / 10 ** p)
+    for exponent in range(-12, 17):
+        values.extend(rng.uniform(-1., 1., 20) * 10. ** exponent)
+    return values
+
+
+def test_parse_ascii_format():
+    fmt = ffi.new('ascii_format_struct *')
+    for text, fixed, width, precision in (
+            (b'%.4f', True, 0, 4), (b'%f', True, 0, 6),
+            (b'%10.3lf', True, 10, 3), (b'%12f', True, 12, 6),
+            (b'%.0f', True, 0, 0), (b'%.10f', False, 0, 0),
+            (b'%40.2f', False, 0, 0), (b'%08.3f', False, 0, 0),
+            (b'%-8.3f', False, 0, 0), (b'%+.3f', False, 0, 0),
+            (b'%.3e', False, 0, 0), (b'%g', False, 0, 0),
+            (b'%.3f %.3f', False, 0, 0), (b'x%.3f', False, 0, 0)):
+        vic_lib.parse_ascii_format(ffi.new('char []', text), fmt)
+        assert fmt.fixed == fixed, text
+        if fixed:
+            assert fmt.width == width
+            assert fmt.precision == precision
+
+
+def test_sprint_ascii_value_fixed():
+    formats = []
+    for p in range(ASCII_FAST_MAX_PRECISION + 1):
+        formats.append('%.{}f'.format(p).encode())
+        for width in (1, 8, 16, ASCII_FAST_MAX_WIDTH):
+            formats.append('%{}.{}f'.format(width, p).encode())
+    formats.extend([b'%f', b'%12f', b'%.4lf'])
+    check_formats(formats, sweep_values())
+
+
+def test_sprint_ascii_value_fallback():
+    # formats the fast formatter does not handle go through snprintf
+    formats = [b'%.10f', b'%40.2f', b'%08.3f', b'%-8.3f', b'%+.3f', b'%.3e',
+               b'%g', b'%.12g']
+    check_formats(formats, sweep_values())
+
+
+def test_sprint_ascii_value_truncation():
+    parsed = ffi.new('ascii_format_struct *')
+    cfmt = ffi.new('char []', b'%.4f')
+    vic_lib.parse_ascii_format(cfmt, parsed)
+    # a buffer smaller than ASCII_FAST_MAX_LEN truncates like snprintf
+    buf = ffi.new('char []', 4)
+    n = vic_lib.sprint_ascii_value(buf, 4, cfmt, parsed, 1234.5678)
+    assert n == 9
+    assert ffi.string(buf) == b'123'
+    buf = ffi.new('char []', ASCII_FAST_MAX_LEN)
+    n = vic_lib.sprint_ascii_value(buf, ASCII_FAST_MAX_LEN, cfmt, parsed,
+                                   1234.5678)
+    assert n == 9
+    assert ffi.string(buf) == b'1234.5678'
+
+
+def test_sprint_ascii_uint():
+    buf = ffi.new('char []', 32)
+    for value, ndigits, expected in ((0, 0, b'0'), (7, 2, b'07'),
+                                     (2016, 4, b'2016'), (12, 1, b'12'),
+                                     (4294967295, 0, b'4294967295')):
+        n = vic_lib.sprint_ascii_uint(buf, value, ndigits)
+        assert ffi.buffer(buf, n)[:] == expected
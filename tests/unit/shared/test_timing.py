@@ -35,3 +35,45 @@ def test_vic_timers():
     vic_lib.timer_stop(timer)
     assert timer[0].delta_wall >= 2 * sleeptime
     assert timer[0].delta_wall < 2 * (sleeptime + delta)
+
+
+def test_phase_timers():
+
+    sleeptime = 0.2
+    delta = 0.1
+
+    # disabled timers do not accumulate
+    vic_lib.initialize_phase_timers(False)
+    assert not vic_lib.phase_timers_enabled()
+    vic_lib.phase_timer_start(vic_lib.PHASE_FORCE)
+    time.sleep(sleeptime)
+    vic_lib.phase_timer_stop(vic_lib.PHASE_FORCE)
+    assert vic_lib.phase_timer_get(vic_lib.PHASE_FORCE) == 0.
+
+    # enabled timers accumulate over start/stop pairs
+    vic_lib.initialize_phase_timers(True)
+    for i in range(2):
+        vic_lib.phase_timer_start(vic_lib.PHASE_FORCE)
+        time.sleep(sleeptime)
+        vic_lib.phase_timer_stop(vic_lib.PHASE_FORCE)
+    assert vic_lib.phase_timer_get(vic_lib.PHASE_FORCE) >= 2 * sleeptime
+    assert vic_lib.phase_timer_get(vic_lib.PHASE_FORCE) < 2 * (sleeptime +
+                                                               delta)
+
+    # external timers are added to a phase
+    timer = ffi.new('timer_struct *')
+    vic_lib.timer_init(timer)
+    timer[0].delta_wall = 1.
+    vic_lib.phase_timer_add(vic_lib.PHASE_VIC_RUN, timer)
+    assert vic_lib.phase_timer_get(vic_lib.PHASE_VIC_RUN) == 1.
+    vic_lib.initialize_phase_timers(False)
+
+
+def test_phase_timer_hierarchy():
+    assert ffi.string(
+        vic_lib.phase_timer_name(vic_lib.PHASE_FORCE_READ)) == b'force_read'
+    assert vic_lib.phase_timer_parent(vic_lib.PHASE_FORCE_READ) == \
+        vic_lib.PHASE_FORCE
+    assert vic_lib.phase_timer_parent(vic_lib.PHASE_VIC_RUN) == -1
+    assert vic_lib.phase_timer_depth(vic_lib.PHASE_OUTPUT_WRITE) == 1
+    assert vic_lib.phase_timer_depth(vic_lib.PHASE_PUT_DATA) == 0
@@ -29,3 +29,30 @@ def test_get_logname():
 
 def test_initialize_log():
     assert vic_lib.initialize_log() is None
+
+
+# call sites stay registered until the end of the run, so they must outlive
+# the test
+warn_fmt = ffi.new('char []', b'test warning')
+warn_site = ffi.new('warn_site_struct *')
+
+
+def test_warn_site_hit():
+    vic_lib.initialize_log()
+    site = warn_site
+    site[0].file = warn_fmt
+    site[0].fmt = warn_fmt
+    total = ffi.new('size_t *')
+    suppressed = ffi.new('size_t *')
+    vic_lib.get_warning_totals(total, suppressed)
+    total0, suppressed0 = total[0], suppressed[0]
+
+    # the first occurrences are printed, the rest are only counted
+    printed = [vic_lib.warn_site_hit(site) for i in range(100)]
+    assert 0 < sum(printed) < 100
+    assert all(printed[:sum(printed)])
+    assert site[0].count == 100
+
+    vic_lib.get_warning_totals(total, suppressed)
+    assert total[0] - total0 == 100
+    assert suppressed[0] - suppressed0 == 100 - sum(printed)
@@ -0,0 +1,25 @@
+from vic import lib as vic_lib
+
+
+def test_adapt_snow_step_grows():
+    vic_lib.initialize_parameters()
+    step_max = vic_lib.param.SNOW_STEP_MAX
+    step_inc = 1
+    for i in range(10):
+        step_inc = vic_lib.adapt_snow_step(step_inc, 0., 0., 0., 0., 1.)
+        assert 1 <= step_inc <= step_max
+    assert step_inc == step_max
+
+
+def test_adapt_snow_step_shrinks():
+    vic_lib.initialize_parameters()
+    tol = vic_lib.param.SNOW_STEP_TSURF_TOL
+    assert vic_lib.adapt_snow_step(4, 0., 5. * 4 * tol, 0., 0., 1.) == 2
+    assert vic_lib.adapt_snow_step(1, 0., 5. * tol, 0., 0., 1.) == 1
+    assert vic_lib.adapt_snow_step(4, 0., 0.75 * 4 * tol, 0., 0., 1.) == 4
+
+
+def test_adapt_snow_step_melt_and_coverage():
+    vic_lib.initialize_parameters()
+    assert vic_lib.adapt_snow_step(4, 0., 0., 0., 0.001, 1.) == 1
+    assert vic_lib.adapt_snow_step(4, 0., 0., 0., 0., 0.5) == 1
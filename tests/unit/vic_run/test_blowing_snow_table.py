@@ -0,0 +1,75 @@
+import numpy as np
+from vic import lib as vic_lib
+from vic import ffi
+
+# accuracy of the table against qromb() stated for BLOWING_TABLE
+BLOWING_TABLE_RTOL = 1e-4
+
+NSTATES = 300
+
+
+def blowing_snow_states(seed):
+    '''10 m wind speed, shear velocity, saltation roughness, humidity and
+    temperature factor of drifting snow, as CalcBlowingSnow() computes them
+    with the constant saltation threshold'''
+    rng = np.random.RandomState(seed)
+    ushear = ffi.new('double *')
+    Zo_salt = ffi.new('double *')
+    utshear = vic_lib.param.BLOWING_UTHRESH
+    states = []
+    while len(states) < NSTATES:
+        U10 = rng.uniform(0.4, 25.)
+        ZO = np.exp(rng.uniform(np.log(1e-4), np.log(0.05)))
+        if 0.4 * U10 <= utshear:
+            continue
+        vic_lib.shear_stress(U10, ZO, ushear, Zo_salt, utshear)
+        if ushear[0] <= utshear:
+            continue
+        Tair = rng.uniform(-35., 0.)
+        es = vic_lib.svp(Tair)
+        EactAir = rng.uniform(0.3, 0.99) * es
+        # F only scales the sublimation integral; this is its range over
+        # the temperatures above
+        F = np.exp(rng.uniform(np.log(1e8), np.log(1e10)))
+        states.append((U10, ushear[0], Zo_salt[0], es, EactAir, F))
+    return states
+
+
+def test_lookup_blowing_table():
+    vic_lib.initialize_parameters()
+    vic_lib.init_blowing_table()
+
+    hsalt = ffi.new('double *')
+    ztop = ffi.new('double *')
+    sub_integral = ffi.new('double *')
+    trans_integral = ffi.new('double *')
+    AirDens = 1.3
+    Zrh = 2.
+    # qromb() takes an unprototyped integrand
+    sub_with_height = ffi.cast('double (*)()', vic_lib.sub_with_height)
+    transport_with_height = ffi.cast('double (*)()',
+                                     vic_lib.transport_with_height)
+    nchecked = 0
+    for U10, ushear, Zo_salt, es, EactAir, F in blowing_snow_states(0):
+        if not vic_lib.lookup_blowing_table(U10, ushear, EactAir, es, F,
+                                            Zo_salt, sub_integral,
+                                            trans_integral):
+            # outside of the table CalcSubFlux() integrates directly
+            continue
+        vic_lib.suspension_limits(U10, ushear, hsalt, ztop)
+        if Zo_salt >= hsalt[0]:
+            # the transport integrand changes sign in the suspension layer,
+            # so qromb() cannot converge to a relative tolerance
+            continue
+        sub = vic_lib.qromb(sub_with_height, es, U10, AirDens,
+                            Zo_salt, EactAir, F, hsalt[0], 1., ushear, Zrh,
+                            hsalt[0], ztop[0])
+        trans = vic_lib.qromb(transport_with_height, es, U10, AirDens,
+                              Zo_salt, EactAir, F, hsalt[0], 1., ushear,
+                              Zrh, hsalt[0], ztop[0])
+        np.testing.assert_allclose(sub_integral[0], sub,
+                                   rtol=BLOWING_TABLE_RTOL)
+        np.testing.assert_allclose(trans_integral[0], trans,
+                                   rtol=BLOWING_TABLE_RTOL)
+        nchecked += 1
+    assert nchecked > NSTATES // 2
@@ -0,0 +1,35 @@
+from vic import lib as vic_lib
+from vic.vic import ffi
+
+MAX_NODES = 50
+
+
+def test_copy_energy_bal():
+    nnodes = 3
+    src = ffi.new('energy_bal_struct *')
+    dst = ffi.new('energy_bal_struct *')
+    src.AlbedoOver = 0.5
+    src.Tsurf = -2.
+    src.Nfrost = 2
+    src.snow_flux = 10.
+    for i in range(MAX_NODES):
+        src.T[i] = i
+        src.moist[i] = i
+        src.T_fbcount[i] = i
+        dst.T[i] = -1.
+        dst.moist[i] = -1.
+        dst.T_fbcount[i] = 99
+    vic_lib.copy_energy_bal(dst, src, nnodes)
+    assert dst.AlbedoOver == 0.5
+    assert dst.Tsurf == -2.
+    assert dst.Nfrost == 2
+    assert dst.snow_flux == 10.
+    for i in range(nnodes):
+        assert dst.T[i] == i
+        assert dst.moist[i] == i
+        assert dst.T_fbcount[i] == i
+    # unused node elements are left untouched
+    for i in range(nnodes, MAX_NODES):
+        assert dst.T[i] == -1.
+        assert dst.moist[i] == -1.
+        assert dst.T_fbcount[i] == 99
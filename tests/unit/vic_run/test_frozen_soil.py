@@ -0,0 +1,173 @@
+import numpy as np
+from vic import lib as vic_lib
+from vic import ffi
+
+# The analytic Jacobian differs from the finite difference Jacobian of the
+# full residual only by the one-sided conductivity slope (step
+# NEWT_RAPH_EPS2 * Wu) and the truncation error of the central differences
+# below.  Entries are compared relative to the largest entry of their row.
+JAC_RTOL = 1e-6
+FD_STEP = 1e-5  # temperature step of the central differences (C)
+
+NNODES = 8
+LAYER_DEPTHS = (0.1, 0.4, 1.0)
+SOIL_DENSITY = 2685.
+BULK_DENSITY = 1500.
+QUARTZ = (0.3, 0.5, 0.7)
+ORGANIC = (0., 0.1, 0.2)
+MAX_MOIST = 0.45
+MOIST = 0.35
+BUBBLE = 20.
+EXPT = 12.
+DELTAT = 3600.
+
+
+def node_layers(Zsum):
+    '''soil layer of each node, as assigned by fda_heat_eqn()'''
+    layers = []
+    lidx = 0
+    Lsum = 0.
+    past_bottom = False
+    for z in Zsum:
+        layers.append(lidx)
+        if z > Lsum + LAYER_DEPTHS[lidx] and not past_bottom:
+            Lsum += LAYER_DEPTHS[lidx]
+            lidx += 1
+            if lidx == len(LAYER_DEPTHS):
+                past_bottom = True
+                lidx = len(LAYER_DEPTHS) - 1
+    return layers
+
+
+def heat_eqn_ctx(T0, noflux, exp_trans):
+    '''context of fda_heat_eqn for a column of NNODES nodes, and the arrays
+    it points to (which must be kept alive while the context is used)'''
+    n = NNODES - 1 if noflux else NNODES - 2
+    Dp = 4.
+    if exp_trans:
+        Bexp = np.log(Dp + 1.) / (n if noflux else n + 1)
+        Zsum = np.exp(Bexp * np.arange(NNODES)) - 1.
+    else:
+        Zsum = np.linspace(0., Dp, NNODES)
+    alpha = np.zeros(NNODES)
+    beta = np.zeros(NNODES)
+    gamma = np.zeros(NNODES)
+    for i in range(NNODES - 2):
+        alpha[i] = Zsum[i + 2] - Zsum[i]
+        beta[i] = Zsum[i + 1] - Zsum[i]
+        gamma[i] = Zsum[i + 2] - Zsum[i + 1]
+    if noflux:
+        # as in set_node_parameters()
+        alpha[NNODES - 2] = 2. * (Zsum[NNODES - 1] - Zsum[NNODES - 2])
+        beta[NNODES - 2] = Zsum[NNODES - 1] - Zsum[NNODES - 2]
+        gamma[NNODES - 2] = Zsum[NNODES - 1] - Zsum[NNODES - 2]
+
+    moist = np.full(NNODES, MOIST)
+    ice = np.zeros(NNODES)
+    kappa = np.zeros(NNODES)
+    Cs = np.zeros(NNODES)
+    soil_fract = BULK_DENSITY / SOIL_DENSITY
+    for i, lidx in enumerate(node_layers(Zsum)):
+        if T0[i] < 0:
+            ice[i] = max(moist[i] - vic_lib.maximum_unfrozen_water(
+                T0[i], MAX_MOIST, BUBBLE, EXPT), 0.)
+        kappa[i] = vic_lib.soil_conductivity(
+            moist[i], moist[i] - ice[i], SOIL_DENSITY, BULK_DENSITY,
+            QUARTZ[lidx], SOIL_DENSITY, BULK_DENSITY, ORGANIC[lidx])
+        Cs[i] = vic_lib.volumetric_heat_capacity(soil_fract, moist[i] - ice[i],
+                                                 ice[i], ORGANIC[lidx])
+
+    arrays = dict(T0=T0, moist=moist, ice=ice, kappa=kappa, Cs=Cs,
+                  max_moist=np.full(NNODES, MAX_MOIST),
+                  bubble=np.full(NNODES, BUBBLE), expt=np.full(NNODES, EXPT),
+                  alpha=alpha, beta=beta, gamma=gamma, Zsum=Zsum,
+                  bulk_dens_min=np.full(3, BULK_DENSITY),
+                  soil_dens_min=np.full(3, SOIL_DENSITY),
+                  quartz=np.array(QUARTZ),
+                  bulk_density=np.full(3, BULK_DENSITY),
+                  soil_density=np.full(3, SOIL_DENSITY),
+                  organic=np.array(ORGANIC),
+                  depth=np.array(LAYER_DEPTHS))
+    keep = {}
+    ctx = ffi.new('fda_heat_eqn_ctx_struct *')
+    ctx.deltat = DELTAT
+    ctx.NOFLUX = noflux
+    ctx.EXP_TRANS = exp_trans
+    ctx.Dp = Dp
+    ctx.Nlayers = len(LAYER_DEPTHS)
+    for name, values in arrays.items():
+        keep[name] = ffi.new('double []', list(values))
+        setattr(ctx, name, keep[name])
+    return n, ctx, keep
+
+
+def residual(T, n, ctx):
+    res = ffi.new('double []', n)
+    vic_lib.fda_heat_eqn(ffi.new('double []', list(T)), res, n, 0, -1, ctx)
+    return np.array(list(res))
+
+
+def check_jacobian(T0, T, noflux, exp_trans):
+    n, ctx, keep = heat_eqn_ctx(np.array(T0, dtype=np.float64), noflux,
+                                exp_trans)
+    T_2 = ffi.new('double []', n)
+    res = ffi.new('double []', n)
+    vic_lib.fda_heat_eqn(T_2, res, n, 1, -1, ctx)
+
+    # finite difference Jacobian of the full residual
+    fd = np.zeros((n, n))
+    for j in range(n):
+        Tp = np.array(T, dtype=np.float64)
+        Tm = np.array(T, dtype=np.float64)
+        Tp[j] += FD_STEP
+        Tm[j] -= FD_STEP
+        fd[:, j] = (residual(Tp, n, ctx) - residual(Tm, n, ctx)) / \
+            (2. * FD_STEP)
+
+    # the analytic Jacobian needs a full evaluation at T
+    residual(T, n, ctx)
+    a = ffi.new('double []', n)
+    b = ffi.new('double []', n)
+    c = ffi.new('double []', n)
+    vic_lib.fda_heat_eqn_jac(ffi.new('double []', list(T)), a, b, c, n, ctx)
+    jac = np.diag(list(b))
+    for i in range(n):
+        if i > 0:
+            jac[i, i - 1] = a[i]
+        if i < n - 1:
+            jac[i, i + 1] = c[i]
+
+    scale = np.abs(fd).max(axis=1, keepdims=True)
+    np.testing.assert_array_less(np.abs(jac - fd),
+                                 JAC_RTOL * np.broadcast_to(scale, fd.shape))
+
+
+def column_temperatures():
+    # previous and current temperatures of a freezing column; no node is
+    # within FD_STEP of 0 C, where the ice content has a kink
+    T0 = [-6., -4., -3., -2., -1.2, -0.4, 0.8, 2.]
+    T = [-4.5, -3.3, -2.1, -1.4, -0.7, 0.3, 1.5, 2.]
+    return T0, T
+
+
+def test_fda_heat_eqn_jac_linear():
+    vic_lib.initialize_parameters()
+    T0, T = column_temperatures()
+    check_jacobian(T0, T[1:NNODES - 1], False, False)
+    check_jacobian(T0, T[1:NNODES], True, False)
+
+
+def test_fda_heat_eqn_jac_exp_trans():
+    vic_lib.initialize_parameters()
+    T0, T = column_temperatures()
+    check_jacobian(T0, T[1:NNODES - 1], False, True)
+    check_jacobian(T0, T[1:NNODES], True, True)
+
+
+def test_fda_heat_eqn_jac_unchanged_ice():
+    # nodes at their previous temperature keep their ice content, so the
+    # conductivity of the context is reused
+    vic_lib.initialize_parameters()
+    T0, T = column_temperatures()
+    T = list(T0[:4]) + list(T[4:])
+    check_jacobian(T0, T[1:NNODES - 1], False, False)
@@ -0,0 +1,53 @@
+import numpy as np
+from vic import lib as vic_lib
+from vic.vic import ffi
+
+
+def make_lake_con(numnod=10, maxdepth=15., maxarea=1e8):
+    lake_con = ffi.new('lake_con_struct *')
+    lake_con.numnod = numnod
+    for i in range(numnod + 1):
+        frac = (numnod - i) / numnod
+        lake_con.z[i] = maxdepth * frac
+        lake_con.basin[i] = maxarea * frac ** 1.5
+    lake_con.maxdepth = maxdepth
+    lake_con.maxvolume = 0.
+    for i in range(1, numnod + 1):
+        lake_con.maxvolume += ((lake_con.basin[i] + lake_con.basin[i - 1]) *
+                               (lake_con.z[i - 1] - lake_con.z[i]) / 2.)
+    vic_lib.compute_lake_basin_volume(lake_con)
+    return lake_con
+
+
+def test_compute_lake_basin_volume():
+    lake_con = make_lake_con()
+    assert lake_con.basin_volume[lake_con.numnod] == 0.
+    for i in range(lake_con.numnod):
+        assert lake_con.basin_volume[i] > lake_con.basin_volume[i + 1]
+    np.testing.assert_allclose(lake_con.basin_volume[0], lake_con.maxvolume)
+
+
+def test_get_sarea_at_nodes():
+    lake_con = make_lake_con()
+    sarea = ffi.new('double *')
+    for i in range(lake_con.numnod):
+        assert vic_lib.get_sarea(lake_con, lake_con.z[i], sarea) == 0
+        np.testing.assert_allclose(sarea[0], lake_con.basin[i])
+
+
+def test_get_volume_at_nodes():
+    lake_con = make_lake_con()
+    volume = ffi.new('double *')
+    for i in range(lake_con.numnod):
+        assert vic_lib.get_volume(lake_con, lake_con.z[i], volume) == 0
+        assert volume[0] == lake_con.basin_volume[i]
+
+
+def test_get_depth_inverts_get_volume():
+    lake_con = make_lake_con()
+    volume = ffi.new('double *')
+    depth = ffi.new('double *')
+    for d in np.linspace(0.01, lake_con.maxdepth - 0.01, 101):
+        assert vic_lib.get_volume(lake_con, d, volume) == 0
+        assert vic_lib.get_depth(lake_con, volume[0], depth) == 0
+        np.testing.assert_allclose(depth[0], d, rtol=1e-12)
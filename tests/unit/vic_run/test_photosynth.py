@@ -1,3 +1,5 @@
+import numpy as np
+from vic.vic import ffi
 from vic import lib as vic_lib
 
 
@@ -14,3 +16,39 @@ def test_darkinhib():
             assert vic_lib.darkinhib(i) == 0.
         else:
             assert vic_lib.darkinhib(i) > 0.
+
+
+def test_photosynth_layers():
+    vic_lib.initialize_parameters()
+    nlayers = 5
+    nscale = np.exp(-0.5 * np.arange(nlayers))
+    apar = 1e-3 * np.exp(-0.7 * np.arange(nlayers))
+    single = ffi.new('double[5]')
+    for ctype in (bytes([vic_lib.PHOTO_C3]), bytes([vic_lib.PHOTO_C4])):
+        for mode in (b'ci', b'rs'):
+            rs = np.full(nlayers, 200., dtype=np.float64)
+            ci = np.full(nlayers, 3e-4, dtype=np.float64)
+            rdark = np.zeros(nlayers, dtype=np.float64)
+            rphoto = np.zeros(nlayers, dtype=np.float64)
+            agross = np.zeros(nlayers, dtype=np.float64)
+            vic_lib.photosynth_layers(
+                ctype, 6e-5, 1.2e-4, 1e-4,
+                ffi.cast('double *', nscale.ctypes.data), 20., 2e-3,
+                ffi.cast('double *', apar.ctypes.data), 95000., 4e-4,
+                ffi.new('char[]', mode), nlayers,
+                ffi.cast('double *', rs.ctypes.data),
+                ffi.cast('double *', ci.ctypes.data),
+                ffi.cast('double *', rdark.ctypes.data),
+                ffi.cast('double *', rphoto.ctypes.data),
+                ffi.cast('double *', agross.ctypes.data))
+            for l in range(nlayers):
+                single[0] = 200.
+                single[1] = 3e-4
+                vic_lib.photosynth(ctype, 6e-5, 1.2e-4, 1e-4, nscale[l], 20.,
+                                   2e-3, apar[l], 95000., 4e-4,
+                                   ffi.new('char[]', mode), single,
+                                   single + 1, single + 2, single + 3,
+                                   single + 4)
+                np.testing.assert_allclose(
+                    [rs[l], ci[l], rdark[l], rphoto[l], agross[l]],
+                    [single[i] for i in range(5)], rtol=1e-12)
@@ -0,0 +1,17 @@
+from vic import lib as vic_lib
+from vic import ffi
+
+
+def test_run_context_str():
+    dmy = ffi.new('dmy_struct *')
+    dmy[0].year = 1999
+    dmy[0].month = 3
+    dmy[0].day = 5
+    dmy[0].dayseconds = 3600
+    vic_lib.set_run_context(42, 7, dmy)
+    assert ffi.string(vic_lib.run_context_str()) == \
+        b'Gridcell: 42, timestep: 7 (1999-03-05-03600)'
+
+    vic_lib.set_run_context(3, 1, ffi.NULL)
+    assert ffi.string(vic_lib.run_context_str()) == \
+        b'Gridcell: 3, timestep: 1'
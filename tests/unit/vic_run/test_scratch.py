@@ -0,0 +1,31 @@
+from vic.vic import ffi
+from vic import lib as vic_lib
+
+
+def test_scratch_calloc():
+    vic_lib.initialize_options()
+    vic_lib.initialize_scratch()
+    mark = vic_lib.scratch_mark()
+    a = ffi.cast('double *', vic_lib.scratch_calloc(4, ffi.sizeof('double')))
+    b = ffi.cast('double *', vic_lib.scratch_calloc(4, ffi.sizeof('double')))
+    for i in range(4):
+        assert a[i] == 0.
+        assert b[i] == 0.
+        a[i] = 1.
+    assert b[0] == 0.
+    vic_lib.scratch_release(mark)
+    assert vic_lib.scratch_mark() == mark
+    vic_lib.free_scratch()
+
+
+def test_scratch_heap_fallback():
+    vic_lib.initialize_options()
+    vic_lib.initialize_scratch()
+    nheap = vic_lib.scratch_heap_allocs()
+    mark = vic_lib.scratch_mark()
+    big = ffi.cast('double *',
+                   vic_lib.scratch_calloc(1000000, ffi.sizeof('double')))
+    assert big[999999] == 0.
+    assert vic_lib.scratch_heap_allocs() == nheap + 1
+    vic_lib.scratch_release(mark)
+    vic_lib.free_scratch()
@@ -0,0 +1,49 @@
+import numpy as np
+from vic import lib as vic_lib
+
+# relative error allowed between the MATH_FUSED and MATH_EXACT kernels
+FUSED_RTOL = 1e-12
+
+
+def soil_conductivity_both(*args):
+    vic_lib.options.MATH_KERNELS = vic_lib.MATH_EXACT
+    exact = vic_lib.soil_conductivity(*args)
+    vic_lib.options.MATH_KERNELS = vic_lib.MATH_FUSED
+    fused = vic_lib.soil_conductivity(*args)
+    vic_lib.options.MATH_KERNELS = vic_lib.MATH_EXACT
+    return exact, fused
+
+
+def maximum_unfrozen_water_both(*args):
+    vic_lib.options.MATH_KERNELS = vic_lib.MATH_EXACT
+    exact = vic_lib.maximum_unfrozen_water(*args)
+    vic_lib.options.MATH_KERNELS = vic_lib.MATH_FUSED
+    fused = vic_lib.maximum_unfrozen_water(*args)
+    vic_lib.options.MATH_KERNELS = vic_lib.MATH_EXACT
+    return exact, fused
+
+
+def test_soil_conductivity_fused():
+    soil_density = 2685.
+    for bulk_density in np.linspace(1100., 1900., 5):
+        porosity = 1. - bulk_density / soil_density
+        for quartz in np.linspace(0., 1., 11):
+            for organic in np.linspace(0., 0.5, 3):
+                for moist in np.linspace(0.01, 1., 12) * porosity:
+                    for Wu in (moist, 0.5 * moist, 0.):
+                        exact, fused = soil_conductivity_both(
+                            moist, Wu, soil_density, bulk_density, quartz,
+                            soil_density, bulk_density, organic)
+                        np.testing.assert_allclose(fused, exact,
+                                                   rtol=FUSED_RTOL)
+
+
+def test_maximum_unfrozen_water_fused():
+    max_moist = 0.45
+    for T in np.linspace(-40., 5., 46):
+        for bubble in np.linspace(5., 80., 6):
+            for expt in np.linspace(4., 30., 6):
+                exact, fused = maximum_unfrozen_water_both(T, max_moist,
+                                                          bubble, expt)
+                np.testing.assert_allclose(fused, exact, rtol=FUSED_RTOL)
+                assert 0. <= fused <= max_moist
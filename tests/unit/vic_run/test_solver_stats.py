@@ -0,0 +1,26 @@
+from vic import lib as vic_lib
+
+
+def test_reset_solver_stats():
+    for site in range(vic_lib.N_SOLVER_SITES):
+        stats = vic_lib.get_solver_stats(site)
+        stats.calls += 1
+        stats.evals += 3
+        stats.maxiter += 1
+    vic_lib.reset_solver_stats()
+    for site in range(vic_lib.N_SOLVER_SITES):
+        stats = vic_lib.get_solver_stats(site)
+        assert stats.calls == 0
+        assert stats.evals == 0
+        assert stats.expansions == 0
+        assert stats.fallbacks == 0
+        assert stats.maxiter == 0
+
+
+def test_get_solver_stats_by_site():
+    vic_lib.reset_solver_stats()
+    surf = vic_lib.get_solver_stats(vic_lib.SOLVER_SURF_ENERGY_BAL)
+    snow = vic_lib.get_solver_stats(vic_lib.SOLVER_SNOW_PACK_ENERGY_BAL)
+    surf.evals += 2
+    assert vic_lib.get_solver_stats(vic_lib.SOLVER_SURF_ENERGY_BAL).evals == 2
+    assert snow.evals == 0
@@ -72,6 +72,10 @@ get_global_param(FILE *gp)
                 sscanf(cmdstr, "%*s %s", flgstr);
                 global_param.time_units = str_to_timeunits(flgstr);
             }
+            else if (strcasecmp("FROZEN_NEWTON", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.FROZEN_NEWTON = str_to_bool(flgstr);
+            }
             else if (strcasecmp("FROZEN_SOIL", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.FROZEN_SOIL = str_to_bool(flgstr);
@@ -92,6 +96,10 @@ get_global_param(FILE *gp)
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.QUICK_SOLVE = str_to_bool(flgstr);
             }
+            else if (strcasecmp("SECANT_SOLVE", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.SECANT_SOLVE = str_to_bool(flgstr);
+            }
             else if ((strcasecmp("NOFLUX",
                                  optstr) == 0) ||
                      (strcasecmp("NO_FLUX", optstr) == 0)) {
@@ -104,6 +112,10 @@ get_global_param(FILE *gp)
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.IMPLICIT = str_to_bool(flgstr);
             }
+            else if (strcasecmp("ANALYTIC_JACOBIAN", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.ANALYTIC_JACOBIAN = str_to_bool(flgstr);
+            }
             else if (strcasecmp("EXP_TRANS", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.EXP_TRANS = str_to_bool(flgstr);
@@ -120,6 +132,22 @@ get_global_param(FILE *gp)
                     log_err("Unknown SNOW_DENSITY option: %s", flgstr);
                 }
             }
+            else if (strcasecmp("MATH_KERNELS", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                if (strcasecmp("FUSED", flgstr) == 0) {
+                    options.MATH_KERNELS = MATH_FUSED;
+                }
+                else if (strcasecmp("EXACT", flgstr) == 0) {
+                    options.MATH_KERNELS = MATH_EXACT;
+                }
+                else {
+                    log_err("Unknown MATH_KERNELS option: %s", flgstr);
+                }
+            }
+            else if (strcasecmp("ADAPTIVE_SNOW_STEP", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.ADAPTIVE_SNOW_STEP = str_to_bool(flgstr);
+            }
             else if (strcasecmp("BLOWING", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.BLOWING = str_to_bool(flgstr);
@@ -144,6 +172,10 @@ get_global_param(FILE *gp)
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.BLOWING_SPATIAL_WIND = str_to_bool(flgstr);
             }
+            else if (strcasecmp("BLOWING_TABLE", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.BLOWING_TABLE = str_to_bool(flgstr);
+            }
             else if (strcasecmp("CORRPREC", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.CORRPREC = str_to_bool(flgstr);
@@ -72,7 +72,7 @@ vic_populate_model_state(char *runtype_str)
                                        veg_con[i]);
                 if (options.LAKES) {
                     generate_default_lake_state(&(all_vars[i]), &(soil_con[i]),
-                                                lake_con[i]);
+                                                &(lake_con[i]));
                 }
             }
         }
@@ -83,7 +83,7 @@ vic_populate_model_state(char *runtype_str)
         compute_derived_state_vars(&(all_vars[i]), &(soil_con[i]), veg_con[i]);
         if (options.LAKES) {
             compute_derived_lake_dimensions(&(all_vars[i].lake_var),
-                                            lake_con[i]);
+                                            &(lake_con[i]));
         }
     }
 }
@@ -0,0 +1,295 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Benchmark of the fast ASCII output formatter against snprintf
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_classic.h>
+#include <inttypes.h>
+#include <time.h>
+
+#define BENCH_ASCII_VALUES 100000  // default number of values per format
+#define BENCH_ASCII_PASSES 10      // default number of timed passes
+#define BENCH_ASCII_SEED 20170201u // default seed of the values
+#define BENCH_ASCII_OUTFILE "vic_bench_ascii.json" // default JSON output file
+
+// global variables
+int                 flag;
+size_t              NR; /* array index for atmos struct that indicates
+                           the model step avarage or sum */
+size_t              NF; /* array index loop counter limit for atmos
+                           struct that indicates the SNOW_STEP values */
+
+global_param_struct global_param;
+veg_lib_struct     *veg_lib;
+option_struct       options;
+Error_struct        Error;
+param_set_struct    param_set;
+parameters_struct   param;
+filenames_struct    filenames;
+filep_struct        filep;
+metadata_struct     out_metadata[N_OUTVAR_TYPES];
+
+// formats timed by the benchmark: the default output format, other fixed
+// point formats of the fast path and one format that falls back to snprintf
+static char        *bench_ascii_formats[] = {
+    OUT_ASCII_FORMAT_DEFAULT, "%.2f", "%10.4f", "%.6f", "%f", "%.9f", "%.4e"
+};
+
+static char         bench_ascii_optstring[] = "n:p:s:o:h";
+
+/******************************************************************************
+ * @brief    Print the usage of the benchmark.
+ *****************************************************************************/
+static void
+print_bench_ascii_usage(char *executable)
+{
+    fprintf(stdout,
+            "Usage: %s [-n <values>] [-p <passes>] [-s <seed>] "
+            "[-o <json_file>]\n", executable);
+    fprintf(stdout,
+            "  n: format <values> values per format (default: %d).\n",
+            BENCH_ASCII_VALUES);
+    fprintf(stdout,
+            "  p: repeat the timed loops <passes> times (default: %d).\n",
+            BENCH_ASCII_PASSES);
+    fprintf(stdout,
+            "  s: seed of the generated values (default: %u).\n",
+            BENCH_ASCII_SEED);
+    fprintf(stdout,
+            "  o: write the results to <json_file> (default: %s).\n",
+            BENCH_ASCII_OUTFILE);
+}
+
+/******************************************************************************
+ * @brief    Read the monotonic clock (ns).
+ *****************************************************************************/
+static uint64_t
+bench_ascii_clock_ns(void)
+{
+    struct timespec t;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &t) != 0) {
+        log_err("Unable to read the monotonic clock");
+    }
+
+    return (uint64_t) t.tv_sec * 1000000000u + (uint64_t) t.tv_nsec;
+}
+
+/******************************************************************************
+ * @brief    Next value of a 64-bit xorshift generator.
+ *****************************************************************************/
+static uint64_t
+bench_ascii_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return *state;
+}
+
+/******************************************************************************
+ * @brief    Generate values that look like model output: one in eight is
+ *           zero, the others have a random sign and a magnitude between 1e-4
+ *           and 1e6.
+ *****************************************************************************/
+static void
+make_bench_ascii_values(double  *values,
+                        size_t   nvalues,
+                        uint64_t seed)
+{
+    uint64_t state;
+    uint64_t r;
+    double   mantissa;
+    size_t   i;
+
+    state = seed | 1u;
+    for (i = 0; i < nvalues; i++) {
+        r = bench_ascii_random(&state);
+        if ((r & 7u) == 0) {
+            values[i] = 0.;
+            continue;
+        }
+        mantissa = (double) (r >> 11) / 9007199254740992.;  // [0, 1)
+        values[i] = (1. + 9. * mantissa) *
+                    pow(10., (double) ((r >> 3) % 11) - 4.);
+        if (r & 8u) {
+            values[i] = -values[i];
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief    Benchmark of the fast ASCII output formatter
+ * @details  Formats a reproducible set of values with each format, once with
+ *           snprintf and once with sprint_ascii_value, and reports the
+ *           fastest pass of each as ns per value.  Every value is also
+ *           checked against snprintf; the benchmark fails if any differs.
+ *****************************************************************************/
+int
+main(int   argc,
+     char *argv[])
+{
+    char                buf[ASCII_FAST_MAX_LEN];
+    char                ref[ASCII_FAST_MAX_LEN];
+    char                outfile[MAXSTRING];
+    char               *format;
+    int                 optchar;
+    size_t              nvalues;
+    size_t              passes;
+    size_t              nformats;
+    size_t              mismatches;
+    size_t              total_mismatches;
+    size_t              chars;
+    size_t              f;
+    size_t              i;
+    size_t              pass;
+    uint64_t            seed;
+    uint64_t            start;
+    uint64_t            ns;
+    uint64_t            ns_snprintf;
+    uint64_t            ns_fast;
+    double             *values;
+    ascii_format_struct fmt;
+    FILE               *out;
+
+    initialize_log();
+
+    nvalues = BENCH_ASCII_VALUES;
+    passes = BENCH_ASCII_PASSES;
+    seed = BENCH_ASCII_SEED;
+    strcpy(outfile, BENCH_ASCII_OUTFILE);
+    while ((optchar = getopt(argc, argv, bench_ascii_optstring)) != EOF) {
+        switch ((char)optchar) {
+        case 'n':
+            nvalues = (size_t) atol(optarg);
+            break;
+        case 'p':
+            passes = (size_t) atol(optarg);
+            break;
+        case 's':
+            seed = (uint64_t) strtoull(optarg, NULL, 10);
+            break;
+        case 'o':
+            strncpy(outfile, optarg, MAXSTRING - 1);
+            outfile[MAXSTRING - 1] = '\0';
+            break;
+        default:
+            print_bench_ascii_usage(argv[0]);
+            exit(EXIT_FAILURE);
+            break;
+        }
+    }
+    if (nvalues == 0 || passes == 0) {
+        fprintf(stderr, "ERROR: The number of values and of passes must be "
+                "at least 1\n");
+        exit(EXIT_FAILURE);
+    }
+
+    values = malloc(nvalues * sizeof(*values));
+    check_alloc_status(values, "Memory allocation error.");
+    make_bench_ascii_values(values, nvalues, seed);
+
+    out = open_file(outfile, "w");
+    fprintf(out, "{\n");
+    fprintf(out, "  \"git_version\": \"%s\",\n", GIT_VERSION);
+    fprintf(out, "  \"values\": %zu,\n", nvalues);
+    fprintf(out, "  \"passes\": %zu,\n", passes);
+    fprintf(out, "  \"seed\": %" PRIu64 ",\n", seed);
+    fprintf(out, "  \"formats\": {");
+
+    nformats = sizeof(bench_ascii_formats) / sizeof(bench_ascii_formats[0]);
+    total_mismatches = 0;
+    chars = 0;
+    for (f = 0; f < nformats; f++) {
+        format = bench_ascii_formats[f];
+        parse_ascii_format(format, &fmt);
+
+        mismatches = 0;
+        for (i = 0; i < nvalues; i++) {
+            snprintf(ref, sizeof(ref), format, values[i]);
+            sprint_ascii_value(buf, sizeof(buf), format, &fmt, values[i]);
+            if (strcmp(buf, ref) != 0) {
+                if (mismatches == 0) {
+                    log_warn("%s: %.17g formatted as \"%s\" instead of "
+                             "\"%s\"", format, values[i], buf, ref);
+                }
+                mismatches++;
+            }
+        }
+        total_mismatches += mismatches;
+
+        ns_snprintf = UINT64_MAX;
+        ns_fast = UINT64_MAX;
+        for (pass = 0; pass < passes; pass++) {
+            start = bench_ascii_clock_ns();
+            for (i = 0; i < nvalues; i++) {
+                chars += (size_t) snprintf(buf, sizeof(buf), format,
+                                           values[i]);
+            }
+            ns = bench_ascii_clock_ns() - start;
+            if (ns < ns_snprintf) {
+                ns_snprintf = ns;
+            }
+
+            start = bench_ascii_clock_ns();
+            for (i = 0; i < nvalues; i++) {
+                chars += (size_t) sprint_ascii_value(buf, sizeof(buf), format,
+                                                     &fmt, values[i]);
+            }
+            ns = bench_ascii_clock_ns() - start;
+            if (ns < ns_fast) {
+                ns_fast = ns;
+            }
+        }
+
+        fprintf(out, "%s\n    \"%s\": {\"fast_path\": %s, "
+                "\"snprintf_ns_per_value\": %.2f, "
+                "\"fast_ns_per_value\": %.2f, \"speedup\": %.2f, "
+                "\"mismatches\": %zu}", f > 0 ? "," : "", format,
+                fmt.fixed ? "true" : "false",
+                (double) ns_snprintf / nvalues, (double) ns_fast / nvalues,
+                (double) ns_snprintf / (double) ns_fast, mismatches);
+        fprintf(stdout, "%-8s  snprintf %7.1f ns  fast %7.1f ns  "
+                "speedup %5.2f  mismatches %zu\n", format,
+                (double) ns_snprintf / nvalues, (double) ns_fast / nvalues,
+                (double) ns_snprintf / (double) ns_fast, mismatches);
+    }
+    fprintf(out, "\n  },\n");
+    // the characters written keep the timed loops from being optimized away
+    fprintf(out, "  \"chars\": %zu\n", chars);
+    fprintf(out, "}\n");
+    fclose(out);
+    log_info("Wrote benchmark results to %s", outfile);
+
+    if (total_mismatches > 0) {
+        log_err("%zu values were not formatted as by snprintf",
+                total_mismatches);
+    }
+
+    free(values);
+    finalize_logging();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,689 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Timed wrappers of the vic_run physics kernels and their counters.
+ *
+ * The benchmark is linked with -Wl,--wrap=<kernel> for every kernel listed
+ * below, so that calls made from other translation units reach
+ * __wrap_<kernel>(), which times __real_<kernel>(), the original function.
+ * Times are inclusive: a kernel's time includes the kernels it calls and the
+ * cost of their wrappers.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_bench.h>
+
+/******************************************************************************
+ * @brief    Names of the kernels, in the order of enum bench_kernels.
+ *****************************************************************************/
+static const char *kernel_name[N_BENCH_KERNELS] = {
+    "vic_run",
+    "surface_fluxes",
+    "calc_surf_energy_bal",
+    "solve_snow",
+    "solve_T_profile",
+    "solve_T_profile_implicit",
+    "solve_lake",
+    "CalcBlowingSnow",
+    "canopy_assimilation"
+};
+
+/******************************************************************************
+ * @brief    Solver call sites reached from each kernel, as bit masks over the
+ *           solver sites.  Kernels that do not call an iterative solver have
+ *           no mask and report no evaluations.
+ *****************************************************************************/
+#define SITE(s) (1u << (s))
+#define EXPLICIT_SITES (SITE(SOLVER_SOIL_THERMAL) | \
+                        SITE(SOLVER_SOIL_THERMAL_NODE))
+#define IMPLICIT_SITES (SITE(SOLVER_HEAT_EQN_IMPLICIT))
+static const unsigned kernel_sites[N_BENCH_KERNELS] = {
+    ~0u,
+    ~SITE(SOLVER_ICE_ENERGY_BAL),
+    SITE(SOLVER_SURF_ENERGY_BAL) | EXPLICIT_SITES | IMPLICIT_SITES,
+    SITE(SOLVER_SNOW_PACK_ENERGY_BAL) | SITE(SOLVER_CANOPY_ENERGY_BAL),
+    EXPLICIT_SITES,
+    IMPLICIT_SITES,
+    SITE(SOLVER_ICE_ENERGY_BAL),
+    0u,
+    0u
+};
+
+/******************************************************************************
+ * @brief    Names of the solver call sites, in the order of their enum.
+ *****************************************************************************/
+static const char *solver_site_name[N_SOLVER_SITES] = {
+    "surf_energy_bal",
+    "canopy_energy_bal",
+    "atmos_energy_bal",
+    "snow_pack_energy_bal",
+    "ice_energy_bal",
+    "soil_thermal",
+    "soil_thermal_node",
+    "heat_eqn_implicit",
+    "grnd_flux_iter",
+    "canopy_iter"
+};
+
+static bench_kernel_struct kernels[N_BENCH_KERNELS];
+static solver_stats_struct solver_totals[N_SOLVER_SITES];
+
+__typeof__(vic_run) __real_vic_run;
+__typeof__(surface_fluxes) __real_surface_fluxes;
+__typeof__(calc_surf_energy_bal) __real_calc_surf_energy_bal;
+__typeof__(solve_snow) __real_solve_snow;
+__typeof__(solve_T_profile) __real_solve_T_profile;
+__typeof__(solve_T_profile_implicit) __real_solve_T_profile_implicit;
+__typeof__(solve_lake) __real_solve_lake;
+__typeof__(CalcBlowingSnow) __real_CalcBlowingSnow;
+__typeof__(canopy_assimilation) __real_canopy_assimilation;
+
+/******************************************************************************
+ * @brief    Read the monotonic clock, in nanoseconds.
+ *****************************************************************************/
+uint64_t
+bench_clock_ns(void)
+{
+    struct timespec t;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &t) != 0) {
+        log_err("Unable to read the monotonic clock");
+    }
+
+    return (uint64_t) t.tv_sec * 1000000000u + (uint64_t) t.tv_nsec;
+}
+
+/******************************************************************************
+ * @brief    Estimate the cost of one timed call (ns) that is included in the
+ *           times of the kernels it is nested in.
+ *****************************************************************************/
+double
+bench_clock_overhead(void)
+{
+    size_t   i;
+    uint64_t start;
+
+    start = bench_clock_ns();
+    for (i = 0; i < BENCH_CLOCK_SAMPLES; i++) {
+        bench_clock_ns();
+        bench_clock_ns();
+    }
+
+    return (double) (bench_clock_ns() - start) / BENCH_CLOCK_SAMPLES;
+}
+
+/******************************************************************************
+ * @brief    Add a call of a kernel that started at start.
+ *****************************************************************************/
+void
+bench_kernel_add(size_t   kernel,
+                 uint64_t start)
+{
+    kernels[kernel].ns += bench_clock_ns() - start;
+    kernels[kernel].calls++;
+}
+
+/******************************************************************************
+ * @brief    Return the name of a kernel.
+ *****************************************************************************/
+const char *
+bench_kernel_name(size_t kernel)
+{
+    if (kernel >= N_BENCH_KERNELS) {
+        log_err("Invalid benchmark kernel %zu", kernel);
+    }
+
+    return kernel_name[kernel];
+}
+
+/******************************************************************************
+ * @brief    Return the name of a solver call site.
+ *****************************************************************************/
+const char *
+bench_solver_site_name(size_t site)
+{
+    if (site >= N_SOLVER_SITES) {
+        log_err("Invalid solver call site %zu", site);
+    }
+
+    return solver_site_name[site];
+}
+
+/******************************************************************************
+ * @brief    Return the counters of a kernel.
+ *****************************************************************************/
+bench_kernel_struct *
+get_bench_kernel(size_t kernel)
+{
+    if (kernel >= N_BENCH_KERNELS) {
+        log_err("Invalid benchmark kernel %zu", kernel);
+    }
+
+    return &(kernels[kernel]);
+}
+
+/******************************************************************************
+ * @brief    Return the solver statistics of a call site, summed over the
+ *           timed vic_run() calls.
+ *****************************************************************************/
+solver_stats_struct *
+get_bench_solver_stats(size_t site)
+{
+    if (site >= N_SOLVER_SITES) {
+        log_err("Invalid solver call site %zu", site);
+    }
+
+    return &(solver_totals[site]);
+}
+
+/******************************************************************************
+ * @brief    Add solver statistics to a running total.
+ *****************************************************************************/
+static void
+add_solver_stats(solver_stats_struct *total,
+                 solver_stats_struct *stats)
+{
+    total->calls += stats->calls;
+    total->evals += stats->evals;
+    total->expansions += stats->expansions;
+    total->fallbacks += stats->fallbacks;
+    total->maxiter += stats->maxiter;
+}
+
+/******************************************************************************
+ * @brief    Add the solver statistics of the last vic_run() call to the
+ *           totals of the call sites and of the kernels that reach them.
+ *
+ * @details  vic_run() resets the statistics when it starts, so this must be
+ *           called after every timed vic_run() call.
+ *****************************************************************************/
+void
+accumulate_bench_solver_stats(void)
+{
+    size_t               site;
+    size_t               k;
+    solver_stats_struct *stats;
+
+    for (site = 0; site < N_SOLVER_SITES; site++) {
+        stats = get_solver_stats(site);
+        add_solver_stats(&(solver_totals[site]), stats);
+        for (k = 0; k < N_BENCH_KERNELS; k++) {
+            if (kernel_sites[k] & SITE(site)) {
+                add_solver_stats(&(kernels[k].solver), stats);
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief    Zero the kernel counters and the solver totals.
+ *****************************************************************************/
+void
+reset_bench_kernels(void)
+{
+    memset(kernels, 0, sizeof(kernels));
+    memset(solver_totals, 0, sizeof(solver_totals));
+}
+
+/******************************************************************************
+ * @brief    Timed wrapper of vic_run().
+ *****************************************************************************/
+int
+__wrap_vic_run(force_data_struct   *force,
+               all_vars_struct     *all_vars,
+               dmy_struct          *dmy,
+               global_param_struct *gp,
+               lake_con_struct     *lake_con,
+               soil_con_struct     *soil_con,
+               veg_con_struct      *veg_con,
+               veg_lib_struct      *veg_lib)
+{
+    int      ret;
+    uint64_t start;
+
+    start = bench_clock_ns();
+    ret = __real_vic_run(force, all_vars, dmy, gp, lake_con, soil_con, veg_con,
+                         veg_lib);
+    bench_kernel_add(BENCH_VIC_RUN, start);
+
+    return ret;
+}
+
+/******************************************************************************
+ * @brief    Timed wrapper of surface_fluxes().
+ *****************************************************************************/
+int
+__wrap_surface_fluxes(bool                 overstory,
+                      double               BareAlbedo,
+                      double               ice0,
+                      double               moist0,
+                      double               surf_atten,
+                      double              *Melt,
+                      double              *Le,
+                      double              *aero_resist,
+                      double              *displacement,
+                      double              *gauge_correction,
+                      double              *out_prec,
+                      double              *out_rain,
+                      double              *out_snow,
+                      double              *ref_height,
+                      double              *roughness,
+                      double              *snow_inflow,
+                      double              *wind,
+                      double              *root,
+                      size_t               Nlayers,
+                      size_t               Nveg,
+                      unsigned short       band,
+                      double               dp,
+                      unsigned short       iveg,
+                      unsigned short       veg_class,
+                      force_data_struct   *force,
+                      dmy_struct          *dmy,
+                      energy_bal_struct   *energy,
+                      global_param_struct *gp,
+                      cell_data_struct    *cell,
+                      snow_data_struct    *snow,
+                      soil_con_struct     *soil_con,
+                      veg_var_struct      *veg_var,
+                      double               lag_one,
+                      double               sigma_slope,
+                      double               fetch,
+                      double              *CanopLayerBnd)
+{
+    int      ret;
+    uint64_t start;
+
+    start = bench_clock_ns();
+    ret = __real_surface_fluxes(overstory, BareAlbedo, ice0, moist0, surf_atten,
+                                Melt, Le, aero_resist, displacement,
+                                gauge_correction, out_prec, out_rain, out_snow,
+                                ref_height, roughness, snow_inflow, wind, root,
+                                Nlayers, Nveg, band, dp, iveg, veg_class, force,
+                                dmy, energy, gp, cell, snow, soil_con, veg_var,
+                                lag_one, sigma_slope, fetch, CanopLayerBnd);
+    bench_kernel_add(BENCH_SURFACE_FLUXES, start);
+
+    return ret;
+}
+
+/******************************************************************************
+ * @brief    Timed wrapper of calc_surf_energy_bal().
+ *****************************************************************************/
+double
+__wrap_calc_surf_energy_bal(double             Le,
+                            double             LongUnderIn,
+                            double             NetLongSnow,
+                            double             NetShortGrnd,
+                            double             NetShortSnow,
+                            double             OldTSurf,
+                            double             ShortUnderIn,
+                            double             SnowAlbedo,
+                            double             SnowLatent,
+                            double             SnowLatentSub,
+                            double             SnowSensible,
+                            double             Tair,
+                            double             VPDcanopy,
+                            double             VPcanopy,
+                            double             delta_coverage,
+                            double             dp,
+                            double             ice0,
+                            double             melt_energy,
+                            double             moist,
+                            double             snow_coverage,
+                            double             snow_depth,
+                            double             BareAlbedo,
+                            double             surf_atten,
+                            double            *aero_resist,
+                            double            *aero_resist_veg,
+                            double            *aero_resist_used,
+                            double            *displacement,
+                            double            *melt,
+                            double            *ppt,
+                            double             rainfall,
+                            double            *ref_height,
+                            double            *roughness,
+                            double             snowfall,
+                            double            *wind,
+                            double            *root,
+                            int                INCLUDE_SNOW,
+                            int                UnderStory,
+                            size_t             Nnodes,
+                            size_t             Nveg,
+                            double             dt,
+                            size_t             hidx,
+                            unsigned short     iveg,
+                            int                overstory,
+                            unsigned short     veg_class,
+                            double            *CanopLayerBnd,
+                            double            *dryFrac,
+                            force_data_struct *force,
+                            dmy_struct        *dmy,
+                            energy_bal_struct *energy,
+                            layer_data_struct *layer,
+                            snow_data_struct  *snow,
+                            soil_con_struct   *soil_con,
+                            veg_var_struct    *veg_var)
+{
+    double   ret;
+    uint64_t start;
+
+    start = bench_clock_ns();
+    ret = __real_calc_surf_energy_bal(Le, LongUnderIn, NetLongSnow,
+                                      NetShortGrnd, NetShortSnow, OldTSurf,
+                                      ShortUnderIn, SnowAlbedo, SnowLatent,
+                                      SnowLatentSub, SnowSensible, Tair,
+                                      VPDcanopy, VPcanopy, delta_coverage, dp,
+                                      ice0, melt_energy, moist, snow_coverage,
+                                      snow_depth, BareAlbedo, surf_atten,
+                                      aero_resist, aero_resist_veg,
+                                      aero_resist_used, displacement, melt, ppt,
+                                      rainfall, ref_height, roughness, snowfall,
+                                      wind, root, INCLUDE_SNOW, UnderStory,
+                                      Nnodes, Nveg, dt, hidx, iveg, overstory,
+                                      veg_class, CanopLayerBnd, dryFrac, force,
+                                      dmy, energy, layer, snow, soil_con,
+                                      veg_var);
+    bench_kernel_add(BENCH_CALC_SURF_ENERGY_BAL, start);
+
+    return ret;
+}
+
+/******************************************************************************
+ * @brief    Timed wrapper of solve_snow().
+ *****************************************************************************/
+double
+__wrap_solve_snow(char               overstory,
+                  double             BareAlbedo,
+                  double             LongUnderOut,
+                  double             MIN_RAIN_TEMP,
+                  double             MAX_SNOW_TEMP,
+                  double             Tcanopy,
+                  double             Tgrnd,
+                  double             air_temp,
+                  double             prec,
+                  double             snow_grnd_flux,
+                  double            *AlbedoUnder,
+                  double            *Le,
+                  double            *LongUnderIn,
+                  double            *NetLongSnow,
+                  double            *NetShortGrnd,
+                  double            *NetShortSnow,
+                  double            *ShortUnderIn,
+                  double            *Torg_snow,
+                  double            *aero_resist,
+                  double            *aero_resist_used,
+                  double            *coverage,
+                  double            *delta_coverage,
+                  double            *delta_snow_heat,
+                  double            *displacement,
+                  double            *gauge_correction,
+                  double            *melt_energy,
+                  double            *out_prec,
+                  double            *out_rain,
+                  double            *out_snow,
+                  double            *ppt,
+                  double            *rainfall,
+                  double            *ref_height,
+                  double            *roughness,
+                  double            *snow_inflow,
+                  double            *snowfall,
+                  double            *surf_atten,
+                  double            *wind,
+                  double            *root,
+                  int                INCLUDE_SNOW,
+                  size_t             Nveg,
+                  unsigned short     iveg,
+                  unsigned short     band,
+                  double             dt,
+                  size_t             hidx,
+                  int                veg_class,
+                  int               *UnderStory,
+                  double            *CanopLayerBnd,
+                  double            *dryFrac,
+                  dmy_struct        *dmy,
+                  force_data_struct *force,
+                  energy_bal_struct *energy,
+                  layer_data_struct *layer,
+                  snow_data_struct  *snow,
+                  soil_con_struct   *soil_con,
+                  veg_var_struct    *veg_var)
+{
+    double   ret;
+    uint64_t start;
+
+    start = bench_clock_ns();
+    ret = __real_solve_snow(overstory, BareAlbedo, LongUnderOut, MIN_RAIN_TEMP,
+                            MAX_SNOW_TEMP, Tcanopy, Tgrnd, air_temp, prec,
+                            snow_grnd_flux, AlbedoUnder, Le, LongUnderIn,
+                            NetLongSnow, NetShortGrnd, NetShortSnow,
+                            ShortUnderIn, Torg_snow, aero_resist,
+                            aero_resist_used, coverage, delta_coverage,
+                            delta_snow_heat, displacement, gauge_correction,
+                            melt_energy, out_prec, out_rain, out_snow, ppt,
+                            rainfall, ref_height, roughness, snow_inflow,
+                            snowfall, surf_atten, wind, root, INCLUDE_SNOW,
+                            Nveg, iveg, band, dt, hidx, veg_class, UnderStory,
+                            CanopLayerBnd, dryFrac, dmy, force, energy, layer,
+                            snow, soil_con, veg_var);
+    bench_kernel_add(BENCH_SOLVE_SNOW, start);
+
+    return ret;
+}
+
+/******************************************************************************
+ * @brief    Timed wrapper of solve_T_profile().
+ *****************************************************************************/
+int
+__wrap_solve_T_profile(double   *T,
+                       double   *T0,
+                       char     *Tfbflag,
+                       unsigned *Tfbcount,
+                       double   *Zsum,
+                       double   *kappa,
+                       double   *Cs,
+                       double   *moist,
+                       double    deltat,
+                       double   *max_moist,
+                       double   *bubble,
+                       double   *expt,
+                       double   *ice,
+                       double   *alpha,
+                       double   *beta,
+                       double   *gamma,
+                       double    Dp,
+                       int       Nnodes,
+                       int      *FIRST_SOLN,
+                       int       FS_ACTIVE,
+                       int       NOFLUX,
+                       int       EXP_TRANS)
+{
+    int      ret;
+    uint64_t start;
+
+    start = bench_clock_ns();
+    ret = __real_solve_T_profile(T, T0, Tfbflag, Tfbcount, Zsum, kappa, Cs,
+                                 moist, deltat, max_moist, bubble, expt, ice,
+                                 alpha, beta, gamma, Dp, Nnodes, FIRST_SOLN,
+                                 FS_ACTIVE, NOFLUX, EXP_TRANS);
+    bench_kernel_add(BENCH_SOLVE_T_PROFILE, start);
+
+    return ret;
+}
+
+/******************************************************************************
+ * @brief    Timed wrapper of solve_T_profile_implicit().
+ *****************************************************************************/
+int
+__wrap_solve_T_profile_implicit(double   *T,
+                                double   *T0,
+                                char     *Tfbflag,
+                                unsigned *Tfbcount,
+                                double   *Zsum,
+                                double   *kappa,
+                                double   *Cs,
+                                double   *moist,
+                                double    deltat,
+                                double   *max_moist,
+                                double   *bubble,
+                                double   *expt,
+                                double   *ice,
+                                double   *alpha,
+                                double   *beta,
+                                double   *gamma,
+                                double    Dp,
+                                int       Nnodes,
+                                int      *FIRST_SOLN,
+                                int       NOFLUX,
+                                int       EXP_TRANS,
+                                double   *bulk_dens_min,
+                                double   *soil_dens_min,
+                                double   *quartz,
+                                double   *bulk_density,
+                                double   *soil_density,
+                                double   *organic,
+                                double   *depth)
+{
+    int      ret;
+    uint64_t start;
+
+    start = bench_clock_ns();
+    ret = __real_solve_T_profile_implicit(T, T0, Tfbflag, Tfbcount, Zsum, kappa,
+                                          Cs, moist, deltat, max_moist, bubble,
+                                          expt, ice, alpha, beta, gamma, Dp,
+                                          Nnodes, FIRST_SOLN, NOFLUX, EXP_TRANS,
+                                          bulk_dens_min, soil_dens_min, quartz,
+                                          bulk_density, soil_density, organic,
+                                          depth);
+    bench_kernel_add(BENCH_SOLVE_T_PROFILE_IMPLICIT, start);
+
+    return ret;
+}
+
+/******************************************************************************
+ * @brief    Timed wrapper of solve_lake().
+ *****************************************************************************/
+int
+__wrap_solve_lake(double           snowfall,
+                  double           rainfall,
+                  double           tair,
+                  double           wind,
+                  double           vp,
+                  double           shortin,
+                  double           longin,
+                  double           vpd,
+                  double           pressure,
+                  double           air_density,
+                  lake_var_struct *lake,
+                  soil_con_struct *soil_con,
+                  double           dt,
+                  double           wind_h,
+                  dmy_struct      *dmy,
+                  double           fracprv)
+{
+    int      ret;
+    uint64_t start;
+
+    start = bench_clock_ns();
+    ret = __real_solve_lake(snowfall, rainfall, tair, wind, vp, shortin, longin,
+                            vpd, pressure, air_density, lake, soil_con, dt,
+                            wind_h, dmy, fracprv);
+    bench_kernel_add(BENCH_SOLVE_LAKE, start);
+
+    return ret;
+}
+
+/******************************************************************************
+ * @brief    Timed wrapper of CalcBlowingSnow().
+ *****************************************************************************/
+double
+__wrap_CalcBlowingSnow(double   Dt,
+                       double   Tair,
+                       unsigned LastSnow,
+                       double   SurfaceLiquidWater,
+                       double   Wind,
+                       double   Ls,
+                       double   AirDens,
+                       double   EactAir,
+                       double   ZO,
+                       double   Zrh,
+                       double   snowdepth,
+                       double   lag_one,
+                       double   sigma_slope,
+                       double   Tsnow,
+                       int      iveg,
+                       int      Nveg,
+                       double   fe,
+                       double   displacement,
+                       double   roughness,
+                       double  *TotalTransport)
+{
+    double   ret;
+    uint64_t start;
+
+    start = bench_clock_ns();
+    ret = __real_CalcBlowingSnow(Dt, Tair, LastSnow, SurfaceLiquidWater, Wind,
+                                 Ls, AirDens, EactAir, ZO, Zrh, snowdepth,
+                                 lag_one, sigma_slope, Tsnow, iveg, Nveg, fe,
+                                 displacement, roughness, TotalTransport);
+    bench_kernel_add(BENCH_CALC_BLOWING_SNOW, start);
+
+    return ret;
+}
+
+/******************************************************************************
+ * @brief    Timed wrapper of canopy_assimilation().
+ *****************************************************************************/
+void
+__wrap_canopy_assimilation(char    Ctype,
+                           double  MaxCarboxRate,
+                           double  MaxETransport,
+                           double  CO2Specificity,
+                           double *NscaleFactor,
+                           double  Tfoliage,
+                           double  SWdown,
+                           double *aPAR,
+                           double  elevation,
+                           double  Catm,
+                           double *CanopLayerBnd,
+                           double  LAItotal,
+                           char   *mode,
+                           double *rsLayer,
+                           double *rc,
+                           double *Ci,
+                           double *GPP,
+                           double *Rdark,
+                           double *Rphoto,
+                           double *Rmaint,
+                           double *Rgrowth,
+                           double *Raut,
+                           double *NPP)
+{
+    uint64_t start;
+
+    start = bench_clock_ns();
+    __real_canopy_assimilation(Ctype, MaxCarboxRate, MaxETransport,
+                               CO2Specificity, NscaleFactor, Tfoliage, SWdown,
+                               aPAR, elevation, Catm, CanopLayerBnd, LAItotal,
+                               mode, rsLayer, rc, Ci, GPP, Rdark, Rphoto,
+                               Rmaint, Rgrowth, Raut, NPP);
+    bench_kernel_add(BENCH_CANOPY_ASSIMILATION, start);
+}
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Snapshot and fingerprint of the model state of the benchmark grid cell.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_bench.h>
+
+/******************************************************************************
+ * @brief    Copy the model state of a grid cell into another one made by
+ *           make_all_vars() for the same number of vegetation tiles.
+ *
+ * @details  The structures are copied by value, except for the canopy layer
+ *           arrays of veg_var_struct, which are copied into the arrays
+ *           already allocated for dst.
+ *****************************************************************************/
+void
+copy_all_vars(all_vars_struct *dst,
+              all_vars_struct *src,
+              size_t           nveg)
+{
+    extern option_struct options;
+
+    size_t               i;
+    size_t               j;
+    veg_var_struct      *from;
+    veg_var_struct      *to;
+    veg_var_struct       keep;
+
+    for (i = 0; i <= nveg; i++) {
+        for (j = 0; j < options.SNOW_BAND; j++) {
+            dst->cell[i][j] = src->cell[i][j];
+            dst->energy[i][j] = src->energy[i][j];
+            dst->snow[i][j] = src->snow[i][j];
+
+            from = &(src->veg_var[i][j]);
+            to = &(dst->veg_var[i][j]);
+            keep = *to;
+            *to = *from;
+            to->NscaleFactor = keep.NscaleFactor;
+            to->aPARLayer = keep.aPARLayer;
+            to->CiLayer = keep.CiLayer;
+            to->rsLayer = keep.rsLayer;
+            if (options.CARBON) {
+                memcpy(to->NscaleFactor, from->NscaleFactor,
+                       options.Ncanopy * sizeof(*(to->NscaleFactor)));
+                memcpy(to->aPARLayer, from->aPARLayer,
+                       options.Ncanopy * sizeof(*(to->aPARLayer)));
+                memcpy(to->CiLayer, from->CiLayer,
+                       options.Ncanopy * sizeof(*(to->CiLayer)));
+                memcpy(to->rsLayer, from->rsLayer,
+                       options.Ncanopy * sizeof(*(to->rsLayer)));
+            }
+        }
+    }
+    dst->lake_var = src->lake_var;
+}
+
+/******************************************************************************
+ * @brief    Sum a few state variables of a grid cell into one number.
+ *
+ * @details  Used to check that every timed pass ends in the same state, and
+ *           recorded so that a change of the simulated physics shows up next
+ *           to a change of its cost.  The value has no physical meaning.
+ *****************************************************************************/
+double
+bench_state_checksum(all_vars_struct *all_vars,
+                     size_t           nveg)
+{
+    extern option_struct options;
+
+    double               sum;
+    size_t               i;
+    size_t               j;
+    size_t               k;
+
+    sum = all_vars->lake_var.volume;
+    for (i = 0; i <= nveg; i++) {
+        for (j = 0; j < options.SNOW_BAND; j++) {
+            for (k = 0; k < options.Nlayer; k++) {
+                sum += all_vars->cell[i][j].layer[k].moist;
+            }
+            for (k = 0; k < options.Nnode; k++) {
+                sum += all_vars->energy[i][j].T[k];
+            }
+            sum += all_vars->energy[i][j].Tsurf;
+            sum += all_vars->snow[i][j].swq;
+            sum += all_vars->veg_var[i][j].Wdew;
+        }
+    }
+
+    return sum;
+}
@@ -0,0 +1,378 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Microbenchmark of the vic_run physics kernels
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_bench.h>
+
+// global variables
+int                 flag;
+size_t              NR; /* array index for atmos struct that indicates
+                           the model step avarage or sum */
+size_t              NF; /* array index loop counter limit for atmos
+                           struct that indicates the SNOW_STEP values */
+
+global_param_struct global_param;
+veg_lib_struct     *veg_lib;
+option_struct       options;
+Error_struct        Error;
+param_set_struct    param_set;
+parameters_struct   param;
+filenames_struct    filenames;
+filep_struct        filep;
+metadata_struct     out_metadata[N_OUTVAR_TYPES];
+
+static char         bench_optstring[] = "g:c:s:n:p:r:o:vh";
+
+/******************************************************************************
+ * @brief    Print the usage of the benchmark.
+ *****************************************************************************/
+static void
+print_bench_usage(char *executable)
+{
+    fprintf(stdout,
+            "Usage: %s [-v | -g <global_parameter_file> [-c <gridcell>] "
+            "[-s <spinup_steps>]\n"
+            "       [-n <steps>] [-p <passes>] [-r <regime>] "
+            "[-o <json_file>]]\n", executable);
+    fprintf(stdout, "  v: display version information\n");
+    fprintf(stdout,
+            "  g: read model parameters from <global_parameter_file>.\n");
+    fprintf(stdout,
+            "  c: run grid cell <gridcell> (default: first active cell).\n");
+    fprintf(stdout,
+            "  s: run <spinup_steps> untimed steps before taking the "
+            "snapshot (default: %d).\n", BENCH_SPINUP_STEPS);
+    fprintf(stdout,
+            "  n: time <steps> steps from the snapshot in each pass "
+            "(default: %d).\n", BENCH_STEPS);
+    fprintf(stdout,
+            "  p: repeat the timed steps <passes> times (default: %d).\n",
+            BENCH_PASSES);
+    fprintf(stdout,
+            "  r: label the results with <regime> (default: the global "
+            "parameter file).\n");
+    fprintf(stdout,
+            "  o: write the results to <json_file> (default: %s).\n",
+            BENCH_OUTFILE);
+}
+
+/******************************************************************************
+ * @brief    Parse the command line of the benchmark.
+ *****************************************************************************/
+static void
+bench_cmd_proc(int                    argc,
+               char                 **argv,
+               bench_settings_struct *settings)
+{
+    int optchar;
+
+    strcpy(settings->global, "MISSING");
+    strcpy(settings->outfile, BENCH_OUTFILE);
+    strcpy(settings->regime, "MISSING");
+    settings->gridcel = -1;
+    settings->spinup_steps = BENCH_SPINUP_STEPS;
+    settings->steps = BENCH_STEPS;
+    settings->passes = BENCH_PASSES;
+
+    while ((optchar = getopt(argc, argv, bench_optstring)) != EOF) {
+        switch ((char)optchar) {
+        case 'v':
+            /** Version information **/
+            display_current_settings(DISP_VERSION);
+            exit(EXIT_SUCCESS);
+            break;
+        case 'g':
+            strncpy(settings->global, optarg, MAXSTRING - 1);
+            break;
+        case 'c':
+            settings->gridcel = atoi(optarg);
+            break;
+        case 's':
+            settings->spinup_steps = (size_t) atol(optarg);
+            break;
+        case 'n':
+            settings->steps = (size_t) atol(optarg);
+            break;
+        case 'p':
+            settings->passes = (size_t) atol(optarg);
+            break;
+        case 'r':
+            strncpy(settings->regime, optarg, MAXSTRING - 1);
+            break;
+        case 'o':
+            strncpy(settings->outfile, optarg, MAXSTRING - 1);
+            break;
+        default:
+            print_bench_usage(argv[0]);
+            exit(EXIT_FAILURE);
+            break;
+        }
+    }
+
+    if (strcmp(settings->global, "MISSING") == 0) {
+        fprintf(stderr,
+                "ERROR: Must set global control file using the '-g' flag\n");
+        print_bench_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    if (settings->steps == 0 || settings->passes == 0) {
+        fprintf(stderr, "ERROR: The number of steps and of passes must be "
+                "at least 1\n");
+        exit(EXIT_FAILURE);
+    }
+    if (strcmp(settings->regime, "MISSING") == 0) {
+        strcpy(settings->regime, settings->global);
+    }
+}
+
+/******************************************************************************
+ * @brief    Run the physics of the grid cell for one time step.
+ *****************************************************************************/
+static void
+run_bench_step(size_t             rec,
+               force_data_struct *force,
+               all_vars_struct   *all_vars,
+               dmy_struct        *dmy,
+               lake_con_struct   *lake_con,
+               soil_con_struct   *soil_con,
+               veg_con_struct    *veg_con,
+               veg_hist_struct  **veg_hist)
+{
+    int ErrorFlag;
+
+    set_run_context((size_t) soil_con->gridcel, rec, &(dmy[rec]));
+    update_step_vars(all_vars, veg_con, veg_hist[rec]);
+    ErrorFlag = vic_run(&(force[rec]), all_vars, &(dmy[rec]), &global_param,
+                        lake_con, soil_con, veg_con, veg_lib);
+    if (ErrorFlag == ERROR) {
+        log_err("Grid cell %i failed in record %zu", soil_con->gridcel, rec);
+    }
+    accumulate_bench_solver_stats();
+}
+
+/******************************************************************************
+ * @brief   Microbenchmark of the vic_run physics kernels
+ * @details Sets up one grid cell of a classic driver simulation, runs it for
+ *          a number of untimed spin-up steps and takes a snapshot of its
+ *          state.  Each timed pass restores the snapshot and runs the same
+ *          steps, so that all passes do the same work.  The calls, inclusive
+ *          wall time and solver evaluations of the kernels are written as
+ *          JSON.
+ *
+ * @param argc Argument count
+ * @param argv Argument vector
+ *****************************************************************************/
+int
+main(int   argc,
+     char *argv[])
+{
+    bool                  MODEL_DONE;
+    bool                  RUN_MODEL;
+    bool                  reproducible;
+    double                checksum;
+    double                pass_checksum;
+    double                overhead;
+    int                   startrec;
+    size_t                nrecs;
+    size_t                Nveg_type;
+    size_t                nveg;
+    size_t                pass;
+    size_t                rec;
+    dmy_struct           *dmy;
+    force_data_struct    *force;
+    veg_hist_struct     **veg_hist;
+    veg_con_struct       *veg_con;
+    soil_con_struct       soil_con;
+    all_vars_struct       all_vars;
+    all_vars_struct       snapshot;
+    lake_con_struct       lake_con;
+    bench_settings_struct settings;
+    FILE                 *out;
+
+    // Initialize Log Destination
+    initialize_log();
+
+    /** Read Benchmark Options **/
+    bench_cmd_proc(argc, argv, &settings);
+    strcpy(filenames.global, settings.global);
+
+    // Initialize global structures
+    initialize_options();
+    initialize_global();
+    initialize_parameters();
+    initialize_filenames();
+    initialize_forcing_files();
+
+    /** Read Global Control File **/
+    filep.globalparam = open_file(filenames.global, "r");
+    get_global_param(filep.globalparam);
+    fclose(filep.globalparam);
+
+    // Set Log Destination
+    setup_logging(MISSING, filenames.log_path, &(filep.logfile));
+
+    /** Set model constants **/
+    if (strcmp(filenames.constants, "MISSING") != 0) {
+        filep.constants = open_file(filenames.constants, "r");
+        get_parameters(filep.constants);
+    }
+    validate_parameters();
+
+    /** Make Date Data Structure **/
+    initialize_time();
+    dmy = make_dmy(&global_param);
+
+    nrecs = settings.spinup_steps + settings.steps;
+    if (nrecs > global_param.nrecs) {
+        log_err("The benchmark needs %zu time steps but the simulation "
+                "period of %s has only %zu", nrecs, filenames.global,
+                global_param.nrecs);
+    }
+
+    // the benchmark writes no model output
+    options.Noutstreams = 0;
+
+    /** Check and Open Files **/
+    check_files(&filep, &filenames);
+    veg_lib = read_veglib(filep.veglib, &Nveg_type);
+    if (options.INIT_STATE) {
+        filep.init_state = check_state_file(filenames.init_state,
+                                            options.Nlayer, options.Nnode,
+                                            &startrec);
+    }
+
+    /** Find the benchmark grid cell **/
+    MODEL_DONE = false;
+    RUN_MODEL = false;
+    while (!MODEL_DONE) {
+        read_soilparam(filep.soilparam, &soil_con, &RUN_MODEL, &MODEL_DONE);
+        if (RUN_MODEL && (settings.gridcel < 0 ||
+                          (int) soil_con.gridcel == settings.gridcel)) {
+            break;
+        }
+        if (RUN_MODEL) {
+            free((char *) soil_con.AreaFract);
+            free((char *) soil_con.BandElev);
+            free((char *) soil_con.Tfactor);
+            free((char *) soil_con.Pfactor);
+            free((char *) soil_con.AboveTreeLine);
+        }
+        RUN_MODEL = false;
+    }
+    if (!RUN_MODEL) {
+        log_err("Grid cell %d is not an active cell of %s",
+                settings.gridcel, filenames.soil);
+    }
+    settings.gridcel = soil_con.gridcel;
+
+    veg_con = read_vegparam(filep.vegparam, soil_con.gridcel, Nveg_type);
+    nveg = veg_con[0].vegetat_type_num;
+    calc_root_fractions(veg_con, &soil_con);
+    if (options.LAKES) {
+        lake_con = read_lakeparam(filep.lakeparam, &soil_con, veg_con);
+    }
+    make_in_and_outfiles(&filep, &filenames, &soil_con, NULL, dmy);
+    read_snowband(filep.snowband, &soil_con);
+
+    all_vars = make_all_vars(nveg);
+    snapshot = make_all_vars(nveg);
+    alloc_atmos(nrecs, &force);
+    alloc_veg_hist(nrecs, nveg, &veg_hist);
+
+    /** Read the forcing and set the initial state **/
+    vic_force(force, dmy, filep.forcing, veg_con, veg_hist, &soil_con, 0,
+              nrecs);
+    vic_populate_model_state(&all_vars, filep, soil_con.gridcel, &soil_con,
+                             veg_con, &lake_con);
+
+    /** Spin up and take the snapshot of the state **/
+    for (rec = 0; rec < settings.spinup_steps; rec++) {
+        run_bench_step(rec, force, &all_vars, dmy, &lake_con, &soil_con,
+                       veg_con, veg_hist);
+    }
+    copy_all_vars(&snapshot, &all_vars, nveg);
+
+    /** Timed passes **/
+    overhead = bench_clock_overhead();
+    reset_bench_kernels();
+    reproducible = true;
+    checksum = 0.;
+    for (pass = 0; pass < settings.passes; pass++) {
+        copy_all_vars(&all_vars, &snapshot, nveg);
+        for (rec = settings.spinup_steps; rec < nrecs; rec++) {
+            run_bench_step(rec, force, &all_vars, dmy, &lake_con, &soil_con,
+                           veg_con, veg_hist);
+        }
+        pass_checksum = bench_state_checksum(&all_vars, nveg);
+        if (pass == 0) {
+            checksum = pass_checksum;
+        }
+        else if (pass_checksum != checksum) {
+            reproducible = false;
+        }
+    }
+    if (!reproducible) {
+        log_warn("The timed passes did not all end in the same state; the "
+                 "snapshot does not capture the whole state of the cell");
+    }
+
+    /** Write the results **/
+    out = open_file(settings.outfile, "w");
+    write_bench_json(out, &settings, &(dmy[settings.spinup_steps]), overhead,
+                     checksum, reproducible);
+    fclose(out);
+    log_info("Wrote benchmark results to %s", settings.outfile);
+
+    /** cleanup **/
+    free_veg_hist(nrecs, nveg, &veg_hist);
+    free_atmos(nrecs, &force);
+    free_all_vars(&snapshot, nveg);
+    free_all_vars(&all_vars, nveg);
+    free_vegcon(&veg_con);
+    free((char *) soil_con.AreaFract);
+    free((char *) soil_con.BandElev);
+    free((char *) soil_con.Tfactor);
+    free((char *) soil_con.Pfactor);
+    free((char *) soil_con.AboveTreeLine);
+    free_dmy(&dmy);
+    close_files(&filep, NULL, &soil_con);
+    fclose(filep.soilparam);
+    free_veglib(&veg_lib);
+    fclose(filep.vegparam);
+    fclose(filep.veglib);
+    if (options.SNOW_BAND > 1) {
+        fclose(filep.snowband);
+    }
+    if (options.LAKES) {
+        fclose(filep.lakeparam);
+    }
+    if (options.INIT_STATE) {
+        fclose(filep.init_state);
+    }
+    free_scratch();
+    finalize_logging();
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Header file for the microbenchmark of the vic_run physics kernels
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#ifndef VIC_BENCH_H
+#define VIC_BENCH_H
+
+#include <vic_driver_classic.h>
+#include <stdint.h>
+#include <time.h>
+
+#define BENCH_SPINUP_STEPS 24      // default number of spin-up steps
+#define BENCH_STEPS 24             // default number of timed steps per pass
+#define BENCH_PASSES 10            // default number of timed passes
+#define BENCH_CLOCK_SAMPLES 100000 // clock reads used to estimate overhead
+#define BENCH_OUTFILE "vic_bench.json" // default JSON output file
+
+/******************************************************************************
+ * @brief   Kernels timed by the benchmark.  Each one is linked through a
+ *          timed wrapper (ld --wrap), see bench_kernels.c.
+ *****************************************************************************/
+enum bench_kernels
+{
+    BENCH_VIC_RUN,
+    BENCH_SURFACE_FLUXES,
+    BENCH_CALC_SURF_ENERGY_BAL,
+    BENCH_SOLVE_SNOW,
+    BENCH_SOLVE_T_PROFILE,
+    BENCH_SOLVE_T_PROFILE_IMPLICIT,
+    BENCH_SOLVE_LAKE,
+    BENCH_CALC_BLOWING_SNOW,
+    BENCH_CANOPY_ASSIMILATION,
+    // Last value of enum - DO NOT ADD ANYTHING BELOW THIS LINE!!
+    // used as a loop counter and must be >= the largest value in this enum
+    N_BENCH_KERNELS
+};
+
+/******************************************************************************
+ * @brief   Calls and inclusive wall time of one kernel.
+ *****************************************************************************/
+typedef struct {
+    size_t calls;                /**< number of calls */
+    uint64_t ns;                 /**< inclusive wall time (ns) */
+    solver_stats_struct solver;  /**< statistics of the solver call sites
+                                    reached from the kernel, summed */
+} bench_kernel_struct;
+
+/******************************************************************************
+ * @brief   Settings of a benchmark run, from the command line.
+ *****************************************************************************/
+typedef struct {
+    char global[MAXSTRING];      /**< global parameter file */
+    char outfile[MAXSTRING];     /**< JSON output file */
+    char regime[MAXSTRING];      /**< label of the regime */
+    int gridcel;                 /**< grid cell to run, or -1 for the first
+                                    active cell of the soil file */
+    size_t spinup_steps;         /**< untimed steps before the snapshot */
+    size_t steps;                /**< timed steps per pass */
+    size_t passes;               /**< timed passes from the snapshot */
+} bench_settings_struct;
+
+void accumulate_bench_solver_stats(void);
+uint64_t bench_clock_ns(void);
+double bench_clock_overhead(void);
+void bench_kernel_add(size_t kernel, uint64_t start);
+const char *bench_kernel_name(size_t kernel);
+const char *bench_solver_site_name(size_t site);
+double bench_state_checksum(all_vars_struct *all_vars, size_t nveg);
+void copy_all_vars(all_vars_struct *dst, all_vars_struct *src, size_t nveg);
+bench_kernel_struct *get_bench_kernel(size_t kernel);
+solver_stats_struct *get_bench_solver_stats(size_t site);
+void reset_bench_kernels(void);
+void write_bench_json(FILE *f, bench_settings_struct *settings,
+                      dmy_struct *dmy, double overhead, double checksum,
+                      bool reproducible);
+
+#endif
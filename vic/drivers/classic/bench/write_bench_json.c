@@ -0,0 +1,134 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Write the results of the microbenchmark as JSON.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_bench.h>
+
+/******************************************************************************
+ * @brief    Write a string as a JSON string.
+ *****************************************************************************/
+static void
+write_json_string(FILE       *f,
+                  const char *s)
+{
+    fputc('"', f);
+    for (; *s != '\0'; s++) {
+        if (*s == '"' || *s == '\\') {
+            fputc('\\', f);
+        }
+        if ((unsigned char) *s >= 0x20) {
+            fputc(*s, f);
+        }
+    }
+    fputc('"', f);
+}
+
+/******************************************************************************
+ * @brief    Write a ratio as a JSON number, or null if the divisor is 0.
+ *****************************************************************************/
+static void
+write_json_ratio(FILE  *f,
+                 double num,
+                 size_t den)
+{
+    if (den == 0) {
+        fprintf(f, "null");
+    }
+    else {
+        fprintf(f, "%.6g", num / den);
+    }
+}
+
+/******************************************************************************
+ * @brief    Write the results of the microbenchmark as JSON.
+ *
+ * @details  One object per run.  Kernel times are inclusive wall times and
+ *           include overhead_ns for every timed kernel call nested in them.
+ *           evals_per_call is the number of solver evaluations reached from
+ *           a kernel per call of the kernel, and null for kernels that made
+ *           no solver calls.
+ *****************************************************************************/
+void
+write_bench_json(FILE                  *f,
+                 bench_settings_struct *settings,
+                 dmy_struct            *dmy,
+                 double                 overhead,
+                 double                 checksum,
+                 bool                   reproducible)
+{
+    size_t               steps;
+    size_t               k;
+    size_t               site;
+    bench_kernel_struct *kernel;
+    solver_stats_struct *stats;
+
+    steps = settings->steps * settings->passes;
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"regime\": ");
+    write_json_string(f, settings->regime);
+    fprintf(f, ",\n  \"global_param\": ");
+    write_json_string(f, settings->global);
+    fprintf(f, ",\n  \"git_version\": ");
+    write_json_string(f, GIT_VERSION);
+    fprintf(f, ",\n  \"gridcell\": %d,\n", settings->gridcel);
+    fprintf(f, "  \"start\": \"%04d-%02hu-%02hu-%05u\",\n", dmy->year,
+            dmy->month, dmy->day, dmy->dayseconds);
+    fprintf(f, "  \"spinup_steps\": %zu,\n", settings->spinup_steps);
+    fprintf(f, "  \"steps\": %zu,\n", settings->steps);
+    fprintf(f, "  \"passes\": %zu,\n", settings->passes);
+    fprintf(f, "  \"overhead_ns\": %.1f,\n", overhead);
+    fprintf(f, "  \"state_checksum\": %.17g,\n", checksum);
+    fprintf(f, "  \"reproducible\": %s,\n", reproducible ? "true" : "false");
+
+    fprintf(f, "  \"kernels\": {");
+    for (k = 0; k < N_BENCH_KERNELS; k++) {
+        kernel = get_bench_kernel(k);
+        fprintf(f, "%s\n    \"%s\": {\"calls\": %zu, \"calls_per_step\": ",
+                k > 0 ? "," : "", bench_kernel_name(k), kernel->calls);
+        write_json_ratio(f, (double) kernel->calls, steps);
+        fprintf(f, ", \"ns_per_call\": ");
+        write_json_ratio(f, (double) kernel->ns, kernel->calls);
+        fprintf(f, ", \"evals_per_call\": ");
+        write_json_ratio(f, (double) kernel->solver.evals,
+                         kernel->solver.calls > 0 ? kernel->calls : 0);
+        fprintf(f, "}");
+    }
+    fprintf(f, "\n  },\n");
+
+    fprintf(f, "  \"solvers\": {");
+    for (site = 0; site < N_SOLVER_SITES; site++) {
+        stats = get_bench_solver_stats(site);
+        fprintf(f, "%s\n    \"%s\": {\"calls\": %zu, \"evals_per_call\": ",
+                site > 0 ? "," : "", bench_solver_site_name(site),
+                stats->calls);
+        write_json_ratio(f, (double) stats->evals, stats->calls);
+        fprintf(f, ", \"expansions\": %zu, \"fallbacks\": %zu, "
+                "\"maxiter\": %zu}", stats->expansions, stats->fallbacks,
+                stats->maxiter);
+    }
+    fprintf(f, "\n  }\n");
+    fprintf(f, "}\n");
+}
@@ -35,6 +35,12 @@
 #define MAX_VEGPARAM_LINE_LENGTH 500
 #define ASCII_STATE_FLOAT_FMT "%.16g"
 
+// Output containers
+#define CONTAINER_MAGIC "VICCELLS"        // identifies a container directory
+#define CONTAINER_MAGIC_LEN 8
+#define CONTAINER_VERSION 2
+#define CONTAINER_COPY_SIZE 1048576       // copy buffer size [bytes]
+
 /******************************************************************************
  * @brief   file structures
  *****************************************************************************/
@@ -43,6 +49,7 @@ typedef struct {
     FILE *globalparam;  /**< global parameters file */
     FILE *constants;    /**< model constants parameter file */
     FILE *init_state;   /**< initial model state file */
+    FILE *journal;      /**< grid cell completion journal */
     FILE *lakeparam;    /**< lake parameter file */
     FILE *snowband;     /**< snow elevation band data file */
     FILE *soilparam;    /**< soil parameters for all grid cells */
@@ -61,25 +68,73 @@ typedef struct {
     char global[MAXSTRING];        /**< global control file name */
     char constants[MAXSTRING];     /**< model constants file name */
     char init_state[MAXSTRING];    /**< initial model state file name */
+    char journal[MAXSTRING];       /**< grid cell completion journal file name */
     char lakeparam[MAXSTRING];     /**< lake model constants file */
     char result_dir[MAXSTRING];    /**< directory where results will be written */
     char snowband[MAXSTRING];      /**< snow band parameter file name */
     char soil[MAXSTRING];          /**< soil parameter file name */
     char statefile[MAXSTRING];     /**< name of file in which to store model state */
+    char timing_trace[MAXSTRING];  /**< phase timer trace file name */
     char veg[MAXSTRING];           /**< vegetation grid coverage file */
     char veglib[MAXSTRING];        /**< vegetation parameter library file */
     char log_path[MAXSTRING];      /**< Location to write log file to*/
 } filenames_struct;
 
+/******************************************************************************
+ * @brief   Entry of the grid cell completion journal.
+ *****************************************************************************/
+typedef struct {
+    int cellnum;            /**< index of the cell among active cells */
+    unsigned int gridcel;   /**< grid cell number from the soil file */
+    long soil_offset;       /**< soil file position just past the cell */
+    long state_offset;      /**< length of the output state file after the
+                                 cell (0 if no state file is saved) */
+    int status;             /**< 0 if the cell finished, ERROR if it failed */
+} journal_entry_struct;
+
+/******************************************************************************
+ * @brief   Header at the start of an output container cell directory.
+ *****************************************************************************/
+typedef struct {
+    char magic[CONTAINER_MAGIC_LEN];  /**< CONTAINER_MAGIC (not terminated) */
+    unsigned int version;             /**< CONTAINER_VERSION */
+    unsigned int entry_size;          /**< size of each directory entry */
+    unsigned long long sorted_start;  /**< index of the first entry of the
+                                           table sorted by cell number */
+    unsigned long long nsorted;       /**< number of entries in the sorted
+                                           table (0 until the first run
+                                           writing to the directory ends) */
+} container_header_struct;
+
+/******************************************************************************
+ * @brief   Cell directory entry locating one grid cell's block of records in
+ *          an output container.
+ *****************************************************************************/
+typedef struct {
+    unsigned int cellid;     /**< grid cell number from the soil file */
+    unsigned int file_format;   /**< ASCII or BINARY */
+    double lat;              /**< grid cell latitude */
+    double lng;              /**< grid cell longitude */
+    unsigned long long offset;  /**< byte offset of the block in the container */
+    unsigned long long nbytes;  /**< length of the block [bytes] */
+} container_entry_struct;
+
 void alloc_atmos(int, force_data_struct **);
 void alloc_veg_hist(int nrecs, int nveg, veg_hist_struct ***veg_hist);
+void append_cell_to_container(stream_struct *stream, char *result_dir,
+                              soil_con_struct *soil_con, bool sync);
 void calc_netlongwave(double *, double, double, double);
 double calc_netshort(double, int, double, double *);
 void check_files(filep_struct *, filenames_struct *);
 bool check_save_state_flag(dmy_struct *, size_t);
 FILE  *check_state_file(char *, size_t, size_t, int *);
-void close_files(filep_struct *filep, stream_struct **streams);
+void close_container(stream_struct *stream, char *result_dir);
+void close_files(filep_struct *filep, stream_struct **streams,
+                 soil_con_struct *soil_con);
 void compute_cell_area(soil_con_struct *);
+bool find_container_cell(char *dirname, unsigned int cellid,
+                         container_entry_struct *entry);
+void flush_output_buffer(stream_struct *stream);
 void free_atmos(int nrecs, force_data_struct **force);
 void free_veg_hist(int nrecs, int nveg, veg_hist_struct ***veg_hist);
 void free_veglib(veg_lib_struct **);
@@ -92,26 +147,32 @@ void initialize_forcing_files(void);
 void make_in_and_outfiles(filep_struct *filep, filenames_struct *filenames,
                           soil_con_struct *soil, stream_struct **streams,
                           dmy_struct *dmy);
+void open_container_cell(stream_struct *stream);
+FILE *open_cell_journal(char *filename);
 FILE *open_state_file(global_param_struct *, filenames_struct, size_t, size_t);
 void print_atmos_data(force_data_struct *force, size_t nr);
 void parse_output_info(FILE *gp, stream_struct **output_streams,
                        dmy_struct *dmy_current);
-void read_atmos_data(FILE *, global_param_struct, int, int, double **,
-                     double ***);
-double **read_forcing_data(FILE **, global_param_struct, double ****);
+bool read_cell_journal(char *filename, journal_entry_struct *entry);
+void read_atmos_data(FILE *, global_param_struct, int, int, size_t, size_t,
+                     double **, double ***);
+double **read_forcing_data(FILE **, global_param_struct, size_t, size_t,
+                           double ****);
 void read_initial_model_state(FILE *, all_vars_struct *, int, int, int,
-                              soil_con_struct *, lake_con_struct);
-lake_con_struct read_lakeparam(FILE *, soil_con_struct, veg_con_struct *);
+                              soil_con_struct *, lake_con_struct *);
+FILE *reopen_state_file(filenames_struct filenames, long state_offset);
+lake_con_struct read_lakeparam(FILE *, soil_con_struct *, veg_con_struct *);
 void read_snowband(FILE *, soil_con_struct *);
 void read_soilparam(FILE *soilparam, soil_con_struct *temp, bool *RUN_MODEL,
                     bool *MODEL_DONE);
 veg_lib_struct *read_veglib(FILE *, size_t *);
 veg_con_struct *read_vegparam(FILE *, int, size_t);
 void vic_force(force_data_struct *, dmy_struct *, FILE **, veg_con_struct *,
-               veg_hist_struct **, soil_con_struct *);
+               veg_hist_struct **, soil_con_struct *, size_t, size_t);
 void vic_populate_model_state(all_vars_struct *, filep_struct, size_t,
                               soil_con_struct *, veg_con_struct *,
-                              lake_con_struct);
+                              lake_con_struct *);
+void write_cell_journal(filep_struct *filep, journal_entry_struct *entry);
 void write_data(stream_struct *streams);
 void write_header(stream_struct **streams, dmy_struct *dmy);
 void write_model_state(all_vars_struct *, int, int, filep_struct *,
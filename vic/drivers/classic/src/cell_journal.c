@@ -0,0 +1,136 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Routines that maintain the grid cell completion journal of the classic
+ * driver.
+ *
+ * After each grid cell's output files are closed, one line is appended to
+ * the journal recording the cell, the position in the soil parameter file
+ * just past the cell, and the length of the output state file.  Each line is
+ * written with a single write and synced to disk before the next cell
+ * starts.  A restarted run seeks past the journaled cells in the soil
+ * parameter file and truncates the state file to its journaled length, so
+ * only the cells that had not finished are simulated again.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_classic.h>
+
+/******************************************************************************
+ * @brief    Read the last complete entry of the cell journal.
+ * @return   true if the journal exists and holds at least one complete
+ *           entry.  A partially written last line is removed from the
+ *           journal, so that new entries start on a fresh line.
+ *****************************************************************************/
+bool
+read_cell_journal(char                 *filename,
+                  journal_entry_struct *entry)
+{
+    FILE                *journal;
+    bool                 found;
+    char                 line[MAXSTRING];
+    size_t               length;
+    long                 valid_length;
+    journal_entry_struct tmp_entry;
+
+    journal = fopen(filename, "r");
+    if (journal == NULL) {
+        return false;
+    }
+
+    found = false;
+    valid_length = 0;
+    while (fgets(line, MAXSTRING, journal) != NULL) {
+        length = strlen(line);
+        if (length == 0 || line[length - 1] != '\n') {
+            // incomplete entry from an interrupted write
+            break;
+        }
+        if (sscanf(line, "%d %u %ld %ld %d", &tmp_entry.cellnum,
+                   &tmp_entry.gridcel, &tmp_entry.soil_offset,
+                   &tmp_entry.state_offset, &tmp_entry.status) != 5) {
+            log_err("Invalid entry in cell journal %s: %s", filename, line);
+        }
+        *entry = tmp_entry;
+        found = true;
+        valid_length = ftell(journal);
+    }
+    fseek(journal, 0, SEEK_END);
+    if (ftell(journal) > valid_length) {
+        if (truncate(filename, valid_length) != 0) {
+            log_err("Unable to remove incomplete entry from cell journal %s",
+                    filename);
+        }
+    }
+    fclose(journal);
+
+    return found;
+}
+
+/******************************************************************************
+ * @brief    Open the cell journal for appending.
+ *****************************************************************************/
+FILE *
+open_cell_journal(char *filename)
+{
+    FILE *journal;
+
+    journal = fopen(filename, "a");
+    if (journal == NULL) {
+        log_err("Unable to open cell journal %s", filename);
+    }
+
+    return journal;
+}
+
+/******************************************************************************
+ * @brief    Record a completed grid cell in the cell journal.
+ * @details  The output state file is synced first, so that the state
+ *           offset in the journal never points past data on disk.  The
+ *           output streams of the cell have already been synced by
+ *           close_files().
+ *****************************************************************************/
+void
+write_cell_journal(filep_struct         *filep,
+                   journal_entry_struct *entry)
+{
+    char line[MAXSTRING];
+    int  length;
+
+    entry->state_offset = 0;
+    if (filep->statefile != NULL) {
+        if (fflush(filep->statefile) != 0 ||
+            fsync(fileno(filep->statefile)) != 0) {
+            log_err("Unable to sync the output state file");
+        }
+        entry->state_offset = ftell(filep->statefile);
+    }
+
+    length = snprintf(line, MAXSTRING, "%d %u %ld %ld %d\n", entry->cellnum,
+                      entry->gridcel, entry->soil_offset,
+                      entry->state_offset, entry->status);
+    if (fwrite(line, 1, length, filep->journal) != (size_t) length ||
+        fflush(filep->journal) != 0 ||
+        fsync(fileno(filep->journal)) != 0) {
+        log_err("Unable to write to cell journal");
+    }
+}
@@ -25,17 +25,38 @@
  *****************************************************************************/
 
 #include <vic_driver_classic.h>
+#include <fcntl.h>
+
+/******************************************************************************
+ * @brief    Sync a closed output file to disk.
+ * @details  Compressed streams have no file descriptor of their own, so the
+ *           file is reopened by name; fsync flushes the file's data whatever
+ *           descriptor it is called on.
+ *****************************************************************************/
+static void
+sync_output_file(char *filename)
+{
+    int fd;
+
+    fd = open(filename, O_RDONLY);
+    if (fd < 0 || fsync(fd) != 0) {
+        log_err("Unable to sync output file %s", filename);
+    }
+    close(fd);
+}
 
 /******************************************************************************
  * @brief    This routine closes all forcing data files, and output files.
  *****************************************************************************/
 void
-close_files(filep_struct   *filep,
-            stream_struct **streams)
+close_files(filep_struct    *filep,
+            stream_struct  **streams,
+            soil_con_struct *soil_con)
 {
-    extern option_struct options;
+    extern option_struct    options;
+    extern filenames_struct filenames;
 
-    size_t               streamnum;
+    size_t                  streamnum;
 
     /**********************
        Close All Input Files
@@ -51,10 +72,18 @@ close_files(filep_struct   *filep,
        Close Output Files
     *******************/
     for (streamnum = 0; streamnum < options.Noutstreams; streamnum++) {
+        flush_output_buffer(&((*streams)[streamnum]));
+        // closing a compressed stream also flushes and closes its gzip file
         fclose((*streams)[streamnum].fh);
-        if ((*streams)[streamnum].compress) {
-            compress_files((*streams)[streamnum].filename,
-                           (*streams)[streamnum].compress);
+        // with a journal, the output must be on disk before the cell is
+        // recorded as complete
+        if (options.OUTPUT_CONTAINER) {
+            append_cell_to_container(&((*streams)[streamnum]),
+                                     filenames.result_dir, soil_con,
+                                     filep->journal != NULL);
+        }
+        else if (filep->journal != NULL) {
+            sync_output_file((*streams)[streamnum].filename);
         }
     }
 }
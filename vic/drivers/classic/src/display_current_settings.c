@@ -111,6 +111,12 @@ display_current_settings(int mode)
 
     fprintf(LOG_DEST, "\n");
     fprintf(LOG_DEST, "Simulation Parameters:\n");
+    if (options.ADAPTIVE_SNOW_STEP) {
+        fprintf(LOG_DEST, "ADAPTIVE_SNOW_STEP\t\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "ADAPTIVE_SNOW_STEP\t\tFALSE\n");
+    }
     if (options.AERO_RESIST_CANSNOW == AR_406) {
         fprintf(LOG_DEST, "AERO_RESIST_CANSNOW\t\tAR_406\n");
     }
@@ -129,6 +135,12 @@ display_current_settings(int mode)
     else {
         fprintf(LOG_DEST, "BLOWING\t\t\tFALSE\n");
     }
+    if (options.BLOWING_TABLE) {
+        fprintf(LOG_DEST, "BLOWING_TABLE\t\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "BLOWING_TABLE\t\tFALSE\n");
+    }
     if (options.CLOSE_ENERGY) {
         fprintf(LOG_DEST, "CLOSE_ENERGY\t\t\tTRUE\n");
     }
@@ -159,6 +171,12 @@ display_current_settings(int mode)
     else {
         fprintf(LOG_DEST, "EXP_TRANS\t\tFALSE\n");
     }
+    if (options.FROZEN_NEWTON) {
+        fprintf(LOG_DEST, "FROZEN_NEWTON\t\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "FROZEN_NEWTON\t\tFALSE\n");
+    }
     if (options.FROZEN_SOIL) {
         fprintf(LOG_DEST, "FROZEN_SOIL\t\tTRUE\n");
     }
@@ -183,6 +201,12 @@ display_current_settings(int mode)
     else {
         fprintf(LOG_DEST, "IMPLICIT\t\tFALSE\n");
     }
+    if (options.ANALYTIC_JACOBIAN) {
+        fprintf(LOG_DEST, "ANALYTIC_JACOBIAN\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "ANALYTIC_JACOBIAN\tFALSE\n");
+    }
     if (options.NOFLUX) {
         fprintf(LOG_DEST, "NOFLUX\t\t\tTRUE\n");
     }
@@ -201,6 +225,12 @@ display_current_settings(int mode)
     else {
         fprintf(LOG_DEST, "QUICK_SOLVE\t\tFALSE\n");
     }
+    if (options.SECANT_SOLVE) {
+        fprintf(LOG_DEST, "SECANT_SOLVE\t\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "SECANT_SOLVE\t\tFALSE\n");
+    }
     if (options.SPATIAL_FROST) {
         fprintf(LOG_DEST, "SPATIAL_FROST\t\tTRUE\n");
         fprintf(LOG_DEST, "Nfrost\t\t%zu\n", options.Nfrost);
@@ -220,6 +250,12 @@ display_current_settings(int mode)
     else if (options.SNOW_DENSITY == DENS_SNTHRM) {
         fprintf(LOG_DEST, "SNOW_DENSITY\t\tDENS_SNTHRM\n");
     }
+    if (options.MATH_KERNELS == MATH_EXACT) {
+        fprintf(LOG_DEST, "MATH_KERNELS\t\tEXACT\n");
+    }
+    else if (options.MATH_KERNELS == MATH_FUSED) {
+        fprintf(LOG_DEST, "MATH_KERNELS\t\tFUSED\n");
+    }
     if (options.TFALLBACK) {
         fprintf(LOG_DEST, "TFALLBACK\t\tTRUE\n");
     }
@@ -273,6 +309,7 @@ display_current_settings(int mode)
             }
         }
     }
+    fprintf(LOG_DEST, "FORCE_WINDOW\t\t%zu\n", global_param.force_window);
     fprintf(LOG_DEST, "GRID_DECIMAL\t\t%d\n", options.GRID_DECIMAL);
 
     fprintf(LOG_DEST, "\n");
@@ -433,5 +470,19 @@ display_current_settings(int mode)
     fprintf(LOG_DEST, "Output Data:\n");
     fprintf(LOG_DEST, "Result dir:\t\t%s\n", filenames.result_dir);
     fprintf(LOG_DEST, "Noutstreams:\t\t%zu\n", options.Noutstreams);
+    fprintf(LOG_DEST, "Journal:\t\t%s\n", filenames.journal);
+    if (options.OUTPUT_CONTAINER) {
+        fprintf(LOG_DEST, "OUTPUT_CONTAINER\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "OUTPUT_CONTAINER\tFALSE\n");
+    }
+    if (options.PHASE_TIMERS) {
+        fprintf(LOG_DEST, "PHASE_TIMERS\t\tTRUE\n");
+        fprintf(LOG_DEST, "Timing trace:\t\t%s\n", filenames.timing_trace);
+    }
+    else {
+        fprintf(LOG_DEST, "PHASE_TIMERS\t\tFALSE\n");
+    }
     fprintf(LOG_DEST, "\n");
 }
@@ -124,6 +124,10 @@ get_global_param(FILE *gp)
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.FULL_ENERGY = str_to_bool(flgstr);
             }
+            else if (strcasecmp("FROZEN_NEWTON", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.FROZEN_NEWTON = str_to_bool(flgstr);
+            }
             else if (strcasecmp("FROZEN_SOIL", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.FROZEN_SOIL = str_to_bool(flgstr);
@@ -144,6 +148,10 @@ get_global_param(FILE *gp)
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.QUICK_SOLVE = str_to_bool(flgstr);
             }
+            else if (strcasecmp("SECANT_SOLVE", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.SECANT_SOLVE = str_to_bool(flgstr);
+            }
             else if ((strcasecmp("NOFLUX",
                                  optstr) == 0) ||
                      (strcasecmp("NO_FLUX", optstr) == 0)) {
@@ -154,6 +162,10 @@ get_global_param(FILE *gp)
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.IMPLICIT = str_to_bool(flgstr);
             }
+            else if (strcasecmp("ANALYTIC_JACOBIAN", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.ANALYTIC_JACOBIAN = str_to_bool(flgstr);
+            }
             else if (strcasecmp("EXP_TRANS", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.EXP_TRANS = str_to_bool(flgstr);
@@ -170,6 +182,22 @@ get_global_param(FILE *gp)
                     log_err("Unknown SNOW_DENSITY option: %s", flgstr);
                 }
             }
+            else if (strcasecmp("MATH_KERNELS", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                if (strcasecmp("FUSED", flgstr) == 0) {
+                    options.MATH_KERNELS = MATH_FUSED;
+                }
+                else if (strcasecmp("EXACT", flgstr) == 0) {
+                    options.MATH_KERNELS = MATH_EXACT;
+                }
+                else {
+                    log_err("Unknown MATH_KERNELS option: %s", flgstr);
+                }
+            }
+            else if (strcasecmp("ADAPTIVE_SNOW_STEP", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.ADAPTIVE_SNOW_STEP = str_to_bool(flgstr);
+            }
             else if (strcasecmp("BLOWING", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.BLOWING = str_to_bool(flgstr);
@@ -194,6 +222,10 @@ get_global_param(FILE *gp)
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.BLOWING_SPATIAL_WIND = str_to_bool(flgstr);
             }
+            else if (strcasecmp("BLOWING_TABLE", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.BLOWING_TABLE = str_to_bool(flgstr);
+            }
             else if (strcasecmp("CORRPREC", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", flgstr);
                 options.CORRPREC = str_to_bool(flgstr);
@@ -412,6 +444,9 @@ get_global_param(FILE *gp)
             else if (strcasecmp("FORCESEC", optstr) == 0) {
                 sscanf(cmdstr, "%*s %u", &global_param.forcesec[file_num]);
             }
+            else if (strcasecmp("FORCE_WINDOW", optstr) == 0) {
+                sscanf(cmdstr, "%*s %zu", &global_param.force_window);
+            }
             else if (strcasecmp("GRID_DECIMAL", optstr) == 0) {
                 sscanf(cmdstr, "%*s %hu", &options.GRID_DECIMAL);
             }
@@ -551,6 +586,20 @@ get_global_param(FILE *gp)
             else if (strcasecmp("RESULT_DIR", optstr) == 0) {
                 sscanf(cmdstr, "%*s %s", filenames.result_dir);
             }
+            else if (strcasecmp("JOURNAL", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", filenames.journal);
+            }
+            else if (strcasecmp("OUTPUT_CONTAINER", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.OUTPUT_CONTAINER = str_to_bool(flgstr);
+            }
+            else if (strcasecmp("PHASE_TIMERS", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", flgstr);
+                options.PHASE_TIMERS = str_to_bool(flgstr);
+            }
+            else if (strcasecmp("TIMING_TRACE", optstr) == 0) {
+                sscanf(cmdstr, "%*s %s", filenames.timing_trace);
+            }
 
             /*************************************
                Define output file contents
@@ -1194,6 +1243,14 @@ get_global_param(FILE *gp)
         }
     }
 
+    // Validate the timing trace information
+    if (strcmp(filenames.timing_trace, "MISSING") != 0 &&
+        !options.PHASE_TIMERS) {
+        log_err("\"TIMING_TRACE\" was specified, but \"PHASE_TIMERS\" is "
+                "FALSE.  Set \"PHASE_TIMERS\" to TRUE in the global "
+                "parameter file to write the timing trace.");
+    }
+
     // Validate the output state file information
     if (options.SAVE_STATE) {
         if (strcmp(filenames.statefile, "MISSING") == 0) {
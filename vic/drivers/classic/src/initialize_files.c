@@ -40,6 +40,8 @@ initialize_filenames()
 
     strcpy(filenames.init_state, "MISSING");
     strcpy(filenames.statefile, "MISSING");
+    strcpy(filenames.timing_trace, "MISSING");
+    strcpy(filenames.journal, "MISSING");
     strcpy(filenames.constants, "MISSING");
     strcpy(filenames.soil, "MISSING");
     strcpy(filenames.veg, "MISSING");
@@ -66,6 +68,7 @@ initialize_fileps()
     filep.globalparam = NULL;
     filep.constants = NULL;
     filep.init_state = NULL;
+    filep.journal = NULL;
     filep.lakeparam = NULL;
     filep.snowband = NULL;
     filep.soilparam = NULL;
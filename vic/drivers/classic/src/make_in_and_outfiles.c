@@ -42,6 +42,7 @@ make_in_and_outfiles(filep_struct     *filep,
     extern FILE *open_file(char string[], char type[]);
 
     char                    latchar[20], lngchar[20], junk[6];
+    char                    mode[3];
     size_t                  filenum;
 
     sprintf(junk, "%%.%if", options.GRID_DECIMAL);
@@ -92,17 +93,35 @@ make_in_and_outfiles(filep_struct     *filep,
         strcat((*streams)[filenum].filename, lngchar);
         if ((*streams)[filenum].file_format == BINARY) {
             strcat((*streams)[filenum].filename, ".bin");
-            (*streams)[filenum].fh = open_file(
-                (*streams)[filenum].filename, "wb");
+            strcpy(mode, "wb");
         }
         else if ((*streams)[filenum].file_format == ASCII) {
             strcat((*streams)[filenum].filename, ".txt");
-            (*streams)[filenum].fh = open_file(
-                (*streams)[filenum].filename, "w");
+            strcpy(mode, "w");
         }
         else {
             log_err("Unrecognized OUT_FORMAT option");
         }
+        if (options.OUTPUT_CONTAINER) {
+            // records are collected in memory and appended to the
+            // stream's container when the grid cell is closed
+            open_container_cell(&((*streams)[filenum]));
+        }
+        else if ((*streams)[filenum].compress) {
+            // compressed streams are written through zlib as they go
+            strcat((*streams)[filenum].filename, ".gz");
+            (*streams)[filenum].fh = open_compressed_file(
+                (*streams)[filenum].filename, mode,
+                (*streams)[filenum].compress);
+            if ((*streams)[filenum].fh == NULL) {
+                log_err("Unable to open File %s",
+                        (*streams)[filenum].filename);
+            }
+        }
+        else {
+            (*streams)[filenum].fh = open_file(
+                (*streams)[filenum].filename, mode);
+        }
     }
     /** Write output file headers **/
     write_header(streams, dmy);
@@ -71,3 +71,26 @@ open_state_file(global_param_struct *global,
 
     return(statefile);
 }
+
+/******************************************************************************
+ * @brief    Reopen the state file of an interrupted run for appending.
+ * @details  Anything written after the last journaled grid cell is
+ *           discarded by truncating the file to state_offset bytes.
+ *****************************************************************************/
+FILE *
+reopen_state_file(filenames_struct filenames,
+                  long             state_offset)
+{
+    extern option_struct options;
+
+    if (truncate(filenames.statefile, state_offset) != 0) {
+        log_err("Unable to truncate state file %s to %ld bytes",
+                filenames.statefile, state_offset);
+    }
+    if (options.STATE_FORMAT == BINARY) {
+        return open_file(filenames.statefile, "ab");
+    }
+    else {
+        return open_file(filenames.statefile, "a");
+    }
+}
@@ -0,0 +1,498 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Routines that collect the output of all grid cells into one container file
+ * per output stream.
+ *
+ * Each grid cell's records for a stream are collected in memory while the
+ * cell runs.  When the cell is closed, they are appended as one block to
+ * <prefix>_container.<txt|bin>[.gz] and an entry giving the cell number,
+ * location, byte offset and length of the block is appended to the cell
+ * directory <prefix>_container.idx.  A block holds exactly what the per-cell
+ * output file would have held, so for compressed streams each block is a
+ * complete gzip member.
+ *
+ * Appends are serialized with an exclusive lock on the cell directory, so
+ * several VIC processes may write to the same containers.  A block is only
+ * referenced once its directory entry has been written, so a run that is
+ * interrupted mid-append leaves no partial cell in the directory.  When a
+ * cell appears more than once, the last directory entry is the valid one.
+ *
+ * At the end of a run the directory entries are merged into a table sorted
+ * by cell number, which is appended to the directory and recorded in its
+ * header, so a cell is found by binary search.  Entries appended after the
+ * table (by a process that is still running) are searched linearly.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_classic.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <zlib.h>
+
+// Open file description locks also serialize threads of one process
+#ifdef F_OFD_SETLKW
+#define CONTAINER_SETLKW F_OFD_SETLKW
+#else
+#define CONTAINER_SETLKW F_SETLKW
+#endif
+
+/******************************************************************************
+ * @brief    Build the names of a stream's container and cell directory.
+ *****************************************************************************/
+static void
+get_container_filenames(stream_struct *stream,
+                        char          *result_dir,
+                        char          *dataname,
+                        char          *dirname)
+{
+    char ext[MAXSTRING];
+
+    if (stream->file_format == BINARY) {
+        strcpy(ext, ".bin");
+    }
+    else {
+        strcpy(ext, ".txt");
+    }
+    if (stream->compress) {
+        strcat(ext, ".gz");
+    }
+    if (snprintf(dataname, MAXSTRING, "%s/%s_container%s", result_dir,
+                 stream->prefix, ext) >= MAXSTRING ||
+        snprintf(dirname, MAXSTRING, "%s/%s_container.idx", result_dir,
+                 stream->prefix) >= MAXSTRING) {
+        log_err("The output container name of stream %s in %s is longer "
+                "than %d characters", stream->prefix, result_dir,
+                MAXSTRING - 1);
+    }
+}
+
+/******************************************************************************
+ * @brief    Write nbytes to a file descriptor, retrying short writes.
+ *****************************************************************************/
+static void
+write_fd(int         fd,
+         const void *buf,
+         size_t      nbytes,
+         char       *filename)
+{
+    const char *ptr = buf;
+    ssize_t     n;
+
+    while (nbytes > 0) {
+        n = write(fd, ptr, nbytes);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            log_err("Error writing to output container %s", filename);
+        }
+        ptr += n;
+        nbytes -= n;
+    }
+}
+
+/******************************************************************************
+ * @brief    Read nbytes at a file offset, retrying short reads.
+ *****************************************************************************/
+static void
+read_fd(int    fd,
+        void  *buf,
+        size_t nbytes,
+        off_t  offset,
+        char  *filename)
+{
+    char   *ptr = buf;
+    ssize_t n;
+
+    while (nbytes > 0) {
+        n = pread(fd, ptr, nbytes, offset);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            log_err("Error reading container directory %s", filename);
+        }
+        ptr += n;
+        nbytes -= n;
+        offset += n;
+    }
+}
+
+/******************************************************************************
+ * @brief    Take the exclusive lock on a container cell directory.
+ *****************************************************************************/
+static void
+lock_container_directory(int   dir_fd,
+                         char *dirname)
+{
+    struct flock lock;
+
+    memset(&lock, 0, sizeof(lock));
+    lock.l_type = F_WRLCK;
+    lock.l_whence = SEEK_SET;
+    lock.l_start = 0;
+    lock.l_len = 0;
+    while (fcntl(dir_fd, CONTAINER_SETLKW, &lock) < 0) {
+        if (errno != EINTR) {
+            log_err("Unable to lock container directory %s", dirname);
+        }
+    }
+}
+
+/******************************************************************************
+ * @brief    Check the header of a container cell directory.
+ *****************************************************************************/
+static void
+check_container_header(container_header_struct *header,
+                       char                    *dirname)
+{
+    if (memcmp(header->magic, CONTAINER_MAGIC, CONTAINER_MAGIC_LEN) != 0) {
+        log_err("%s is not a VIC container directory", dirname);
+    }
+    if (header->version != CONTAINER_VERSION ||
+        header->entry_size != sizeof(container_entry_struct)) {
+        log_err("Container directory %s has version %u and entry size %u; "
+                "expected version %u and entry size %zu", dirname,
+                header->version, header->entry_size, CONTAINER_VERSION,
+                sizeof(container_entry_struct));
+    }
+}
+
+/******************************************************************************
+ * @brief    Compress a grid cell's records into one gzip member.
+ * @return   the compressed block, which the caller frees; its length is
+ *           returned in nbytes.
+ *****************************************************************************/
+static char *
+gzip_cell_records(char      *records,
+                  size_t     len,
+                  short int  level,
+                  size_t    *nbytes)
+{
+    char    *block;
+    int      status;
+    z_stream zs;
+
+    memset(&zs, 0, sizeof(zs));
+    // Same settings as gzopen(), so a block matches the per-cell .gz file
+    if (deflateInit2(&zs, get_compression_level(level), Z_DEFLATED,
+                     MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        log_err("Unable to initialize gzip compression of an output "
+                "container block");
+    }
+    block = malloc(deflateBound(&zs, (uLong) len) * sizeof(*block));
+    check_alloc_status(block, "Memory allocation error.");
+    zs.next_in = (Bytef *) records;
+    zs.avail_in = (uInt) len;
+    zs.next_out = (Bytef *) block;
+    zs.avail_out = (uInt) deflateBound(&zs, (uLong) len);
+    status = deflate(&zs, Z_FINISH);
+    if (status != Z_STREAM_END) {
+        log_err("Error compressing an output container block (zlib "
+                "status %d)", status);
+    }
+    *nbytes = (size_t) zs.total_out;
+    deflateEnd(&zs);
+
+    return block;
+}
+
+/******************************************************************************
+ * @brief    Open the in-memory stream that collects the current grid cell's
+ *           records for a stream written to an output container.
+ *****************************************************************************/
+void
+open_container_cell(stream_struct *stream)
+{
+    stream->container_buf = NULL;
+    stream->container_len = 0;
+    stream->fh = open_memstream(&(stream->container_buf),
+                                &(stream->container_len));
+    if (stream->fh == NULL) {
+        log_err("Unable to open the output container buffer of stream %s",
+                stream->prefix);
+    }
+}
+
+/******************************************************************************
+ * @brief    Append the records of a grid cell, collected in memory since
+ *           open_container_cell() and closed with the stream, to the
+ *           stream's output container and record their location in the cell
+ *           directory.  If sync is true, the block is synced to disk before
+ *           its directory entry is written, and the entry before the lock is
+ *           released.
+ *****************************************************************************/
+void
+append_cell_to_container(stream_struct   *stream,
+                         char            *result_dir,
+                         soil_con_struct *soil_con,
+                         bool             sync)
+{
+    char                    dataname[MAXSTRING];
+    char                    dirname[MAXSTRING];
+    char                   *block;
+    int                     dir_fd;
+    int                     data_fd;
+    off_t                   offset;
+    size_t                  nbytes;
+    container_header_struct header;
+    container_entry_struct  entry;
+
+    get_container_filenames(stream, result_dir, dataname, dirname);
+
+    // Compress before taking the lock, so other processes can append
+    if (stream->compress) {
+        block = gzip_cell_records(stream->container_buf,
+                                  stream->container_len, stream->compress,
+                                  &nbytes);
+        free(stream->container_buf);
+    }
+    else {
+        block = stream->container_buf;
+        nbytes = stream->container_len;
+    }
+    stream->container_buf = NULL;
+    stream->container_len = 0;
+
+    // Lock the cell directory for the whole append
+    dir_fd = open(dirname, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (dir_fd < 0) {
+        log_err("Unable to open container directory %s", dirname);
+    }
+    lock_container_directory(dir_fd, dirname);
+
+    // A new directory starts with a header
+    if (lseek(dir_fd, 0, SEEK_END) == 0) {
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, CONTAINER_MAGIC, CONTAINER_MAGIC_LEN);
+        header.version = CONTAINER_VERSION;
+        header.entry_size = sizeof(entry);
+        write_fd(dir_fd, &header, sizeof(header), dirname);
+    }
+
+    // Write the block to the end of the container
+    data_fd = open(dataname, O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (data_fd < 0) {
+        log_err("Unable to open output container %s", dataname);
+    }
+    offset = lseek(data_fd, 0, SEEK_END);
+    if (offset < 0) {
+        log_err("Unable to seek in output container %s", dataname);
+    }
+    write_fd(data_fd, block, nbytes, dataname);
+    free(block);
+    if (sync && fsync(data_fd) != 0) {
+        log_err("Unable to sync output container %s", dataname);
+    }
+    if (close(data_fd) != 0) {
+        log_err("Error closing output container %s", dataname);
+    }
+
+    // Record the block in the cell directory; closing it releases the lock
+    memset(&entry, 0, sizeof(entry));
+    entry.cellid = soil_con->gridcel;
+    entry.file_format = stream->file_format;
+    entry.lat = soil_con->lat;
+    entry.lng = soil_con->lng;
+    entry.offset = offset;
+    entry.nbytes = nbytes;
+    write_fd(dir_fd, &entry, sizeof(entry), dirname);
+    if (sync && fsync(dir_fd) != 0) {
+        log_err("Unable to sync container directory %s", dirname);
+    }
+    if (close(dir_fd) != 0) {
+        log_err("Error closing container directory %s", dirname);
+    }
+}
+
+/******************************************************************************
+ * @brief    Order container directory entries by cell number, and the
+ *           entries of one cell in the order they were appended (their
+ *           blocks only move forward in the container).
+ *****************************************************************************/
+static int
+compare_container_entries(const void *a,
+                          const void *b)
+{
+    const container_entry_struct *ea = a;
+    const container_entry_struct *eb = b;
+
+    if (ea->cellid != eb->cellid) {
+        return ea->cellid < eb->cellid ? -1 : 1;
+    }
+    if (ea->offset != eb->offset) {
+        return ea->offset < eb->offset ? -1 : 1;
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * @brief    Merge the entries of a stream's container cell directory into a
+ *           table sorted by cell number.
+ * @details  The table holds the last entry of each cell and is appended to
+ *           the directory; the header is only updated once the table is on
+ *           disk, so an interrupted merge leaves the directory valid.  The
+ *           entries it replaces are left in place and are still read in
+ *           order by readers that scan the whole directory.
+ *****************************************************************************/
+void
+close_container(stream_struct *stream,
+                char          *result_dir)
+{
+    char                    dataname[MAXSTRING];
+    char                    dirname[MAXSTRING];
+    int                     dir_fd;
+    off_t                   end;
+    size_t                  i;
+    size_t                  n;
+    size_t                  nentries;
+    size_t                  nsorted;
+    container_header_struct header;
+    container_entry_struct *entries;
+
+    get_container_filenames(stream, result_dir, dataname, dirname);
+
+    dir_fd = open(dirname, O_RDWR);
+    if (dir_fd < 0) {
+        if (errno == ENOENT) {
+            // no grid cell was written
+            return;
+        }
+        log_err("Unable to open container directory %s", dirname);
+    }
+    lock_container_directory(dir_fd, dirname);
+
+    read_fd(dir_fd, &header, sizeof(header), 0, dirname);
+    check_container_header(&header, dirname);
+    end = lseek(dir_fd, 0, SEEK_END);
+    if (end < 0) {
+        log_err("Unable to seek in container directory %s", dirname);
+    }
+    nentries = ((size_t) end - sizeof(header)) / sizeof(*entries);
+
+    // Only the sorted table and the entries after it are current
+    n = nentries - header.sorted_start;
+    if (n > header.nsorted) {
+        entries = malloc(n * sizeof(*entries));
+        check_alloc_status(entries, "Memory allocation error.");
+        read_fd(dir_fd, entries, n * sizeof(*entries),
+                sizeof(header) + header.sorted_start * sizeof(*entries),
+                dirname);
+        qsort(entries, n, sizeof(*entries), compare_container_entries);
+        nsorted = 0;
+        for (i = 0; i < n; i++) {
+            if (i + 1 < n && entries[i + 1].cellid == entries[i].cellid) {
+                continue;
+            }
+            entries[nsorted++] = entries[i];
+        }
+
+        write_fd(dir_fd, entries, nsorted * sizeof(*entries), dirname);
+        free(entries);
+        if (fsync(dir_fd) != 0) {
+            log_err("Unable to sync container directory %s", dirname);
+        }
+        header.sorted_start = nentries;
+        header.nsorted = nsorted;
+        if (pwrite(dir_fd, &header, sizeof(header), 0) !=
+            (ssize_t) sizeof(header) || fsync(dir_fd) != 0) {
+            log_err("Unable to update the header of container directory %s",
+                    dirname);
+        }
+    }
+
+    if (close(dir_fd) != 0) {
+        log_err("Error closing container directory %s", dirname);
+    }
+}
+
+/******************************************************************************
+ * @brief    Look up a grid cell in a container cell directory.
+ * @details  Binary search of the table sorted by close_container(), followed
+ *           by a scan of the entries appended after it.
+ * @return   true if the cell was found, in which case entry holds the most
+ *           recently appended block for the cell.
+ *****************************************************************************/
+bool
+find_container_cell(char                   *dirname,
+                    unsigned int            cellid,
+                    container_entry_struct *entry)
+{
+    FILE                   *fh;
+    bool                    found;
+    unsigned long long      lo;
+    unsigned long long      hi;
+    unsigned long long      mid;
+    container_header_struct header;
+    container_entry_struct  tmp_entry;
+
+    fh = fopen(dirname, "rb");
+    if (fh == NULL) {
+        log_err("Unable to open container directory %s", dirname);
+    }
+    if (fread(&header, sizeof(header), 1, fh) != 1) {
+        log_err("%s is not a VIC container directory", dirname);
+    }
+    check_container_header(&header, dirname);
+
+    found = false;
+    lo = header.sorted_start;
+    hi = header.sorted_start + header.nsorted;
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        if (fseeko(fh, (off_t) (sizeof(header) + mid * sizeof(tmp_entry)),
+                   SEEK_SET) != 0 ||
+            fread(&tmp_entry, sizeof(tmp_entry), 1, fh) != 1) {
+            log_err("Container directory %s ends inside its sorted table",
+                    dirname);
+        }
+        if (tmp_entry.cellid == cellid) {
+            *entry = tmp_entry;
+            found = true;
+            break;
+        }
+        else if (tmp_entry.cellid < cellid) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    // Entries appended after the sorted table supersede it
+    if (fseeko(fh, (off_t) (sizeof(header) + (header.sorted_start +
+                                              header.nsorted) *
+                            sizeof(tmp_entry)), SEEK_SET) != 0) {
+        log_err("Unable to seek in container directory %s", dirname);
+    }
+    while (fread(&tmp_entry, sizeof(tmp_entry), 1, fh) == 1) {
+        if (tmp_entry.cellid == cellid) {
+            *entry = tmp_entry;
+            found = true;
+        }
+    }
+    fclose(fh);
+
+    return found;
+}
@@ -142,11 +142,13 @@ print_filenames(filenames_struct *fnames)
     fprintf(LOG_DEST, "\tglobal       : %s\n", fnames->global);
     fprintf(LOG_DEST, "\tconstants    : %s\n", fnames->constants);
     fprintf(LOG_DEST, "\tinit_state   : %s\n", fnames->init_state);
+    fprintf(LOG_DEST, "\tjournal      : %s\n", fnames->journal);
     fprintf(LOG_DEST, "\tlakeparam    : %s\n", fnames->lakeparam);
     fprintf(LOG_DEST, "\tresult_dir   : %s\n", fnames->result_dir);
     fprintf(LOG_DEST, "\tsnowband     : %s\n", fnames->snowband);
     fprintf(LOG_DEST, "\tsoil         : %s\n", fnames->soil);
     fprintf(LOG_DEST, "\tstatefile    : %s\n", fnames->statefile);
+    fprintf(LOG_DEST, "\ttiming_trace : %s\n", fnames->timing_trace);
     fprintf(LOG_DEST, "\tveg          : %s\n", fnames->veg);
     fprintf(LOG_DEST, "\tveglib       : %s\n", fnames->veglib);
     fprintf(LOG_DEST, "\tlog_path     : %s\n", fnames->log_path);
@@ -164,6 +166,7 @@ print_filep(filep_struct *fp)
     fprintf(LOG_DEST, "\tglobalparam: %p\n", fp->globalparam);
     fprintf(LOG_DEST, "\tconstants  : %p\n", fp->constants);
     fprintf(LOG_DEST, "\tinit_state : %p\n", fp->init_state);
+    fprintf(LOG_DEST, "\tjournal    : %p\n", fp->journal);
     fprintf(LOG_DEST, "\tlakeparam  : %p\n", fp->lakeparam);
     fprintf(LOG_DEST, "\tsnowband   : %p\n", fp->snowband);
     fprintf(LOG_DEST, "\tsoilparam  : %p\n", fp->soilparam);
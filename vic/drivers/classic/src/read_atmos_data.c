@@ -28,12 +28,18 @@
 
 /******************************************************************************
  * @brief    Read in atmospheric data values from a binary/ascii file.
+ * @details  Reads the nrecs records starting at simulation record rec_start.
+ *           The file is positioned at the start of the simulation only when
+ *           rec_start is 0; otherwise reading continues from the current
+ *           file position.
  *****************************************************************************/
 void
 read_atmos_data(FILE               *infile,
                 global_param_struct global_param,
                 int                 file_num,
                 int                 forceskip,
+                size_t              rec_start,
+                size_t              nrecs,
                 double            **forcing_data,
                 double           ***veg_hist_data)
 {
@@ -102,48 +108,49 @@ read_atmos_data(FILE               *infile,
             endian = BIG;
         }
 
-        // Check for presence of a header, & skip over it if appropriate.
-        // A VIC header will start with 4 instances of the identifier,
-        // followed by number of bytes in the header (Nbytes).
-        // Nbytes is assumed to be the byte offset at which the data records start.
-        fseek(infile, 0, SEEK_SET);
-        if (feof(infile)) {
-            log_err("No data in the forcing file.");
-        }
-        for (i = 0; i < 4; i++) {
-            fread(&ustmp, sizeof(unsigned short int), 1, infile);
-            if (endian != param_set.FORCE_ENDIAN[file_num]) {
-                ustmp = ((ustmp & 0xFF) << 8) | ((ustmp >> 8) & 0xFF);
+        if (rec_start == 0) {
+            // Check for presence of a header, & skip over it if appropriate.
+            // A VIC header will start with 4 instances of the identifier,
+            // followed by number of bytes in the header (Nbytes).
+            // Nbytes is assumed to be the byte offset at which the data records start.
+            fseek(infile, 0, SEEK_SET);
+            if (feof(infile)) {
+                log_err("No data in the forcing file.");
             }
-            Identifier[i] = ustmp;
-        }
-        if (Identifier[0] != 0xFFFF || Identifier[1] != 0xFFFF ||
-            Identifier[2] != 0xFFFF || Identifier[3] != 0xFFFF) {
-            Nbytes = 0;
-        }
-        else {
-            fread(&ustmp, sizeof(unsigned short int), 1, infile);
-            if (endian != param_set.FORCE_ENDIAN[file_num]) {
-                ustmp = ((ustmp & 0xFF) << 8) | ((ustmp >> 8) & 0xFF);
+            for (i = 0; i < 4; i++) {
+                fread(&ustmp, sizeof(unsigned short int), 1, infile);
+                if (endian != param_set.FORCE_ENDIAN[file_num]) {
+                    ustmp = ((ustmp & 0xFF) << 8) | ((ustmp >> 8) & 0xFF);
+                }
+                Identifier[i] = ustmp;
             }
-            Nbytes = (int) ustmp;
-        }
-        fseek(infile, Nbytes, SEEK_SET);
-
+            if (Identifier[0] != 0xFFFF || Identifier[1] != 0xFFFF ||
+                Identifier[2] != 0xFFFF || Identifier[3] != 0xFFFF) {
+                Nbytes = 0;
+            }
+            else {
+                fread(&ustmp, sizeof(unsigned short int), 1, infile);
+                if (endian != param_set.FORCE_ENDIAN[file_num]) {
+                    ustmp = ((ustmp & 0xFF) << 8) | ((ustmp >> 8) & 0xFF);
+                }
+                Nbytes = (int) ustmp;
+            }
+            fseek(infile, Nbytes, SEEK_SET);
 
-        /** if forcing file starts before the model simulation,
-            skip over its starting records **/
-        fseek(infile, skip_recs * Nfields * sizeof(short int), SEEK_CUR);
-        if (feof(infile)) {
-            log_err("No data for the specified time period in the forcing "
-                    "file.");
+            /** if forcing file starts before the model simulation,
+                skip over its starting records **/
+            fseek(infile, skip_recs * Nfields * sizeof(short int), SEEK_CUR);
+            if (feof(infile)) {
+                log_err("No data for the specified time period in the forcing "
+                        "file.");
+            }
         }
 
         /** Read BINARY forcing data **/
         rec = 0;
 
         while (!feof(infile) && (rec * param_set.FORCE_DT[file_num] <
-                                 global_param.nrecs * global_param.dt)) {
+                                 nrecs * global_param.dt)) {
             for (i = 0; i < Nfields; i++) {
                 if (field_index[i] != ALBEDO && field_index[i] != LAI_IN &&
                     field_index[i] != FCANOPY) {
@@ -213,10 +220,12 @@ read_atmos_data(FILE               *infile,
         // also read the headers if necessary).
 
         /* skip to the beginning of the required met data */
-        for (i = 0; i < skip_recs; i++) {
-            if (fgets(str, MAXSTRING, infile) == NULL) {
-                log_err("No data for the specified time period in the forcing "
-                        "file.");
+        if (rec_start == 0) {
+            for (i = 0; i < skip_recs; i++) {
+                if (fgets(str, MAXSTRING, infile) == NULL) {
+                    log_err("No data for the specified time period in the "
+                            "forcing file.");
+                }
             }
         }
 
@@ -224,7 +233,7 @@ read_atmos_data(FILE               *infile,
         rec = 0;
 
         while (!feof(infile) && (rec * param_set.FORCE_DT[file_num] <
-                                 global_param.nrecs * global_param.dt)) {
+                                 nrecs * global_param.dt)) {
             for (i = 0; i < Nfields; i++) {
                 if (field_index[i] != ALBEDO && field_index[i] != LAI_IN &&
                     field_index[i] != FCANOPY) {
@@ -243,13 +252,14 @@ read_atmos_data(FILE               *infile,
         }
     }
 
-    if (rec * param_set.FORCE_DT[file_num] <
-        global_param.nrecs * global_param.dt) {
-        log_err("Not enough records in forcing file %i (%u * %f = %f) to run "
+    if (rec * param_set.FORCE_DT[file_num] < nrecs * global_param.dt) {
+        log_err("Not enough records in forcing file %i (%zu * %f = %f) to run "
                 "the number of records defined in the global file "
                 "(%zu * %f = %f).  Check forcing file time step, and global "
-                "file", file_num + 1, rec, param_set.FORCE_DT[file_num],
-                rec * param_set.FORCE_DT[file_num], global_param.nrecs,
+                "file", file_num + 1, rec_start + rec,
+                param_set.FORCE_DT[file_num],
+                (rec_start + rec) * param_set.FORCE_DT[file_num],
+                global_param.nrecs,
                 global_param.dt,
                 global_param.nrecs * global_param.dt);
     }
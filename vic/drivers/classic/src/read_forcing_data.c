@@ -31,10 +31,14 @@
 /******************************************************************************
  * @brief    Control the order and number of forcing variables read from the
  *           forcing data files.
+ * @details  Only the nrecs records starting at simulation record rec_start
+ *           are read and stored.
  *****************************************************************************/
 double **
 read_forcing_data(FILE              **infile,
                   global_param_struct global_param,
+                  size_t              rec_start,
+                  size_t              nrecs,
                   double          ****veg_hist_data)
 {
     extern param_set_struct param_set;
@@ -51,7 +55,7 @@ read_forcing_data(FILE              **infile,
     for (i = 0; i < N_FORCING_TYPES; i++) {
         if (param_set.TYPE[i].SUPPLIED) {
             if (i != ALBEDO && i != LAI_IN && i != FCANOPY) {
-                forcing_data[i] = calloc(global_param.nrecs * NF,
+                forcing_data[i] = calloc(nrecs * NF,
                                          sizeof(*(forcing_data[i])));
                 check_alloc_status(forcing_data[i], "Memory allocation error.");
             }
@@ -61,7 +65,7 @@ read_forcing_data(FILE              **infile,
                 check_alloc_status((*veg_hist_data)[i],
                                    "Memory allocation error.");
                 for (j = 0; j < param_set.TYPE[i].N_ELEM; j++) {
-                    (*veg_hist_data)[i][j] = calloc(global_param.nrecs * NF,
+                    (*veg_hist_data)[i][j] = calloc(nrecs * NF,
                                                     sizeof(*((*veg_hist_data)[i]
                                                              [j])));
                     check_alloc_status((*veg_hist_data)[i][j],
@@ -74,7 +78,7 @@ read_forcing_data(FILE              **infile,
     /** Read First Forcing Data File **/
     if (param_set.FORCE_DT[0] > 0) {
         read_atmos_data(infile[0], global_param, 0, global_param.forceskip[0],
-                        forcing_data, (*veg_hist_data));
+                        rec_start, nrecs, forcing_data, (*veg_hist_data));
     }
     else {
         log_err("File time step must be defined for at least the first "
@@ -84,7 +88,7 @@ read_forcing_data(FILE              **infile,
     /** Read Second Forcing Data File **/
     if (param_set.FORCE_DT[1] > 0) {
         read_atmos_data(infile[1], global_param, 1, global_param.forceskip[1],
-                        forcing_data, (*veg_hist_data));
+                        rec_start, nrecs, forcing_data, (*veg_hist_data));
     }
 
     return(forcing_data);
@@ -43,7 +43,7 @@ read_initial_model_state(FILE            *init_state,
                          int              Nbands,
                          int              cellnum,
                          soil_con_struct *soil_con,
-                         lake_con_struct  lake_con)
+                         lake_con_struct *lake_con)
 {
     extern option_struct options;
 
@@ -766,7 +766,7 @@ read_initial_model_state(FILE            *init_state,
 
         // Override possible bad values of soil moisture under lake coming from state file
         // (ideally we wouldn't store these in the state file in the first place)
-        if (options.LAKES && (int) veg == lake_con.lake_idx) {
+        if (options.LAKES && (int) veg == lake_con->lake_idx) {
             for (lidx = 0; lidx < options.Nlayer; lidx++) {
                 lake_var->soil.layer[lidx].moist =
                     soil_con->max_moist[lidx];
@@ -34,7 +34,7 @@
  *****************************************************************************/
 lake_con_struct
 read_lakeparam(FILE           *lakeparam,
-               soil_con_struct soil_con,
+               soil_con_struct *soil_con,
                veg_con_struct *veg_con)
 {
     extern option_struct options;
@@ -50,7 +50,7 @@ read_lakeparam(FILE           *lakeparam,
     /******************************************************************/
 
     fscanf(lakeparam, "%u %d", &lakecel, &temp.lake_idx);
-    while (lakecel != soil_con.gridcel && !feof(lakeparam)) {
+    while (lakecel != soil_con->gridcel && !feof(lakeparam)) {
         fgets(tmpstr, MAXSTRING, lakeparam); // grid cell number, etc.
         if (temp.lake_idx >= 0) {
             fgets(tmpstr, MAXSTRING, lakeparam); // lake depth-area relationship
@@ -61,7 +61,7 @@ read_lakeparam(FILE           *lakeparam,
     // cell number not found
     if (feof(lakeparam)) {
         log_err("Unable to find cell %d in the lake parameter file",
-                soil_con.gridcel);
+                soil_con->gridcel);
     }
 
     // read lake parameters from file
@@ -71,39 +71,39 @@ read_lakeparam(FILE           *lakeparam,
         if (temp.numnod < 1) {
             log_err("Number of vertical lake nodes (%zu) for cell %d specified "
                     "in the lake parameter file is < 1; increase this number "
-                    "to at least 1.", temp.numnod, soil_con.gridcel);
+                    "to at least 1.", temp.numnod, soil_con->gridcel);
         }
         if (temp.numnod > MAX_LAKE_NODES) {
             log_err("Number of lake nodes (%zu) in cell %d specified in the "
                     "lake parameter file exceeds the maximum allowable (%d), "
                     "edit MAX_LAKE_NODES in user_def.h.", temp.numnod,
-                    soil_con.gridcel, MAX_LAKE_NODES);
+                    soil_con->gridcel, MAX_LAKE_NODES);
         }
         fscanf(lakeparam, "%lf", &temp.mindepth);
         if (temp.mindepth < 0) {
             log_err("Minimum lake depth (%f) for cell %d specified in the "
                     "lake parameter file is < 0; increase this number to at "
-                    "least 0.", temp.mindepth, soil_con.gridcel);
+                    "least 0.", temp.mindepth, soil_con->gridcel);
         }
         fscanf(lakeparam, "%lf", &temp.wfrac);
         if (temp.wfrac < 0 || temp.wfrac > 1) {
             log_err("Lake outlet width fraction (%f) for cell %d specified in "
                     "the lake parameter file falls outside the range 0 to 1.  "
                     "Change wfrac to be between 0 and 1.", temp.wfrac,
-                    soil_con.gridcel);
+                    soil_con->gridcel);
         }
         fscanf(lakeparam, "%lf", &temp.depth_in);
         if (temp.depth_in < 0) {
             log_err("Initial lake depth (%f) for cell %d specified in the "
                     "lake parameter file is < 0; increase this number to at "
-                    "least 1.", temp.depth_in, soil_con.gridcel);
+                    "least 1.", temp.depth_in, soil_con->gridcel);
         }
         fscanf(lakeparam, "%lf", &temp.rpercent);
         if (temp.rpercent < 0 || temp.rpercent > 1) {
             log_err("Fraction of runoff entering lake catchment (%f) for cell "
                     "%d specified in the lake parameter file falls outside the"
                     " range 0 to 1.  Change rpercent to be between 0 and 1.",
-                    temp.rpercent, soil_con.gridcel);
+                    temp.rpercent, soil_con->gridcel);
         }
     }
     else { // no lake exists anywhere in this grid cell
@@ -136,13 +136,13 @@ read_lakeparam(FILE           *lakeparam,
         if (temp.Cl[0] < 0.0 || temp.Cl[0] > 1.0) {
             log_err("Lake area fraction (%f) for cell (%d) specified in the "
                     "lake parameter file must be a fraction between 0 and 1.",
-                    temp.Cl[0], soil_con.gridcel);
+                    temp.Cl[0], soil_con->gridcel);
         }
         if (fabs(1 - temp.Cl[0] / veg_con[temp.lake_idx].Cv) > 0.01) {
             log_err("Lake area fraction at top of lake basin (%f) for cell "
                     "(%d) specified in the lake parameter file must equal the "
                     "area fraction of the veg tile containing it (%f).",
-                    temp.Cl[0], soil_con.gridcel, veg_con[temp.lake_idx].Cv);
+                    temp.Cl[0], soil_con->gridcel, veg_con[temp.lake_idx].Cv);
         }
         else {
             temp.Cl[0] = veg_con[temp.lake_idx].Cv;
@@ -163,7 +163,7 @@ read_lakeparam(FILE           *lakeparam,
                             "for cell (%d) specified in the lake parameter "
                             "file must equal the area fraction of the veg "
                             "tile containing it (%f).", temp.Cl[0],
-                            soil_con.gridcel,
+                            soil_con->gridcel,
                             veg_con[temp.lake_idx].Cv);
                 }
                 else {
@@ -174,7 +174,7 @@ read_lakeparam(FILE           *lakeparam,
                 log_err("Lake layer %d area fraction (%f) for cell (%d) "
                         "specified in the lake parameter file must be a "
                         "fraction between 0 and 1.", (int)i, temp.Cl[i],
-                        soil_con.gridcel);
+                        soil_con->gridcel);
             }
         }
     }
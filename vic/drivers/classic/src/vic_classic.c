@@ -56,30 +56,35 @@ main(int   argc,
      char *argv[])
 {
     /** Variable Declarations **/
-    extern FILE       *LOG_DEST;
-
-    bool               MODEL_DONE;
-    bool               RUN_MODEL;
-    char               dmy_str[MAXSTRING];
-    size_t             rec;
-    size_t             Nveg_type;
-    int                cellnum;
-    int                startrec;
-    int                ErrorFlag;
-    int                n;
-    size_t             streamnum;
-    dmy_struct        *dmy;
-    force_data_struct *force;
-    veg_hist_struct  **veg_hist;
-    veg_con_struct    *veg_con;
-    soil_con_struct    soil_con;
-    all_vars_struct    all_vars;
-    lake_con_struct    lake_con;
-    stream_struct     *streams = NULL;
-    double          ***out_data;   // [1, nvars, nelem]
-    save_data_struct   save_data;
-    timer_struct       global_timers[N_TIMERS];
-    timer_struct       cell_timer;
+    extern FILE         *LOG_DEST;
+
+    bool                 MODEL_DONE;
+    bool                 RUN_MODEL;
+    bool                 RESUME;
+    char                 trace_key[MAXSTRING];
+    size_t               rec;
+    size_t               force_rec0;
+    size_t               force_nrecs;
+    size_t               Nveg_type;
+    int                  cellnum;
+    int                  startrec;
+    int                  ErrorFlag;
+    int                  n;
+    size_t               streamnum;
+    dmy_struct          *dmy;
+    force_data_struct   *force;
+    veg_hist_struct    **veg_hist;
+    veg_con_struct      *veg_con;
+    soil_con_struct      soil_con;
+    all_vars_struct      all_vars;
+    lake_con_struct      lake_con;
+    stream_struct       *streams = NULL;
+    double            ***out_data;   // [1, nvars, nelem]
+    save_data_struct     save_data;
+    journal_entry_struct journal_entry;
+    long                 soil_offset;
+    timer_struct         global_timers[N_TIMERS];
+    timer_struct         cell_timer;
 
     // start vic all timer
     timer_start(&(global_timers[TIMER_VIC_ALL]));
@@ -117,6 +122,11 @@ main(int   argc,
     // Check that model parameters are valid
     validate_parameters();
 
+    /** Build the blowing snow table before any grid cell runs **/
+    if (options.BLOWING && !options.BLOWING_SIMPLE && options.BLOWING_TABLE) {
+        init_blowing_table();
+    }
+
     /** Make Date Data Structure **/
     initialize_time();
     dmy = make_dmy(&global_param);
@@ -138,8 +148,16 @@ main(int   argc,
     /** Initialize Parameters **/
     cellnum = -1;
 
-    /** allocate memory for the force_data_struct **/
-    alloc_atmos(global_param.nrecs, &force);
+    /** allocate memory for the force_data_struct, holding at most
+        FORCE_WINDOW days of records at a time **/
+    force_nrecs = global_param.nrecs;
+    if (global_param.force_window > 0 &&
+        global_param.force_window * global_param.model_steps_per_day <
+        global_param.nrecs) {
+        force_nrecs = global_param.force_window *
+                      global_param.model_steps_per_day;
+    }
+    alloc_atmos(force_nrecs, &force);
 
     /** Initial state **/
     startrec = 0;
@@ -149,11 +167,36 @@ main(int   argc,
                                             &startrec);
     }
 
+    /** Skip grid cells completed by an earlier run of this simulation **/
+    RESUME = false;
+    if (strcmp(filenames.journal, "MISSING") != 0) {
+        RESUME = read_cell_journal(filenames.journal, &journal_entry);
+        if (RESUME) {
+            if (fseek(filep.soilparam, journal_entry.soil_offset,
+                      SEEK_SET) != 0) {
+                log_err("Unable to seek past completed grid cells in soil "
+                        "file %s", filenames.soil);
+            }
+            cellnum = journal_entry.cellnum;
+            log_info("Resuming simulation after grid cell %u (%d grid "
+                     "cells completed according to %s)",
+                     journal_entry.gridcel, journal_entry.cellnum + 1,
+                     filenames.journal);
+        }
+        filep.journal = open_cell_journal(filenames.journal);
+    }
+
     /** open state file if model state is to be saved **/
     if (options.SAVE_STATE && strcmp(filenames.statefile, "NONE") != 0) {
-        filep.statefile = open_state_file(&global_param, filenames,
-                                          options.Nlayer,
-                                          options.Nnode);
+        if (RESUME && journal_entry.state_offset > 0) {
+            filep.statefile = reopen_state_file(filenames,
+                                                journal_entry.state_offset);
+        }
+        else {
+            filep.statefile = open_state_file(&global_param, filenames,
+                                              options.Nlayer,
+                                              options.Nnode);
+        }
     }
     else {
         filep.statefile = NULL;
@@ -166,11 +209,17 @@ main(int   argc,
 
     // stop init timer
     timer_stop(&(global_timers[TIMER_VIC_INIT]));
+    // start phase timers
+    initialize_phase_timers(options.PHASE_TIMERS);
+    if (strcmp(filenames.timing_trace, "MISSING") != 0) {
+        open_phase_trace(filenames.timing_trace, "gridcell");
+    }
     // start vic run timer
     timer_start(&(global_timers[TIMER_VIC_RUN]));
 
     while (!MODEL_DONE) {
         read_soilparam(filep.soilparam, &soil_con, &RUN_MODEL, &MODEL_DONE);
+        soil_offset = ftell(filep.soilparam);
 
         if (RUN_MODEL) {
             cellnum++;
@@ -182,7 +231,7 @@ main(int   argc,
 
             if (options.LAKES) {
                 lake_con =
-                    read_lakeparam(filep.lakeparam, soil_con, veg_con);
+                    read_lakeparam(filep.lakeparam, &soil_con, veg_con);
             }
 
             /** Build Gridded Filenames, and Open **/
@@ -206,7 +255,7 @@ main(int   argc,
             all_vars = make_all_vars(veg_con[0].vegetat_type_num);
 
             /** allocate memory for the veg_hist_struct **/
-            alloc_veg_hist(global_param.nrecs, veg_con[0].vegetat_type_num,
+            alloc_veg_hist(force_nrecs, veg_con[0].vegetat_type_num,
                            &veg_hist);
 
             /**************************************************
@@ -214,14 +263,18 @@ main(int   argc,
                Have not Been Specifically Set
             **************************************************/
 
-            vic_force(force, dmy, filep.forcing, veg_con, veg_hist, &soil_con);
+            force_rec0 = 0;
+            phase_timer_start(PHASE_FORCE);
+            vic_force(force, dmy, filep.forcing, veg_con, veg_hist, &soil_con,
+                      force_rec0, force_nrecs);
+            phase_timer_stop(PHASE_FORCE);
 
             /**************************************************
                Initialize Energy Balance and Snow Variables
             **************************************************/
 
             vic_populate_model_state(&all_vars, filep, soil_con.gridcel,
-                                     &soil_con, veg_con, lake_con);
+                                     &soil_con, veg_con, &lake_con);
 
             /** Initialize the storage terms in the water and energy balances **/
             initialize_save_data(&all_vars, &force[0], &soil_con, veg_con,
@@ -233,41 +286,61 @@ main(int   argc,
             ******************************************/
 
             for (rec = startrec; rec < global_param.nrecs; rec++) {
-                // Set global reference string (for debugging inside vic_run)
-                sprint_dmy(dmy_str, &(dmy[rec]));
-                sprintf(vic_run_ref_str,
-                        "Gridcell cellnum: %i, timestep info: %s",
-                        cellnum, dmy_str);
+                // Set run context (for diagnostics inside vic_run)
+                set_run_context((size_t) soil_con.gridcel, rec, &(dmy[rec]));
+
+                /**************************************************
+                   Read the next forcing window once the current one
+                   has been used up
+                **************************************************/
+                while (rec >= force_rec0 + force_nrecs) {
+                    force_rec0 += force_nrecs;
+                    phase_timer_start(PHASE_FORCE);
+                    vic_force(force, dmy, filep.forcing, veg_con, veg_hist,
+                              &soil_con, force_rec0,
+                              min(force_nrecs,
+                                  global_param.nrecs - force_rec0));
+                    phase_timer_stop(PHASE_FORCE);
+                }
 
                 /**************************************************
                    Update data structures for current time step
                 **************************************************/
+                phase_timer_start(PHASE_UPDATE_STEP_VARS);
                 ErrorFlag = update_step_vars(&all_vars, veg_con,
-                                             veg_hist[rec]);
+                                             veg_hist[rec - force_rec0]);
+                phase_timer_stop(PHASE_UPDATE_STEP_VARS);
 
                 /**************************************************
                    Compute cell physics for 1 timestep
                 **************************************************/
                 timer_start(&cell_timer);
-                ErrorFlag = vic_run(&force[rec], &all_vars,
+                ErrorFlag = vic_run(&force[rec - force_rec0], &all_vars,
                                     &(dmy[rec]), &global_param, &lake_con,
                                     &soil_con, veg_con, veg_lib);
                 timer_stop(&cell_timer);
+                phase_timer_add(PHASE_VIC_RUN, &cell_timer);
 
                 /**************************************************
                    Calculate cell average values for current time step
                 **************************************************/
-                put_data(&all_vars, &force[rec], &soil_con, veg_con, veg_lib,
-                         &lake_con, out_data[0], &save_data, &cell_timer);
+                phase_timer_start(PHASE_PUT_DATA);
+                put_data(&all_vars, &force[rec - force_rec0], &soil_con,
+                         veg_con, veg_lib, &lake_con, out_data[0], &save_data,
+                         &cell_timer);
+                phase_timer_stop(PHASE_PUT_DATA);
 
+                phase_timer_start(PHASE_AGG_DATA);
                 for (streamnum = 0;
                      streamnum < options.Noutstreams;
                      streamnum++) {
                     agg_stream_data(&(streams[streamnum]), &(dmy[rec]),
                                     out_data);
                 }
+                phase_timer_stop(PHASE_AGG_DATA);
 
                 // Write cell average values for current time step
+                phase_timer_start(PHASE_OUTPUT);
                 write_output(&streams, &dmy[rec]);
 
                 /************************************
@@ -279,6 +352,7 @@ main(int   argc,
                     write_model_state(&all_vars, veg_con->vegetat_type_num,
                                       soil_con.gridcel, &filep, &soil_con);
                 }
+                phase_timer_stop(PHASE_OUTPUT);
 
 
                 if (ErrorFlag == ERROR) {
@@ -302,9 +376,24 @@ main(int   argc,
                 }
             } /* End Rec Loop */
 
-            close_files(&filep, &streams);
+            phase_timer_start(PHASE_OUTPUT);
+            close_files(&filep, &streams, &soil_con);
+            phase_timer_stop(PHASE_OUTPUT);
+
+            /** Record the time spent in each phase for this grid cell **/
+            sprintf(trace_key, "%i", soil_con.gridcel);
+            write_phase_trace(trace_key);
+
+            /** Record the completed grid cell in the journal **/
+            if (filep.journal != NULL) {
+                journal_entry.cellnum = cellnum;
+                journal_entry.gridcel = soil_con.gridcel;
+                journal_entry.soil_offset = soil_offset;
+                journal_entry.status = ErrorFlag;
+                write_cell_journal(&filep, &journal_entry);
+            }
 
-            free_veg_hist(global_param.nrecs, veg_con[0].vegetat_type_num,
+            free_veg_hist(force_nrecs, veg_con[0].vegetat_type_num,
                           &veg_hist);
             free_all_vars(&all_vars, veg_con[0].vegetat_type_num);
             free_vegcon(&veg_con);
@@ -318,11 +407,21 @@ main(int   argc,
 
     // stop vic run timer
     timer_stop(&(global_timers[TIMER_VIC_RUN]));
+    // close phase timer trace
+    close_phase_trace();
     // start vic final timer
     timer_start(&(global_timers[TIMER_VIC_FINAL]));
 
+    /** Sort the cell directories of the output containers **/
+    if (options.OUTPUT_CONTAINER) {
+        for (streamnum = 0; streamnum < (size_t) options.Noutstreams;
+             streamnum++) {
+            close_container(&(streams[streamnum]), filenames.result_dir);
+        }
+    }
+
     /** cleanup **/
-    free_atmos(global_param.nrecs, &force);
+    free_atmos(force_nrecs, &force);
     free_dmy(&dmy);
     free_streams(&streams);
     free_out_data(1, out_data);  // 1 is for the number of gridcells, 1 in classic driver
@@ -342,6 +441,10 @@ main(int   argc,
     if (options.SAVE_STATE && strcmp(filenames.statefile, "NONE") != 0) {
         fclose(filep.statefile);
     }
+    if (filep.journal != NULL) {
+        fclose(filep.journal);
+    }
+    free_scratch();
     finalize_logging();
 
     log_info("Completed running VIC %s", VIC_DRIVER);
@@ -26,6 +26,50 @@
 
 #include <vic_driver_classic.h>
 
+/******************************************************************************
+ * @brief    Write the wall time of the phase timers, as a breakdown of the
+ *           run time.  Phases that were never timed are left out, and the
+ *           run time that is not covered by any phase is shown as "other".
+ *****************************************************************************/
+static void
+write_phase_timing_table(double run_time,
+                         double ndays)
+{
+    extern FILE *LOG_DEST;
+
+    char         name[MAXSTRING];
+    double       phase_time;
+    double       other;
+    size_t       i;
+
+    fprintf(LOG_DEST, "  Phase Timing Table:\n");
+    fprintf(LOG_DEST,
+            "|----------------------|----------------------|----------------------|----------|\n");
+    fprintf(LOG_DEST,
+            "| Phase                | Wall Time (secs)     | Wall Time (secs/day) | %% of Run |\n");
+    fprintf(LOG_DEST,
+            "|----------------------|----------------------|----------------------|----------|\n");
+    other = run_time;
+    for (i = 0; i < N_PHASE_TIMERS; i++) {
+        phase_time = phase_timer_get(i);
+        if (phase_timer_parent(i) < 0) {
+            other -= phase_time;
+        }
+        if (phase_time > 0) {
+            sprintf(name, "%*s%s", (int) (2 * phase_timer_depth(i)), "",
+                    phase_timer_name(i));
+            fprintf(LOG_DEST, "| %-20s | %20g | %20g | %8.2f |\n", name,
+                    phase_time, phase_time / ndays,
+                    100. * phase_time / run_time);
+        }
+    }
+    fprintf(LOG_DEST, "| %-20s | %20g | %20g | %8.2f |\n", "other", other,
+            other / ndays, 100. * other / run_time);
+    fprintf(LOG_DEST,
+            "|----------------------|----------------------|----------------------|----------|\n");
+    fprintf(LOG_DEST, "\n");
+}
+
 /******************************************************************************
  * @brief    VIC timing file
  *****************************************************************************/
@@ -140,6 +184,10 @@ write_vic_timing_table(timer_struct *timers)
             "|------------|----------------------|----------------------|----------------------|----------------------|\n");
     fprintf(LOG_DEST, "\n");
 
+    if (phase_timers_enabled()) {
+        write_phase_timing_table(timers[TIMER_VIC_RUN].delta_wall, ndays);
+    }
+
     fprintf(LOG_DEST,
             "\n------------------------------"
             " END VIC TIMING PROFILE "
@@ -29,6 +29,11 @@
 
 /******************************************************************************
  * @brief    Initialize atmospheric variables for the model and snow time steps.
+ * @details  Fills force and veg_hist for the nrecs records starting at
+ *           simulation record rec_start.  A call with rec_start = 0 positions
+ *           the forcing files at the start of the simulation; subsequent
+ *           calls continue reading from the current file positions, so
+ *           windows must be requested in order.
  *****************************************************************************/
 void
 vic_force(force_data_struct *force,
@@ -36,7 +41,9 @@ vic_force(force_data_struct *force,
           FILE             **infile,
           veg_con_struct    *veg_con,
           veg_hist_struct  **veg_hist,
-          soil_con_struct   *soil_con)
+          soil_con_struct   *soil_con,
+          size_t             rec_start,
+          size_t             nrecs)
 {
     extern option_struct       options;
     extern param_set_struct    param_set;
@@ -106,7 +113,8 @@ vic_force(force_data_struct *force,
        read in meteorological data
     *******************************/
 
-    forcing_data = read_forcing_data(infile, global_param, &veg_hist_data);
+    forcing_data = read_forcing_data(infile, global_param, rec_start, nrecs,
+                                     &veg_hist_data);
 
     log_info("Read meteorological forcing file");
 
@@ -121,7 +129,7 @@ vic_force(force_data_struct *force,
         }
     }
 
-    for (rec = 0; rec < global_param.nrecs; rec++) {
+    for (rec = 0; rec < nrecs; rec++) {
         for (i = 0; i < NF; i++) {
             uidx = rec * NF + i;
             // temperature in Celsius
@@ -173,8 +181,8 @@ vic_force(force_data_struct *force,
                 force[rec].coszen[i] = compute_coszen(soil_con->lat,
                                                       soil_con->lng,
                                                       soil_con->time_zone_lng,
-                                                      dmy[rec].day_in_year,
-                                                      dmy[rec].dayseconds);
+                                                      dmy[rec_start + rec].day_in_year,
+                                                      dmy[rec_start + rec].dayseconds);
             }
         }
         if (NF > 1) {
@@ -206,7 +214,7 @@ vic_force(force_data_struct *force,
                 force[rec].coszen[NR] = compute_coszen(soil_con->lat,
                                                        soil_con->lng,
                                                        soil_con->time_zone_lng,
-                                                       dmy[rec].day_in_year,
+                                                       dmy[rec_start + rec].day_in_year,
                                                        SEC_PER_DAY / 2);
             }
         }
@@ -217,25 +225,25 @@ vic_force(force_data_struct *force,
     ****************************************************/
 
     /* First, assign default climatology */
-    for (rec = 0; rec < global_param.nrecs; rec++) {
+    for (rec = 0; rec < nrecs; rec++) {
         for (v = 0; v <= veg_con[0].vegetat_type_num; v++) {
             for (i = 0; i < NF; i++) {
                 veg_hist[rec][v].albedo[i] =
-                    veg_con[v].albedo[dmy[rec].month - 1];
+                    veg_con[v].albedo[dmy[rec_start + rec].month - 1];
                 veg_hist[rec][v].displacement[i] =
-                    veg_con[v].displacement[dmy[rec].month - 1];
+                    veg_con[v].displacement[dmy[rec_start + rec].month - 1];
                 veg_hist[rec][v].fcanopy[i] =
-                    veg_con[v].fcanopy[dmy[rec].month - 1];
+                    veg_con[v].fcanopy[dmy[rec_start + rec].month - 1];
                 veg_hist[rec][v].LAI[i] =
-                    veg_con[v].LAI[dmy[rec].month - 1];
+                    veg_con[v].LAI[dmy[rec_start + rec].month - 1];
                 veg_hist[rec][v].roughness[i] =
-                    veg_con[v].roughness[dmy[rec].month - 1];
+                    veg_con[v].roughness[dmy[rec_start + rec].month - 1];
             }
         }
     }
 
     /* Next, overwrite with veg_hist values, validate, and average */
-    for (rec = 0; rec < global_param.nrecs; rec++) {
+    for (rec = 0; rec < nrecs; rec++) {
         for (v = 0; v <= veg_con[0].vegetat_type_num; v++) {
             for (i = 0; i < NF; i++) {
                 uidx = rec * NF + i;
@@ -263,7 +271,8 @@ vic_force(force_data_struct *force,
                 // Check on fcanopy
                 if (veg_hist[rec][v].fcanopy[i] < MIN_FCANOPY) {
                     log_warn(
-                        "rec %zu, veg %zu substep %zu fcanopy %f < minimum of %f; setting = %f", rec, v, i,
+                        "rec %zu, veg %zu substep %zu fcanopy %f < minimum of %f; setting = %f",
+                        rec_start + rec, v, i,
                         veg_hist[rec][v].fcanopy[i], MIN_FCANOPY,
                         MIN_FCANOPY);
                     veg_hist[rec][v].fcanopy[i] = MIN_FCANOPY;
@@ -307,7 +316,7 @@ vic_force(force_data_struct *force,
        Compute treeline based on July average temperature
     ****************************************************/
 
-    if (options.COMPUTE_TREELINE) {
+    if (options.COMPUTE_TREELINE && rec_start == 0) {
         if (!(options.JULY_TAVG_SUPPLIED && avgJulyAirTemp == -999)) {
             compute_treeline(force, dmy, avgJulyAirTemp, Tfactor,
                              AboveTreeLine);
@@ -44,7 +44,7 @@ vic_populate_model_state(all_vars_struct *all_vars,
                          size_t           cellnum,
                          soil_con_struct *soil_con,
                          veg_con_struct  *veg_con,
-                         lake_con_struct  lake_con)
+                         lake_con_struct *lake_con)
 {
     extern option_struct options;
 
@@ -70,7 +70,7 @@ vic_populate_model_state(all_vars_struct *all_vars,
     initialize_snow(snow, Nveg);
     initialize_veg(veg_var, Nveg);
     if (options.LAKES) {
-        tmp_lake_idx = lake_con.lake_idx;
+        tmp_lake_idx = lake_con->lake_idx;
         if (tmp_lake_idx < 0) {
             tmp_lake_idx = 0;
         }
@@ -46,6 +46,8 @@ write_data(stream_struct *stream)
     int                   *tmp_iptr;
     float                 *tmp_fptr;
     double                *tmp_dptr;
+    char                  *bufptr;
+    int                    nchars;
 
     if (stream->file_format == BINARY) {
         n = N_OUTVAR_TYPES * options.Nlayer * options.SNOW_BAND;
@@ -151,22 +153,33 @@ write_data(stream_struct *stream)
         free((char *) tmp_dptr);
     }
     else if (stream->file_format == ASCII) {
+        // Records are formatted into the stream buffer, which is written to
+        // the file in large blocks by flush_output_buffer
+        if (stream->buffer == NULL) {
+            stream->buffer = malloc(ASCII_BUFFER_SIZE *
+                                    sizeof(*(stream->buffer)));
+            check_alloc_status(stream->buffer, "Memory allocation error.");
+            stream->buffer_len = 0;
+        }
+        if (ASCII_BUFFER_SIZE - stream->buffer_len < ASCII_FAST_MAX_LEN) {
+            flush_output_buffer(stream);
+        }
+
         // Write the date
+        bufptr = stream->buffer + stream->buffer_len;
+        bufptr += sprint_ascii_uint(bufptr, stream->time_bounds[0].year, 4);
+        *bufptr++ = '\t';
+        bufptr += sprint_ascii_uint(bufptr, stream->time_bounds[0].month, 2);
+        *bufptr++ = '\t';
+        bufptr += sprint_ascii_uint(bufptr, stream->time_bounds[0].day, 2);
+        *bufptr++ = '\t';
         if (stream->agg_alarm.is_subdaily) {
             // Write year, month, day, and sec
-            fprintf(stream->fh,
-                    "%04u\t%02hu\t%02hu\t%05u\t",
-                    stream->time_bounds[0].year, stream->time_bounds[0].month,
-                    stream->time_bounds[0].day,
-                    stream->time_bounds[0].dayseconds);
-        }
-        else {
-            // Only write year, month, and day
-            fprintf(stream->fh,
-                    "%04u\t%02hu\t%02hu\t",
-                    stream->time_bounds[0].year, stream->time_bounds[0].month,
-                    stream->time_bounds[0].day);
+            bufptr += sprint_ascii_uint(bufptr,
+                                        stream->time_bounds[0].dayseconds, 5);
+            *bufptr++ = '\t';
         }
+        stream->buffer_len = bufptr - stream->buffer;
 
         // Loop over this output file's data variables
         for (var_idx = 0; var_idx < stream->nvars; var_idx++) {
@@ -175,16 +188,69 @@ write_data(stream_struct *stream)
             for (elem_idx = 0; elem_idx < out_metadata[varid].nelem;
                  elem_idx++) {
                 if (!(var_idx == 0 && elem_idx == 0)) {
-                    fprintf(stream->fh, "\t ");
+                    if (ASCII_BUFFER_SIZE - stream->buffer_len < 2) {
+                        flush_output_buffer(stream);
+                    }
+                    stream->buffer[stream->buffer_len++] = '\t';
+                    stream->buffer[stream->buffer_len++] = ' ';
+                }
+                nchars = sprint_ascii_value(
+                    stream->buffer + stream->buffer_len,
+                    ASCII_BUFFER_SIZE - stream->buffer_len,
+                    stream->format[var_idx],
+                    &(stream->ascii_format[var_idx]),
+                    stream->aggdata[0][var_idx][elem_idx][0]);
+                if (nchars < 0) {
+                    log_err("Error formatting %s for output",
+                            out_metadata[varid].varname);
+                }
+                else if ((size_t) nchars >=
+                         ASCII_BUFFER_SIZE - stream->buffer_len) {
+                    // did not fit in the remaining buffer space
+                    flush_output_buffer(stream);
+                    if ((size_t) nchars < ASCII_BUFFER_SIZE) {
+                        nchars = sprint_ascii_value(
+                            stream->buffer, ASCII_BUFFER_SIZE,
+                            stream->format[var_idx],
+                            &(stream->ascii_format[var_idx]),
+                            stream->aggdata[0][var_idx][elem_idx][0]);
+                    }
+                    else {
+                        fprintf(stream->fh, stream->format[var_idx],
+                                stream->aggdata[0][var_idx][elem_idx][0]);
+                        nchars = 0;
+                    }
                 }
-                fprintf(stream->fh,
-                        stream->format[var_idx],
-                        stream->aggdata[0][var_idx][elem_idx][0]);
+                stream->buffer_len += nchars;
             }
         }
-        fprintf(stream->fh, "\n");
+        if (stream->buffer_len == ASCII_BUFFER_SIZE) {
+            flush_output_buffer(stream);
+        }
+        stream->buffer[stream->buffer_len++] = '\n';
     }
     else {
         log_err("Unrecognized OUT_FORMAT option");
     }
 }
+
+/******************************************************************************
+ * @brief    Write the formatted records held in the stream buffer to the
+ *           stream's output file.
+ *****************************************************************************/
+void
+flush_output_buffer(stream_struct *stream)
+{
+    size_t nwritten;
+
+    if (stream->buffer == NULL || stream->buffer_len == 0) {
+        return;
+    }
+
+    nwritten = fwrite(stream->buffer, sizeof(*(stream->buffer)),
+                      stream->buffer_len, stream->fh);
+    if (nwritten != stream->buffer_len) {
+        log_err("Error writing to output file %s", stream->filename);
+    }
+    stream->buffer_len = 0;
+}
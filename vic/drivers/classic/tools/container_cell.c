@@ -0,0 +1,173 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Extract the block of one grid cell from an output container
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_classic.h>
+
+// global variables
+int                 flag;
+size_t              NR; /* array index for atmos struct that indicates
+                           the model step avarage or sum */
+size_t              NF; /* array index loop counter limit for atmos
+                           struct that indicates the SNOW_STEP values */
+
+global_param_struct global_param;
+veg_lib_struct     *veg_lib;
+option_struct       options;
+Error_struct        Error;
+param_set_struct    param_set;
+parameters_struct   param;
+filenames_struct    filenames;
+filep_struct        filep;
+metadata_struct     out_metadata[N_OUTVAR_TYPES];
+
+static char         container_cell_optstring[] = "c:o:h";
+
+/******************************************************************************
+ * @brief    Print the usage of the container reader.
+ *****************************************************************************/
+static void
+print_container_cell_usage(char *executable)
+{
+    fprintf(stdout,
+            "Usage: %s -c <gridcell> [-o <output_file>] <container_file>\n",
+            executable);
+    fprintf(stdout,
+            "  c: number of the grid cell in the soil parameter file.\n");
+    fprintf(stdout,
+            "  o: write the block of the cell to <output_file> "
+            "(default: standard output).\n");
+    fprintf(stdout,
+            "  <container_file> is <prefix>_container.<txt|bin>[.gz]; the "
+            "cell directory\n  <prefix>_container.idx is read from the same "
+            "directory.\n");
+}
+
+/******************************************************************************
+ * @brief    Extract the block of one grid cell from an output container
+ * @details  Looks the cell up in the cell directory of the container with
+ *           find_container_cell() and copies its most recent block, which
+ *           holds exactly what the per-cell output file of the stream would
+ *           have held, to the output file.
+ *****************************************************************************/
+int
+main(int   argc,
+     char *argv[])
+{
+    char                   dataname[MAXSTRING];
+    char                   dirname[MAXSTRING];
+    char                   outname[MAXSTRING];
+    char                  *buf;
+    char                  *suffix;
+    int                    optchar;
+    long                   cellid;
+    size_t                 n;
+    unsigned long long     nbytes;
+    container_entry_struct entry;
+    FILE                  *data;
+    FILE                  *out;
+
+    initialize_log();
+
+    cellid = -1;
+    outname[0] = '\0';
+    while ((optchar = getopt(argc, argv, container_cell_optstring)) != EOF) {
+        switch ((char)optchar) {
+        case 'c':
+            cellid = atol(optarg);
+            break;
+        case 'o':
+            strncpy(outname, optarg, MAXSTRING - 1);
+            outname[MAXSTRING - 1] = '\0';
+            break;
+        default:
+            print_container_cell_usage(argv[0]);
+            exit(EXIT_FAILURE);
+            break;
+        }
+    }
+    if (cellid < 0 || optind != argc - 1) {
+        print_container_cell_usage(argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    // The cell directory is <prefix>_container.idx next to the container
+    strncpy(dataname, argv[optind], MAXSTRING - 1);
+    dataname[MAXSTRING - 1] = '\0';
+    strcpy(dirname, dataname);
+    suffix = strstr(dirname, "_container.");
+    if (suffix == NULL ||
+        strlen(dirname) - strlen(suffix) + strlen("_container.idx") >=
+        MAXSTRING) {
+        log_err("%s is not named like an output container "
+                "(<prefix>_container.<txt|bin>[.gz])", dataname);
+    }
+    strcpy(suffix, "_container.idx");
+
+    if (!find_container_cell(dirname, (unsigned int) cellid, &entry)) {
+        log_err("Grid cell %ld is not in container directory %s", cellid,
+                dirname);
+    }
+
+    data = fopen(dataname, "rb");
+    if (data == NULL) {
+        log_err("Unable to open output container %s", dataname);
+    }
+    if (fseeko(data, (off_t) entry.offset, SEEK_SET) != 0) {
+        log_err("Unable to seek to byte %llu of output container %s",
+                entry.offset, dataname);
+    }
+    if (outname[0] != '\0') {
+        out = open_file(outname, "wb");
+    }
+    else {
+        out = stdout;
+    }
+
+    buf = malloc(CONTAINER_COPY_SIZE * sizeof(*buf));
+    check_alloc_status(buf, "Memory allocation error.");
+    nbytes = entry.nbytes;
+    while (nbytes > 0) {
+        n = nbytes < CONTAINER_COPY_SIZE ? (size_t) nbytes :
+            CONTAINER_COPY_SIZE;
+        if (fread(buf, 1, n, data) != n) {
+            log_err("Output container %s ends inside the block of grid "
+                    "cell %ld", dataname, cellid);
+        }
+        if (fwrite(buf, 1, n, out) != n) {
+            log_err("Error writing the block of grid cell %ld", cellid);
+        }
+        nbytes -= n;
+    }
+    free(buf);
+    fclose(data);
+    if (out != stdout) {
+        fclose(out);
+    }
+
+    finalize_logging();
+
+    return EXIT_SUCCESS;
+}
@@ -80,6 +80,7 @@ main(int    argc,
     int          status;
     timer_struct global_timers[N_TIMERS];
     char         state_filename[MAXSTRING];
+    char         trace_key[MAXSTRING];
 
     // start vic all timer
     timer_start(&(global_timers[TIMER_VIC_ALL]));
@@ -127,18 +128,27 @@ main(int    argc,
 
     // stop init timer
     timer_stop(&(global_timers[TIMER_VIC_INIT]));
+    // start phase timers
+    initialize_phase_timers(options.PHASE_TIMERS);
+    if (mpi_rank == VIC_MPI_ROOT &&
+        strcmp(filenames.timing_trace, "MISSING") != 0) {
+        open_phase_trace(filenames.timing_trace, "time");
+    }
     // start vic run timer
     timer_start(&(global_timers[TIMER_VIC_RUN]));
 
     // loop over all timesteps
     for (current = 0; current < global_param.nrecs; current++) {
         // read forcing data
+        phase_timer_start(PHASE_FORCE);
         vic_force();
+        phase_timer_stop(PHASE_FORCE);
 
         // run vic over the domain
         vic_image_run(&(dmy[current]));
 
         // Write history files
+        phase_timer_start(PHASE_OUTPUT);
         vic_write_output(&(dmy[current]));
 
         // Write state file
@@ -147,9 +157,23 @@ main(int    argc,
             vic_store(&(dmy[current]), state_filename);
             debug("finished storing state file: %s", state_filename)
         }
+        phase_timer_stop(PHASE_OUTPUT);
+
+        // Record the time spent in each phase for this timestep
+        if (mpi_rank == VIC_MPI_ROOT && options.PHASE_TIMERS) {
+            sprintf(trace_key, "%04hu-%02hu-%02hu-%05u", dmy[current].year,
+                    dmy[current].month, dmy[current].day,
+                    dmy[current].dayseconds);
+            write_phase_trace(trace_key);
+        }
     }
     // stop vic run timer
     timer_stop(&(global_timers[TIMER_VIC_RUN]));
+    // collect phase timers from all processes
+    if (options.PHASE_TIMERS) {
+        close_phase_trace();
+        reduce_phase_timers();
+    }
     // start vic final timer
     timer_start(&(global_timers[TIMER_VIC_FINAL]));
     // clean up
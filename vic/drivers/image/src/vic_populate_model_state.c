@@ -57,7 +57,7 @@ vic_populate_model_state(void)
             generate_default_state(&(all_vars[i]), &(soil_con[i]), veg_con[i]);
             if (options.LAKES) {
                 generate_default_lake_state(&(all_vars[i]), &(soil_con[i]),
-                                            lake_con[i]);
+                                            &(lake_con[i]));
             }
         }
     }
@@ -67,7 +67,7 @@ vic_populate_model_state(void)
         compute_derived_state_vars(&(all_vars[i]), &(soil_con[i]), veg_con[i]);
         if (options.LAKES) {
             compute_derived_lake_dimensions(&(all_vars[i].lake_var),
-                                            lake_con[i]);
+                                            &(lake_con[i]));
         }
     }
 }
@@ -106,21 +106,6 @@ def make_cffi_headers():
     '''Process the C headers such that CFFI can interpret them'''
 
     omissions = ['va_list',
-                 'error_print_atmos_energy_bal',
-                 'error_print_atmos_moist_bal',
-                 'error_print_canopy_energy_bal',
-                 'error_print_solve_T_profile',
-                 'error_print_surf_energy_bal',
-                 'ErrorPrintIcePackEnergyBalance',
-                 'ErrorPrintSnowPackEnergyBalance',
-                 'func_atmos_energy_bal',
-                 'func_atmos_moist_bal',
-                 'func_canopy_energy_bal',
-                 'func_surf_energy_bal',
-                 'IceEnergyBalance',
-                 'root_brent',
-                 'SnowPackEnergyBalance',
-                 'soil_thermal_eqn',
                  'zwtvmoist_zwt',
                  'zwtvmoist_moist']
 
@@ -255,6 +240,7 @@ ext_obj = ext_name + sysconfig.get_config_var('SO')
 ext_module = Extension(ext_name,
                        sources=sources,
                        include_dirs=includes,
+                       libraries=['z'],
                        extra_compile_args=['-std=c99',
                                            '-DLOG_LVL={0}'.format(log_level)])
 
@@ -106,6 +106,12 @@ display_current_settings(int mode)
 
     fprintf(LOG_DEST, "\n");
     fprintf(LOG_DEST, "Simulation Parameters:\n");
+    if (options.ADAPTIVE_SNOW_STEP) {
+        fprintf(LOG_DEST, "ADAPTIVE_SNOW_STEP\t\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "ADAPTIVE_SNOW_STEP\t\tFALSE\n");
+    }
     if (options.AERO_RESIST_CANSNOW == AR_406) {
         fprintf(LOG_DEST, "AERO_RESIST_CANSNOW\t\tAR_406\n");
     }
@@ -124,6 +130,12 @@ display_current_settings(int mode)
     else {
         fprintf(LOG_DEST, "BLOWING\t\t\tFALSE\n");
     }
+    if (options.BLOWING_TABLE) {
+        fprintf(LOG_DEST, "BLOWING_TABLE\t\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "BLOWING_TABLE\t\tFALSE\n");
+    }
     if (options.CLOSE_ENERGY) {
         fprintf(LOG_DEST, "CLOSE_ENERGY\t\t\tTRUE\n");
     }
@@ -154,6 +166,12 @@ display_current_settings(int mode)
     else {
         fprintf(LOG_DEST, "EXP_TRANS\t\tFALSE\n");
     }
+    if (options.FROZEN_NEWTON) {
+        fprintf(LOG_DEST, "FROZEN_NEWTON\t\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "FROZEN_NEWTON\t\tFALSE\n");
+    }
     if (options.FROZEN_SOIL) {
         fprintf(LOG_DEST, "FROZEN_SOIL\t\tTRUE\n");
     }
@@ -178,6 +196,12 @@ display_current_settings(int mode)
     else {
         fprintf(LOG_DEST, "IMPLICIT\t\tFALSE\n");
     }
+    if (options.ANALYTIC_JACOBIAN) {
+        fprintf(LOG_DEST, "ANALYTIC_JACOBIAN\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "ANALYTIC_JACOBIAN\tFALSE\n");
+    }
     if (options.NOFLUX) {
         fprintf(LOG_DEST, "NOFLUX\t\t\tTRUE\n");
     }
@@ -196,6 +220,12 @@ display_current_settings(int mode)
     else {
         fprintf(LOG_DEST, "QUICK_SOLVE\t\tFALSE\n");
     }
+    if (options.SECANT_SOLVE) {
+        fprintf(LOG_DEST, "SECANT_SOLVE\t\tTRUE\n");
+    }
+    else {
+        fprintf(LOG_DEST, "SECANT_SOLVE\t\tFALSE\n");
+    }
     if (options.SPATIAL_FROST) {
         fprintf(LOG_DEST, "SPATIAL_FROST\t\tTRUE\n");
         fprintf(LOG_DEST, "Nfrost\t\t%zu\n", options.Nfrost);
@@ -215,6 +245,12 @@ display_current_settings(int mode)
     else if (options.SNOW_DENSITY == DENS_SNTHRM) {
         fprintf(LOG_DEST, "SNOW_DENSITY\t\tDENS_SNTHRM\n");
     }
+    if (options.MATH_KERNELS == MATH_EXACT) {
+        fprintf(LOG_DEST, "MATH_KERNELS\t\tEXACT\n");
+    }
+    else if (options.MATH_KERNELS == MATH_FUSED) {
+        fprintf(LOG_DEST, "MATH_KERNELS\t\tFUSED\n");
+    }
     if (options.TFALLBACK) {
         fprintf(LOG_DEST, "TFALLBACK\t\tTRUE\n");
     }
@@ -37,11 +37,21 @@
 // Output compression setting
 #define COMPRESSION_LVL_UNSET -1
 #define COMPRESSION_LVL_DEFAULT 5
+#define GZIP_BUFFER_SIZE 131072  // zlib internal buffer size [bytes]
 
 // Default ouput values
 #define OUT_MULT_DEFAULT 0  // Why is this not 1?
 #define OUT_ASCII_FORMAT_DEFAULT "%.4f"
 
+// ASCII output formatting
+#define ASCII_FAST_MAX_PRECISION 9      // largest precision of fast formatter
+#define ASCII_FAST_MAX_WIDTH 32         // largest field width of fast formatter
+#define ASCII_FAST_MAX_LEN 64           // buffer space needed by fast formatter
+#define ASCII_FAST_MAX_SCALED 1e15      // largest |value| * 10^precision
+#define ASCII_FAST_TIE_TOL 4e-16        // relative distance to a rounding tie
+#define ASCII_UINT_MAX_DIGITS 20        // maximum digits of a formatted uint
+#define ASCII_BUFFER_SIZE 1048576       // size of ASCII output buffers [bytes]
+
 // Default snow band setting
 #define SNOW_BAND_TRUE_BUT_UNSET 99999
 
@@ -282,6 +292,11 @@ enum
     // Timing and Profiling Terms
     OUT_TIME_VICRUN_WALL, /**< Wall time spent inside vic_run [seconds] */
     OUT_TIME_VICRUN_CPU,  /**< Wall time spent inside vic_run [seconds] */
+    OUT_SOLVER_CALLS,     /**< solver calls, by call site [count] */
+    OUT_SOLVER_EVALS,     /**< solver residual evaluations or loop iterations, by call site [count] */
+    OUT_SOLVER_EXPANSIONS, /**< root bracket expansions, by call site [count] */
+    OUT_SOLVER_FALLBACKS, /**< solves handed to a fallback method, by call site [count] */
+    OUT_SOLVER_MAXITER,   /**< solves stopped by an iteration limit, by call site [count] */
     // Last value of enum - DO NOT ADD ANYTHING BELOW THIS LINE!!
     // used as a loop counter and must be >= the largest value in this enum
     N_OUTVAR_TYPES        /**< used as a loop counter*/
@@ -454,6 +469,26 @@ enum timers
     N_TIMERS
 };
 
+/******************************************************************************
+ * @brief   Codes for phase timers.  FORCE_READ and FORCE_SCATTER are nested
+ *          in FORCE, OUTPUT_GATHER and OUTPUT_WRITE in OUTPUT; all other
+ *          phases are nested in TIMER_VIC_RUN.
+ *****************************************************************************/
+enum phase_timers
+{
+    PHASE_FORCE,
+    PHASE_FORCE_READ,
+    PHASE_FORCE_SCATTER,
+    PHASE_UPDATE_STEP_VARS,
+    PHASE_VIC_RUN,
+    PHASE_PUT_DATA,
+    PHASE_AGG_DATA,
+    PHASE_OUTPUT,
+    PHASE_OUTPUT_GATHER,
+    PHASE_OUTPUT_WRITE,
+    N_PHASE_TIMERS
+};
+
 /******************************************************************************
  * @brief    Stores forcing file input information.
  *****************************************************************************/
@@ -494,6 +529,16 @@ typedef struct {
     bool is_subdaily;    /**< flag denoting if alarm will be raised more than once per day */
 } alarm_struct;
 
+/******************************************************************************
+ * @brief   This structure stores a parsed ASCII output format.
+ *****************************************************************************/
+typedef struct {
+    bool fixed;     /**< true if format is "%[width].[precision]f" and can be
+                         written by the fast formatter */
+    int width;      /**< minimum field width */
+    int precision;  /**< number of digits after the decimal point */
+} ascii_format_struct;
+
 /******************************************************************************
  * @brief   This structure stores output information for one output stream.
  *****************************************************************************/
@@ -513,6 +558,13 @@ typedef struct {
                                           OUT_TYPE_DOUBLE = double precision floating point */
     double *mult;                    /**< multiplier, when written to a binary file [shape=(nvars, )] */
     char **format;                    /**< format, when written to disk [shape=(nvars, )] */
+    ascii_format_struct *ascii_format; /**< parsed format, used by the ASCII writer [shape=(nvars, )] */
+    char *buffer;                    /**< buffer of formatted ASCII records not yet written to fh */
+    size_t buffer_len;               /**< number of bytes used in buffer */
+    char *container_buf;             /**< current grid cell's records, held in
+                                          memory until they are appended to the
+                                          stream's output container */
+    size_t container_len;            /**< number of bytes in container_buf */
     unsigned int *varid;             /**< id numbers of the variables to store in the file
                                           (a variable's id number is its index in the out_data array).
                                           The order of the id numbers in the varid array
@@ -597,14 +649,15 @@ void collect_wb_terms(cell_data_struct, veg_var_struct, snow_data_struct,
                       double **);
 void compute_derived_state_vars(all_vars_struct *, soil_con_struct *,
                                 veg_con_struct *);
-void compute_lake_params(lake_con_struct *, soil_con_struct);
+void compute_lake_params(lake_con_struct *, soil_con_struct *);
 void compute_treeline(force_data_struct *, dmy_struct *, double, double *,
                       bool *);
 size_t count_force_vars(FILE *gp);
 void count_nstreams_nvars(FILE *gp, size_t *nstreams, size_t nvars[]);
+void close_phase_trace(void);
 void cmd_proc(int argc, char **argv, char *globalfilename);
-void compress_files(char string[], short int level);
 stream_struct create_outstream(stream_struct *output_streams);
+int get_compression_level(short int level);
 double get_cpu_time();
 void get_current_datetime(char *cdt);
 double get_wall_time();
@@ -628,7 +681,7 @@ void free_vegcon(veg_con_struct **veg_con);
 void generate_default_state(all_vars_struct *, soil_con_struct *,
                             veg_con_struct *);
 void generate_default_lake_state(all_vars_struct *, soil_con_struct *,
-                                 lake_con_struct);
+                                 lake_con_struct *);
 void get_default_nstreams_nvars(size_t *nstreams, size_t nvars[]);
 void get_parameters(FILE *paramfile);
 void init_output_list(double **out_data, int write, char *format, int type,
@@ -636,6 +689,7 @@ void init_output_list(double **out_data, int write, char *format, int type,
 void initialize_energy(energy_bal_struct **energy, size_t nveg);
 void initialize_global(void);
 void initialize_options(void);
+void initialize_phase_timers(bool enabled);
 void initialize_parameters(void);
 void initialize_save_data(all_vars_struct *all_vars, force_data_struct *force,
                           soil_con_struct *soil_con, veg_con_struct *veg_con,
@@ -660,7 +714,18 @@ double no_leap_day_from_dmy(dmy_struct *dmy);
 void num2date(double origin, double time_value, double tzoffset,
               unsigned short int calendar, unsigned short int time_units,
               dmy_struct *date);
+FILE *open_compressed_file(char string[], char type[], short int level);
 FILE *open_file(char string[], char type[]);
+void open_phase_trace(char *filename, char *key_name);
+void parse_ascii_format(char *format, ascii_format_struct *fmt);
+void phase_timer_add(size_t phase, timer_struct *t);
+double phase_timer_get(size_t phase);
+size_t phase_timer_depth(size_t phase);
+char *phase_timer_name(size_t phase);
+int phase_timer_parent(size_t phase);
+void phase_timer_start(size_t phase);
+void phase_timer_stop(size_t phase);
+bool phase_timers_enabled(void);
 void parse_nc_time_units(char *nc_unit_chars, unsigned short int *units,
                          dmy_struct *dmy);
 void put_data(all_vars_struct *, force_data_struct *, soil_con_struct *,
@@ -711,6 +776,9 @@ void set_output_defaults(stream_struct **output_streams,
 void set_output_met_data_info();
 void setup_stream(stream_struct *stream, size_t nvars, size_t ngridcells);
 void soil_moisture_from_water_table(soil_con_struct *soil_con, size_t nlayers);
+size_t sprint_ascii_uint(char *str, unsigned int value, size_t ndigits);
+int sprint_ascii_value(char *str, size_t size, char *format,
+                       ascii_format_struct *fmt, double value);
 void sprint_dmy(char *str, dmy_struct *dmy);
 void str_from_calendar(unsigned short int calendar, char *calendar_str);
 void str_from_time_units(unsigned short int time_units, char *unit_str);
@@ -732,6 +800,7 @@ int update_step_vars(all_vars_struct *, veg_con_struct *, veg_hist_struct *);
 int invalid_date(unsigned short int calendar, dmy_struct *dmy);
 void validate_parameters(void);
 void validate_streams(stream_struct **stream);
+void write_phase_trace(char *key);
 char will_it_snow(double *t, double t_offset, double max_snow_temp,
                   double *prcp, size_t n);
 void zero_output_list(double **);
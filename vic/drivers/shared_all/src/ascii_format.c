@@ -0,0 +1,204 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Fast formatting of ASCII output values.  Output formats of the form
+ * "%[width].[precision]f" are formatted without going through printf; every
+ * other format (and any value the fast path cannot reproduce exactly) falls
+ * back to snprintf, so the text written is identical to fprintf.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_shared_all.h>
+
+static const double ascii_pow10[ASCII_FAST_MAX_PRECISION + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+};
+
+/******************************************************************************
+ * @brief    Parse an ASCII output format and determine whether it can be
+ *           handled by the fast fixed-point formatter.
+ *****************************************************************************/
+void
+parse_ascii_format(char                *format,
+                   ascii_format_struct *fmt)
+{
+    char *c = format;
+    int   width = 0;
+    int   precision = 6;
+
+    fmt->fixed = false;
+    fmt->width = 0;
+    fmt->precision = 0;
+
+    // only a single conversion with no flags, text or length modifiers
+    // other than 'l' is accepted: %[width][.precision][l]f
+    if (*c++ != '%') {
+        return;
+    }
+    while (*c >= '0' && *c <= '9') {
+        if (c == format + 1 && *c == '0') {
+            // zero padding flag
+            return;
+        }
+        width = width * 10 + (*c++ - '0');
+    }
+    if (*c == '.') {
+        c++;
+        precision = 0;
+        while (*c >= '0' && *c <= '9') {
+            precision = precision * 10 + (*c++ - '0');
+        }
+    }
+    if (*c == 'l') {
+        c++;
+    }
+    if (*c++ != 'f' || *c != '\0') {
+        return;
+    }
+    if (precision > ASCII_FAST_MAX_PRECISION || width > ASCII_FAST_MAX_WIDTH) {
+        return;
+    }
+
+    fmt->fixed = true;
+    fmt->width = width;
+    fmt->precision = precision;
+}
+
+/******************************************************************************
+ * @brief    Write an unsigned integer, zero padded to ndigits, to str.
+ * @return   number of characters written (no terminating null is written)
+ *****************************************************************************/
+size_t
+sprint_ascii_uint(char        *str,
+                  unsigned int value,
+                  size_t       ndigits)
+{
+    char   tmp[ASCII_UINT_MAX_DIGITS];
+    size_t n = 0;
+    size_t i;
+
+    do {
+        tmp[n++] = (char) ('0' + value % 10);
+        value /= 10;
+    }
+    while (value > 0);
+    while (n < ndigits && n < ASCII_UINT_MAX_DIGITS) {
+        tmp[n++] = '0';
+    }
+    for (i = 0; i < n; i++) {
+        str[i] = tmp[n - 1 - i];
+    }
+
+    return n;
+}
+
+/******************************************************************************
+ * @brief    Format a single output value into str.
+ *
+ * @param    str    destination buffer
+ * @param    size   number of bytes available in str
+ * @param    format printf-style format of the value
+ * @param    fmt    parsed format (from parse_ascii_format)
+ * @param    value  value to format
+ * @return   number of characters that the formatted value requires
+ *           (excluding the terminating null).  If the return value is >= size
+ *           the output was truncated, as with snprintf.
+ *****************************************************************************/
+int
+sprint_ascii_value(char                *str,
+                   size_t               size,
+                   char                *format,
+                   ascii_format_struct *fmt,
+                   double               value)
+{
+    char               digits[ASCII_FAST_MAX_LEN];
+    double             scaled;
+    double             ipart;
+    double             frac;
+    unsigned long long n;
+    size_t             len;
+    size_t             nint;
+    size_t             pad;
+    size_t             i;
+    int                p;
+
+    if (!fmt->fixed || !isfinite(value) || size < ASCII_FAST_MAX_LEN) {
+        return snprintf(str, size, format, value);
+    }
+
+    p = fmt->precision;
+    scaled = fabs(value) * ascii_pow10[p];
+    if (scaled >= ASCII_FAST_MAX_SCALED) {
+        return snprintf(str, size, format, value);
+    }
+    ipart = floor(scaled);
+    frac = scaled - ipart;
+    // printf rounds the exact binary value; if the scaled value is too close
+    // to a rounding tie to be sure of the rounding direction, let printf
+    // decide
+    if (fabs(frac - 0.5) <= ASCII_FAST_TIE_TOL * (scaled + 1.)) {
+        return snprintf(str, size, format, value);
+    }
+    n = (unsigned long long) ipart;
+    if (frac > 0.5) {
+        n++;
+    }
+
+    // digits of the rounded value, least significant first
+    len = 0;
+    for (i = 0; i < (size_t) p; i++) {
+        digits[len++] = (char) ('0' + n % 10);
+        n /= 10;
+    }
+    nint = 0;
+    do {
+        digits[len++] = (char) ('0' + n % 10);
+        n /= 10;
+        nint++;
+    }
+    while (n > 0);
+
+    // total length: sign, integer digits, decimal point, fraction digits
+    len = nint + (p > 0 ? (size_t) p + 1 : 0) + (signbit(value) ? 1 : 0);
+    pad = (fmt->width > 0 && (size_t) fmt->width > len) ?
+          (size_t) fmt->width - len : 0;
+
+    i = 0;
+    while (i < pad) {
+        str[i++] = ' ';
+    }
+    if (signbit(value)) {
+        str[i++] = '-';
+    }
+    while (nint > 0) {
+        str[i++] = digits[p + --nint];
+    }
+    if (p > 0) {
+        str[i++] = '.';
+        while (p > 0) {
+            str[i++] = digits[--p];
+        }
+    }
+    str[i] = '\0';
+
+    return (int) i;
+}
@@ -33,7 +33,7 @@
 ******************************************************************************/
 void
 compute_lake_params(lake_con_struct *lake_con,
-                    soil_con_struct  soil_con)
+                    soil_con_struct *soil_con)
 {
     extern parameters_struct param;
     extern option_struct     options;
@@ -47,7 +47,7 @@ compute_lake_params(lake_con_struct *lake_con,
     // miscellaneous lake parameters
     lake_con->bpercent = lake_con->rpercent;
     lake_con->maxdepth = lake_con->z[0];
-    lake_con->basin[0] = lake_con->Cl[0] * soil_con.cell_area;
+    lake_con->basin[0] = lake_con->Cl[0] * soil_con->cell_area;
 
     if (!options.LAKE_PROFILE) {
         // generate lake depth-area relationship
@@ -63,7 +63,7 @@ compute_lake_params(lake_con_struct *lake_con,
                 pow(lake_con->z[i] / lake_con->maxdepth,
                     param.LAKE_BETA) * radius;
             lake_con->basin[i] = CONST_PI * x * x;
-            lake_con->Cl[i] = lake_con->basin[i] / soil_con.cell_area;
+            lake_con->Cl[i] = lake_con->basin[i] / soil_con->cell_area;
         }
     }
     else {
@@ -74,7 +74,7 @@ compute_lake_params(lake_con_struct *lake_con,
         // depth-area relationship specified (for area fractions)
         // compute basin node surface areas
         for (i = 1; i <= lake_con->numnod; i++) {
-            lake_con->basin[i] = lake_con->Cl[i] * soil_con.cell_area;
+            lake_con->basin[i] = lake_con->Cl[i] * soil_con->cell_area;
         }
     }
 
@@ -85,8 +85,11 @@ compute_lake_params(lake_con_struct *lake_con,
                                (lake_con->z[i - 1] - lake_con->z[i]) / 2.;
     }
 
+    // compute volume below each lake node
+    compute_lake_basin_volume(lake_con);
+
     // compute volume corresponding to mindepth
-    ErrFlag = get_volume(*lake_con, lake_con->mindepth, &(lake_con->minvolume));
+    ErrFlag = get_volume(lake_con, lake_con->mindepth, &(lake_con->minvolume));
     if (ErrFlag == ERROR) {
         log_err("Error calculating depth: depth %f volume %f",
                 lake_con->mindepth, lake_con->minvolume);
@@ -34,15 +34,15 @@
 void
 generate_default_lake_state(all_vars_struct *all_vars,
                             soil_con_struct *soil_con,
-                            lake_con_struct  lake_con)
+                            lake_con_struct *lake_con)
 {
     extern option_struct options;
 
     size_t               k;
 
-    lake_var_struct      lake;
+    lake_var_struct     *lake;
 
-    lake = all_vars->lake_var;
+    lake = &(all_vars->lake_var);
 
     /************************************************************************
        Initialize lake state variables
@@ -52,10 +52,10 @@ generate_default_lake_state(all_vars_struct *all_vars,
             want control over initial depth)
     ************************************************************************/
     if (options.LAKES) {
-        lake.ldepth = lake_con.depth_in;
-        for (k = 0; k < lake.activenod; k++) {
+        lake->ldepth = lake_con->depth_in;
+        for (k = 0; k < lake->activenod; k++) {
             // lake model requires FULL_ENERGY set to true
-            lake.temp[k] = soil_con->avg_temp;
+            lake->temp[k] = soil_con->avg_temp;
         }
     }
 }
@@ -477,6 +477,19 @@ get_parameters(FILE *paramfile)
             else if (strcasecmp("TOL_OVER", optstr) == 0) {
                 sscanf(cmdstr, "%*s %lf", &param.TOL_OVER);
             }
+            // Adaptive Snow Step Parameters
+            else if (strcasecmp("SNOW_STEP_MAX", optstr) == 0) {
+                sscanf(cmdstr, "%*s %d", &param.SNOW_STEP_MAX);
+            }
+            else if (strcasecmp("SNOW_STEP_SWE_TOL", optstr) == 0) {
+                sscanf(cmdstr, "%*s %lf", &param.SNOW_STEP_SWE_TOL);
+            }
+            else if (strcasecmp("SNOW_STEP_TSURF_TOL", optstr) == 0) {
+                sscanf(cmdstr, "%*s %lf", &param.SNOW_STEP_TSURF_TOL);
+            }
+            else if (strcasecmp("SNOW_STEP_FLUX_TOL", optstr) == 0) {
+                sscanf(cmdstr, "%*s %lf", &param.SNOW_STEP_FLUX_TOL);
+            }
             // Frozen Soil Parameters
             else if (strcasecmp("FROZEN_MAXITER", optstr) == 0) {
                 sscanf(cmdstr, "%*s %d", &param.FROZEN_MAXITER);
@@ -509,6 +522,9 @@ get_parameters(FILE *paramfile)
             else if (strcasecmp("NEWT_RAPH_EPS2", optstr) == 0) {
                 sscanf(cmdstr, "%*s %lf", &param.NEWT_RAPH_EPS2);
             }
+            else if (strcasecmp("NEWT_RAPH_JAC_REUSE", optstr) == 0) {
+                sscanf(cmdstr, "%*s %d", &param.NEWT_RAPH_JAC_REUSE);
+            }
             // Root-Brent parameters
             else if (strcasecmp("ROOT_BRENT_MAXTRIES", optstr) == 0) {
                 sscanf(cmdstr, "%*s %d", &param.ROOT_BRENT_MAXTRIES);
@@ -522,6 +538,13 @@ get_parameters(FILE *paramfile)
             else if (strcasecmp("ROOT_BRENT_T", optstr) == 0) {
                 sscanf(cmdstr, "%*s %lf", &param.ROOT_BRENT_T);
             }
+            // Root-Secant parameters
+            else if (strcasecmp("ROOT_SECANT_MAXITER", optstr) == 0) {
+                sscanf(cmdstr, "%*s %d", &param.ROOT_SECANT_MAXITER);
+            }
+            else if (strcasecmp("ROOT_SECANT_TSTEP", optstr) == 0) {
+                sscanf(cmdstr, "%*s %lf", &param.ROOT_SECANT_TSTEP);
+            }
             else {
                 log_warn("Unrecognized option in the parameter file:  %s "
                          "- check your spelling", optstr);
@@ -875,6 +898,23 @@ validate_parameters()
     if (!(param.TOL_OVER >= 0.)) {
         log_err("TOL_OVER must be defined on the interval [0, inf)");
     }
+    // Adaptive Snow Step Parameters
+    if (!(param.SNOW_STEP_MAX >= 1)) {
+        log_err("SNOW_STEP_MAX must be defined on the interval [1, inf) "
+                "(snow steps)");
+    }
+    if (!(param.SNOW_STEP_SWE_TOL > 0.)) {
+        log_err("SNOW_STEP_SWE_TOL must be defined on the interval (0, inf) "
+                "(m)");
+    }
+    if (!(param.SNOW_STEP_TSURF_TOL > 0.)) {
+        log_err("SNOW_STEP_TSURF_TOL must be defined on the interval (0, inf) "
+                "(C)");
+    }
+    if (!(param.SNOW_STEP_FLUX_TOL > 0.)) {
+        log_err("SNOW_STEP_FLUX_TOL must be defined on the interval (0, inf) "
+                "(W/m2)");
+    }
     // Frozen Soil Parameters
     if (!(param.FROZEN_MAXITER >= 0)) {
         log_err(
@@ -905,6 +945,10 @@ validate_parameters()
     if (!(param.NEWT_RAPH_EPS2 >= 0.)) {
         log_err("NEWT_RAPH_EPS2 must be defined on the interval [0, inf) (-)");
     }
+    if (!(param.NEWT_RAPH_JAC_REUSE >= 1)) {
+        log_err("NEWT_RAPH_JAC_REUSE must be defined on the interval [1, inf) "
+                "(iterations)");
+    }
     // Root-Brent parameters
     if (param.ROOT_BRENT_MAXTRIES < 0) {
         log_err("ROOT_BRENT_MAXTRIES must be defined on the interval [0, inf)");
@@ -918,4 +962,11 @@ validate_parameters()
     if (!(param.ROOT_BRENT_T >= 0.)) {
         log_err("ROOT_BRENT_T must be defined on the interval [0, inf)");
     }
+    // Root-Secant parameters
+    if (param.ROOT_SECANT_MAXITER < 0) {
+        log_err("ROOT_SECANT_MAXITER must be defined on the interval [0, inf)");
+    }
+    if (!(param.ROOT_SECANT_TSTEP > 0.)) {
+        log_err("ROOT_SECANT_TSTEP must be defined on the interval (0, inf)");
+    }
 }
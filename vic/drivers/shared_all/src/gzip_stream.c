@@ -0,0 +1,213 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * In-process gzip streams built on zlib.  A compressed file is exposed to the
+ * rest of the model as an ordinary stdio stream, so the forcing readers and
+ * output writers can read and write it directly without temporary copies or
+ * calls to an external gzip process.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_driver_shared_all.h>
+#include <zlib.h>
+
+/******************************************************************************
+ * @brief    Read callback for a gzip backed stdio stream.
+ *****************************************************************************/
+static ssize_t
+gz_stream_read(void  *cookie,
+               char  *buf,
+               size_t size)
+{
+    int nbytes;
+
+    nbytes = gzread((gzFile) cookie, buf, (unsigned int) size);
+
+    return (ssize_t) nbytes;
+}
+
+/******************************************************************************
+ * @brief    Write callback for a gzip backed stdio stream.
+ *****************************************************************************/
+static ssize_t
+gz_stream_write(void       *cookie,
+                const char *buf,
+                size_t      size)
+{
+    int nbytes;
+
+    nbytes = gzwrite((gzFile) cookie, buf, (unsigned int) size);
+    if (nbytes <= 0 && size > 0) {
+        return -1;
+    }
+
+    return (ssize_t) nbytes;
+}
+
+/******************************************************************************
+ * @brief    Close callback for a gzip backed stdio stream.
+ *****************************************************************************/
+static int
+gz_stream_close(void *cookie)
+{
+    if (gzclose((gzFile) cookie) != Z_OK) {
+        return EOF;
+    }
+
+    return 0;
+}
+
+#ifdef __APPLE__
+/******************************************************************************
+ * @brief    Seek callback for a gzip backed stdio stream (BSD funopen).
+ *****************************************************************************/
+static fpos_t
+gz_stream_seek(void  *cookie,
+               fpos_t offset,
+               int    whence)
+{
+    return (fpos_t) gzseek((gzFile) cookie, (z_off_t) offset, whence);
+}
+
+static int
+gz_stream_read_bsd(void *cookie,
+                   char *buf,
+                   int   size)
+{
+    return (int) gz_stream_read(cookie, buf, (size_t) size);
+}
+
+static int
+gz_stream_write_bsd(void       *cookie,
+                    const char *buf,
+                    int         size)
+{
+    return (int) gz_stream_write(cookie, buf, (size_t) size);
+}
+#else
+/******************************************************************************
+ * @brief    Seek callback for a gzip backed stdio stream (glibc fopencookie).
+ * @note     zlib only supports SEEK_SET and SEEK_CUR; seeking backwards in a
+ *           stream opened for reading restarts decompression from the
+ *           beginning of the file.
+ *****************************************************************************/
+static int
+gz_stream_seek(void    *cookie,
+               off64_t *offset,
+               int      whence)
+{
+    z_off_t pos;
+
+    pos = gzseek((gzFile) cookie, (z_off_t) *offset, whence);
+    if (pos < 0) {
+        return -1;
+    }
+    *offset = (off64_t) pos;
+
+    return 0;
+}
+#endif
+
+/******************************************************************************
+ * @brief    Translate a stream COMPRESS setting into a zlib compression level.
+ *
+ * @param    level COMPRESS setting; COMPRESSION_LVL_UNSET (TRUE) selects
+ *                 COMPRESSION_LVL_DEFAULT, otherwise an integer 1-9
+ * @return   zlib compression level
+ *****************************************************************************/
+int
+get_compression_level(short int level)
+{
+    if (level == COMPRESSION_LVL_UNSET) {
+        return COMPRESSION_LVL_DEFAULT;
+    }
+    else if (level < Z_BEST_SPEED || level > Z_BEST_COMPRESSION) {
+        log_err("Invalid compression level %hd for gzip, must be an integer "
+                "1-9", level);
+    }
+
+    return (int) level;
+}
+
+/******************************************************************************
+ * @brief    Open a gzip compressed file and associate a stdio stream with it.
+ *
+ * @param    string path to the compressed file
+ * @param    type   "r", "rb", "w" or "wb"
+ * @param    level  zlib compression level for writing (ignored for reading)
+ * @return   a pointer to the file structure associated with the stream, or
+ *           NULL if the file could not be opened.
+ *****************************************************************************/
+FILE *
+open_compressed_file(char      string[],
+                     char      type[],
+                     short int level)
+{
+    gzFile gzfh;
+    FILE  *stream;
+    char   gzmode[8];
+
+    if (type[0] == 'r') {
+        strcpy(gzmode, "rb");
+    }
+    else if (type[0] == 'w') {
+        sprintf(gzmode, "wb%d", get_compression_level(level));
+    }
+    else {
+        log_err("Compressed files can only be opened for reading or "
+                "writing, not with mode \"%s\": %s", type, string);
+    }
+
+    gzfh = gzopen(string, gzmode);
+    if (gzfh == NULL) {
+        return NULL;
+    }
+    // Use a larger internal buffer than the zlib default (8 KB) to reduce the
+    // number of read/write system calls
+    gzbuffer(gzfh, GZIP_BUFFER_SIZE);
+
+#ifdef __APPLE__
+    if (type[0] == 'r') {
+        stream = funopen(gzfh, gz_stream_read_bsd, NULL, gz_stream_seek,
+                         gz_stream_close);
+    }
+    else {
+        stream = funopen(gzfh, NULL, gz_stream_write_bsd, gz_stream_seek,
+                         gz_stream_close);
+    }
+#else
+    cookie_io_functions_t gz_funcs = {
+        .read = gz_stream_read,
+        .write = gz_stream_write,
+        .seek = gz_stream_seek,
+        .close = gz_stream_close
+    };
+    stream = fopencookie(gzfh, type, gz_funcs);
+#endif
+
+    if (stream == NULL) {
+        gzclose(gzfh);
+        log_err("Unable to create stream for compressed file %s", string);
+    }
+
+    return stream;
+}
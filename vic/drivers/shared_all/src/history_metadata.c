@@ -1476,6 +1476,54 @@ set_output_met_data_info()
     strcpy(out_metadata[OUT_TIME_VICRUN_CPU].description,
            "CPU time spent inside vic_run");
 
+    /* solver calls, by call site [count] */
+    strcpy(out_metadata[OUT_SOLVER_CALLS].varname, "OUT_SOLVER_CALLS");
+    strcpy(out_metadata[OUT_SOLVER_CALLS].long_name, "solver_calls");
+    strcpy(out_metadata[OUT_SOLVER_CALLS].standard_name,
+           "number_of_solver_calls");
+    strcpy(out_metadata[OUT_SOLVER_CALLS].units, "1");
+    strcpy(out_metadata[OUT_SOLVER_CALLS].description,
+           "Number of solver calls, by call site");
+
+    /* solver residual evaluations or loop iterations, by call site [count] */
+    strcpy(out_metadata[OUT_SOLVER_EVALS].varname, "OUT_SOLVER_EVALS");
+    strcpy(out_metadata[OUT_SOLVER_EVALS].long_name, "solver_evals");
+    strcpy(out_metadata[OUT_SOLVER_EVALS].standard_name,
+           "number_of_solver_evaluations");
+    strcpy(out_metadata[OUT_SOLVER_EVALS].units, "1");
+    strcpy(out_metadata[OUT_SOLVER_EVALS].description,
+           "Number of residual evaluations or iterations of the solvers, "
+           "by call site");
+
+    /* root bracket expansions, by call site [count] */
+    strcpy(out_metadata[OUT_SOLVER_EXPANSIONS].varname,
+           "OUT_SOLVER_EXPANSIONS");
+    strcpy(out_metadata[OUT_SOLVER_EXPANSIONS].long_name,
+           "solver_expansions");
+    strcpy(out_metadata[OUT_SOLVER_EXPANSIONS].standard_name,
+           "number_of_solver_bracket_expansions");
+    strcpy(out_metadata[OUT_SOLVER_EXPANSIONS].units, "1");
+    strcpy(out_metadata[OUT_SOLVER_EXPANSIONS].description,
+           "Number of expansions of the root bracket, by call site");
+
+    /* solves handed to a fallback method, by call site [count] */
+    strcpy(out_metadata[OUT_SOLVER_FALLBACKS].varname, "OUT_SOLVER_FALLBACKS");
+    strcpy(out_metadata[OUT_SOLVER_FALLBACKS].long_name, "solver_fallbacks");
+    strcpy(out_metadata[OUT_SOLVER_FALLBACKS].standard_name,
+           "number_of_solver_fallbacks");
+    strcpy(out_metadata[OUT_SOLVER_FALLBACKS].units, "1");
+    strcpy(out_metadata[OUT_SOLVER_FALLBACKS].description,
+           "Number of solves handed to a fallback method, by call site");
+
+    /* solves stopped by an iteration limit, by call site [count] */
+    strcpy(out_metadata[OUT_SOLVER_MAXITER].varname, "OUT_SOLVER_MAXITER");
+    strcpy(out_metadata[OUT_SOLVER_MAXITER].long_name, "solver_maxiter");
+    strcpy(out_metadata[OUT_SOLVER_MAXITER].standard_name,
+           "number_of_solver_iteration_limit_hits");
+    strcpy(out_metadata[OUT_SOLVER_MAXITER].units, "1");
+    strcpy(out_metadata[OUT_SOLVER_MAXITER].description,
+           "Number of solves stopped by an iteration limit, by call site");
+
     if (options.FROZEN_SOIL) {
         out_metadata[OUT_FDEPTH].nelem = MAX_FRONTS;
         out_metadata[OUT_TDEPTH].nelem = MAX_FRONTS;
@@ -1492,6 +1540,11 @@ set_output_met_data_info()
     out_metadata[OUT_SOIL_TNODE].nelem = options.Nnode;
     out_metadata[OUT_SOIL_TNODE_WL].nelem = options.Nnode;
     out_metadata[OUT_SOILT_FBFLAG].nelem = options.Nnode;
+    out_metadata[OUT_SOLVER_CALLS].nelem = N_SOLVER_SITES;
+    out_metadata[OUT_SOLVER_EVALS].nelem = N_SOLVER_SITES;
+    out_metadata[OUT_SOLVER_EXPANSIONS].nelem = N_SOLVER_SITES;
+    out_metadata[OUT_SOLVER_FALLBACKS].nelem = N_SOLVER_SITES;
+    out_metadata[OUT_SOLVER_MAXITER].nelem = N_SOLVER_SITES;
     out_metadata[OUT_ADV_SENS_BAND].nelem = options.SNOW_BAND;
     out_metadata[OUT_ADVECTION_BAND].nelem = options.SNOW_BAND;
     out_metadata[OUT_ALBEDO_BAND].nelem = options.SNOW_BAND;
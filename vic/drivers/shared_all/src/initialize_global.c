@@ -64,6 +64,7 @@ initialize_global()
         global_param.forceskip[i] = 0;
         global_param.forceoffset[i] = 0;
     }
+    global_param.force_window = 0;
     global_param.stateyear = 0;
     global_param.statemonth = 0;
     global_param.stateday = 0;
@@ -40,6 +40,7 @@ initialize_options()
 
     // simulation modes
     options.AboveTreelineVeg = -1;
+    options.ADAPTIVE_SNOW_STEP = false;
     options.AERO_RESIST_CANSNOW = AR_406_FULL;
     options.BLOWING = false;
     options.BLOWING_VAR_THRESHOLD = true;
@@ -47,6 +48,7 @@ initialize_options()
     options.BLOWING_SIMPLE = false;
     options.BLOWING_FETCH = true;
     options.BLOWING_SPATIAL_WIND = true;
+    options.BLOWING_TABLE = false;
     options.CARBON = false;
     options.CLOSE_ENERGY = false;
     options.COMPUTE_TREELINE = false;
@@ -54,15 +56,19 @@ initialize_options()
     options.CORRPREC = false;
     options.EQUAL_AREA = false;
     options.EXP_TRANS = true;
+    options.FROZEN_NEWTON = false;
     options.FROZEN_SOIL = false;
     options.FULL_ENERGY = false;
     options.GRND_FLUX_TYPE = GF_410;
     options.IMPLICIT = true;
+    options.ANALYTIC_JACOBIAN = false;
     options.LAKES = false;
+    options.MATH_KERNELS = MATH_EXACT;
     options.LAKE_PROFILE = false;
     options.NOFLUX = false;
     options.QUICK_FLUX = true;
     options.QUICK_SOLVE = false;
+    options.SECANT_SOLVE = false;
     options.RC_MODE = RC_JARVIS;
     options.SHARE_LAYER_MOIST = true;
     options.SNOW_DENSITY = DENS_BRAS;
@@ -95,4 +101,7 @@ initialize_options()
     options.SAVE_STATE = false;
     // output options
     options.Noutstreams = 2;
+    options.OUTPUT_CONTAINER = false;
+    // timing options
+    options.PHASE_TIMERS = false;
 }
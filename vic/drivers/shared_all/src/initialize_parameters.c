@@ -208,6 +208,12 @@ initialize_parameters()
     param.TOL_GRND = 0.001;
     param.TOL_OVER = 0.001;
 
+    // Adaptive Snow Step Parameters
+    param.SNOW_STEP_MAX = 6;
+    param.SNOW_STEP_SWE_TOL = 0.0005;
+    param.SNOW_STEP_TSURF_TOL = 1.0;
+    param.SNOW_STEP_FLUX_TOL = 10.0;
+
     // Frozen Soil Parameters
     param.FROZEN_MAXITER = 1000;
 
@@ -221,6 +227,7 @@ initialize_parameters()
     param.NEWT_RAPH_RELAX2 = 0.7;
     param.NEWT_RAPH_RELAX3 = 0.2;
     param.NEWT_RAPH_EPS2 = 1.0e-4;
+    param.NEWT_RAPH_JAC_REUSE = 1;
 
     // Root-Brent parameters
     param.ROOT_BRENT_MAXTRIES = 5;
@@ -228,6 +235,10 @@ initialize_parameters()
     param.ROOT_BRENT_TSTEP = 10;
     param.ROOT_BRENT_T = 1.0e-7;
 
+    // Root-Secant parameters
+    param.ROOT_SECANT_MAXITER = 20;
+    param.ROOT_SECANT_TSTEP = 0.1;
+
     // Frozen Soil Parameters
     param.FROZEN_MAXITER = 1000;
 }
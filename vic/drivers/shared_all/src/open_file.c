@@ -46,29 +46,20 @@ open_file(char string[],
 {
     FILE *stream;
     char  zipname[MAXSTRING],
-          command[MAXSTRING],
           jnkstr[MAXSTRING];
     int   temp, headcnt, i;
 
     stream = fopen(string, type);
 
-    if (stream == NULL) {
-        /** Check if file is compressed **/
+    if (stream == NULL && type[0] == 'r' && strchr(type, '+') == NULL) {
+        /** Check if file is compressed, and if so read it through an
+            in-process gzip stream (no temporary uncompressed copy) **/
         strcpy(zipname, string);
         strcat(zipname, ".gz");
-        stream = fopen(zipname, type);
-        if (stream == NULL) {
-            log_err("Unable to open File %s", string);
-        }
-        fclose(stream);
-
-        /** uncompress and open zipped file **/
-        sprintf(command, "gzip -d %s", zipname);
-        system(command);
-        stream = fopen(string, type);
-        if (stream == NULL) {
-            log_err("Unable to open File %s", string);
-        }
+        stream = open_compressed_file(zipname, type, COMPRESSION_LVL_UNSET);
+    }
+    if (stream == NULL) {
+        log_err("Unable to open File %s", string);
     }
 
     if (strcmp(type, "r") == 0) {
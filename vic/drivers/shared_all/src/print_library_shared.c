@@ -274,6 +274,7 @@ print_global_param(global_param_struct *gp)
         fprintf(LOG_DEST, "\tforceskip[%zd]      : %u\n", i, gp->forceskip[i]);
         fprintf(LOG_DEST, "\tforceyear[%zd]      : %hu\n", i, gp->forceyear[i]);
     }
+    fprintf(LOG_DEST, "\tforce_window        : %zu\n", gp->force_window);
     fprintf(LOG_DEST, "\tnrecs               : %zu\n", gp->nrecs);
     fprintf(LOG_DEST, "\tstartday            : %hu\n", gp->startday);
     fprintf(LOG_DEST, "\tstartsec            : %u\n", gp->startsec);
@@ -311,6 +312,11 @@ print_lake_con(lake_con_struct *lcon,
         fprintf(LOG_DEST, "\t%.4f", lcon->Cl[i]);
     }
     fprintf(LOG_DEST, "\n");
+    fprintf(LOG_DEST, "\tbasin_volume:");
+    for (i = 0; i < nlnodes; i++) {
+        fprintf(LOG_DEST, "\t%.4f", lcon->basin_volume[i]);
+    }
+    fprintf(LOG_DEST, "\n");
     fprintf(LOG_DEST, "\tb        : %.4f\n", lcon->b);
     fprintf(LOG_DEST, "\tmaxdepth : %.4f\n", lcon->maxdepth);
     fprintf(LOG_DEST, "\tmindepth : %.4f\n", lcon->mindepth);
@@ -432,6 +438,8 @@ print_option(option_struct *option)
     fprintf(LOG_DEST, "option:\n");
     fprintf(LOG_DEST, "\tAboveTreelineVeg     : %d\n",
             option->AboveTreelineVeg);
+    fprintf(LOG_DEST, "\tADAPTIVE_SNOW_STEP   : %d\n",
+            option->ADAPTIVE_SNOW_STEP);
     fprintf(LOG_DEST, "\tAERO_RESIST_CANSNOW  : %d\n",
             option->AERO_RESIST_CANSNOW);
     fprintf(LOG_DEST, "\tBLOWING              : %d\n", option->BLOWING);
@@ -443,6 +451,8 @@ print_option(option_struct *option)
     fprintf(LOG_DEST, "\tBLOWING_FETCH        : %d\n", option->BLOWING_FETCH);
     fprintf(LOG_DEST, "\tBLOWING_SPATIAL_WIND : %d\n",
             option->BLOWING_SPATIAL_WIND);
+    fprintf(LOG_DEST, "\tBLOWING_TABLE        : %d\n",
+            option->BLOWING_TABLE);
     fprintf(LOG_DEST, "\tCARBON               : %d\n", option->CARBON);
     fprintf(LOG_DEST, "\tCLOSE_ENERGY         : %d\n", option->CLOSE_ENERGY);
     fprintf(LOG_DEST, "\tCOMPUTE_TREELINE     : %d\n",
@@ -451,13 +461,17 @@ print_option(option_struct *option)
     fprintf(LOG_DEST, "\tCORRPREC             : %d\n", option->CORRPREC);
     fprintf(LOG_DEST, "\tEQUAL_AREA           : %d\n", option->EQUAL_AREA);
     fprintf(LOG_DEST, "\tEXP_TRANS            : %d\n", option->EXP_TRANS);
+    fprintf(LOG_DEST, "\tFROZEN_NEWTON        : %d\n", option->FROZEN_NEWTON);
     fprintf(LOG_DEST, "\tFROZEN_SOIL          : %d\n", option->FROZEN_SOIL);
     fprintf(LOG_DEST, "\tFULL_ENERGY          : %d\n", option->FULL_ENERGY);
     fprintf(LOG_DEST, "\tGRND_FLUX_TYPE       : %d\n", option->GRND_FLUX_TYPE);
     fprintf(LOG_DEST, "\tIMPLICIT             : %d\n", option->IMPLICIT);
+    fprintf(LOG_DEST, "\tANALYTIC_JACOBIAN    : %d\n",
+            option->ANALYTIC_JACOBIAN);
     fprintf(LOG_DEST, "\tJULY_TAVG_SUPPLIED   : %d\n",
             option->JULY_TAVG_SUPPLIED);
     fprintf(LOG_DEST, "\tLAKES                : %d\n", option->LAKES);
+    fprintf(LOG_DEST, "\tMATH_KERNELS         : %d\n", option->MATH_KERNELS);
     fprintf(LOG_DEST, "\tNcanopy              : %zu\n", option->Ncanopy);
     fprintf(LOG_DEST, "\tNfrost               : %zu\n", option->Nfrost);
     fprintf(LOG_DEST, "\tNlakenode            : %zu\n", option->Nlakenode);
@@ -469,6 +483,7 @@ print_option(option_struct *option)
     fprintf(LOG_DEST, "\tROOT_ZONES           : %zu\n", option->ROOT_ZONES);
     fprintf(LOG_DEST, "\tQUICK_FLUX           : %d\n", option->QUICK_FLUX);
     fprintf(LOG_DEST, "\tQUICK_SOLVE          : %d\n", option->QUICK_SOLVE);
+    fprintf(LOG_DEST, "\tSECANT_SOLVE         : %d\n", option->SECANT_SOLVE);
     fprintf(LOG_DEST, "\tSHARE_LAYER_MOIST    : %d\n",
             option->SHARE_LAYER_MOIST);
     fprintf(LOG_DEST, "\tSNOW_DENSITY         : %d\n", option->SNOW_DENSITY);
@@ -493,6 +508,9 @@ print_option(option_struct *option)
     fprintf(LOG_DEST, "\tINIT_STATE           : %d\n", option->INIT_STATE);
     fprintf(LOG_DEST, "\tSAVE_STATE           : %d\n", option->SAVE_STATE);
     fprintf(LOG_DEST, "\tNoutstreams          : %zu\n", option->Noutstreams);
+    fprintf(LOG_DEST, "\tOUTPUT_CONTAINER     : %d\n",
+            option->OUTPUT_CONTAINER);
+    fprintf(LOG_DEST, "\tPHASE_TIMERS         : %d\n", option->PHASE_TIMERS);
 }
 
 /******************************************************************************
@@ -768,6 +786,12 @@ print_parameters(parameters_struct *param)
     fprintf(LOG_DEST, "\tCANOPY_VP: %.4f\n", param->CANOPY_VP);
     fprintf(LOG_DEST, "\tTOL_GRND: %.4f\n", param->TOL_GRND);
     fprintf(LOG_DEST, "\tTOL_OVER: %.4f\n", param->TOL_OVER);
+    fprintf(LOG_DEST, "\tSNOW_STEP_MAX: %d\n", param->SNOW_STEP_MAX);
+    fprintf(LOG_DEST, "\tSNOW_STEP_SWE_TOL: %.4f\n", param->SNOW_STEP_SWE_TOL);
+    fprintf(LOG_DEST, "\tSNOW_STEP_TSURF_TOL: %.4f\n",
+            param->SNOW_STEP_TSURF_TOL);
+    fprintf(LOG_DEST, "\tSNOW_STEP_FLUX_TOL: %.4f\n",
+            param->SNOW_STEP_FLUX_TOL);
     fprintf(LOG_DEST, "\tFROZEN_MAXITER: %d\n", param->FROZEN_MAXITER);
     fprintf(LOG_DEST, "\tNEWT_RAPH_MAXTRIAL: %d\n", param->NEWT_RAPH_MAXTRIAL);
     fprintf(LOG_DEST, "\tNEWT_RAPH_TOLX: %.4f\n", param->NEWT_RAPH_TOLX);
@@ -778,11 +802,16 @@ print_parameters(parameters_struct *param)
     fprintf(LOG_DEST, "\tNEWT_RAPH_RELAX2: %.4f\n", param->NEWT_RAPH_RELAX2);
     fprintf(LOG_DEST, "\tNEWT_RAPH_RELAX3: %.4f\n", param->NEWT_RAPH_RELAX3);
     fprintf(LOG_DEST, "\tNEWT_RAPH_EPS2: %.4f\n", param->NEWT_RAPH_EPS2);
+    fprintf(LOG_DEST, "\tNEWT_RAPH_JAC_REUSE: %d\n",
+            param->NEWT_RAPH_JAC_REUSE);
     fprintf(LOG_DEST, "\tROOT_BRENT_MAXTRIES: %d\n",
             param->ROOT_BRENT_MAXTRIES);
     fprintf(LOG_DEST, "\tROOT_BRENT_MAXITER: %d\n", param->ROOT_BRENT_MAXITER);
     fprintf(LOG_DEST, "\tROOT_BRENT_TSTEP: %.4f\n", param->ROOT_BRENT_TSTEP);
     fprintf(LOG_DEST, "\tROOT_BRENT_T: %.4f\n", param->ROOT_BRENT_T);
+    fprintf(LOG_DEST, "\tROOT_SECANT_MAXITER: %d\n",
+            param->ROOT_SECANT_MAXITER);
+    fprintf(LOG_DEST, "\tROOT_SECANT_TSTEP: %.4f\n", param->ROOT_SECANT_TSTEP);
     fprintf(LOG_DEST, "\tFROZEN_MAXITER: %d\n", param->FROZEN_MAXITER);
 }
 
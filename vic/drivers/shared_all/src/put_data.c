@@ -72,6 +72,7 @@ put_data(all_vars_struct   *all_vars,
     double                     ThisTreeAdjust;
     size_t                     i;
     double                     dt_sec;
+    solver_stats_struct       *solver_stats;
 
     cell_data_struct         **cell;
     energy_bal_struct        **energy;
@@ -572,6 +573,16 @@ put_data(all_vars_struct   *all_vars,
     // vic_run run time
     out_data[OUT_TIME_VICRUN_WALL][0] = timer->delta_wall;
     out_data[OUT_TIME_VICRUN_CPU][0] = timer->delta_cpu;
+
+    // solver statistics of the vic_run call, by call site
+    for (i = 0; i < N_SOLVER_SITES; i++) {
+        solver_stats = get_solver_stats(i);
+        out_data[OUT_SOLVER_CALLS][i] = (double) solver_stats->calls;
+        out_data[OUT_SOLVER_EVALS][i] = (double) solver_stats->evals;
+        out_data[OUT_SOLVER_EXPANSIONS][i] = (double) solver_stats->expansions;
+        out_data[OUT_SOLVER_FALLBACKS][i] = (double) solver_stats->fallbacks;
+        out_data[OUT_SOLVER_MAXITER][i] = (double) solver_stats->maxiter;
+    }
 }
 
 /******************************************************************************
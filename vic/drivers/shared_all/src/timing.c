@@ -95,3 +95,193 @@ timer_continue(timer_struct *t)
     t->start_wall = get_wall_time();
     t->start_cpu = get_cpu_time();
 }
+
+/******************************************************************************
+ * @brief    Phase timer registry.
+ *
+ * @details  Phase timers accumulate the wall time spent in each phase of the
+ *           model time step, as listed in enum phase_timers, over the whole
+ *           run.  They only read the clock when enabled, so that the
+ *           instrumented phases cost one branch each otherwise.
+ *****************************************************************************/
+static bool         phase_timers_on = false;
+static timer_struct phase_timers[N_PHASE_TIMERS];
+static double       phase_trace_last[N_PHASE_TIMERS];
+static FILE        *phase_trace = NULL;
+static char        *phase_names[N_PHASE_TIMERS] = {
+    "force", "force_read", "force_scatter", "update_step_vars", "vic_run",
+    "put_data", "agg_data", "output", "output_gather", "output_write"
+};
+static int          phase_parents[N_PHASE_TIMERS] = {
+    -1, PHASE_FORCE, PHASE_FORCE, -1, -1, -1, -1, -1, PHASE_OUTPUT,
+    PHASE_OUTPUT
+};
+
+/******************************************************************************
+ * @brief    Reset the phase timers and enable or disable them
+ *****************************************************************************/
+void
+initialize_phase_timers(bool enabled)
+{
+    size_t i;
+
+    for (i = 0; i < N_PHASE_TIMERS; i++) {
+        timer_init(&(phase_timers[i]));
+        phase_trace_last[i] = 0;
+    }
+    phase_timers_on = enabled;
+}
+
+/******************************************************************************
+ * @brief    Return true if the phase timers are enabled
+ *****************************************************************************/
+bool
+phase_timers_enabled(void)
+{
+    return phase_timers_on;
+}
+
+/******************************************************************************
+ * @brief    Start (or continue) a phase timer, wall time only
+ *****************************************************************************/
+void
+phase_timer_start(size_t phase)
+{
+    if (phase_timers_on) {
+        phase_timers[phase].start_wall = get_wall_time();
+    }
+}
+
+/******************************************************************************
+ * @brief    Stop a phase timer and add the time since it was started
+ *****************************************************************************/
+void
+phase_timer_stop(size_t phase)
+{
+    if (phase_timers_on) {
+        phase_timers[phase].stop_wall = get_wall_time();
+        phase_timers[phase].delta_wall += phase_timers[phase].stop_wall -
+                                          phase_timers[phase].start_wall;
+    }
+}
+
+/******************************************************************************
+ * @brief    Add the wall time of a timer that was started and stopped by the
+ *           caller, e.g. the vic_run timer that is also written to the
+ *           OUT_TIME_VICRUN_* outputs, to a phase timer.
+ *****************************************************************************/
+void
+phase_timer_add(size_t        phase,
+                timer_struct *t)
+{
+    if (phase_timers_on) {
+        phase_timers[phase].delta_wall += t->delta_wall;
+    }
+}
+
+/******************************************************************************
+ * @brief    Return the accumulated wall time of a phase timer (seconds)
+ *****************************************************************************/
+double
+phase_timer_get(size_t phase)
+{
+    return phase_timers[phase].delta_wall;
+}
+
+/******************************************************************************
+ * @brief    Return the name of a phase timer
+ *****************************************************************************/
+char *
+phase_timer_name(size_t phase)
+{
+    return phase_names[phase];
+}
+
+/******************************************************************************
+ * @brief    Return the phase that a phase timer is nested in, or -1 if it is
+ *           nested in the run timer only
+ *****************************************************************************/
+int
+phase_timer_parent(size_t phase)
+{
+    return phase_parents[phase];
+}
+
+/******************************************************************************
+ * @brief    Return the nesting depth of a phase timer, 0 for the phases
+ *           nested in the run timer only
+ *****************************************************************************/
+size_t
+phase_timer_depth(size_t phase)
+{
+    size_t depth = 0;
+    int    parent;
+
+    parent = phase_parents[phase];
+    while (parent >= 0) {
+        depth++;
+        parent = phase_parents[parent];
+    }
+
+    return depth;
+}
+
+/******************************************************************************
+ * @brief    Open the phase timer trace file and write its header
+ *
+ * @details  The trace is a CSV file with one row per call to
+ *           write_phase_trace(): a key identifying the row (key_name is the
+ *           name of its column) followed by the wall time spent in each phase
+ *           since the previous row.
+ *****************************************************************************/
+void
+open_phase_trace(char *filename,
+                 char *key_name)
+{
+    size_t i;
+
+    phase_trace = fopen(filename, "w");
+    if (phase_trace == NULL) {
+        log_err("Unable to open timing trace file %s", filename);
+    }
+
+    fprintf(phase_trace, "%s", key_name);
+    for (i = 0; i < N_PHASE_TIMERS; i++) {
+        fprintf(phase_trace, ",%s", phase_names[i]);
+        phase_trace_last[i] = phase_timers[i].delta_wall;
+    }
+    fprintf(phase_trace, "\n");
+}
+
+/******************************************************************************
+ * @brief    Write a row of the phase timer trace, if it is open
+ *****************************************************************************/
+void
+write_phase_trace(char *key)
+{
+    size_t i;
+
+    if (phase_trace == NULL) {
+        return;
+    }
+
+    fprintf(phase_trace, "%s", key);
+    for (i = 0; i < N_PHASE_TIMERS; i++) {
+        fprintf(phase_trace, ",%.6f",
+                phase_timers[i].delta_wall - phase_trace_last[i]);
+        phase_trace_last[i] = phase_timers[i].delta_wall;
+    }
+    fprintf(phase_trace, "\n");
+}
+
+/******************************************************************************
+ * @brief    Close the phase timer trace file, if it is open
+ *****************************************************************************/
+void
+close_phase_trace(void)
+{
+    if (phase_trace != NULL) {
+        fclose(phase_trace);
+        phase_trace = NULL;
+    }
+}
@@ -76,6 +76,8 @@ setup_stream(stream_struct *stream,
     stream->ngridcells = ngridcells;
     stream->file_format = UNSET_FILE_FORMAT;
     stream->compress = false;
+    stream->container_buf = NULL;
+    stream->container_len = 0;
 
     // Initialize dmy_junk - this step is to avoid time-related error caused
     // by junk dmy; the date set here does not matter and will be overwritten
@@ -113,6 +115,13 @@ setup_stream(stream_struct *stream,
         stream->format[i] = calloc(MAXSTRING, sizeof(*(stream->format[i])));
         check_alloc_status(stream->format[i], "Memory allocation error.");
     }
+
+    stream->ascii_format = calloc(nvars, sizeof(*(stream->ascii_format)));
+    check_alloc_status(stream->ascii_format, "Memory allocation error.");
+
+    // ASCII output buffer is allocated by the driver when first needed
+    stream->buffer = NULL;
+    stream->buffer_len = 0;
     // Initialize some of the stream members
     // these will be overwritten in set_output_var
     for (i = 0; i < nvars; i++) {
@@ -324,6 +333,11 @@ get_default_outvar_aggtype(unsigned int varid)
     case OUT_SURFT_FBFLAG:
     case OUT_TCAN_FBFLAG:
     case OUT_TFOL_FBFLAG:
+    case OUT_SOLVER_CALLS:
+    case OUT_SOLVER_EVALS:
+    case OUT_SOLVER_EXPANSIONS:
+    case OUT_SOLVER_FALLBACKS:
+    case OUT_SOLVER_MAXITER:
         agg_type = AGG_TYPE_SUM;
         break;
     default:
@@ -375,6 +389,8 @@ set_output_var(stream_struct     *stream,
     else {
         strcpy(stream->format[varnum], "%.4f");
     }
+    parse_ascii_format(stream->format[varnum],
+                       &(stream->ascii_format[varnum]));
     // Output type (BINARY and netCDF)
     if (type != OUT_TYPE_DEFAULT) {
         stream->type[varnum] = type;
@@ -434,6 +450,8 @@ free_streams(stream_struct **streams)
         free((*streams)[streamnum].type);
         free((*streams)[streamnum].mult);
         free((*streams)[streamnum].format);
+        free((*streams)[streamnum].ascii_format);
+        free((*streams)[streamnum].buffer);
         free((*streams)[streamnum].varid);
         free((*streams)[streamnum].aggtype);
     }
@@ -30,6 +30,14 @@
 
 #include <vic_driver_shared_all.h>
 
+/******************************************************************************
+ * @brief    Warning call sites that were reached, most recent first, and the
+ *           number of warnings that were issued and not printed.
+ *****************************************************************************/
+static warn_site_struct *warn_sites = NULL;
+static size_t            warn_total = 0;
+static size_t            warn_suppressed = 0;
+
 /******************************************************************************
  * @brief    Finalize logging - called after all logging is completed
  *****************************************************************************/
@@ -38,6 +46,8 @@ finalize_logging(void)
 {
     extern FILE *LOG_DEST;
 
+    print_warning_summary();
+
     if (!(LOG_DEST == stdout || LOG_DEST == stderr)) {
         fclose(LOG_DEST);
         LOG_DEST = stderr;
@@ -140,6 +150,102 @@ setup_logging(int    id,
     }
 }
 
+/******************************************************************************
+ * @brief    Count an occurrence of a warning and decide whether to print it.
+ *
+ * @details  Called by log_warn.  Returns 1 for the first LOG_WARN_MAX
+ *           occurrences of a call site and 0 after that.  The last printed
+ *           occurrence is announced as such, and the number of occurrences is
+ *           printed again whenever it reaches LOG_WARN_MAX times a power of
+ *           ten, so that a warning that fires every time step shows up a few
+ *           times in the log instead of once per step.
+ *****************************************************************************/
+int
+warn_site_hit(warn_site_struct *site)
+{
+    extern FILE *LOG_DEST;
+
+    size_t       count;
+    size_t       period;
+
+#ifdef _OPENMP
+#pragma omp critical (warn_sites)
+#endif
+    {
+        if (site->count == 0) {
+            site->next = warn_sites;
+            warn_sites = site;
+        }
+        site->count++;
+        count = site->count;
+        warn_total++;
+        if (LOG_WARN_MAX > 0 && count > LOG_WARN_MAX) {
+            warn_suppressed++;
+        }
+    }
+
+    if (LOG_WARN_MAX == 0 || count < LOG_WARN_MAX) {
+        return 1;
+    }
+    else if (count == LOG_WARN_MAX) {
+        fprintf(LOG_DEST, "[WARN] %s:%d: warning issued %zu times, further "
+                "occurrences are only counted\n", site->file, site->line,
+                count);
+        return 1;
+    }
+
+    period = LOG_WARN_MAX;
+    while (period < count) {
+        period *= 10;
+    }
+    if (period == count) {
+        fprintf(LOG_DEST, "[WARN] %s:%d: warning issued %zu times\n",
+                site->file, site->line, count);
+    }
+
+    return 0;
+}
+
+/******************************************************************************
+ * @brief    Return the number of warnings issued so far and the number of
+ *           them that were not printed.
+ *****************************************************************************/
+void
+get_warning_totals(size_t *total,
+                   size_t *suppressed)
+{
+    *total = warn_total;
+    *suppressed = warn_suppressed;
+}
+
+/******************************************************************************
+ * @brief    Print the number of warnings issued from each call site.
+ *****************************************************************************/
+void
+print_warning_summary(void)
+{
+    extern FILE      *LOG_DEST;
+
+    warn_site_struct *site;
+    size_t            nsites;
+
+    if (warn_total == 0) {
+        return;
+    }
+
+    nsites = 0;
+    for (site = warn_sites; site != NULL; site = site->next) {
+        nsites++;
+    }
+
+    fprintf(LOG_DEST, "[WARN] Warning summary: %zu warnings from %zu call "
+            "sites, %zu not printed\n", warn_total, nsites, warn_suppressed);
+    for (site = warn_sites; site != NULL; site = site->next) {
+        fprintf(LOG_DEST, "[WARN]   %s:%d: %zu times: %s\n", site->file,
+                site->line, site->count, site->fmt);
+    }
+}
+
 /******************************************************************************
  * @brief    Print traceback for current error position
  *****************************************************************************/
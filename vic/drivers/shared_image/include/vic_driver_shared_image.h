@@ -121,6 +121,7 @@ typedef struct {
     int nj_dimid;
     int node_dimid;
     int root_zone_dimid;
+    int solver_dimid;
     int time_dimid;
     int time_bounds_dimid;
     int veg_dimid;
@@ -135,6 +136,7 @@ typedef struct {
     size_t nj_size;
     size_t node_size;
     size_t root_zone_size;
+    size_t solver_size;
     size_t time_size;
     size_t veg_size;
     bool open;
@@ -183,6 +185,7 @@ typedef struct {
     char init_state[MAXSTRING];    /**< initial model state file name */
     char result_dir[MAXSTRING];    /**< directory where results will be written */
     char statefile[MAXSTRING];     /**< name of file in which to store model state */
+    char timing_trace[MAXSTRING];  /**< phase timer trace file name */
     char log_path[MAXSTRING];      /**< Location to write log file to */
 } filenames_struct;
 
@@ -239,6 +242,7 @@ void print_nc_file(nc_file_struct *nc);
 void print_nc_var(nc_var_struct *nc_var);
 void print_veg_con_map(veg_con_map_struct *veg_con_map);
 void put_nc_attr(int nc_id, int var_id, const char *name, const char *value);
+void reduce_phase_timers(void);
 void set_force_type(char *cmdstr, int file_num, int *field);
 void set_global_nc_attributes(int ncid, unsigned short int file_type);
 void set_state_meta_data_info();
@@ -62,5 +62,6 @@ void mpi_map_decomp_domain(size_t ncells, size_t mpi_size,
                            int **mpi_map_global_array_offsets,
                            size_t **mpi_map_mapping_array);
 void print_mpi_error_str(int error_code);
+void reduce_warning_totals(void);
 
 #endif
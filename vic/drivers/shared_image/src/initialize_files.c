@@ -40,6 +40,7 @@ initialize_filenames()
 
     strcpy(filenames.init_state, "MISSING");
     strcpy(filenames.statefile, "MISSING");
+    strcpy(filenames.timing_trace, "MISSING");
     strcpy(filenames.constants, "MISSING");
     strcpy(filenames.params, "MISSING");
     strcpy(filenames.result_dir, "MISSING");
@@ -138,6 +138,7 @@ print_nc_file(nc_file_struct *nc)
     fprintf(LOG_DEST, "\tnj_dimid       : %d\n", nc->nj_dimid);
     fprintf(LOG_DEST, "\tnode_dimid     : %d\n", nc->node_dimid);
     fprintf(LOG_DEST, "\troot_zone_dimid: %d\n", nc->root_zone_dimid);
+    fprintf(LOG_DEST, "\tsolver_dimid   : %d\n", nc->solver_dimid);
     fprintf(LOG_DEST, "\ttime_dimid     : %d\n", nc->time_dimid);
     fprintf(LOG_DEST, "\tveg_dimid      : %d\n", nc->veg_dimid);
     fprintf(LOG_DEST, "\tband_size      : %zd\n", nc->band_size);
@@ -148,6 +149,7 @@ print_nc_file(nc_file_struct *nc)
     fprintf(LOG_DEST, "\tnj_size        : %zd\n", nc->nj_size);
     fprintf(LOG_DEST, "\tnode_size      : %zd\n", nc->node_size);
     fprintf(LOG_DEST, "\troot_zone_size : %zd\n", nc->root_zone_size);
+    fprintf(LOG_DEST, "\tsolver_size    : %zd\n", nc->solver_size);
     fprintf(LOG_DEST, "\ttime_size      : %zd\n", nc->time_size);
     fprintf(LOG_DEST, "\tveg_size       : %zd\n", nc->veg_size);
     fprintf(LOG_DEST, "\topen           : %d\n", nc->open);
@@ -127,5 +127,7 @@ vic_finalize(void)
     MPI_Type_free(&mpi_alarm_struct_type);
     MPI_Type_free(&mpi_option_struct_type);
     MPI_Type_free(&mpi_param_struct_type);
+    free_scratch();
+    reduce_warning_totals();
     finalize_logging();
 }
@@ -38,7 +38,7 @@ vic_image_run(dmy_struct *dmy_current)
     extern domain_struct       local_domain;
     extern option_struct       options;
     extern global_param_struct global_param;
-    extern lake_con_struct     lake_con;
+    extern lake_con_struct    *lake_con;
     extern double           ***out_data;
     extern stream_struct      *output_streams;
     extern save_data_struct   *save_data;
@@ -49,6 +49,7 @@ vic_image_run(dmy_struct *dmy_current)
 
     char                       dmy_str[MAXSTRING];
     size_t                     i;
+    lake_con_struct           *lake;
     timer_struct               timer;
 
     // Print the current timestep info before running vic_run
@@ -56,22 +57,32 @@ vic_image_run(dmy_struct *dmy_current)
     debug("Running timestep %zu: %s", current, dmy_str);
 
     for (i = 0; i < local_domain.ncells_active; i++) {
-        // Set global reference string (for debugging inside vic_run)
-        sprintf(vic_run_ref_str, "Gridcell io_idx: %zu, timestep info: %s",
-                local_domain.locations[i].io_idx, dmy_str);
+        // Set run context (for diagnostics inside vic_run)
+        set_run_context(local_domain.locations[i].io_idx, current,
+                        dmy_current);
 
+        phase_timer_start(PHASE_UPDATE_STEP_VARS);
         update_step_vars(&(all_vars[i]), veg_con[i], veg_hist[i]);
+        phase_timer_stop(PHASE_UPDATE_STEP_VARS);
+
+        // lake_con is only allocated if the lake model is on
+        lake = options.LAKES ? &(lake_con[i]) : NULL;
 
         timer_start(&timer);
         vic_run(&(force[i]), &(all_vars[i]), dmy_current, &global_param,
-                &lake_con, &(soil_con[i]), veg_con[i], veg_lib[i]);
+                lake, &(soil_con[i]), veg_con[i], veg_lib[i]);
         timer_stop(&timer);
+        phase_timer_add(PHASE_VIC_RUN, &timer);
 
+        phase_timer_start(PHASE_PUT_DATA);
         put_data(&(all_vars[i]), &(force[i]), &(soil_con[i]), veg_con[i],
-                 veg_lib[i], &lake_con, out_data[i], &(save_data[i]),
+                 veg_lib[i], lake, out_data[i], &(save_data[i]),
                  &timer);
+        phase_timer_stop(PHASE_PUT_DATA);
     }
+    phase_timer_start(PHASE_AGG_DATA);
     for (i = 0; i < options.Noutstreams; i++) {
         agg_stream_data(&(output_streams[i]), dmy_current, out_data);
     }
+    phase_timer_stop(PHASE_AGG_DATA);
 }
@@ -26,6 +26,86 @@
 
 #include <vic_driver_shared_image.h>
 
+/******************************************************************************
+ * @brief    Phase timers reduced over all processes, on the master process
+ *****************************************************************************/
+static double phase_min[N_PHASE_TIMERS];
+static double phase_mean[N_PHASE_TIMERS];
+static double phase_max[N_PHASE_TIMERS];
+
+/******************************************************************************
+ * @brief    Reduce the phase timers of all processes to their minimum, mean
+ *           and maximum on the master process.
+ *
+ * @details  Must be called by all processes, before MPI is finalized.  The
+ *           spread between the minimum and maximum of a phase shows the load
+ *           imbalance between processes.
+ *****************************************************************************/
+void
+reduce_phase_timers(void)
+{
+    extern MPI_Comm MPI_COMM_VIC;
+    extern int      mpi_size;
+
+    double          local[N_PHASE_TIMERS];
+    int             status;
+    size_t          i;
+
+    for (i = 0; i < N_PHASE_TIMERS; i++) {
+        local[i] = phase_timer_get(i);
+    }
+
+    status = MPI_Reduce(local, phase_min, N_PHASE_TIMERS, MPI_DOUBLE,
+                        MPI_MIN, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Reduce(local, phase_mean, N_PHASE_TIMERS, MPI_DOUBLE,
+                        MPI_SUM, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Reduce(local, phase_max, N_PHASE_TIMERS, MPI_DOUBLE,
+                        MPI_MAX, VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    for (i = 0; i < N_PHASE_TIMERS; i++) {
+        phase_mean[i] /= mpi_size;
+    }
+}
+
+/******************************************************************************
+ * @brief    Write the wall time of the phase timers, reduced over all
+ *           processes.  Phases that were never timed are left out.
+ *****************************************************************************/
+static void
+write_phase_timing_table(double run_time)
+{
+    extern FILE *LOG_DEST;
+
+    char         name[MAXSTRING];
+    double       imbalance;
+    size_t       i;
+
+    fprintf(LOG_DEST, "  Phase Timing Table (wall time over all pes):\n");
+    fprintf(LOG_DEST,
+            "|----------------------|----------------------|----------------------|----------------------|----------|----------|\n");
+    fprintf(LOG_DEST,
+            "| Phase                | Min (secs)           | Mean (secs)          | Max (secs)           | %% of Run | Max/Mean |\n");
+    fprintf(LOG_DEST,
+            "|----------------------|----------------------|----------------------|----------------------|----------|----------|\n");
+    for (i = 0; i < N_PHASE_TIMERS; i++) {
+        if (phase_max[i] > 0) {
+            sprintf(name, "%*s%s", (int) (2 * phase_timer_depth(i)), "",
+                    phase_timer_name(i));
+            imbalance = phase_mean[i] > 0 ? phase_max[i] / phase_mean[i] : 0;
+            fprintf(LOG_DEST,
+                    "| %-20s | %20g | %20g | %20g | %8.2f | %8.3f |\n",
+                    name, phase_min[i], phase_mean[i], phase_max[i],
+                    100. * phase_mean[i] / run_time, imbalance);
+        }
+    }
+    fprintf(LOG_DEST,
+            "|----------------------|----------------------|----------------------|----------------------|----------|----------|\n");
+    fprintf(LOG_DEST, "\n");
+}
+
 /******************************************************************************
  * @brief    VIC timing file
  *****************************************************************************/
@@ -148,6 +228,10 @@ write_vic_timing_table(timer_struct *timers,
             "|------------|----------------------|----------------------|----------------------|----------------------|\n");
     fprintf(LOG_DEST, "\n");
 
+    if (phase_timers_enabled()) {
+        write_phase_timing_table(timers[TIMER_VIC_RUN].delta_wall);
+    }
+
     fprintf(LOG_DEST,
             "\n------------------------------"
             " END VIC TIMING PROFILE "
@@ -1530,7 +1530,7 @@ vic_init(void)
         // compute other lake parameters here
         for (i = 0; i < local_domain.ncells_active; i++) {
             soil_con[i].cell_area = local_domain.locations[i].area;
-            compute_lake_params(&(lake_con[i]), soil_con[i]);
+            compute_lake_params(&(lake_con[i]), &(soil_con[i]));
         }
     }
 
@@ -1545,13 +1545,18 @@ vic_init(void)
             if (tmp_lake_idx < 0) {
                 tmp_lake_idx = 0;
             }
-            initialize_lake(&(all_vars[i].lake_var), lake_con[i],
+            initialize_lake(&(all_vars[i].lake_var), &(lake_con[i]),
                             &(soil_con[i]),
                             &(all_vars[i].cell[tmp_lake_idx][0]), false);
         }
         initialize_energy(all_vars[i].energy, nveg);
     }
 
+    // build the blowing snow table before the threads of vic_image_run use it
+    if (options.BLOWING && !options.BLOWING_SIMPLE && options.BLOWING_TABLE) {
+        init_blowing_table();
+    }
+
     // set state metadata structure
     set_state_meta_data_info();
 
@@ -40,7 +40,7 @@ vic_init_output(dmy_struct *dmy_current)
     extern MPI_Comm           MPI_COMM_VIC;
     extern int                mpi_rank;
     extern nc_file_struct    *nc_hist_files;
-    extern lake_con_struct    lake_con;
+    extern lake_con_struct   *lake_con;
     extern double          ***out_data;
     extern save_data_struct  *save_data;
     extern soil_con_struct   *soil_con;
@@ -66,7 +66,9 @@ vic_init_output(dmy_struct *dmy_current)
     // initialize the save data structures
     for (i = 0; i < local_domain.ncells_active; i++) {
         initialize_save_data(&(all_vars[i]), &(force[i]), &(soil_con[i]),
-                             veg_con[i], veg_lib[i], &lake_con, out_data[i],
+                             veg_con[i], veg_lib[i],
+                             options.LAKES ? &(lake_con[i]) : NULL,
+                             out_data[i],
                              &(save_data[i]), &timer);
     }
 
@@ -311,6 +313,11 @@ initialize_history_file(nc_file_struct *nc,
     check_nc_status(status, "Error defining root_zone dimension in %s",
                     stream->filename);
 
+    status = nc_def_dim(nc->nc_id, "solver_site", nc->solver_size,
+                        &(nc->solver_dimid));
+    check_nc_status(status, "Error defining solver_site dimension in %s",
+                    stream->filename);
+
     status = nc_def_dim(nc->nc_id, "veg_class", nc->veg_size,
                         &(nc->veg_dimid));
     check_nc_status(status, "Error defining veg_class dimension in %s",
@@ -688,6 +695,7 @@ initialize_nc_file(nc_file_struct     *nc_file,
     nc_file->nj_dimid = MISSING;
     nc_file->node_dimid = MISSING;
     nc_file->root_zone_dimid = MISSING;
+    nc_file->solver_dimid = MISSING;
     nc_file->time_dimid = MISSING;
     nc_file->veg_dimid = MISSING;
 
@@ -700,6 +708,7 @@ initialize_nc_file(nc_file_struct     *nc_file,
     nc_file->nj_size = global_domain.n_ny;
     nc_file->node_size = options.Nnode;
     nc_file->root_zone_size = options.ROOT_ZONES;
+    nc_file->solver_size = N_SOLVER_SITES;
     nc_file->time_size = NC_UNLIMITED;
     nc_file->veg_size = options.NVEGTYPES;
 
@@ -100,7 +100,7 @@ create_MPI_global_struct_type(MPI_Datatype *mpi_type)
     MPI_Datatype   *mpi_types;
 
     // nitems has to equal the number of elements in global_param_struct
-    nitems = 32;
+    nitems = 33;
     blocklengths = malloc(nitems * sizeof(*blocklengths));
     check_alloc_status(blocklengths, "Memory allocation error.");
 
@@ -196,6 +196,10 @@ create_MPI_global_struct_type(MPI_Datatype *mpi_type)
     blocklengths[i] = 2;
     mpi_types[i++] = MPI_UNSIGNED;
 
+    // size_t force_window;
+    offsets[i] = offsetof(global_param_struct, force_window);
+    mpi_types[i++] = MPI_AINT;
+
     // unsigned short int forceyear[2];
     offsets[i] = offsetof(global_param_struct, forceyear);
     blocklengths[i] = 2;
@@ -293,7 +297,7 @@ create_MPI_filenames_struct_type(MPI_Datatype *mpi_type)
     MPI_Datatype   *mpi_types;
 
     // nitems has to equal the number of elements in filenames_struct
-    nitems = 10;
+    nitems = 11;
     blocklengths = malloc(nitems * sizeof(*blocklengths));
     check_alloc_status(blocklengths, "Memory allocation error.");
 
@@ -350,6 +354,10 @@ create_MPI_filenames_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(filenames_struct, statefile);
     mpi_types[i++] = MPI_CHAR;
 
+    // char timing_trace[MAXSTRING];
+    offsets[i] = offsetof(filenames_struct, timing_trace);
+    mpi_types[i++] = MPI_CHAR;
+
     // char log_path[MAXSTRING];
     offsets[i] = offsetof(filenames_struct, log_path);
     mpi_types[i++] = MPI_CHAR;
@@ -488,7 +496,7 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     MPI_Datatype   *mpi_types;
 
     // nitems has to equal the number of elements in option_struct
-    nitems = 53;
+    nitems = 62;
     blocklengths = malloc(nitems * sizeof(*blocklengths));
     check_alloc_status(blocklengths, "Memory allocation error.");
 
@@ -510,6 +518,10 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, AboveTreelineVeg);
     mpi_types[i++] = MPI_SHORT;
 
+    // bool ADAPTIVE_SNOW_STEP;
+    offsets[i] = offsetof(option_struct, ADAPTIVE_SNOW_STEP);
+    mpi_types[i++] = MPI_C_BOOL;
+
     // unsigned short AERO_RESIST_CANSNOW;
     offsets[i] = offsetof(option_struct, AERO_RESIST_CANSNOW);
     mpi_types[i++] = MPI_UNSIGNED_SHORT;
@@ -538,6 +550,10 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, BLOWING_SPATIAL_WIND);
     mpi_types[i++] = MPI_C_BOOL;
 
+    // bool BLOWING_TABLE;
+    offsets[i] = offsetof(option_struct, BLOWING_TABLE);
+    mpi_types[i++] = MPI_C_BOOL;
+
     // bool CARBON;
     offsets[i] = offsetof(option_struct, CARBON);
     mpi_types[i++] = MPI_C_BOOL;
@@ -566,6 +582,10 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, EXP_TRANS);
     mpi_types[i++] = MPI_C_BOOL;
 
+    // bool FROZEN_NEWTON;
+    offsets[i] = offsetof(option_struct, FROZEN_NEWTON);
+    mpi_types[i++] = MPI_C_BOOL;
+
     // bool FROZEN_SOIL;
     offsets[i] = offsetof(option_struct, FROZEN_SOIL);
     mpi_types[i++] = MPI_C_BOOL;
@@ -582,6 +602,10 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, IMPLICIT);
     mpi_types[i++] = MPI_C_BOOL;
 
+    // bool ANALYTIC_JACOBIAN;
+    offsets[i] = offsetof(option_struct, ANALYTIC_JACOBIAN);
+    mpi_types[i++] = MPI_C_BOOL;
+
     // bool JULY_TAVG_SUPPLIED;
     offsets[i] = offsetof(option_struct, JULY_TAVG_SUPPLIED);
     mpi_types[i++] = MPI_C_BOOL;
@@ -590,6 +614,10 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, LAKES);
     mpi_types[i++] = MPI_C_BOOL;
 
+    // unsigned short MATH_KERNELS;
+    offsets[i] = offsetof(option_struct, MATH_KERNELS);
+    mpi_types[i++] = MPI_UNSIGNED_SHORT;
+
     // size_t Ncanopy;
     offsets[i] = offsetof(option_struct, Ncanopy);
     mpi_types[i++] = MPI_AINT; // note there is no MPI_SIZE_T equivalent
@@ -618,6 +646,10 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, NVEGTYPES);
     mpi_types[i++] = MPI_AINT; // note there is no MPI_SIZE_T equivalent
 
+    // size_t NLAKENODES;
+    offsets[i] = offsetof(option_struct, NLAKENODES);
+    mpi_types[i++] = MPI_AINT; // note there is no MPI_SIZE_T equivalent
+
     // unsigned short RC_MODE;
     offsets[i] = offsetof(option_struct, RC_MODE);
     mpi_types[i++] = MPI_UNSIGNED_SHORT;
@@ -634,6 +666,10 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, QUICK_SOLVE);
     mpi_types[i++] = MPI_C_BOOL;
 
+    // bool SECANT_SOLVE;
+    offsets[i] = offsetof(option_struct, SECANT_SOLVE);
+    mpi_types[i++] = MPI_C_BOOL;
+
     // bool SHARE_LAYER_MOIST;
     offsets[i] = offsetof(option_struct, SHARE_LAYER_MOIST);
     mpi_types[i++] = MPI_C_BOOL;
@@ -718,6 +754,14 @@ create_MPI_option_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(option_struct, SAVE_STATE);
     mpi_types[i++] = MPI_C_BOOL;
 
+    // bool OUTPUT_CONTAINER;
+    offsets[i] = offsetof(option_struct, OUTPUT_CONTAINER);
+    mpi_types[i++] = MPI_C_BOOL;
+
+    // bool PHASE_TIMERS;
+    offsets[i] = offsetof(option_struct, PHASE_TIMERS);
+    mpi_types[i++] = MPI_C_BOOL;
+
     // make sure that the we have the right number of elements
     if (i != (size_t) nitems) {
         log_err("Miscount: %zd not equal to %d.", i, nitems);
@@ -755,7 +799,7 @@ create_MPI_param_struct_type(MPI_Datatype *mpi_type)
     MPI_Datatype   *mpi_types;
 
     // nitems has to equal the number of elements in parameters_struct
-    nitems = 153;
+    nitems = 160;
     blocklengths = malloc(nitems * sizeof(*blocklengths));
     check_alloc_status(blocklengths, "Memory allocation error.");
 
@@ -1329,6 +1373,22 @@ create_MPI_param_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(parameters_struct, TOL_OVER);
     mpi_types[i++] = MPI_DOUBLE;
 
+    // int SNOW_STEP_MAX
+    offsets[i] = offsetof(parameters_struct, SNOW_STEP_MAX);
+    mpi_types[i++] = MPI_INT;
+
+    // double SNOW_STEP_SWE_TOL
+    offsets[i] = offsetof(parameters_struct, SNOW_STEP_SWE_TOL);
+    mpi_types[i++] = MPI_DOUBLE;
+
+    // double SNOW_STEP_TSURF_TOL
+    offsets[i] = offsetof(parameters_struct, SNOW_STEP_TSURF_TOL);
+    mpi_types[i++] = MPI_DOUBLE;
+
+    // double SNOW_STEP_FLUX_TOL
+    offsets[i] = offsetof(parameters_struct, SNOW_STEP_FLUX_TOL);
+    mpi_types[i++] = MPI_DOUBLE;
+
     // int FROZEN_MAXITER
     offsets[i] = offsetof(parameters_struct, FROZEN_MAXITER);
     mpi_types[i++] = MPI_INT;
@@ -1369,6 +1429,10 @@ create_MPI_param_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(parameters_struct, NEWT_RAPH_EPS2);
     mpi_types[i++] = MPI_DOUBLE;
 
+    // int NEWT_RAPH_JAC_REUSE
+    offsets[i] = offsetof(parameters_struct, NEWT_RAPH_JAC_REUSE);
+    mpi_types[i++] = MPI_INT;
+
     // int ROOT_BRENT_MAXTRIES
     offsets[i] = offsetof(parameters_struct, ROOT_BRENT_MAXTRIES);
     mpi_types[i++] = MPI_INT;
@@ -1385,6 +1449,14 @@ create_MPI_param_struct_type(MPI_Datatype *mpi_type)
     offsets[i] = offsetof(parameters_struct, ROOT_BRENT_T);
     mpi_types[i++] = MPI_DOUBLE;
 
+    // int ROOT_SECANT_MAXITER
+    offsets[i] = offsetof(parameters_struct, ROOT_SECANT_MAXITER);
+    mpi_types[i++] = MPI_INT;
+
+    // double ROOT_SECANT_TSTEP
+    offsets[i] = offsetof(parameters_struct, ROOT_SECANT_TSTEP);
+    mpi_types[i++] = MPI_DOUBLE;
+
     // make sure that the we have the right number of elements
     if (i != (size_t) nitems) {
         log_err("Miscount: %zd not equal to %d.", i, nitems);
@@ -1725,11 +1797,13 @@ gather_put_nc_field_double(int     nc_id,
     }
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    phase_timer_start(PHASE_OUTPUT_GATHER);
     status = MPI_Gatherv(var, local_domain.ncells_active, MPI_DOUBLE,
                          dvar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_DOUBLE,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
     check_mpi_status(status, "MPI error.");
+    phase_timer_stop(PHASE_OUTPUT_GATHER);
     if (mpi_rank == VIC_MPI_ROOT) {
         // remap the array
         map(sizeof(double), global_domain.ncells_active, NULL,
@@ -1738,8 +1812,10 @@ gather_put_nc_field_double(int     nc_id,
         map(sizeof(double), global_domain.ncells_active, NULL,
             filter_active_cells, dvar_remapped, dvar);
 
+        phase_timer_start(PHASE_OUTPUT_WRITE);
         status = nc_put_vara_double(nc_id, var_id, start, count, dvar);
         check_nc_status(status, "Error writing values.");
+        phase_timer_stop(PHASE_OUTPUT_WRITE);
         // cleanup
         free(dvar);
         free(dvar_gathered);
@@ -1792,11 +1868,13 @@ gather_put_nc_field_float(int     nc_id,
     }
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    phase_timer_start(PHASE_OUTPUT_GATHER);
     status = MPI_Gatherv(var, local_domain.ncells_active, MPI_FLOAT,
                          fvar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_FLOAT,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
     check_mpi_status(status, "Error with gather of floats");
+    phase_timer_stop(PHASE_OUTPUT_GATHER);
 
     if (mpi_rank == VIC_MPI_ROOT) {
         // remap the array
@@ -1807,8 +1885,10 @@ gather_put_nc_field_float(int     nc_id,
             filter_active_cells, fvar_remapped, fvar);
 
         // write to file
+        phase_timer_start(PHASE_OUTPUT_WRITE);
         status = nc_put_vara_float(nc_id, var_id, start, count, fvar);
         check_nc_status(status, "Error writing values");
+        phase_timer_stop(PHASE_OUTPUT_WRITE);
 
         // cleanup
         free(fvar);
@@ -1865,11 +1945,13 @@ gather_put_nc_field_int(int     nc_id,
     }
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    phase_timer_start(PHASE_OUTPUT_GATHER);
     status = MPI_Gatherv(var, local_domain.ncells_active, MPI_INT,
                          ivar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_INT,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
     check_mpi_status(status, "MPI error.");
+    phase_timer_stop(PHASE_OUTPUT_GATHER);
 
     if (mpi_rank == VIC_MPI_ROOT) {
         // remap the array
@@ -1880,8 +1962,10 @@ gather_put_nc_field_int(int     nc_id,
         map(sizeof(int), global_domain.ncells_active, NULL, filter_active_cells,
             ivar_remapped, ivar);
         // write to file
+        phase_timer_start(PHASE_OUTPUT_WRITE);
         status = nc_put_vara_int(nc_id, var_id, start, count, ivar);
         check_nc_status(status, "Error writing values");
+        phase_timer_stop(PHASE_OUTPUT_WRITE);
 
         // cleanup
         free(ivar);
@@ -1938,11 +2022,13 @@ gather_put_nc_field_short(int        nc_id,
     }
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    phase_timer_start(PHASE_OUTPUT_GATHER);
     status = MPI_Gatherv(var, local_domain.ncells_active, MPI_SHORT,
                          svar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_SHORT,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
     check_mpi_status(status, "MPI error.");
+    phase_timer_stop(PHASE_OUTPUT_GATHER);
 
     if (mpi_rank == VIC_MPI_ROOT) {
         // remap the array
@@ -1953,8 +2039,10 @@ gather_put_nc_field_short(int        nc_id,
         map(sizeof(short int), global_domain.ncells_active, NULL,
             filter_active_cells, svar_remapped, svar);
         // write to file
+        phase_timer_start(PHASE_OUTPUT_WRITE);
         status = nc_put_vara_short(nc_id, var_id, start, count, svar);
         check_nc_status(status, "Error writing values");
+        phase_timer_stop(PHASE_OUTPUT_WRITE);
 
         // cleanup
         free(svar);
@@ -2011,11 +2099,13 @@ gather_put_nc_field_schar(int     nc_id,
     }
     // Gather the results from the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    phase_timer_start(PHASE_OUTPUT_GATHER);
     status = MPI_Gatherv(var, local_domain.ncells_active, MPI_CHAR,
                          cvar_gathered, mpi_map_local_array_sizes,
                          mpi_map_global_array_offsets, MPI_CHAR,
                          VIC_MPI_ROOT, MPI_COMM_VIC);
     check_mpi_status(status, "MPI error.");
+    phase_timer_stop(PHASE_OUTPUT_GATHER);
 
     if (mpi_rank == VIC_MPI_ROOT) {
         // remap the array
@@ -2026,8 +2116,10 @@ gather_put_nc_field_schar(int     nc_id,
         map(sizeof(char), global_domain.ncells_active, NULL,
             filter_active_cells, cvar_remapped, cvar);
         // write to file
+        phase_timer_start(PHASE_OUTPUT_WRITE);
         status = nc_put_vara_schar(nc_id, var_id, start, count, cvar);
         check_nc_status(status, "Error writing values");
+        phase_timer_stop(PHASE_OUTPUT_WRITE);
 
         // cleanup
         free(cvar);
@@ -2073,7 +2165,9 @@ get_scatter_nc_field_double(char   *nc_name,
             malloc(global_domain.ncells_active * sizeof(*dvar_mapped));
         check_alloc_status(dvar_mapped, "Memory allocation error.");
 
+        phase_timer_start(PHASE_FORCE_READ);
         get_nc_field_double(nc_name, var_name, start, count, dvar);
+        phase_timer_stop(PHASE_FORCE_READ);
         // filter the active cells only
         map(sizeof(double), global_domain.ncells_active, filter_active_cells,
             NULL, dvar, dvar_filtered);
@@ -2086,11 +2180,13 @@ get_scatter_nc_field_double(char   *nc_name,
 
     // Scatter the results to the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    phase_timer_start(PHASE_FORCE_SCATTER);
     status = MPI_Scatterv(dvar_mapped, mpi_map_local_array_sizes,
                           mpi_map_global_array_offsets, MPI_DOUBLE,
                           var, local_domain.ncells_active, MPI_DOUBLE,
                           VIC_MPI_ROOT, MPI_COMM_VIC);
     check_mpi_status(status, "MPI error.");
+    phase_timer_stop(PHASE_FORCE_SCATTER);
 
     if (mpi_rank == VIC_MPI_ROOT) {
         free(dvar_mapped);
@@ -2134,7 +2230,9 @@ get_scatter_nc_field_float(char   *nc_name,
             malloc(global_domain.ncells_active * sizeof(*fvar_mapped));
         check_alloc_status(fvar_mapped, "Memory allocation error.");
 
+        phase_timer_start(PHASE_FORCE_READ);
         get_nc_field_float(nc_name, var_name, start, count, fvar);
+        phase_timer_stop(PHASE_FORCE_READ);
         // filter the active cells only
         map(sizeof(float), global_domain.ncells_active, filter_active_cells,
             NULL,
@@ -2149,11 +2247,13 @@ get_scatter_nc_field_float(char   *nc_name,
 
     // Scatter the results to the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    phase_timer_start(PHASE_FORCE_SCATTER);
     status = MPI_Scatterv(fvar_mapped, mpi_map_local_array_sizes,
                           mpi_map_global_array_offsets, MPI_FLOAT,
                           var, local_domain.ncells_active, MPI_FLOAT,
                           VIC_MPI_ROOT, MPI_COMM_VIC);
     check_mpi_status(status, "MPI error.");
+    phase_timer_stop(PHASE_FORCE_SCATTER);
 
     if (mpi_rank == VIC_MPI_ROOT) {
         free(fvar_mapped);
@@ -2196,7 +2296,9 @@ get_scatter_nc_field_int(char   *nc_name,
             malloc(global_domain.ncells_active * sizeof(*ivar_mapped));
         check_alloc_status(ivar_mapped, "Memory allocation error.");
 
+        phase_timer_start(PHASE_FORCE_READ);
         get_nc_field_int(nc_name, var_name, start, count, ivar);
+        phase_timer_stop(PHASE_FORCE_READ);
         // filter the active cells only
         map(sizeof(int), global_domain.ncells_active, filter_active_cells, NULL,
             ivar, ivar_filtered);
@@ -2210,11 +2312,13 @@ get_scatter_nc_field_int(char   *nc_name,
 
     // Scatter the results to the nodes, result for the local node is in the
     // array *var (which is a function argument)
+    phase_timer_start(PHASE_FORCE_SCATTER);
     status = MPI_Scatterv(ivar_mapped, mpi_map_local_array_sizes,
                           mpi_map_global_array_offsets, MPI_INT,
                           var, local_domain.ncells_active, MPI_INT,
                           VIC_MPI_ROOT, MPI_COMM_VIC);
     check_mpi_status(status, "MPI error.");
+    phase_timer_stop(PHASE_FORCE_SCATTER);
 
     if (mpi_rank == VIC_MPI_ROOT) {
         free(ivar_mapped);
@@ -2405,3 +2509,41 @@ main(int    argc,
 }
 
 #endif
+
+/******************************************************************************
+ * @brief   Report the number of warnings issued by all processes.
+ * @details Each process lists its own warnings by call site when logging is
+ *          finalized.  This adds the totals over all processes, and the
+ *          largest total of a single process, to the log of the master
+ *          process.  Must be called by all processes.
+ *****************************************************************************/
+void
+reduce_warning_totals(void)
+{
+    extern MPI_Comm    MPI_COMM_VIC;
+    extern int         mpi_rank;
+
+    size_t             total;
+    size_t             suppressed;
+    unsigned long long local[2];
+    unsigned long long sum[2];
+    unsigned long long max[2];
+    int                status;
+
+    get_warning_totals(&total, &suppressed);
+    local[0] = (unsigned long long) total;
+    local[1] = (unsigned long long) suppressed;
+
+    status = MPI_Reduce(local, sum, 2, MPI_UNSIGNED_LONG_LONG, MPI_SUM,
+                        VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+    status = MPI_Reduce(local, max, 2, MPI_UNSIGNED_LONG_LONG, MPI_MAX,
+                        VIC_MPI_ROOT, MPI_COMM_VIC);
+    check_mpi_status(status, "MPI error.");
+
+    if (mpi_rank == VIC_MPI_ROOT && sum[0] > 0) {
+        fprintf(LOG_DEST, "[WARN] All processes: %llu warnings, %llu not "
+                "printed, at most %llu on one process\n", sum[0], sum[1],
+                max[0]);
+    }
+}
@@ -101,6 +101,16 @@ set_nc_var_info(unsigned int       varid,
         nc_var->nc_counts[2] = nc_hist_file->nj_size;
         nc_var->nc_counts[3] = nc_hist_file->ni_size;
         break;
+    case OUT_SOLVER_CALLS:
+    case OUT_SOLVER_EVALS:
+    case OUT_SOLVER_EXPANSIONS:
+    case OUT_SOLVER_FALLBACKS:
+    case OUT_SOLVER_MAXITER:
+        nc_var->nc_dims = 4;
+        nc_var->nc_counts[1] = nc_hist_file->solver_size;
+        nc_var->nc_counts[2] = nc_hist_file->nj_size;
+        nc_var->nc_counts[3] = nc_hist_file->ni_size;
+        break;
     default:
         nc_var->nc_dims = 3;
         nc_var->nc_counts[1] = nc_hist_file->nj_size;
@@ -178,6 +188,16 @@ set_nc_var_dimids(unsigned int    varid,
         nc_var->nc_dimids[2] = nc_hist_file->nj_dimid;
         nc_var->nc_dimids[3] = nc_hist_file->ni_dimid;
         break;
+    case OUT_SOLVER_CALLS:
+    case OUT_SOLVER_EVALS:
+    case OUT_SOLVER_EXPANSIONS:
+    case OUT_SOLVER_FALLBACKS:
+    case OUT_SOLVER_MAXITER:
+        nc_var->nc_dimids[0] = nc_hist_file->time_dimid;
+        nc_var->nc_dimids[1] = nc_hist_file->solver_dimid;
+        nc_var->nc_dimids[2] = nc_hist_file->nj_dimid;
+        nc_var->nc_dimids[3] = nc_hist_file->ni_dimid;
+        break;
     default:
         nc_var->nc_dimids[0] = nc_hist_file->time_dimid;
         nc_var->nc_dimids[1] = nc_hist_file->nj_dimid;
@@ -1295,6 +1295,7 @@ set_nc_state_file_info(nc_file_struct *nc_state_file)
     nc_state_file->nj_dimid = MISSING;
     nc_state_file->node_dimid = MISSING;
     nc_state_file->root_zone_dimid = MISSING;
+    nc_state_file->solver_dimid = MISSING;
     nc_state_file->time_dimid = MISSING;
     nc_state_file->veg_dimid = MISSING;
 
@@ -1307,6 +1308,7 @@ set_nc_state_file_info(nc_file_struct *nc_state_file)
     nc_state_file->nj_size = global_domain.n_ny;
     nc_state_file->node_size = options.Nnode;
     nc_state_file->root_zone_size = options.ROOT_ZONES;
+    nc_state_file->solver_size = N_SOLVER_SITES;
     nc_state_file->time_size = NC_UNLIMITED;
     nc_state_file->veg_size = options.NVEGTYPES;
 
@@ -94,7 +94,6 @@ extern size_t NR;       /**< array index for force struct that indicates
                              the model step avarage or sum */
 extern size_t NF;       /**< array index loop counter limit for force
                              struct that indicates the SNOW_STEP values */
-char          vic_run_ref_str[MAXSTRING];
 
 /******************************************************************************
  * @brief   Snow Density parametrizations
@@ -105,6 +104,15 @@ enum
     DENS_SNTHRM
 };
 
+/******************************************************************************
+ * @brief   Math kernel options
+ *****************************************************************************/
+enum
+{
+    MATH_EXACT,
+    MATH_FUSED
+};
+
 /******************************************************************************
  * @brief   Baseflow parametrizations
  *****************************************************************************/
@@ -161,6 +169,32 @@ enum
     PHOTO_C4
 };
 
+/******************************************************************************
+ * @brief   Solver call sites counted by the solver statistics
+ *****************************************************************************/
+enum
+{
+    SOLVER_SURF_ENERGY_BAL,      /**< surface temperature, calc_surf_energy_bal */
+    SOLVER_CANOPY_ENERGY_BAL,    /**< foliage temperature, snow_intercept */
+    SOLVER_ATMOS_ENERGY_BAL,     /**< canopy air temperature,
+                                    calc_atmos_energy_bal */
+    SOLVER_SNOW_PACK_ENERGY_BAL, /**< snow surface temperature, snow_melt */
+    SOLVER_ICE_ENERGY_BAL,       /**< lake snow surface temperature, ice_melt */
+    SOLVER_SOIL_THERMAL,         /**< explicit soil temperature profile,
+                                    calc_soil_thermal_fluxes */
+    SOLVER_SOIL_THERMAL_NODE,    /**< frozen node temperature,
+                                    calc_soil_thermal_fluxes */
+    SOLVER_HEAT_EQN_IMPLICIT,    /**< implicit soil temperature profile,
+                                    solve_T_profile_implicit */
+    SOLVER_GRND_FLUX_ITER,       /**< snow/ground flux iteration,
+                                    surface_fluxes */
+    SOLVER_CANOPY_ITER,          /**< canopy temperature iteration,
+                                    surface_fluxes */
+    // Last value of enum - DO NOT ADD ANYTHING BELOW THIS LINE!!
+    // used as a loop counter and must be >= the largest value in this enum
+    N_SOLVER_SITES               /**< used as a loop counter */
+};
+
 /***** Data Structures *****/
 
 /******************************************************************************
@@ -170,6 +204,8 @@ typedef struct {
     // simulation modes
     short AboveTreelineVeg;  /**< Default veg type to use above treeline;
                                 Negative number indicates bare soil. */
+    bool ADAPTIVE_SNOW_STEP;  /**< TRUE = merge consecutive snow steps while
+                                 the snowpack changes slowly */
     unsigned short int AERO_RESIST_CANSNOW;  /**< "AR_406" = multiply aerodynamic resistance
                                                 by 10 for latent heat but not
                                                 for sensible heat (as in
@@ -200,6 +236,8 @@ typedef struct {
     bool BLOWING_SIMPLE;
     bool BLOWING_FETCH;
     bool BLOWING_SPATIAL_WIND;
+    bool BLOWING_TABLE;  /**< TRUE = interpolate the blowing snow suspension
+                            layer integrals from a lookup table */
     bool CARBON;         /**< TRUE = simulate carbon cycling processes;
                             FALSE = no carbon cycling (default) */
     bool CLOSE_ENERGY;   /**< TRUE = all energy balance calculations are
@@ -217,6 +255,10 @@ typedef struct {
                             FALSE = RESOLUTION stores grid cell side length in degrees */
     bool EXP_TRANS;      /**< TRUE = Uses grid transform for exponential node
                             distribution for soil heat flux calculations*/
+    bool FROZEN_NEWTON;  /**< TRUE = solve the explicit soil temperature
+                            profile with Newton iterations on the full
+                            tridiagonal system, falling back to
+                            Gauss-Seidel sweeps on failure */
     bool FROZEN_SOIL;    /**< TRUE = Use frozen soils code */
     bool FULL_ENERGY;    /**< TRUE = Use full energy code */
     unsigned short int GRND_FLUX_TYPE; /**< "GF_406"  = use (flawed) formulas for ground flux, deltaH, and fusion
@@ -224,10 +266,17 @@ typedef struct {
                                           "GF_410"  = use formulas from VIC 4.1.0 */
     bool IMPLICIT;       /**< TRUE = Use implicit solution when computing
                             soil thermal fluxes */
+    bool ANALYTIC_JACOBIAN; /**< TRUE = use the analytic Jacobian of the
+                               implicit soil thermal solution instead of
+                               finite differences */
     bool JULY_TAVG_SUPPLIED; /**< If TRUE and COMPUTE_TREELINE is also true,
                                 then average July air temperature will be read
                                 from soil file and used in calculating treeline */
     bool LAKES;          /**< TRUE = use lake energy code */
+    unsigned short int MATH_KERNELS; /**< MATH_EXACT: evaluate the soil
+                                        thermal property kernels as written;
+                                        MATH_FUSED: use the fused exp/log
+                                        forms, accurate to 1e-12 */
     size_t Ncanopy;      /**< Number of canopy layers in the model. */
     size_t Nfrost;       /**< Number of frost subareas in model */
     size_t Nlakenode;    /**< Number of lake thermal nodes in the model. */
@@ -248,6 +297,10 @@ typedef struct {
     bool QUICK_SOLVE;    /**< TRUE = Use Liang et al., 1999 formulation for
                             iteration, but explicit finite difference
                             method for final step. */
+    bool SECANT_SOLVE;   /**< TRUE = solve the surface and snow pack energy
+                            balances with a secant method warm-started
+                            from the previous temperature, falling back
+                            to the Brent method on failure */
     bool SHARE_LAYER_MOIST; /**< TRUE = transpiration in moisture-limited layers can draw from other layers (default) */
     unsigned short int SNOW_DENSITY;   /**< DENS_BRAS: Use algorithm of Bras, 1990; DENS_SNTHRM: Use algorithm of SNTHRM89 adapted for 1-layer pack */
     size_t SNOW_BAND;    /**< Number of elevation bands over which to solve the
@@ -291,6 +344,11 @@ typedef struct {
 
     // output options
     size_t Noutstreams;  /**< Number of output stream */
+    bool OUTPUT_CONTAINER; /**< TRUE = append the records of all grid cells
+                              to one container file per output stream */
+
+    // timing options
+    bool PHASE_TIMERS;   /**< TRUE = time the phases of each model step */
 } option_struct;
 
 /******************************************************************************
@@ -318,6 +376,8 @@ typedef struct {
                                            forcing files; updated after every read */
     unsigned int forceskip[2];   /**< number of model time steps to skip at
                                       the start of the forcing file */
+    size_t force_window;         /**< number of days of forcing held in
+                                    memory at a time (0 = whole simulation) */
     unsigned short int forceyear[2];  /**< year forcing files start */
     size_t nrecs;                /**< Number of time steps simulated */
     unsigned short int startday;  /**< Starting day of the simulation */
@@ -515,6 +575,12 @@ typedef struct {
     double TOL_GRND;
     double TOL_OVER;
 
+    // Adaptive Snow Step Parameters
+    int SNOW_STEP_MAX;  /**< Maximum number of snow steps merged into one step */
+    double SNOW_STEP_SWE_TOL;  /**< Change in snow water equivalent per snow step above which steps are not merged (m) */
+    double SNOW_STEP_TSURF_TOL;  /**< Change in snow surface temperature per snow step above which steps are not merged (C) */
+    double SNOW_STEP_FLUX_TOL;  /**< Snow/ground heat flux iteration residual above which steps are not merged (W/m2) */
+
     // Frozen Soil Parameters
     int FROZEN_MAXITER;
 
@@ -528,12 +594,17 @@ typedef struct {
     double NEWT_RAPH_RELAX2;
     double NEWT_RAPH_RELAX3;
     double NEWT_RAPH_EPS2;
+    int NEWT_RAPH_JAC_REUSE;
 
     // Root-Brent parameters
     int ROOT_BRENT_MAXTRIES;
     int ROOT_BRENT_MAXITER;
     double ROOT_BRENT_TSTEP;
     double ROOT_BRENT_T;
+
+    // Root-Secant parameters
+    int ROOT_SECANT_MAXITER;
+    double ROOT_SECANT_TSTEP;
 } parameters_struct;
 
 /******************************************************************************
@@ -825,18 +896,11 @@ typedef struct {
     double AlbedoOver;           /**< albedo of intercepted snow (fract) */
     double AlbedoUnder;          /**< surface albedo (fraction) */
     double Cs[2];                /**< heat capacity for top two layers (J/m^3/K) */
-    double Cs_node[MAX_NODES];   /**< heat capacity of the soil thermal nodes (J/m^3/K) */
     double fdepth[MAX_FRONTS];   /**< all simulated freezing front depths */
     bool frozen;                   /**< TRUE = frozen soil present */
-    double ice[MAX_NODES];       /**< thermal node ice content */
     double kappa[2];             /**< soil thermal conductivity for top two layers (W/m/K) */
-    double kappa_node[MAX_NODES]; /**< thermal conductivity of the soil thermal nodes (W/m/K) */
-    double moist[MAX_NODES];     /**< thermal node moisture content */
     size_t Nfrost;               /**< number of simulated freezing fronts */
     size_t Nthaw;                /**< number of simulated thawing fronts */
-    double T[MAX_NODES];         /**< thermal node temperatures (C) */
-    bool T_fbflag[MAX_NODES];      /**< flag indicating if previous step's temperature was used */
-    unsigned int T_fbcount[MAX_NODES]; /**< running total number of times that previous step's temperature was used */
     int T1_index;                   /**< soil node at the bottom of the top layer */
     double Tcanopy;              /**< temperature of the canopy air */
     bool Tcanopy_fbflag;           /**< flag indicating if previous step's temperature was used */
@@ -888,6 +952,15 @@ typedef struct {
     double ShortOverIn;          /**< incoming shortwave to overstory */
     double ShortUnderIn;         /**< incoming shortwave to understory */
     double snow_flux;            /**< thermal flux through the snow pack (Wm-2) */
+    // Soil thermal node states.  Keep them last, starting with Cs_node:
+    // copy_energy_bal() copies the fields above in one block.
+    double Cs_node[MAX_NODES];   /**< heat capacity of the soil thermal nodes (J/m^3/K) */
+    double ice[MAX_NODES];       /**< thermal node ice content */
+    double kappa_node[MAX_NODES]; /**< thermal conductivity of the soil thermal nodes (W/m/K) */
+    double moist[MAX_NODES];     /**< thermal node moisture content */
+    double T[MAX_NODES];         /**< thermal node temperatures (C) */
+    bool T_fbflag[MAX_NODES];      /**< flag indicating if previous step's temperature was used */
+    unsigned int T_fbcount[MAX_NODES]; /**< running total number of times that previous step's temperature was used */
 } energy_bal_struct;
 
 /******************************************************************************
@@ -1008,6 +1081,7 @@ typedef struct {
     double z[MAX_LAKE_NODES + 1]; /**< Elevation of each lake node (when lake storage is at maximum), relative to lake's deepest point (m) */
     double basin[MAX_LAKE_NODES + 1]; /**< Area of lake basin at each lake node (when lake storage is at maximum) (m^2) */
     double Cl[MAX_LAKE_NODES + 1]; /**< Fractional coverage of lake basin at each node (when lake storage is at maximum) (fraction of grid cell area) */
+    double basin_volume[MAX_LAKE_NODES + 1]; /**< Lake volume below each lake node (m^3) */
     double b;                     /**< Exponent in default lake depth-area profile (y=Ax^b) */
     double maxdepth;              /**< Maximum allowable depth of liquid portion of lake (m) */
     double mindepth;              /**< Minimum allowable depth of liquid portion of lake (m) */
@@ -1087,4 +1161,374 @@ typedef struct {
     veg_var_struct **veg_var;     /**< Stores vegetation variables */
 } all_vars_struct;
 
+/******************************************************************************
+ * @brief   This structure stores the terms needed to evaluate the surface
+ *          energy balance residual, func_surf_energy_bal().  It is filled
+ *          once by calc_surf_energy_bal() before each root_brent() solve.
+ *****************************************************************************/
+typedef struct {
+    // general model terms
+    int VEG;                     /**< true if vegetation is present */
+    int veg_class;               /**< vegetation class */
+    double delta_t;              /**< model time step (s) */
+    // soil layer terms
+    double Cs1;                  /**< top layer heat capacity (J/m^3/K) */
+    double Cs2;                  /**< second layer heat capacity (J/m^3/K) */
+    double D1;                   /**< top layer thickness (m) */
+    double D2;                   /**< depth below layer boundary considered (m) */
+    double T1_old;               /**< previous temperature at layer boundary (C) */
+    double T2;                   /**< constant deep soil temperature (C) */
+    double Ts_old;               /**< previous surface temperature (C) */
+    double *Told_node;           /**< previous soil node temperatures (C) */
+    double bubble;               /**< top layer bubbling pressure (cm) */
+    double dp;                   /**< soil thermal damping depth (m) */
+    double expt;                 /**< top layer exponent */
+    double ice0;                 /**< top layer ice content */
+    double kappa1;               /**< top layer conductivity (W/m/K) */
+    double kappa2;               /**< second layer conductivity (W/m/K) */
+    double max_moist;            /**< top layer maximum moisture (fraction) */
+    double moist;                /**< top layer moisture (fraction) */
+    double *root;                /**< root fractions */
+    double *CanopLayerBnd;       /**< canopy layer boundaries */
+    // meteorological forcing terms
+    int UnderStory;              /**< understory index */
+    int overstory;               /**< true if overstory is present */
+    double NetShortBare;         /**< net SW that reaches bare ground (W/m^2) */
+    double NetShortGrnd;         /**< net SW that penetrates snowpack (W/m^2) */
+    double NetShortSnow;         /**< net SW that reaches snow surface (W/m^2) */
+    double Tair;                 /**< temperature of canopy air or atmosphere (C) */
+    double atmos_density;        /**< atmospheric density (kg/m^3) */
+    double atmos_pressure;       /**< atmospheric pressure (kPa) */
+    double emissivity;           /**< surface emissivity */
+    double LongBareIn;           /**< incoming LW to snow-free surface (W/m^2) */
+    double LongSnowIn;           /**< incoming LW to snow surface (W/m^2) */
+    double surf_atten;           /**< canopy attenuation of radiation */
+    double vp;                   /**< vapor pressure (kPa) */
+    double vpd;                  /**< vapor pressure deficit (kPa) */
+    double shortwave;            /**< incoming shortwave (W/m^2) */
+    double Catm;                 /**< atmospheric CO2 mixing ratio */
+    double *dryFrac;             /**< fraction of canopy that is dry */
+    double *Wdew;                /**< canopy dew storage (mm) */
+    double *displacement;        /**< displacement heights (m) */
+    double *ra;                  /**< aerodynamic resistances (s/m) */
+    double *Ra_veg;              /**< vegetation aerodynamic resistances (s/m) */
+    double *Ra_used;             /**< resistances actually used (s/m) */
+    double rainfall;             /**< rainfall (mm) */
+    double *ref_height;          /**< reference heights (m) */
+    double *roughness;           /**< roughness lengths (m) */
+    double *wind;                /**< wind speeds (m/s) */
+    // latent heat terms
+    double Le;                   /**< latent heat of vaporization (J/kg) */
+    // snowpack terms
+    double Advection;            /**< advected energy (W/m^2) */
+    double OldTSurf;             /**< previous snow surface temperature (C) */
+    double Tsnow_surf;           /**< snow surface temperature (C) */
+    double kappa_snow;           /**< snow conductance / depth */
+    double melt_energy;          /**< energy consumed reducing snow coverage */
+    double snow_coverage;        /**< snowpack coverage fraction */
+    double snow_density;         /**< snow density (kg/m^3) */
+    double snow_swq;             /**< snow water equivalent (m) */
+    double snow_water;           /**< snow surface liquid water (m) */
+    double *deltaCC;             /**< change in snow cold content (W/m^2) */
+    double *refreeze_energy;     /**< refreeze energy (W/m^2) */
+    double *vapor_flux;          /**< total snow vapor flux (m) */
+    double *blowing_flux;        /**< blowing snow vapor flux (m) */
+    double *surface_flux;        /**< snow surface vapor flux (m) */
+    // soil node terms
+    int Nnodes;                  /**< number of soil nodes to solve */
+    double *Cs_node;             /**< node heat capacities (J/m^3/K) */
+    double *T_node;              /**< node temperatures (C) */
+    double *Tnew_node;           /**< new node temperatures (C) */
+    char *Tnew_fbflag;           /**< node temperature fallback flags */
+    unsigned *Tnew_fbcount;      /**< node temperature fallback counts */
+    double *alpha;               /**< node thermal solution terms */
+    double *beta;                /**< node thermal solution terms */
+    double *bubble_node;         /**< node bubbling pressures (cm) */
+    double *Zsum_node;           /**< node depths (m) */
+    double *expt_node;           /**< node exponents */
+    double *gamma;               /**< node thermal solution terms */
+    double *ice_node;            /**< node ice contents */
+    double *kappa_node;          /**< node conductivities (W/m/K) */
+    double *max_moist_node;      /**< node maximum moistures */
+    double *moist_node;          /**< node moistures */
+    // model structures
+    soil_con_struct *soil_con;   /**< soil parameters */
+    layer_data_struct *layer;    /**< soil layer variables */
+    veg_var_struct *veg_var;     /**< vegetation variables */
+    // control flags
+    int INCLUDE_SNOW;            /**< true if snow is solved with the surface */
+    int NOFLUX;                  /**< true for no-flux lower boundary */
+    int EXP_TRANS;               /**< true for exponential node spacing */
+    int SNOWING;                 /**< true if it is snowing */
+    int *FIRST_SOLN;             /**< first solution flags */
+    // returned energy balance terms
+    double *NetLongBare;         /**< net LW from snow-free ground (W/m^2) */
+    double *NetLongSnow;         /**< net LW from snow surface (W/m^2) */
+    double *T1;                  /**< temperature at layer boundary (C) */
+    double *deltaH;              /**< change in soil heat storage (W/m^2) */
+    double *fusion;              /**< energy of soil fusion (W/m^2) */
+    double *grnd_flux;           /**< ground heat flux (W/m^2) */
+    double *latent_heat;         /**< latent heat flux (W/m^2) */
+    double *latent_heat_sub;     /**< latent heat of sublimation (W/m^2) */
+    double *sensible_heat;       /**< sensible heat flux (W/m^2) */
+    double *snow_flux;           /**< heat flux through snowpack (W/m^2) */
+    double *store_error;         /**< energy balance error (W/m^2) */
+} surf_energy_bal_ctx_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the terms needed to evaluate the canopy
+ *          energy balance residual, func_canopy_energy_bal().
+ *****************************************************************************/
+typedef struct {
+    // general model parameters
+    double delta_t;              /**< model time step (s) */
+    double elevation;            /**< grid cell elevation (m) */
+    double *Wmax;                /**< layer maximum moisture (mm) */
+    double *Wcr;                 /**< layer critical moisture (mm) */
+    double *Wpwp;                /**< layer wilting point moisture (mm) */
+    double *frost_fract;         /**< frost subarea fractions */
+    // atmospheric condition and forcings
+    double AirDens;              /**< air density (kg/m^3) */
+    double EactAir;              /**< actual vapor pressure of air (Pa) */
+    double Press;                /**< air pressure (Pa) */
+    double Le;                   /**< latent heat of vaporization (J/kg) */
+    double Tcanopy;              /**< canopy air temperature (C) */
+    double Vpd;                  /**< vapor pressure deficit (Pa) */
+    double shortwave;            /**< incoming shortwave (W/m^2) */
+    double Catm;                 /**< atmospheric CO2 mixing ratio */
+    double *dryFrac;             /**< fraction of canopy that is dry */
+    double *Evap;                /**< canopy evaporation */
+    double *Ra;                  /**< aerodynamic resistances (s/m) */
+    double *Ra_used;             /**< resistance actually used (s/m) */
+    double Rainfall;             /**< rainfall (m) */
+    double *Wind;                /**< wind speeds (m/s) */
+    // vegetation terms
+    int veg_class;               /**< vegetation class */
+    double *displacement;        /**< displacement heights (m) */
+    double *ref_height;          /**< reference heights (m) */
+    double *roughness;           /**< roughness lengths (m) */
+    double *root;                /**< root fractions */
+    double *CanopLayerBnd;       /**< canopy layer boundaries */
+    // water flux terms
+    double IntRain;              /**< intercepted rain at start of step (m) */
+    double IntSnow;              /**< intercepted snow (m) */
+    double *Wdew;                /**< intercepted rain (m) */
+    layer_data_struct *layer;    /**< soil layer variables */
+    veg_var_struct *veg_var;     /**< vegetation variables */
+    // energy flux terms
+    double LongOverIn;           /**< incoming LW from sky (W/m^2) */
+    double LongUnderOut;         /**< incoming LW from understory (W/m^2) */
+    double NetShortOver;         /**< net SW in canopy (W/m^2) */
+    double *AdvectedEnergy;      /**< advected energy (W/m^2) */
+    double *LatentHeat;          /**< latent heat flux (W/m^2) */
+    double *LatentHeatSub;       /**< latent heat of sublimation (W/m^2) */
+    double *LongOverOut;         /**< LW emitted by canopy (W/m^2) */
+    double *NetLongOver;         /**< net canopy LW (W/m^2) */
+    double *NetRadiation;        /**< net canopy radiation (W/m^2) */
+    double *RefreezeEnergy;      /**< refreeze energy (W/m^2) */
+    double *SensibleHeat;        /**< sensible heat flux (W/m^2) */
+    double *VaporMassFlux;       /**< intercepted snow vapor flux */
+} canopy_energy_bal_ctx_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the terms needed to evaluate the snow pack
+ *          energy balance residual, SnowPackEnergyBalance().
+ *****************************************************************************/
+typedef struct {
+    // general model parameters
+    double Dt;                   /**< model time step (s) */
+    double Ra;                   /**< aerodynamic resistance (s/m) */
+    double *Ra_used;             /**< stability-corrected resistance (s/m) */
+    // vegetation parameters
+    double Z;                    /**< reference height (m) */
+    double *Z0;                  /**< surface roughness height (m) */
+    // atmospheric forcing variables
+    double AirDens;              /**< air density (kg/m^3) */
+    double EactAir;              /**< actual vapor pressure of air (Pa) */
+    double LongSnowIn;           /**< incoming longwave (W/m^2) */
+    double Lv;                   /**< latent heat of vaporization (J/kg) */
+    double Press;                /**< air pressure (Pa) */
+    double Rain;                 /**< rainfall (m/timestep) */
+    double NetShortUnder;        /**< net incident shortwave (W/m^2) */
+    double Vpd;                  /**< vapor pressure deficit (Pa) */
+    double Wind;                 /**< wind speed (m/s) */
+    // snowpack variables
+    double OldTSurf;             /**< previous surface temperature (C) */
+    double SnowCoverFract;       /**< snow covered fraction */
+    double SnowDepth;            /**< snowpack depth (m) */
+    double SnowDensity;          /**< snowpack density (kg/m^3) */
+    double SurfaceLiquidWater;   /**< surface layer liquid water (m) */
+    double SweSurfaceLayer;      /**< surface layer snow water equivalent (m) */
+    // energy balance components
+    double Tair;                 /**< canopy air / air temperature (C) */
+    double TGrnd;                /**< ground surface temperature (C) */
+    double *AdvectedEnergy;      /**< energy advected by precipitation (W/m^2) */
+    double *AdvectedSensibleHeat; /**< sensible heat advected from snow-free
+                                     area (W/m^2) */
+    double *DeltaColdContent;    /**< change in surface cold content (W/m^2) */
+    double *GroundFlux;          /**< ground heat flux (W/m^2) */
+    double *LatentHeat;          /**< latent heat flux (W/m^2) */
+    double *LatentHeatSub;       /**< latent heat of sublimation (W/m^2) */
+    double *NetLongUnder;        /**< net longwave at snow surface (W/m^2) */
+    double *RefreezeEnergy;      /**< refreeze energy (W/m^2) */
+    double *SensibleHeat;        /**< sensible heat flux (W/m^2) */
+    double *vapor_flux;          /**< total vapor flux (m/timestep) */
+    double *blowing_flux;        /**< blowing snow vapor flux (m/timestep) */
+    double *surface_flux;        /**< pack snow vapor flux (m/timestep) */
+} snow_pack_energy_bal_ctx_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the terms needed to evaluate the lake ice
+ *          snow pack energy balance residual, IceEnergyBalance().
+ *****************************************************************************/
+typedef struct {
+    double Dt;                   /**< model time step (s) */
+    double Ra;                   /**< aerodynamic resistance (s/m) */
+    double *Ra_used;             /**< stability-corrected resistance (s/m) */
+    double Z;                    /**< reference height (m) */
+    double Z0;                   /**< surface roughness height (m) */
+    double Wind;                 /**< wind speed (m/s) */
+    double ShortRad;             /**< net incident shortwave (W/m^2) */
+    double LongRadIn;            /**< incoming longwave (W/m^2) */
+    double AirDens;              /**< air density (kg/m^3) */
+    double Lv;                   /**< latent heat of vaporization (J/kg) */
+    double Tair;                 /**< air temperature (C) */
+    double Press;                /**< air pressure (Pa) */
+    double Vpd;                  /**< vapor pressure deficit (Pa) */
+    double EactAir;              /**< actual vapor pressure of air (Pa) */
+    double Rain;                 /**< rainfall (m/timestep) */
+    double SurfaceLiquidWater;   /**< surface layer liquid water (m) */
+    double *RefreezeEnergy;      /**< refreeze energy (W/m^2) */
+    double *vapor_flux;          /**< total vapor flux (m/timestep) */
+    double *blowing_flux;        /**< blowing snow vapor flux (m/timestep) */
+    double *surface_flux;        /**< pack snow vapor flux (m/timestep) */
+    double *AdvectedEnergy;      /**< energy advected by precipitation (W/m^2) */
+    double Tfreeze;              /**< freezing temperature (C) */
+    double AvgCond;              /**< average snow/ice conductivity */
+    double SWconducted;          /**< shortwave conducted through ice (W/m^2) */
+    double *qf;                  /**< ground heat flux (W/m^2) */
+    double *LatentHeat;          /**< latent heat flux (W/m^2) */
+    double *LatentHeatSub;       /**< latent heat of sublimation (W/m^2) */
+    double *SensibleHeat;        /**< sensible heat flux (W/m^2) */
+    double *LongRadOut;          /**< net longwave (W/m^2) */
+} ice_energy_bal_ctx_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the terms needed to evaluate the frozen soil
+ *          node residual, soil_thermal_eqn().
+ *****************************************************************************/
+typedef struct {
+    double TL;                   /**< temperature of the node below (C) */
+    double TU;                   /**< temperature of the node above (C) */
+    double T0;                   /**< node temperature at previous step (C) */
+    double moist;                /**< node moisture */
+    double max_moist;            /**< node maximum moisture */
+    double bubble;               /**< node bubbling pressure (cm) */
+    double expt;                 /**< node exponent */
+    double ice0;                 /**< node ice content at previous step */
+    double A;                    /**< finite difference coefficient */
+    double B;                    /**< finite difference coefficient */
+    double C;                    /**< finite difference coefficient */
+    double D;                    /**< finite difference coefficient */
+    double E;                    /**< finite difference coefficient */
+    int EXP_TRANS;               /**< true for exponential node spacing */
+    int j;                       /**< node index */
+} soil_thermal_eqn_ctx_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the parameters and work arrays of the
+ *          implicit heat equation residual, fda_heat_eqn(), that is solved
+ *          by newt_raph().
+ *****************************************************************************/
+typedef struct {
+    double deltat;               /**< model time step (s) */
+    int NOFLUX;                  /**< true for no-flux lower boundary */
+    int EXP_TRANS;               /**< true for exponential node spacing */
+    double *T0;                  /**< node temperatures at previous step (C) */
+    double *moist;               /**< node moistures */
+    double *ice;                 /**< node ice contents */
+    double *kappa;               /**< node conductivities (W/m/K) */
+    double *Cs;                  /**< node heat capacities (J/m^3/K) */
+    double *max_moist;           /**< node maximum moistures */
+    double *bubble;              /**< node bubbling pressures (cm) */
+    double *expt;                /**< node exponents */
+    double *alpha;               /**< node thermal solution terms */
+    double *beta;                /**< node thermal solution terms */
+    double *gamma;               /**< node thermal solution terms */
+    double *Zsum;                /**< node depths (m) */
+    double Dp;                   /**< soil thermal damping depth (m) */
+    double *bulk_dens_min;       /**< layer mineral bulk density (kg/m^3) */
+    double *soil_dens_min;       /**< layer mineral soil density (kg/m^3) */
+    double *quartz;              /**< layer quartz content */
+    double *bulk_density;        /**< layer bulk density (kg/m^3) */
+    double *soil_density;        /**< layer soil density (kg/m^3) */
+    double *organic;             /**< layer organic fraction */
+    double *depth;               /**< layer depths (m) */
+    size_t Nlayers;              /**< number of soil layers */
+    // terms derived at initialization
+    double Ts;                   /**< surface boundary temperature (C) */
+    double Tb;                   /**< bottom boundary temperature (C) */
+    double Bexp;                 /**< exponential node spacing factor */
+    // work arrays
+    double ice_new[MAX_NODES];   /**< updated node ice contents */
+    double Cs_new[MAX_NODES];    /**< updated node heat capacities */
+    double kappa_new[MAX_NODES]; /**< updated node conductivities */
+    double DT[MAX_NODES];        /**< temperature differences */
+    double DT_down[MAX_NODES];   /**< downward temperature differences */
+    double DT_up[MAX_NODES];     /**< upward temperature differences */
+    double Dkappa[MAX_NODES];    /**< conductivity differences */
+} fda_heat_eqn_ctx_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the terms needed to evaluate the canopy air
+ *          energy balance residual, func_atmos_energy_bal().
+ *****************************************************************************/
+typedef struct {
+    double Ra;                   /**< aerodynamic resistance (s/m) */
+    double Tair;                 /**< air temperature (C) */
+    double atmos_density;        /**< atmospheric density (kg/m^3) */
+    double InSensible;           /**< incoming sensible heat (W/m^2) */
+    double *SensibleHeat;        /**< sensible heat flux (W/m^2) */
+} atmos_energy_bal_ctx_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the terms needed to evaluate the canopy air
+ *          moisture balance residual, func_atmos_moist_bal().
+ *****************************************************************************/
+typedef struct {
+    double InLatentHeat;         /**< incoming latent heat (W/m^2) */
+    double Lv;                   /**< latent heat of vaporization (J/kg) */
+    double Ra;                   /**< aerodynamic resistance (s/m) */
+    double atmos_density;        /**< atmospheric density (kg/m^3) */
+    double gamma;                /**< psychrometric constant */
+    double vp;                   /**< atmospheric vapor pressure */
+    double *LatentHeat;          /**< latent heat flux (W/m^2) */
+} atmos_moist_bal_ctx_struct;
+
+/******************************************************************************
+ * @brief   This structure stores the cost counters of the solver at one call
+ *          site, accumulated over a vic_run() call.
+ *****************************************************************************/
+typedef struct {
+    size_t calls;                /**< number of solver calls; a solve handed
+                                    to a fallback counts once per solver */
+    size_t evals;                /**< number of residual evaluations, or of
+                                    iterations of a solver loop */
+    size_t expansions;           /**< number of bracket expansions */
+    size_t fallbacks;            /**< number of solves handed to a slower
+                                    fallback method */
+    size_t maxiter;              /**< number of solves stopped by an
+                                    iteration limit */
+} solver_stats_struct;
+
+/******************************************************************************
+ * @brief   This structure identifies the grid cell and time step that
+ *          vic_run() is working on, for diagnostic messages.
+ *****************************************************************************/
+typedef struct {
+    size_t cell;                 /**< grid cell identifier of the driver */
+    size_t step;                 /**< time step index */
+    dmy_struct *dmy;             /**< date of the time step */
+} run_context_struct;
+
 #endif
@@ -58,13 +58,34 @@
 #define LOG_LVL 25
 #endif
 
+// Number of times a warning is printed from the same call site.  Further
+// occurrences are only counted, and reported at LOG_WARN_MAX times powers of
+// ten and in the warning summary at the end of the run.  0 = no limit.
+#ifndef LOG_WARN_MAX
+#define LOG_WARN_MAX 10
+#endif
+
 FILE *LOG_DEST;
 
+/******************************************************************************
+ * @brief   Call site of log_warn, with the number of times it was reached
+ *****************************************************************************/
+typedef struct warn_site_struct {
+    const char *file;               /**< source file */
+    int line;                       /**< source line */
+    const char *fmt;                /**< message format */
+    size_t count;                   /**< number of occurrences */
+    struct warn_site_struct *next;  /**< next call site that was reached */
+} warn_site_struct;
+
 void finalize_logging(void);
 void get_logname(const char *path, int id, char *filename);
+void get_warning_totals(size_t *total, size_t *suppressed);
 void initialize_log(void);
 void print_trace(void);
+void print_warning_summary(void);
 void setup_logging(int id, char log_path[], FILE **logfile);
+int warn_site_hit(warn_site_struct *site);
 
 
 // Macros for logging
@@ -94,12 +115,19 @@ void setup_logging(int id, char log_path[], FILE **logfile);
 // Warn Level
 #if LOG_LVL < 30
 #ifdef NO_LINENOS
-#define log_warn(M, ...) fprintf(LOG_DEST, "[WARN] errno: %s: " M "\n", \
-                                 clean_errno(), ## __VA_ARGS__); errno = 0
+#define log_warn(M, ...) do { \
+        static warn_site_struct warn_site_ = {__FILE__, __LINE__, M, 0, NULL}; \
+        if (warn_site_hit(&warn_site_)) { \
+            fprintf(LOG_DEST, "[WARN] errno: %s: " M "\n", \
+                    clean_errno(), ## __VA_ARGS__); } \
+        errno = 0; } while (0)
 #else
-#define log_warn(M, ...) fprintf(LOG_DEST, "[WARN] %s:%d: errno: %s: " M "\n", \
-                                 __FILE__, __LINE__, \
-                                 clean_errno(), ## __VA_ARGS__); errno = 0
+#define log_warn(M, ...) do { \
+        static warn_site_struct warn_site_ = {__FILE__, __LINE__, M, 0, NULL}; \
+        if (warn_site_hit(&warn_site_)) { \
+            fprintf(LOG_DEST, "[WARN] %s:%d: errno: %s: " M "\n", \
+                    __FILE__, __LINE__, clean_errno(), ## __VA_ARGS__); } \
+        errno = 0; } while (0)
 #endif
 #else
 #define log_warn(M, ...)
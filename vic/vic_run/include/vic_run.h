@@ -35,15 +35,21 @@ void advect_snow_storage(double, double, double, snow_data_struct *);
 void advect_soil_veg_storage(double, double, double, double *,
                              soil_con_struct *, veg_con_struct *,
                              cell_data_struct *, veg_var_struct *,
-                             lake_con_struct);
+                             lake_con_struct *);
 double advected_sensible_heat(double, double, double, double, double);
+size_t adapt_snow_step(size_t step_inc, double delta_swq,
+                       double delta_surf_temp, double flux_residual,
+                       double melt, double coverage);
 void alblake(double, double, double *, double *, double *, double *, double,
              double, double, unsigned int *, double, bool *, unsigned short int,
              double);
+void alloc_snow_step_force(force_data_struct *block);
 double arno_evap(layer_data_struct *, double, double, double, double, double,
                  double, double, double, double, double, double *);
 bool assert_close_double(double x, double y, double rtol, double abs_tol);
 bool assert_close_float(float x, float y, float rtol, float abs_tol);
+void average_snow_step_force(force_data_struct *force, size_t hidx, size_t n,
+                             force_data_struct *block);
 double calc_atmos_energy_bal(double, double, double, double, double, double,
                              double, double, double, double, double, double,
                              double, double *, double *, double *, double *,
@@ -70,6 +76,10 @@ int calc_soil_thermal_fluxes(int, double *, double *, char *, unsigned int *,
                              double *, double *, double *, double *, double *,
                              double *, double *, double *, double *, double *,
                              double *, int, int, int);
+int calc_soil_thermal_fluxes_newton(int, double *, double *, double *, double *,
+                                    double *, double *, double *, double *,
+                                    double *, double *, double *, double *,
+                                    int, int, int);
 double calc_surf_energy_bal(double, double, double, double, double, double,
                             double, double, double, double, double, double,
                             double, double, double, double, double, double,
@@ -90,8 +100,6 @@ int CalcAerodynamic(bool, double, double, double, double, double, double *,
 double CalcBlowingSnow(double, double, unsigned int, double, double, double,
                        double, double, double, double, double, double, double,
                        double, int, int, double, double, double, double *);
-double CalcIcePackEnergyBalance(double Tsurf, ...);
-double CalcSnowPackEnergyBalance(double Tsurf, ...);
 double CalcSubFlux(double EactAir, double es, double Zrh, double AirDens,
                    double utshear, double ushear, double fe, double Tsnow,
                    double Tair, double U10, double Zo_salt, double F,
@@ -107,7 +115,8 @@ double canopy_evap(layer_data_struct *, veg_var_struct *, bool,
 void colavg(double *, double *, double *, double, double *, int, double,
             double);
 double compute_coszen(double, double, double, unsigned short int, unsigned int);
-void compute_derived_lake_dimensions(lake_var_struct *, lake_con_struct);
+void compute_derived_lake_dimensions(lake_var_struct *, lake_con_struct *);
+void compute_lake_basin_volume(lake_con_struct *);
 void compute_pot_evap(size_t, double, double, double, double, double, double,
                       double, double, double, double *, char, double, double,
                       double, double *);
@@ -120,6 +129,7 @@ void compute_soil_layer_thermal_properties(layer_data_struct *, double *,
                                            double *, double *, double *,
                                            double *, size_t);
 double compute_zwt(soil_con_struct *, int, double);
+void copy_energy_bal(energy_bal_struct *, energy_bal_struct *, size_t);
 void correct_precip(double *, double, double, double, double);
 double darkinhib(double);
 int distribute_node_moisture_properties(double *, double *, double *, double *,
@@ -130,20 +140,20 @@ int distribute_node_moisture_properties(double *, double *, double *, double *,
 void eddy(int, double, double *, double *, double, int, double, double);
 void energycalc(double *, double *, int, double, double, double *, double *,
                 double *);
-double error_calc_atmos_energy_bal(double Tcanopy, ...);
-double error_calc_atmos_moist_bal(double, ...);
-double error_calc_canopy_energy_bal(double Tsurf, ...);
-double error_calc_surf_energy_bal(double Tsurf, ...);
-double error_print_atmos_energy_bal(double, va_list);
-double error_print_atmos_moist_bal(double, va_list);
-double error_print_canopy_energy_bal(double, va_list);
-double error_print_solve_T_profile(double, va_list);
-double error_print_surf_energy_bal(double, va_list);
-double error_solve_T_profile(double Tsurf, ...);
-double ErrorIcePackEnergyBalance(double Tsurf, ...);
-double ErrorPrintIcePackEnergyBalance(double, va_list);
-int ErrorPrintSnowPackEnergyBalance(double, va_list);
-int ErrorSnowPackEnergyBalance(double Tsurf, ...);
+double error_print_atmos_energy_bal(double, atmos_energy_bal_ctx_struct *,
+                                    double, double);
+double error_print_atmos_moist_bal(double, atmos_moist_bal_ctx_struct *);
+double error_print_canopy_energy_bal(double, canopy_energy_bal_ctx_struct *,
+                                     int, int, int, int, double *);
+double error_print_solve_T_profile(double, soil_thermal_eqn_ctx_struct *,
+                                   double);
+double error_print_surf_energy_bal(double, surf_energy_bal_ctx_struct *,
+                                   dmy_struct *, int, double);
+double ErrorPrintIcePackEnergyBalance(double, ice_energy_bal_ctx_struct *,
+                                      double, double, double, double, double,
+                                      double, double);
+int ErrorPrintSnowPackEnergyBalance(double, snow_pack_energy_bal_ctx_struct *,
+                                    int, int);
 void estimate_frost_temperature_and_depth(double ***, double **, double *,
                                           double *, double *, double *, double,
                                           size_t, size_t);
@@ -160,38 +170,43 @@ int estimate_layer_ice_content_quick_flux(layer_data_struct *, double *,
 double estimate_T1(double, double, double, double, double, double, double,
                    double, double, double);
 void faparl(double *, double, double, double, double, double *, double *);
-void fda_heat_eqn(double *, double *, int, int, ...);
+void fda_heat_eqn(double *, double *, int, int, int, void *);
+void fda_heat_eqn_jac(double *, double *, double *, double *, int, void *);
 void fdjac3(double *, double *, double *, double *, double *, void (*vecfunc)(
-                double *, double *, int, int, ...), int);
+                double *, double *, int, int, int, void *), int, void *);
 void find_0_degree_fronts(energy_bal_struct *, double *, double *, int);
 void free_2d_double(size_t *shape, double **array);
 void free_3d_double(size_t *shape, double ***array);
-double func_atmos_energy_bal(double, va_list);
-double func_atmos_moist_bal(double, va_list);
-double func_canopy_energy_bal(double, va_list);
-double func_surf_energy_bal(double, va_list);
+void free_scratch(void);
+double func_atmos_energy_bal(double, void *);
+double func_atmos_moist_bal(double, void *);
+double func_canopy_energy_bal(double, void *);
+double func_surf_energy_bal(double, void *);
 double (*funcd)(double z, double es, double Wind, double AirDens, double ZO,
                 double EactAir, double F, double hsalt, double phi_r,
                 double ushear,
                 double Zrh);
-int get_depth(lake_con_struct, double, double *);
+int get_depth(lake_con_struct *, double, double *);
 double get_prob(double Tair, double Age, double SurfaceLiquidWater, double U10);
-int get_sarea(lake_con_struct, double, double *);
+int get_sarea(lake_con_struct *, double, double *);
 void get_shear(double x, double *f, double *df, double Ur, double Zr);
+solver_stats_struct *get_solver_stats(size_t site);
 double get_thresh(double Tair, double SurfaceLiquidWater, double Zo_salt);
-int get_volume(lake_con_struct, double, double *);
+int get_volume(lake_con_struct *, double, double *);
 double hiTinhib(double);
 int ice_melt(double, double, double *, double, snow_data_struct *,
              lake_var_struct *, double, double, double, double, double, double,
              double, double, double, double, double, double, double, double,
              double, double *, double *, double *, double *, double *, double *,
              double *, double *, double *);
-double IceEnergyBalance(double, va_list);
+double IceEnergyBalance(double, void *);
 void iceform(double *, double *, double, double, double *, int, double, double,
              double, double *, double *, double *, double *, double);
 void icerad(double, double, double, double *, double *, double *);
-void initialize_lake(lake_var_struct *, lake_con_struct, soil_con_struct *,
+void init_blowing_table(void);
+void initialize_lake(lake_var_struct *, lake_con_struct *, soil_con_struct *,
                      cell_data_struct *, bool);
+void initialize_scratch(void);
 int lakeice(double, double, double, double, double, double *, double, double *,
             double *, double, double);
 void latent_heat_from_snow(double, double, double, double, double, double,
@@ -201,17 +216,24 @@ void latsens(double, double, double, double, double, double, double, double,
              double *, double *, double);
 double linear_interp(double, double, double, double, double);
 double lkdrag(double, double, double, double, double);
+bool lookup_blowing_table(double U10, double ushear, double EactAir, double es,
+                          double F, double Zo_salt, double *sub_integral,
+                          double *trans_integral);
 void malloc_2d_double(size_t *shape, double ***array);
 void malloc_3d_double(size_t *shape, double ****array);
 void MassRelease(double *, double *, double *, double *);
 double maximum_unfrozen_water(double, double, double, double);
 double new_snow_density(double);
-int newt_raph(void (*vecfunc)(double *, double *, int, int,
-                              ...), double *, int);
+int newt_raph(void (*vecfunc)(double *, double *, int, int, int, void *),
+              void (*jacfunc)(double *, double *, double *, double *, int,
+                              void *), double *, int, void *, size_t);
 double penman(double, double, double, double, double, double, double);
 void photosynth(char, double, double, double, double, double, double, double,
                 double, double, char *, double *, double *, double *, double *,
                 double *);
+void photosynth_layers(char, double, double, double, double *, double, double,
+                       double *, double, double, char *, size_t, double *,
+                       double *, double *, double *, double *);
 void polint(double xa[], double ya[], int n, double x, double *y, double *dy);
 void prepare_full_energy(int, all_vars_struct *, soil_con_struct *, double *,
                          double *);
@@ -223,14 +245,26 @@ void rescale_snow_energy_fluxes(double, double, snow_data_struct *,
 void rescale_snow_storage(double, double, snow_data_struct *);
 void rescale_soil_veg_fluxes(double, double, cell_data_struct *,
                              veg_var_struct *);
+void reset_solver_stats(void);
 void rhoinit(double *, double);
-double root_brent(double, double, double (*Function)(double, va_list), ...);
+double root_brent(double, double, double (*Function)(double, void *), void *,
+                  size_t);
+double root_secant(double, double, double, double (*Function)(double, void *),
+                   void *, size_t);
 double rtnewt(double x1, double x2, double xacc, double Ur, double Zr);
+char *run_context_str(void);
 int runoff(cell_data_struct *, energy_bal_struct *, soil_con_struct *, double,
            double *, int);
+double **scratch_2d_double(size_t *shape);
+double ***scratch_3d_double(size_t *shape);
+void *scratch_calloc(size_t nmemb, size_t size);
+size_t scratch_heap_allocs(void);
+size_t scratch_mark(void);
+void scratch_release(size_t mark);
 void set_node_parameters(double *, double *, double *, double *, double *,
                          double *, double *, double *, double *, double *,
                          double *, int, int);
+void set_run_context(size_t cell, size_t step, dmy_struct *dmy);
 void shear_stress(double U10, double ZO, double *ushear, double *Zo_salt,
                   double utshear);
 double snow_albedo(double, double, double, double, double, int, bool);
@@ -250,18 +284,15 @@ int snow_melt(double, double, double, double, double *, double, double *,
               double *, double *, double *, double *, double *, double *,
               double *, double *, double *, double *, int, int, int,
               snow_data_struct *);
-double SnowPackEnergyBalance(double, va_list);
+double SnowPackEnergyBalance(double, void *);
 void soil_carbon_balance(soil_con_struct *, energy_bal_struct *,
                          cell_data_struct *, veg_var_struct *);
 double soil_conductivity(double, double, double, double, double, double, double,
                          double);
-double soil_thermal_eqn(double, va_list);
-double solve_atmos_energy_bal(double Tcanopy, ...);
-double solve_atmos_moist_bal(double, ...);
-double solve_canopy_energy_bal(double Tfoliage, ...);
+double soil_thermal_eqn(double, void *);
 int solve_lake(double, double, double, double, double, double, double, double,
-               double, double, lake_var_struct *, soil_con_struct, double,
-               double, dmy_struct, double);
+               double, double, lake_var_struct *, soil_con_struct *, double,
+               double, dmy_struct *, double);
 double solve_snow(char, double, double, double, double, double, double, double,
                   double, double, double *, double *, double *, double *,
                   double *, double *, double *, double *, double *, double *,
@@ -272,7 +303,6 @@ double solve_snow(char, double, double, double, double, double, double, double,
                   size_t, int, int *, double *, double *, dmy_struct *,
                   force_data_struct *, energy_bal_struct *, layer_data_struct *,
                   snow_data_struct *, soil_con_struct *, veg_var_struct *);
-double solve_surf_energy_bal(double Tsurf, ...);
 int solve_T_profile(double *, double *, char *, unsigned int *, double *,
                     double *, double *, double *, double, double *, double *,
                     double *, double *, double *, double *, double *, double,
@@ -296,6 +326,8 @@ int surface_fluxes(bool, double, double, double, double, double *, double *,
                    energy_bal_struct *, global_param_struct *,
                    cell_data_struct *, snow_data_struct *, soil_con_struct *,
                    veg_var_struct *, double, double, double, double *);
+void suspension_limits(double U10, double ushear, double *hsalt,
+                       double *ztop);
 double svp(double);
 double svp_slope(double);
 void temp_area(double, double, double, double *, double *, double *, double *,
@@ -318,8 +350,9 @@ int vic_run(force_data_struct *, all_vars_struct *, dmy_struct *,
             global_param_struct *, lake_con_struct *, soil_con_struct *,
             veg_con_struct *, veg_lib_struct *);
 double volumetric_heat_capacity(double, double, double, double);
-int water_balance(lake_var_struct *, lake_con_struct, double, all_vars_struct *,
-                  int, int, double, soil_con_struct, veg_con_struct);
+int water_balance(lake_var_struct *, lake_con_struct *, double,
+                  all_vars_struct *, int, int, double, soil_con_struct *,
+                  veg_con_struct *);
 int water_energy_balance(int, double *, double *, double, double, double,
                          double, double, double, double, double, double, double,
                          double, double, double, double *, double *, double *,
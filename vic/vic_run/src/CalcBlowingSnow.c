@@ -320,16 +320,11 @@ polint(double  xa[],
 {
     int     i, m, ns;
     double  den, dif, dift, ho, hp, w;
-    double *c = NULL;
-    double *d = NULL;
+    double  c[n + 1];
+    double  d[n + 1];
 
     ns = 1;
     dif = fabs(x - xa[1]);
-    c = (double *)malloc((size_t) ((n + 1) * sizeof(double)));
-    check_alloc_status(c, "Memory allocation error.");
-    d = (double *)malloc((size_t) ((n + 1) * sizeof(double)));
-    check_alloc_status(d, "Memory allocation error.");
-
 
     for (i = 1; i <= n; i++) {
         if ((dift = fabs(x - xa[i])) < dif) {
@@ -354,8 +349,6 @@ polint(double  xa[],
         }
         *y += (*dy = (2 * ns < (n - m) ? c[ns + 1] : d[ns--]));
     }
-    free(d);
-    free(c);
 }
 
 /******************************************************************************
@@ -718,7 +711,9 @@ CalcSubFlux(double  EactAir,
     double                   SubFlux;
     double                   Qsalt, hsalt;
     double                   phi_s, psi_s;
-    double                   T, ztop;
+    double                   ztop;
+    double                   sub_integral, trans_integral;
+    bool                     use_table;
     double                   particle;
     double                   saltation_transport;
     double                   suspension_transport;
@@ -750,16 +745,17 @@ CalcSubFlux(double  EactAir,
             Qsalt *= (1. + (500. / (3. * fe)) * (exp(-3. * fe / 500.) - 1.));
         }
 
-        // Pomeroy and Male (1992)
-        hsalt = 0.08436 * pow(ushear, 1.27);
+        // Height of the saltation layer and top of the suspension layer
+        suspension_limits(U10, ushear, &hsalt, &ztop);
 
         // Saltation layer mass concentration (kg/m3)
         phi_s = Qsalt / (hsalt * particle);
 
-        T = 0.5 * (ushear * ushear) / (U10 * param.BLOWING_SETTLING);
-        ztop = hsalt *
-               pow(T / (T + 1.),
-                   (CONST_KARMAN * ushear) / (-1. * param.BLOWING_SETTLING));
+        // Suspension layer integrals from the lookup table, if requested
+        use_table = options.BLOWING_TABLE &&
+                    lookup_blowing_table(U10, ushear, EactAir, es, F,
+                                         Zo_salt, &sub_integral,
+                                         &trans_integral);
 
         if (EactAir >= es) {
             SubFlux = 0.0;
@@ -774,19 +770,29 @@ CalcSubFlux(double  EactAir,
             SubFlux = phi_s * psi_s * hsalt;
 
             // Suspension layer must be integrated
-            SubFlux += qromb(sub_with_height, es, U10, AirDens, Zo_salt,
-                             EactAir, F, hsalt,
-                             phi_s, ushear, Zrh, hsalt, ztop);
+            if (use_table) {
+                SubFlux += phi_s * sub_integral;
+            }
+            else {
+                SubFlux += qromb(sub_with_height, es, U10, AirDens, Zo_salt,
+                                 EactAir, F, hsalt,
+                                 phi_s, ushear, Zrh, hsalt, ztop);
+            }
         }
 
         // Transport out of the domain by saltation Qs(fe) (kg/m*s), eq 10 Liston and Sturm
         saltation_transport = Qsalt * (1 - exp(-3. * fe / 500.));
 
         // Transport in the suspension layer
-        suspension_transport = qromb(transport_with_height, es, U10, AirDens,
-                                     Zo_salt,
-                                     EactAir, F, hsalt, phi_s, ushear, Zrh,
-                                     hsalt, ztop);
+        if (use_table) {
+            suspension_transport = phi_s * trans_integral;
+        }
+        else {
+            suspension_transport = qromb(transport_with_height, es, U10,
+                                         AirDens, Zo_salt,
+                                         EactAir, F, hsalt, phi_s, ushear,
+                                         Zrh, hsalt, ztop);
+        }
 
         // Transport at the downstream edge of the fetch in kg/m*s
         *Transport = (suspension_transport + saltation_transport);
@@ -798,6 +804,29 @@ CalcSubFlux(double  EactAir,
     return SubFlux;
 }
 
+/******************************************************************************
+ * @brief    Calculate the height of the saltation layer and the top of the
+ *           suspension layer.
+ *****************************************************************************/
+void
+suspension_limits(double  U10,
+                  double  ushear,
+                  double *hsalt,
+                  double *ztop)
+{
+    extern parameters_struct param;
+
+    double                   T;
+
+    // Pomeroy and Male (1992)
+    *hsalt = 0.08436 * pow(ushear, 1.27);
+
+    T = 0.5 * (ushear * ushear) / (U10 * param.BLOWING_SETTLING);
+    *ztop = *hsalt *
+            pow(T / (T + 1.),
+                (CONST_KARMAN * ushear) / (-1. * param.BLOWING_SETTLING));
+}
+
 /******************************************************************************
  * @brief    Calculate the transport rate for a given height above the boundary
  *           layer.
@@ -30,12 +30,14 @@
  * @brief    Calculate the surface energy balance for the snow pack.
  *****************************************************************************/
 double
-IceEnergyBalance(double  TSurf,
-                 va_list ap)
+IceEnergyBalance(double TSurf,
+                 void  *ctx)
 {
     extern parameters_struct param;
 
-    /* start of list of arguments in variable argument list */
+    ice_energy_bal_ctx_struct *c = (ice_energy_bal_ctx_struct *) ctx;
+
+    /* solver context terms */
 
     double  Dt;                  /* Model time step (seconds) */
     double  Ra;                  /* Aerodynamic resistance (s/m) */
@@ -70,7 +72,7 @@ IceEnergyBalance(double  TSurf,
     double *SensibleHeat;       /* Sensible heat exchange at surface (W/m2) */
     double *LongRadOut;
 
-    /* end of list of arguments in variable argument list */
+    /* end of solver context terms */
 
     double Density;              /* Density of water/ice at TMean (kg/m3) */
     double NetRad;                      /* Net radiation exchange at surface (W/m2) */
@@ -85,47 +87,36 @@ IceEnergyBalance(double  TSurf,
     double SurfaceMassFlux;      /* Mass flux of water vapor to or from
                                     snow pack (kg/m2s) */
 
-    /* Assign the elements of the array to the appropriate variables.  The list
-       is traversed as if the elements are doubles, because:
-
-       In the variable-length part of variable-length argument lists, the old
-       ``default argument promotions'' apply: arguments of type double are
-       always promoted (widened) to type double, and types char and short int
-       are promoted to int. Therefore, it is never correct to invoke
-       va_arg(argp, double); instead you should always use va_arg(argp,
-       double).
-
-       (quoted from the comp.lang.c FAQ list)
-     */
-    Dt = (double) va_arg(ap, double);
-    Ra = (double) va_arg(ap, double);
-    Ra_used = (double *) va_arg(ap, double *);
-    Z = (double) va_arg(ap, double);
-    Z0 = (double) va_arg(ap, double);
-    Wind = (double) va_arg(ap, double);
-    ShortRad = (double) va_arg(ap, double);
-    LongRadIn = (double) va_arg(ap, double);
-    AirDens = (double) va_arg(ap, double);
-    Lv = (double) va_arg(ap, double);
-    Tair = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    Rain = (double) va_arg(ap, double);
-    SurfaceLiquidWater = (double) va_arg(ap, double);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    vapor_flux = (double *) va_arg(ap, double *);
-    blowing_flux = (double *) va_arg(ap, double *);
-    surface_flux = (double *) va_arg(ap, double *);
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    Tfreeze = (double) va_arg(ap, double);
-    AvgCond = (double) va_arg(ap, double);
-    SWconducted = (double) va_arg(ap, double);
-    qf = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    LongRadOut = (double *) va_arg(ap, double *);
+    /* Read variables from the solver context */
+    Dt = c->Dt;
+    Ra = c->Ra;
+    Ra_used = c->Ra_used;
+    Z = c->Z;
+    Z0 = c->Z0;
+    Wind = c->Wind;
+    ShortRad = c->ShortRad;
+    LongRadIn = c->LongRadIn;
+    AirDens = c->AirDens;
+    Lv = c->Lv;
+    Tair = c->Tair;
+    Press = c->Press;
+    Vpd = c->Vpd;
+    EactAir = c->EactAir;
+    Rain = c->Rain;
+    SurfaceLiquidWater = c->SurfaceLiquidWater;
+    RefreezeEnergy = c->RefreezeEnergy;
+    vapor_flux = c->vapor_flux;
+    blowing_flux = c->blowing_flux;
+    surface_flux = c->surface_flux;
+    AdvectedEnergy = c->AdvectedEnergy;
+    Tfreeze = c->Tfreeze;
+    AvgCond = c->AvgCond;
+    SWconducted = c->SWconducted;
+    qf = c->qf;
+    LatentHeat = c->LatentHeat;
+    LatentHeatSub = c->LatentHeatSub;
+    SensibleHeat = c->SensibleHeat;
+    LongRadOut = c->LongRadOut;
 
     /* Calculate active temp for energy balance as average of old and new  */
 
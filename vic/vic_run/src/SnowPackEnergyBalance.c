@@ -30,13 +30,15 @@
  * @brief    Calculate the surface energy balance for the snow pack.
  *****************************************************************************/
 double
-SnowPackEnergyBalance(double  TSurf,
-                      va_list ap)
+SnowPackEnergyBalance(double TSurf,
+                      void  *ctx)
 {
     extern option_struct     options;
     extern parameters_struct param;
 
-    /* Define Variable Argument List */
+    snow_pack_energy_bal_ctx_struct *c = (snow_pack_energy_bal_ctx_struct *) ctx;
+
+    /* Solver Context Terms */
 
     /* General Model Parameters */
     double  Dt;                   /* Model time step (sec) */
@@ -106,63 +108,52 @@ SnowPackEnergyBalance(double  TSurf,
     double BlowingMassFlux;       /* Mass flux of water vapor from blowing snow. (kg/m2s) */
     double SurfaceMassFlux;       /* Mass flux of water vapor from pack snow. (kg/m2s) */
 
-    /* Assign the elements of the array to the appropriate variables.  The list
-       is traversed as if the elements are doubles, because:
-
-       In the variable-length part of variable-length argument lists, the old
-       ``default argument promotions'' apply: arguments of type double are
-       always promoted (widened) to type double, and types char and short int
-       are promoted to int. Therefore, it is never correct to invoke
-       va_arg(argp, double); instead you should always use va_arg(argp,
-       double).
-
-       (quoted from the comp.lang.c FAQ list)
-     */
+    /* Read variables from the solver context */
 
     /* General Model Parameters */
-    Dt = (double) va_arg(ap, double);
-    Ra = (double) va_arg(ap, double);
-    Ra_used = (double *) va_arg(ap, double *);
+    Dt = c->Dt;
+    Ra = c->Ra;
+    Ra_used = c->Ra_used;
 
     /* Vegetation Parameters */
-    Z = (double) va_arg(ap, double);
-    Z0 = (double *) va_arg(ap, double *);
+    Z = c->Z;
+    Z0 = c->Z0;
 
     /* Atmospheric Forcing Variables */
-    AirDens = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    LongSnowIn = (double) va_arg(ap, double);
-    Lv = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Rain = (double) va_arg(ap, double);
-    NetShortUnder = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    Wind = (double) va_arg(ap, double);
+    AirDens = c->AirDens;
+    EactAir = c->EactAir;
+    LongSnowIn = c->LongSnowIn;
+    Lv = c->Lv;
+    Press = c->Press;
+    Rain = c->Rain;
+    NetShortUnder = c->NetShortUnder;
+    Vpd = c->Vpd;
+    Wind = c->Wind;
 
     /* Snowpack Variables */
-    OldTSurf = (double) va_arg(ap, double);
-    SnowCoverFract = (double) va_arg(ap, double);
-    SnowDepth = (double) va_arg(ap, double);
-    SnowDensity = (double) va_arg(ap, double);
-    SurfaceLiquidWater = (double) va_arg(ap, double);
-    SweSurfaceLayer = (double) va_arg(ap, double);
+    OldTSurf = c->OldTSurf;
+    SnowCoverFract = c->SnowCoverFract;
+    SnowDepth = c->SnowDepth;
+    SnowDensity = c->SnowDensity;
+    SurfaceLiquidWater = c->SurfaceLiquidWater;
+    SweSurfaceLayer = c->SweSurfaceLayer;
 
     /* Energy Balance Components */
-    Tair = (double) va_arg(ap, double);
-    TGrnd = (double) va_arg(ap, double);
-
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    AdvectedSensibleHeat = (double *)va_arg(ap, double *);
-    DeltaColdContent = (double *) va_arg(ap, double *);
-    GroundFlux = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    NetLongUnder = (double *) va_arg(ap, double *);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    vapor_flux = (double *) va_arg(ap, double *);
-    blowing_flux = (double *) va_arg(ap, double *);
-    surface_flux = (double *) va_arg(ap, double *);
+    Tair = c->Tair;
+    TGrnd = c->TGrnd;
+
+    AdvectedEnergy = c->AdvectedEnergy;
+    AdvectedSensibleHeat = c->AdvectedSensibleHeat;
+    DeltaColdContent = c->DeltaColdContent;
+    GroundFlux = c->GroundFlux;
+    LatentHeat = c->LatentHeat;
+    LatentHeatSub = c->LatentHeatSub;
+    NetLongUnder = c->NetLongUnder;
+    RefreezeEnergy = c->RefreezeEnergy;
+    SensibleHeat = c->SensibleHeat;
+    vapor_flux = c->vapor_flux;
+    blowing_flux = c->blowing_flux;
+    surface_flux = c->surface_flux;
 
     /* Calculate active temp for energy balance as average of old and new  */
 
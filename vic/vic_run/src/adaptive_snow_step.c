@@ -0,0 +1,171 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Step size control of the adaptive snow sub-steps of surface_fluxes().
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_run.h>
+
+/******************************************************************************
+ * @brief    Allocate a single-element forcing structure from the scratch
+ *           arena, to hold the forcing of a merged snow sub-step.
+ *****************************************************************************/
+void
+alloc_snow_step_force(force_data_struct *block)
+{
+    block->air_temp = scratch_calloc(1, sizeof(*(block->air_temp)));
+    block->Catm = scratch_calloc(1, sizeof(*(block->Catm)));
+    block->channel_in = scratch_calloc(1, sizeof(*(block->channel_in)));
+    block->coszen = scratch_calloc(1, sizeof(*(block->coszen)));
+    block->density = scratch_calloc(1, sizeof(*(block->density)));
+    block->fdir = scratch_calloc(1, sizeof(*(block->fdir)));
+    block->longwave = scratch_calloc(1, sizeof(*(block->longwave)));
+    block->par = scratch_calloc(1, sizeof(*(block->par)));
+    block->prec = scratch_calloc(1, sizeof(*(block->prec)));
+    block->pressure = scratch_calloc(1, sizeof(*(block->pressure)));
+    block->shortwave = scratch_calloc(1, sizeof(*(block->shortwave)));
+    block->snowflag = scratch_calloc(1, sizeof(*(block->snowflag)));
+    block->vp = scratch_calloc(1, sizeof(*(block->vp)));
+    block->vpd = scratch_calloc(1, sizeof(*(block->vpd)));
+    block->wind = scratch_calloc(1, sizeof(*(block->wind)));
+}
+
+/******************************************************************************
+ * @brief    Sum of n consecutive elements of a forcing array
+ *****************************************************************************/
+static double
+sum_snow_steps(double *ar,
+               size_t  n)
+{
+    size_t i;
+    double sum;
+
+    sum = 0.;
+    for (i = 0; i < n; i++) {
+        sum += ar[i];
+    }
+
+    return sum;
+}
+
+/******************************************************************************
+ * @brief    Combine the forcing of n consecutive snow sub-steps, starting at
+ *           sub-step hidx, into element 0 of block.
+ *
+ * @details  Forcing variables are averaged, precipitation and channel inflow
+ *           are summed, and the snowfall flag is set if it is set for any of
+ *           the sub-steps, as the drivers do for the whole model step
+ *           (element NR).
+ *****************************************************************************/
+void
+average_snow_step_force(force_data_struct *force,
+                        size_t             hidx,
+                        size_t             n,
+                        force_data_struct *block)
+{
+    extern option_struct options;
+
+    size_t               i;
+
+    block->air_temp[0] = sum_snow_steps(&(force->air_temp[hidx]), n) / n;
+    block->density[0] = sum_snow_steps(&(force->density[hidx]), n) / n;
+    block->longwave[0] = sum_snow_steps(&(force->longwave[hidx]), n) / n;
+    block->prec[0] = sum_snow_steps(&(force->prec[hidx]), n);
+    block->pressure[0] = sum_snow_steps(&(force->pressure[hidx]), n) / n;
+    block->shortwave[0] = sum_snow_steps(&(force->shortwave[hidx]), n) / n;
+    block->vp[0] = sum_snow_steps(&(force->vp[hidx]), n) / n;
+    block->vpd[0] = sum_snow_steps(&(force->vpd[hidx]), n) / n;
+    block->wind[0] = sum_snow_steps(&(force->wind[hidx]), n) / n;
+    block->snowflag[0] = false;
+    for (i = hidx; i < hidx + n; i++) {
+        if (force->snowflag[i]) {
+            block->snowflag[0] = true;
+        }
+    }
+    if (options.LAKES) {
+        block->channel_in[0] = sum_snow_steps(&(force->channel_in[hidx]), n);
+    }
+    if (options.CARBON) {
+        block->Catm[0] = sum_snow_steps(&(force->Catm[hidx]), n) / n;
+        block->coszen[0] = sum_snow_steps(&(force->coszen[hidx]), n) / n;
+        block->fdir[0] = sum_snow_steps(&(force->fdir[hidx]), n) / n;
+        block->par[0] = sum_snow_steps(&(force->par[hidx]), n) / n;
+    }
+    block->out_prec = force->out_prec;
+    block->out_rain = force->out_rain;
+    block->out_snow = force->out_snow;
+}
+
+/******************************************************************************
+ * @brief    Choose the number of SNOW_STEPs spanned by the next snow sub-step.
+ *
+ * @details  The changes in snow water equivalent and snow surface
+ *           temperature over the sub-step just completed, per SNOW_STEP, and
+ *           the residual of the snow/ground heat flux iteration are compared
+ *           with their tolerances.  The next sub-step is twice as long, but
+ *           no longer than SNOW_STEP_MAX SNOW_STEPs, if all of them are below
+ *           half of their tolerance, and half as long (rounded up) if any
+ *           of them exceeds its tolerance.  It falls back to a single
+ *           SNOW_STEP if the snowpack melted or does not cover the whole
+ *           tile.  Otherwise it keeps its length.
+ *           Sub-steps are not repeated: a change of regime is resolved from
+ *           the sub-step after the one in which it was detected.
+ *****************************************************************************/
+size_t
+adapt_snow_step(size_t step_inc,
+                double delta_swq,
+                double delta_surf_temp,
+                double flux_residual,
+                double melt,
+                double coverage)
+{
+    extern parameters_struct param;
+
+    double                   ratio;
+
+    if (melt > 0 || coverage < 1) {
+        return 1;
+    }
+
+    // largest change relative to its tolerance
+    ratio = fabs(delta_swq) / (param.SNOW_STEP_SWE_TOL * step_inc);
+    if (fabs(delta_surf_temp) / (param.SNOW_STEP_TSURF_TOL * step_inc) >
+        ratio) {
+        ratio = fabs(delta_surf_temp) / (param.SNOW_STEP_TSURF_TOL * step_inc);
+    }
+    if (fabs(flux_residual) / param.SNOW_STEP_FLUX_TOL > ratio) {
+        ratio = fabs(flux_residual) / param.SNOW_STEP_FLUX_TOL;
+    }
+
+    if (!(ratio <= 1.)) {
+        return (step_inc + 1) / 2;
+    }
+    else if (ratio < 0.5) {
+        if (2 * step_inc > (size_t) param.SNOW_STEP_MAX) {
+            return (size_t) param.SNOW_STEP_MAX;
+        }
+        return 2 * step_inc;
+    }
+
+    return step_inc;
+}
@@ -0,0 +1,214 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Lookup table of the suspension layer integrals of the blowing snow scheme.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_run.h>
+
+#define BLOWING_TABLE_NWIND     64    /**< number of wind speed nodes */
+#define BLOWING_TABLE_NSHEAR    64    /**< number of shear velocity nodes */
+#define BLOWING_TABLE_WIND_MIN  0.4   /**< smallest 10 m wind speed (m/s) */
+#define BLOWING_TABLE_WIND_MAX  25.   /**< largest 10 m wind speed (m/s) */
+#define BLOWING_TABLE_SHEAR_MIN 0.05  /**< smallest shear velocity (m/s) */
+#define BLOWING_TABLE_SHEAR_MAX 12.   /**< largest shear velocity (m/s) */
+#define BLOWING_TABLE_ZO        1e-6  /**< reference roughness (m) */
+
+// The table is filled by init_blowing_table() while the driver starts up,
+// before any thread runs vic_run, and is only read afterwards.
+
+// each table has one extra node on either side of the range it covers, so
+// that the cubic interpolation never has to extrapolate
+#define BLOWING_TABLE_ROWS      (BLOWING_TABLE_NWIND + 2)
+#define BLOWING_TABLE_COLS      (BLOWING_TABLE_NSHEAR + 2)
+
+static bool   blowing_table_ready = false;
+static double blowing_table_sub[BLOWING_TABLE_ROWS][BLOWING_TABLE_COLS];
+static double blowing_table_trans[BLOWING_TABLE_ROWS][BLOWING_TABLE_COLS];
+static double blowing_table_trans_e[BLOWING_TABLE_ROWS][BLOWING_TABLE_COLS];
+
+/******************************************************************************
+ * @brief    Fill the blowing snow lookup table.
+ *
+ * @details  The suspension layer integrals of CalcSubFlux() depend on the
+ *           humidity deficit, the air temperature (through F), the saltation
+ *           layer concentration and the roughness of the saltation layer
+ *           only through factors that can be taken out of the integral:
+ *
+ *           sublimation = phi_s * (1 - EactAir / es) / F * S(U10, ushear)
+ *           transport   = phi_s * (T1(U10, ushear) - ln(Zo_salt / Zref) *
+ *                                  T0(U10, ushear))
+ *
+ *           so only the 10 m wind speed U10 and the shear velocity ushear
+ *           have to be tabulated.  S is stored with EactAir = 0, es = 1,
+ *           F = 1 and phi_s = 1, and the transport integral is stored for
+ *           Zo_salt = Zref (T1) and Zo_salt = Zref / e (T1 + T0), where the
+ *           reference roughness Zref lies below the bottom of the suspension
+ *           layer so that neither integrand changes sign.  All entries are
+ *           computed with qromb() and stored as logarithms, on nodes spaced
+ *           evenly in ln(U10) and ln(ushear).  The drivers build the table
+ *           once, from the BLOWING_* parameters, after the parameters are
+ *           read and before the first time step, so that the threads of the
+ *           model only read it.
+ *****************************************************************************/
+void
+init_blowing_table(void)
+{
+    size_t i;
+    size_t j;
+    double dlnwind;
+    double dlnshear;
+    double U10;
+    double ushear;
+    double hsalt;
+    double ztop;
+
+    dlnwind = log(BLOWING_TABLE_WIND_MAX / BLOWING_TABLE_WIND_MIN) /
+              (double) (BLOWING_TABLE_NWIND - 1);
+    dlnshear = log(BLOWING_TABLE_SHEAR_MAX / BLOWING_TABLE_SHEAR_MIN) /
+               (double) (BLOWING_TABLE_NSHEAR - 1);
+
+    for (i = 0; i < BLOWING_TABLE_ROWS; i++) {
+        U10 = BLOWING_TABLE_WIND_MIN * exp(dlnwind * ((double) i - 1.));
+        for (j = 0; j < BLOWING_TABLE_COLS; j++) {
+            ushear = BLOWING_TABLE_SHEAR_MIN *
+                     exp(dlnshear * ((double) j - 1.));
+            suspension_limits(U10, ushear, &hsalt, &ztop);
+            blowing_table_sub[i][j] =
+                log(-qromb(sub_with_height, 1., U10, 0., 1., 0., 1., hsalt,
+                           1., ushear, 0., hsalt, ztop));
+            blowing_table_trans[i][j] =
+                log(qromb(transport_with_height, 1., U10, 0.,
+                          BLOWING_TABLE_ZO, 0., 1., hsalt, 1., ushear, 0.,
+                          hsalt, ztop));
+            blowing_table_trans_e[i][j] =
+                log(qromb(transport_with_height, 1., U10, 0.,
+                          BLOWING_TABLE_ZO * exp(-1.), 0., 1., hsalt, 1.,
+                          ushear, 0., hsalt, ztop));
+        }
+    }
+
+    blowing_table_ready = true;
+}
+
+/******************************************************************************
+ * @brief    Catmull-Rom weights for the four nodes around fractional
+ *           position f in [0, 1].
+ *****************************************************************************/
+static void
+blowing_table_weights(double  f,
+                      double *w)
+{
+    w[0] = f * (-0.5 + f * (1. - 0.5 * f));
+    w[1] = 1. + f * f * (-2.5 + 1.5 * f);
+    w[2] = f * (0.5 + f * (2. - 1.5 * f));
+    w[3] = f * f * (-0.5 + 0.5 * f);
+}
+
+/******************************************************************************
+ * @brief    Interpolate the blowing snow lookup table.
+ *
+ * @details  Returns the suspension layer sublimation and transport integrals
+ *           of CalcSubFlux() for unit saltation layer concentration, using
+ *           bicubic interpolation of their logarithms in ln(U10) and
+ *           ln(ushear).  Returns false, leaving the outputs untouched, if
+ *           (U10, ushear) lies outside of the table, in which case the caller
+ *           integrates directly.
+ *****************************************************************************/
+bool
+lookup_blowing_table(double  U10,
+                     double  ushear,
+                     double  EactAir,
+                     double  es,
+                     double  F,
+                     double  Zo_salt,
+                     double *sub_integral,
+                     double *trans_integral)
+{
+    size_t i;
+    size_t j;
+    size_t p;
+    size_t q;
+    double x;
+    double y;
+    double wx[4];
+    double wy[4];
+    double w;
+    double sub;
+    double trans;
+    double trans_e;
+
+    if (!(U10 >= BLOWING_TABLE_WIND_MIN && U10 <= BLOWING_TABLE_WIND_MAX)) {
+        return false;
+    }
+    if (!(ushear >= BLOWING_TABLE_SHEAR_MIN &&
+          ushear <= BLOWING_TABLE_SHEAR_MAX)) {
+        return false;
+    }
+
+    if (!blowing_table_ready) {
+        log_err("The blowing snow table has not been built; the driver must "
+                "call init_blowing_table() before running the model");
+    }
+
+    // position in the table, counted from the first node inside the range
+    x = log(U10 / BLOWING_TABLE_WIND_MIN) /
+        log(BLOWING_TABLE_WIND_MAX / BLOWING_TABLE_WIND_MIN) *
+        (double) (BLOWING_TABLE_NWIND - 1);
+    y = log(ushear / BLOWING_TABLE_SHEAR_MIN) /
+        log(BLOWING_TABLE_SHEAR_MAX / BLOWING_TABLE_SHEAR_MIN) *
+        (double) (BLOWING_TABLE_NSHEAR - 1);
+    i = (size_t) x;
+    if (i > BLOWING_TABLE_NWIND - 2) {
+        i = BLOWING_TABLE_NWIND - 2;
+    }
+    j = (size_t) y;
+    if (j > BLOWING_TABLE_NSHEAR - 2) {
+        j = BLOWING_TABLE_NSHEAR - 2;
+    }
+    blowing_table_weights(x - (double) i, wx);
+    blowing_table_weights(y - (double) j, wy);
+
+    // nodes i - 1 .. i + 2 of the range are rows i .. i + 3 of the table
+    sub = 0.;
+    trans = 0.;
+    trans_e = 0.;
+    for (p = 0; p < 4; p++) {
+        for (q = 0; q < 4; q++) {
+            w = wx[p] * wy[q];
+            sub += w * blowing_table_sub[i + p][j + q];
+            trans += w * blowing_table_trans[i + p][j + q];
+            trans_e += w * blowing_table_trans_e[i + p][j + q];
+        }
+    }
+    sub = -exp(sub);
+    trans = exp(trans);
+    trans_e = exp(trans_e);
+
+    // undo the normalization of init_blowing_table()
+    *sub_integral = sub * (1. - EactAir / es) / F;
+    *trans_integral = trans - log(Zo_salt / BLOWING_TABLE_ZO) *
+                      (trans_e - trans);
+
+    return true;
+}
@@ -58,15 +58,16 @@ calc_atmos_energy_bal(double    InOverSensible,
                       bool     *Tcanopy_fbflag,
                       unsigned *Tcanopy_fbcount)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
+    extern option_struct        options;
+    extern parameters_struct    param;
 
-    double                   F; // canopy closure fraction, not currently used by VIC
-    double                   InSensible;
-    double                   NetRadiation;
-    double                   T_lower;
-    double                   T_upper;
-    double                   Tcanopy;
+    atmos_energy_bal_ctx_struct ctx;
+    double                      F; // canopy closure fraction, not currently used by VIC
+    double                      InSensible;
+    double                      NetRadiation;
+    double                      T_lower;
+    double                      T_upper;
+    double                      Tcanopy;
 
     F = 1;
 
@@ -90,6 +91,12 @@ calc_atmos_energy_bal(double    InOverSensible,
        Find Canopy Air Temperature
     ******************************/
 
+    ctx.Ra = Ra;
+    ctx.Tair = Tair;
+    ctx.atmos_density = atmos_density;
+    ctx.InSensible = InSensible;
+    ctx.SensibleHeat = SensibleHeat;
+
     if (options.CLOSE_ENERGY) {
         /* initialize Tcanopy_fbflag */
         *Tcanopy_fbflag = 0;
@@ -99,9 +106,8 @@ calc_atmos_energy_bal(double    InOverSensible,
         T_upper = (Tair) + param.CANOPY_DT;
 
         // iterate for canopy air temperature
-        Tcanopy = root_brent(T_lower, T_upper,
-                             func_atmos_energy_bal, Ra, Tair, atmos_density,
-                             InSensible, SensibleHeat);
+        Tcanopy = root_brent(T_lower, T_upper, func_atmos_energy_bal, &ctx,
+                             SOLVER_ATMOS_ENERGY_BAL);
 
         if (Tcanopy <= -998) {
             if (options.TFALLBACK) {
@@ -111,12 +117,10 @@ calc_atmos_energy_bal(double    InOverSensible,
             }
             else {
                 // handle error flag from root brent
-                (*Error) = error_calc_atmos_energy_bal(Tcanopy, (*LatentHeat) +
-                                                       (*LatentHeatSub),
-                                                       NetRadiation, Ra, Tair,
-                                                       atmos_density,
-                                                       InSensible,
-                                                       SensibleHeat);
+                (*Error) = error_print_atmos_energy_bal(Tcanopy, &ctx,
+                                                        (*LatentHeat) +
+                                                        (*LatentHeatSub),
+                                                        NetRadiation);
                 return (ERROR);
             }
         }
@@ -126,74 +130,19 @@ calc_atmos_energy_bal(double    InOverSensible,
     }
 
     // compute variables based on final temperature
-    (*Error) = solve_atmos_energy_bal(Tcanopy, Ra, Tair, atmos_density,
-                                      InSensible, SensibleHeat);
+    (*Error) = func_atmos_energy_bal(Tcanopy, &ctx);
     return(Tcanopy);
 }
 
-/******************************************************************************
- * @brief    Dummy function to allow calling func_atmos_energy_bal() directly.
- *****************************************************************************/
-double
-solve_atmos_energy_bal(double Tcanopy,
-                       ...)
-{
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, Tcanopy);
-    error = func_atmos_energy_bal(Tcanopy, ap);
-    va_end(ap);
-
-    return error;
-}
-
-/******************************************************************************
- * @brief    Dummy function to allow calling error_calc_atmos_energy_bal()
- *           directly.
- *****************************************************************************/
-double
-error_calc_atmos_energy_bal(double Tcanopy,
-                            ...)
-{
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, Tcanopy);
-    error = error_print_atmos_energy_bal(Tcanopy, ap);
-    va_end(ap);
-
-    return error;
-}
-
 /******************************************************************************
  * @brief    Print atmos energy balance terms.
  *****************************************************************************/
 double
-error_print_atmos_energy_bal(double  Tcanopy,
-                             va_list ap)
+error_print_atmos_energy_bal(double                       Tcanopy,
+                             atmos_energy_bal_ctx_struct *ctx,
+                             double                       LatentHeat,
+                             double                       NetRadiation)
 {
-    double  LatentHeat;
-    double  NetRadiation;
-    double  Ra;
-    double  Tair;
-    double  atmos_density;
-    double  InSensible;
-
-    double *SensibleHeat;
-
-    // extract variables from va_arg
-    LatentHeat = (double)  va_arg(ap, double);
-    NetRadiation = (double)  va_arg(ap, double);
-    Ra = (double)  va_arg(ap, double);
-    Tair = (double)  va_arg(ap, double);
-    atmos_density = (double)  va_arg(ap, double);
-    InSensible = (double)  va_arg(ap, double);
-
-    SensibleHeat = (double *)va_arg(ap, double *);
-
     // print variable values
     log_warn("Failure to converge to a solution in root_brent.\n"
              "Check for invalid values.\n"
@@ -207,73 +156,19 @@ error_print_atmos_energy_bal(double  Tcanopy,
              "*SensibleHeat = %f\n"
              "Try increasing CANOPY_DT to get model to complete cell.\n"
              "Then check output for instabilities.",
-             Tcanopy, LatentHeat, NetRadiation, Ra, Tair, atmos_density,
-             InSensible, *SensibleHeat);
+             Tcanopy, LatentHeat, NetRadiation, ctx->Ra, ctx->Tair,
+             ctx->atmos_density, ctx->InSensible, *ctx->SensibleHeat);
 
     return(ERROR);
 }
 
-/******************************************************************************
- * @brief   Dummy function to allow calling func_atmos_moist_bal() directly.
- *****************************************************************************/
-double
-solve_atmos_moist_bal(double VPcanopy,
-                      ...)
-{
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, VPcanopy);
-    error = func_atmos_moist_bal(VPcanopy, ap);
-    va_end(ap);
-
-    return error;
-}
-
-/******************************************************************************
- * @brief    Dummy function to allow calling error_print_atmos_moist_bal()
- *           directly.
- *****************************************************************************/
-double
-error_calc_atmos_moist_bal(double VPcanopy,
-                           ...)
-{
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, VPcanopy);
-    error = error_print_atmos_moist_bal(VPcanopy, ap);
-    va_end(ap);
-
-    return error;
-}
-
 /******************************************************************************
  * @brief    Print atmos moist energy balance terms.
  *****************************************************************************/
 double
-error_print_atmos_moist_bal(double  VPcanopy,
-                            va_list ap)
+error_print_atmos_moist_bal(double                      VPcanopy,
+                            atmos_moist_bal_ctx_struct *ctx)
 {
-    double  InLatent;
-    double  Lv;
-    double  Ra;
-    double  atmos_density;
-    double  gamma;
-    double  vp;
-    double *AtmosLatent;
-
-    // extract variables from va_arg
-    InLatent = (double)  va_arg(ap, double);
-    Lv = (double)  va_arg(ap, double);
-    Ra = (double)  va_arg(ap, double);
-    atmos_density = (double)  va_arg(ap, double);
-    gamma = (double)  va_arg(ap, double);
-    vp = (double)  va_arg(ap, double);
-    AtmosLatent = (double *)va_arg(ap, double *);
-
     // print variable values
     log_err("VPcanopy = %f\n"
             "InLatent = %f\n"
@@ -285,8 +180,8 @@ error_print_atmos_moist_bal(double  VPcanopy,
             "AtmosLatent = %f\n"
             "Try increasing CANOPY_VP to get model to complete cell.\n"
             "Then check output for instabilities.",
-            VPcanopy, InLatent, Lv, Ra, atmos_density, gamma, vp,
-            *AtmosLatent);
+            VPcanopy, ctx->InLatentHeat, ctx->Lv, ctx->Ra, ctx->atmos_density,
+            ctx->gamma, ctx->vp, *ctx->LatentHeat);
 
     return(0.0);
 }
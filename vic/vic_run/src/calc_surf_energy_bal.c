@@ -88,68 +88,70 @@ calc_surf_energy_bal(double             Le,
                      soil_con_struct   *soil_con,
                      veg_var_struct    *veg_var)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
-
-    int                      FIRST_SOLN[2];
-    int                      VEG;
-    int                      i;
-    size_t                   nidx;
-    int                      inidx;
-    int                      tmpNnodes;
-
-    double                   Cs1;
-    double                   Cs2;
-    double                   D1;
-    double                   D2;
-    double                   LongBareIn;
-    double                   NetLongBare;
-    double                   NetShortBare;
-    double                   T1;
-    double                   T1_old;
-    double                   T2;
-    double                   Ts_old;
-    double                   Tsnow_surf;
-    double                   Tsurf;
-    char                     Tsurf_fbflag;
-    unsigned                 Tsurf_fbcount;
-    double                   atmos_density;
-    double                   atmos_pressure;
-    double                   atmos_shortwave;
-    double                   atmos_Catm;
-    double                   bubble;
-    double                   delta_t;
-    double                   emissivity;
-    double                   error;
-    double                   expt;
-    double                   kappa1;
-    double                   kappa2;
-    double                   kappa_snow;
-    double                   max_moist;
-    double                   refrozen_water;
-
-    double                   Wdew;
-    double                  *T_node;
-    double                   Tnew_node[MAX_NODES];
-    char                     Tnew_fbflag[MAX_NODES];
-    unsigned                 Tnew_fbcount[MAX_NODES];
-    double                  *Zsum_node;
-    double                  *kappa_node;
-    double                  *Cs_node;
-    double                  *moist_node;
-    double                  *bubble_node;
-    double                  *expt_node;
-    double                  *max_moist_node;
-    double                  *ice_node;
-    double                  *alpha;
-    double                  *beta;
-    double                  *gamma;
-
-    double                   T_lower, T_upper;
-    double                   LongSnowIn;
-    double                   TmpNetLongSnow;
-    double                   TmpNetShortSnow;
-    double                   old_swq, old_depth;
+    extern option_struct       options;
+    extern parameters_struct   param;
+
+    int                        FIRST_SOLN[2];
+    int                        VEG;
+    int                        i;
+    size_t                     nidx;
+    int                        inidx;
+    int                        tmpNnodes;
+
+    double                     Cs1;
+    double                     Cs2;
+    double                     D1;
+    double                     D2;
+    double                     LongBareIn;
+    double                     NetLongBare;
+    double                     NetShortBare;
+    double                     T1;
+    double                     T1_old;
+    double                     T2;
+    double                     Ts_old;
+    double                     Tsnow_surf;
+    double                     Tsurf;
+    char                       Tsurf_fbflag;
+    unsigned                   Tsurf_fbcount;
+    double                     atmos_density;
+    double                     atmos_pressure;
+    double                     atmos_shortwave;
+    double                     atmos_Catm;
+    double                     bubble;
+    double                     delta_t;
+    double                     emissivity;
+    double                     error;
+    double                     expt;
+    double                     kappa1;
+    double                     kappa2;
+    double                     kappa_snow;
+    double                     max_moist;
+    double                     refrozen_water;
+
+    double                     Wdew;
+    double                    *T_node;
+    double                     Tnew_node[MAX_NODES];
+    char                       Tnew_fbflag[MAX_NODES];
+    unsigned                   Tnew_fbcount[MAX_NODES];
+    double                    *Zsum_node;
+    double                    *kappa_node;
+    double                    *Cs_node;
+    double                    *moist_node;
+    double                    *bubble_node;
+    double                    *expt_node;
+    double                    *max_moist_node;
+    double                    *ice_node;
+    double                    *alpha;
+    double                    *beta;
+    double                    *gamma;
+
+    double                     T_lower, T_upper;
+    double                     LongSnowIn;
+    double                     TmpNetLongSnow;
+    double                     TmpNetShortSnow;
+    double                     old_swq, old_depth;
+
+    surf_energy_bal_ctx_struct ctx;
 
     /**************************************************
        Set All Variables For Use
@@ -260,6 +262,109 @@ calc_surf_energy_bal(double             Le,
     Zsum_node = soil_con->Zsum_node;
     ice_node = energy->ice;
 
+    /*************************************************************
+       Fill the solver context once for all evaluations of
+       func_surf_energy_bal() in this time step
+    *************************************************************/
+
+    ctx.VEG = VEG;
+    ctx.veg_class = veg_class;
+    ctx.delta_t = delta_t;
+    ctx.Cs1 = Cs1;
+    ctx.Cs2 = Cs2;
+    ctx.D1 = D1;
+    ctx.D2 = D2;
+    ctx.T1_old = T1_old;
+    ctx.T2 = T2;
+    ctx.Ts_old = Ts_old;
+    ctx.Told_node = energy->T;
+    ctx.bubble = bubble;
+    ctx.dp = dp;
+    ctx.expt = expt;
+    ctx.ice0 = ice0;
+    ctx.kappa1 = kappa1;
+    ctx.kappa2 = kappa2;
+    ctx.max_moist = max_moist;
+    ctx.moist = moist;
+    ctx.root = root;
+    ctx.CanopLayerBnd = CanopLayerBnd;
+    ctx.UnderStory = UnderStory;
+    ctx.overstory = overstory;
+    ctx.NetShortBare = NetShortBare;
+    ctx.NetShortGrnd = NetShortGrnd;
+    ctx.NetShortSnow = TmpNetShortSnow;
+    ctx.Tair = Tair;
+    ctx.atmos_density = atmos_density;
+    ctx.atmos_pressure = atmos_pressure;
+    ctx.emissivity = emissivity;
+    ctx.LongBareIn = LongBareIn;
+    ctx.LongSnowIn = LongSnowIn;
+    ctx.surf_atten = surf_atten;
+    ctx.vp = VPcanopy;
+    ctx.vpd = VPDcanopy;
+    ctx.shortwave = atmos_shortwave;
+    ctx.Catm = atmos_Catm;
+    ctx.dryFrac = dryFrac;
+    ctx.Wdew = &Wdew;
+    ctx.displacement = displacement;
+    ctx.ra = aero_resist;
+    ctx.Ra_veg = aero_resist_veg;
+    ctx.Ra_used = aero_resist_used;
+    ctx.rainfall = rainfall;
+    ctx.ref_height = ref_height;
+    ctx.roughness = roughness;
+    ctx.wind = wind;
+    ctx.Le = Le;
+    ctx.Advection = energy->advection;
+    ctx.OldTSurf = OldTSurf;
+    ctx.Tsnow_surf = Tsnow_surf;
+    ctx.kappa_snow = kappa_snow;
+    ctx.melt_energy = melt_energy;
+    ctx.snow_coverage = snow_coverage;
+    ctx.snow_density = snow->density;
+    ctx.snow_swq = snow->swq;
+    ctx.snow_water = snow->surf_water;
+    ctx.deltaCC = &energy->deltaCC;
+    ctx.refreeze_energy = &energy->refreeze_energy;
+    ctx.vapor_flux = &snow->vapor_flux;
+    ctx.blowing_flux = &snow->blowing_flux;
+    ctx.surface_flux = &snow->surface_flux;
+    ctx.Nnodes = (int) Nnodes;
+    ctx.Cs_node = Cs_node;
+    ctx.T_node = T_node;
+    ctx.Tnew_node = Tnew_node;
+    ctx.Tnew_fbflag = Tnew_fbflag;
+    ctx.Tnew_fbcount = Tnew_fbcount;
+    ctx.alpha = alpha;
+    ctx.beta = beta;
+    ctx.bubble_node = bubble_node;
+    ctx.Zsum_node = Zsum_node;
+    ctx.expt_node = expt_node;
+    ctx.gamma = gamma;
+    ctx.ice_node = ice_node;
+    ctx.kappa_node = kappa_node;
+    ctx.max_moist_node = max_moist_node;
+    ctx.moist_node = moist_node;
+    ctx.soil_con = soil_con;
+    ctx.layer = layer;
+    ctx.veg_var = veg_var;
+    ctx.INCLUDE_SNOW = INCLUDE_SNOW;
+    ctx.NOFLUX = options.NOFLUX;
+    ctx.EXP_TRANS = options.EXP_TRANS;
+    ctx.SNOWING = snow->snow;
+    ctx.FIRST_SOLN = FIRST_SOLN;
+    ctx.NetLongBare = &NetLongBare;
+    ctx.NetLongSnow = &TmpNetLongSnow;
+    ctx.T1 = &T1;
+    ctx.deltaH = &energy->deltaH;
+    ctx.fusion = &energy->fusion;
+    ctx.grnd_flux = &energy->grnd_flux;
+    ctx.latent_heat = &energy->latent;
+    ctx.latent_heat_sub = &energy->latent_sub;
+    ctx.sensible_heat = &energy->sensible;
+    ctx.snow_flux = &energy->snow_flux;
+    ctx.store_error = &energy->error;
+
     /**************************************************
        Find Surface Temperature Using Root Brent Method
     **************************************************/
@@ -298,34 +403,15 @@ calc_surf_energy_bal(double             Le,
             tmpNnodes = Nnodes;
         }
 
-        Tsurf = root_brent(T_lower, T_upper, func_surf_energy_bal,
-                           VEG, veg_class, delta_t, Cs1, Cs2, D1, D2,
-                           T1_old, T2, Ts_old, energy->T, bubble, dp, expt,
-                           ice0, kappa1, kappa2, max_moist, moist, root,
-                           CanopLayerBnd, UnderStory, overstory, NetShortBare,
-                           NetShortGrnd, TmpNetShortSnow, Tair, atmos_density,
-                           atmos_pressure, emissivity, LongBareIn, LongSnowIn,
-                           surf_atten, VPcanopy, VPDcanopy, atmos_shortwave,
-                           atmos_Catm, dryFrac, &Wdew, displacement,
-                           aero_resist, aero_resist_veg, aero_resist_used,
-                           rainfall, ref_height,
-                           roughness, wind, Le, energy->advection, OldTSurf,
-                           Tsnow_surf, kappa_snow, melt_energy, snow_coverage,
-                           snow->density, snow->swq, snow->surf_water,
-                           &energy->deltaCC, &energy->refreeze_energy,
-                           &snow->vapor_flux, &snow->blowing_flux,
-                           &snow->surface_flux, tmpNnodes, Cs_node, T_node,
-                           Tnew_node, Tnew_fbflag, Tnew_fbcount, alpha, beta,
-                           bubble_node, Zsum_node, expt_node, gamma, ice_node,
-                           kappa_node, max_moist_node, moist_node, soil_con,
-                           layer, veg_var, INCLUDE_SNOW, options.NOFLUX,
-                           options.EXP_TRANS,
-                           snow->snow, FIRST_SOLN, &NetLongBare,
-                           &TmpNetLongSnow, &T1, &energy->deltaH,
-                           &energy->fusion, &energy->grnd_flux,
-                           &energy->latent, &energy->latent_sub,
-                           &energy->sensible, &energy->snow_flux,
-                           &energy->error);
+        ctx.Nnodes = tmpNnodes;
+        if (options.SECANT_SOLVE) {
+            Tsurf = root_secant(Ts_old, T_lower, T_upper, func_surf_energy_bal,
+                                &ctx, SOLVER_SURF_ENERGY_BAL);
+        }
+        else {
+            Tsurf = root_brent(T_lower, T_upper, func_surf_energy_bal, &ctx,
+                               SOLVER_SURF_ENERGY_BAL);
+        }
 
         if (Tsurf <= -998) {
             if (options.TFALLBACK) {
@@ -335,77 +421,9 @@ calc_surf_energy_bal(double             Le,
             }
             else {
                 log_info("SURF_DT = %.2f", param.SURF_DT);
-                error = error_calc_surf_energy_bal(Tsurf, (int) dmy->year,
-                                                   (int) dmy->month,
-                                                   (int) dmy->day,
-                                                   (int) dmy->dayseconds,
-                                                   VEG, iveg,
-                                                   veg_class, delta_t, Cs1, Cs2,
-                                                   D1, D2,
-                                                   T1_old, T2, Ts_old,
-                                                   energy->T,
-                                                   soil_con->b_infilt, bubble,
-                                                   dp,
-                                                   expt, ice0, kappa1, kappa2,
-                                                   soil_con->max_infil,
-                                                   max_moist,
-                                                   moist, soil_con->Wcr,
-                                                   soil_con->Wpwp,
-                                                   soil_con->depth,
-                                                   soil_con->resid_moist, root,
-                                                   CanopLayerBnd,
-                                                   UnderStory, overstory,
-                                                   NetShortBare,
-                                                   NetShortGrnd,
-                                                   TmpNetShortSnow, Tair,
-                                                   atmos_density,
-                                                   atmos_pressure,
-                                                   soil_con->elevation,
-                                                   emissivity, LongBareIn,
-                                                   LongSnowIn,
-                                                   surf_atten, VPcanopy,
-                                                   VPDcanopy,
-                                                   atmos_shortwave, atmos_Catm,
-                                                   dryFrac,
-                                                   &Wdew, displacement,
-                                                   aero_resist,
-                                                   aero_resist_veg,
-                                                   aero_resist_used,
-                                                   rainfall, ref_height,
-                                                   roughness,
-                                                   wind, Le, energy->advection,
-                                                   OldTSurf, snow->pack_temp,
-                                                   Tsnow_surf,
-                                                   kappa_snow, melt_energy,
-                                                   snow_coverage, snow->density,
-                                                   snow->swq, snow->surf_water,
-                                                   &energy->deltaCC,
-                                                   &energy->refreeze_energy,
-                                                   &snow->vapor_flux, Nnodes,
-                                                   Cs_node,
-                                                   T_node, Tnew_node, alpha,
-                                                   beta,
-                                                   bubble_node, Zsum_node,
-                                                   expt_node,
-                                                   gamma, ice_node, kappa_node,
-                                                   max_moist_node, moist_node,
-                                                   soil_con->frost_fract,
-                                                   layer, veg_var,
-                                                   INCLUDE_SNOW,
-                                                   soil_con->FS_ACTIVE,
-                                                   options.NOFLUX,
-                                                   options.EXP_TRANS,
-                                                   snow->snow, FIRST_SOLN,
-                                                   &NetLongBare,
-                                                   &TmpNetLongSnow, &T1,
-                                                   &energy->deltaH,
-                                                   &energy->fusion,
-                                                   &energy->grnd_flux,
-                                                   &energy->latent,
-                                                   &energy->latent_sub,
-                                                   &energy->sensible,
-                                                   &energy->snow_flux,
-                                                   &energy->error);
+                ctx.Nnodes = Nnodes;
+                error = error_print_surf_energy_bal(Tsurf, &ctx, dmy, iveg,
+                                                    snow->pack_temp);
                 return (ERROR);
             }
         }
@@ -416,39 +434,18 @@ calc_surf_energy_bal(double             Le,
 
         if (Ts_old * Tsurf < 0 && options.QUICK_SOLVE) {
             tmpNnodes = Nnodes;
+            ctx.Nnodes = tmpNnodes;
             FIRST_SOLN[0] = true;
 
-            Tsurf = root_brent(T_lower, T_upper,
-                               func_surf_energy_bal, VEG, veg_class,
-                               delta_t, Cs1, Cs2, D1, D2, T1_old, T2, Ts_old,
-                               energy->T, bubble, dp, expt, ice0, kappa1,
-                               kappa2, max_moist, moist, root, CanopLayerBnd,
-                               UnderStory, overstory, NetShortBare,
-                               NetShortGrnd,
-                               TmpNetShortSnow, Tair, atmos_density,
-                               atmos_pressure, emissivity, LongBareIn,
-                               LongSnowIn, surf_atten, VPcanopy, VPDcanopy,
-                               atmos_shortwave, atmos_Catm, dryFrac, &Wdew,
-                               displacement, aero_resist, aero_resist_veg,
-                               aero_resist_used,
-                               rainfall, ref_height, roughness, wind, Le,
-                               energy->advection, OldTSurf, Tsnow_surf,
-                               kappa_snow, melt_energy, snow_coverage,
-                               snow->density, snow->swq, snow->surf_water,
-                               &energy->deltaCC, &energy->refreeze_energy,
-                               &snow->vapor_flux, &snow->blowing_flux,
-                               &snow->surface_flux, tmpNnodes, Cs_node, T_node,
-                               Tnew_node, Tnew_fbflag, Tnew_fbcount, alpha,
-                               beta, bubble_node, Zsum_node, expt_node, gamma,
-                               ice_node, kappa_node, max_moist_node,
-                               moist_node, soil_con, layer, veg_var,
-                               INCLUDE_SNOW, options.NOFLUX, options.EXP_TRANS,
-                               snow->snow,
-                               FIRST_SOLN, &NetLongBare, &TmpNetLongSnow, &T1,
-                               &energy->deltaH, &energy->fusion,
-                               &energy->grnd_flux, &energy->latent,
-                               &energy->latent_sub, &energy->sensible,
-                               &energy->snow_flux, &energy->error);
+            if (options.SECANT_SOLVE) {
+                Tsurf = root_secant(Tsurf, T_lower, T_upper,
+                                    func_surf_energy_bal, &ctx,
+                                    SOLVER_SURF_ENERGY_BAL);
+            }
+            else {
+                Tsurf = root_brent(T_lower, T_upper, func_surf_energy_bal,
+                                   &ctx, SOLVER_SURF_ENERGY_BAL);
+            }
 
             if (Tsurf <= -998) {
                 if (options.TFALLBACK) {
@@ -457,83 +454,9 @@ calc_surf_energy_bal(double             Le,
                     Tsurf_fbcount++;
                 }
                 else {
-                    error = error_calc_surf_energy_bal(Tsurf, (int) dmy->year,
-                                                       (int) dmy->month,
-                                                       (int) dmy->day,
-                                                       (int) dmy->dayseconds,
-                                                       VEG, iveg,
-                                                       veg_class, delta_t, Cs1,
-                                                       Cs2, D1,
-                                                       D2, T1_old, T2, Ts_old,
-                                                       energy->T,
-                                                       soil_con->b_infilt,
-                                                       bubble, dp,
-                                                       expt, ice0, kappa1,
-                                                       kappa2,
-                                                       soil_con->max_infil,
-                                                       max_moist,
-                                                       moist, soil_con->Wcr,
-                                                       soil_con->Wpwp,
-                                                       soil_con->depth,
-                                                       soil_con->resid_moist,
-                                                       root, CanopLayerBnd,
-                                                       UnderStory, overstory,
-                                                       NetShortBare,
-                                                       NetShortGrnd,
-                                                       TmpNetShortSnow, Tair,
-                                                       atmos_density,
-                                                       atmos_pressure,
-                                                       soil_con->elevation,
-                                                       emissivity, LongBareIn,
-                                                       LongSnowIn,
-                                                       surf_atten, VPcanopy,
-                                                       VPDcanopy,
-                                                       atmos_shortwave,
-                                                       atmos_Catm, dryFrac,
-                                                       &Wdew, displacement,
-                                                       aero_resist,
-                                                       aero_resist_veg,
-                                                       aero_resist_used,
-                                                       rainfall, ref_height,
-                                                       roughness, wind, Le,
-                                                       energy->advection,
-                                                       OldTSurf,
-                                                       snow->pack_temp,
-                                                       Tsnow_surf,
-                                                       kappa_snow, melt_energy,
-                                                       snow_coverage,
-                                                       snow->density,
-                                                       snow->swq,
-                                                       snow->surf_water,
-                                                       &energy->deltaCC,
-                                                       &energy->refreeze_energy,
-                                                       &snow->vapor_flux,
-                                                       Nnodes, Cs_node,
-                                                       T_node, Tnew_node, alpha,
-                                                       beta,
-                                                       bubble_node, Zsum_node,
-                                                       expt_node,
-                                                       gamma, ice_node,
-                                                       kappa_node,
-                                                       max_moist_node,
-                                                       moist_node,
-                                                       soil_con->frost_fract,
-                                                       layer, veg_var,
-                                                       INCLUDE_SNOW,
-                                                       soil_con->FS_ACTIVE,
-                                                       options.NOFLUX,
-                                                       options.EXP_TRANS,
-                                                       snow->snow, FIRST_SOLN,
-                                                       &NetLongBare,
-                                                       &TmpNetLongSnow, &T1,
-                                                       &energy->deltaH,
-                                                       &energy->fusion,
-                                                       &energy->grnd_flux,
-                                                       &energy->latent,
-                                                       &energy->latent_sub,
-                                                       &energy->sensible,
-                                                       &energy->snow_flux,
-                                                       &energy->error);
+                    ctx.Nnodes = Nnodes;
+                    error = error_print_surf_energy_bal(Tsurf, &ctx, dmy,
+                                                        iveg, snow->pack_temp);
                     return (ERROR);
                 }
             }
@@ -549,37 +472,8 @@ calc_surf_energy_bal(double             Le,
         FIRST_SOLN[0] = true;
     }
 
-    error = solve_surf_energy_bal(Tsurf, VEG, veg_class, delta_t, Cs1,
-                                  Cs2, D1, D2, T1_old, T2, Ts_old, energy->T,
-                                  bubble, dp, expt, ice0, kappa1, kappa2,
-                                  max_moist, moist, root, CanopLayerBnd,
-                                  UnderStory, overstory, NetShortBare,
-                                  NetShortGrnd, TmpNetShortSnow, Tair,
-                                  atmos_density, atmos_pressure, emissivity,
-                                  LongBareIn, LongSnowIn, surf_atten, VPcanopy,
-                                  VPDcanopy, atmos_shortwave, atmos_Catm,
-                                  dryFrac, &Wdew, displacement, aero_resist,
-                                  aero_resist_veg, aero_resist_used, rainfall,
-                                  ref_height,
-                                  roughness, wind, Le, energy->advection,
-                                  OldTSurf, Tsnow_surf, kappa_snow,
-                                  melt_energy, snow_coverage, snow->density,
-                                  snow->swq, snow->surf_water,
-                                  &energy->deltaCC, &energy->refreeze_energy,
-                                  &snow->vapor_flux, &snow->blowing_flux,
-                                  &snow->surface_flux, (int) Nnodes, Cs_node,
-                                  T_node, Tnew_node, Tnew_fbflag, Tnew_fbcount,
-                                  alpha, beta, bubble_node, Zsum_node,
-                                  expt_node, gamma, ice_node, kappa_node,
-                                  max_moist_node, moist_node, soil_con, layer,
-                                  veg_var, INCLUDE_SNOW, options.NOFLUX,
-                                  options.EXP_TRANS,
-                                  snow->snow, FIRST_SOLN, &NetLongBare,
-                                  &TmpNetLongSnow, &T1, &energy->deltaH,
-                                  &energy->fusion, &energy->grnd_flux,
-                                  &energy->latent, &energy->latent_sub,
-                                  &energy->sensible, &energy->snow_flux,
-                                  &energy->error);
+    ctx.Nnodes = Nnodes;
+    error = func_surf_energy_bal(Tsurf, &ctx);
     if (error == ERROR) {
         return(ERROR);
     }
@@ -750,49 +644,15 @@ calc_surf_energy_bal(double             Le,
     return (Tsurf);
 }
 
-/******************************************************************************
- * @brief    Dummy function to allow calling func_surf_energy_bal() directly.
- *****************************************************************************/
-double
-solve_surf_energy_bal(double Tsurf,
-                      ...)
-{
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, Tsurf);
-    error = func_surf_energy_bal(Tsurf, ap);
-    va_end(ap);
-
-    return error;
-}
-
-/******************************************************************************
- * @brief    Dummy function to allow calling error_print_surf_energy_bal()
- *           directly.
- *****************************************************************************/
-double
-error_calc_surf_energy_bal(double Tsurf,
-                           ...)
-{
-    va_list ap;
-
-    double  error;
-
-    va_start(ap, Tsurf);
-    error = error_print_surf_energy_bal(Tsurf, ap);
-    va_end(ap);
-
-    return error;
-}
-
 /******************************************************************************
  * @brief    Print energy balance terms.
  *****************************************************************************/
 double
-error_print_surf_energy_bal(double  Ts,
-                            va_list ap)
+error_print_surf_energy_bal(double                      Ts,
+                            surf_energy_bal_ctx_struct *ctx,
+                            dmy_struct                 *dmy,
+                            int                         iveg,
+                            double                      TPack)
 {
     extern option_struct options;
 
@@ -801,7 +661,6 @@ error_print_surf_energy_bal(double  Ts,
     /* general model terms */
     int                year, month, day;
     int                sec;
-    int                iveg;
     int                VEG;
     int                veg_class;
 
@@ -872,7 +731,6 @@ error_print_surf_energy_bal(double  Ts,
     /* snowpack terms */
     double             Advection;
     double             OldTSurf;
-    double             TPack;
     double             Tsnow_surf;
     double             kappa_snow;
     double             melt_energy;
@@ -935,142 +793,142 @@ error_print_surf_energy_bal(double  Ts,
     /* Define internal routine variables */
     int                i;
 
-    /***************************
-       Read Variables from List
-    ***************************/
+    /*************************************
+       Read Variables from Solver Context
+    *************************************/
 
     /* general model terms */
-    year = (int) va_arg(ap, int);
-    month = (int) va_arg(ap, int);
-    day = (int) va_arg(ap, int);
-    sec = (int) va_arg(ap, int);
-    VEG = (int) va_arg(ap, int);
-    iveg = (int) va_arg(ap, int);
-    veg_class = (int) va_arg(ap, int);
+    year = (int) dmy->year;
+    month = (int) dmy->month;
+    day = (int) dmy->day;
+    sec = (int) dmy->dayseconds;
+    VEG = ctx->VEG;
+    veg_class = ctx->veg_class;
 
-    delta_t = (double) va_arg(ap, double);
+    delta_t = ctx->delta_t;
 
     /* soil layer terms */
-    Cs1 = (double) va_arg(ap, double);
-    Cs2 = (double) va_arg(ap, double);
-    D1 = (double) va_arg(ap, double);
-    D2 = (double) va_arg(ap, double);
-    T1_old = (double) va_arg(ap, double);
-    T2 = (double) va_arg(ap, double);
-    Ts_old = (double) va_arg(ap, double);
-    Told_node = (double *) va_arg(ap, double *);
-    b_infilt = (double) va_arg(ap, double);
-    bubble = (double) va_arg(ap, double);
-    dp = (double) va_arg(ap, double);
-    expt = (double) va_arg(ap, double);
-    ice0 = (double) va_arg(ap, double);
-    kappa1 = (double) va_arg(ap, double);
-    kappa2 = (double) va_arg(ap, double);
-    max_infil = (double) va_arg(ap, double);
-    max_moist = (double) va_arg(ap, double);
-    moist = (double) va_arg(ap, double);
-
-    Wcr = (double *) va_arg(ap, double *);
-    Wpwp = (double *) va_arg(ap, double *);
-    depth = (double *) va_arg(ap, double *);
-    resid_moist = (double *) va_arg(ap, double *);
-
-    root = (double  *) va_arg(ap, double  *);
-    CanopLayerBnd = (double *) va_arg(ap, double *);
+    Cs1 = ctx->Cs1;
+    Cs2 = ctx->Cs2;
+    D1 = ctx->D1;
+    D2 = ctx->D2;
+    T1_old = ctx->T1_old;
+    T2 = ctx->T2;
+    Ts_old = ctx->Ts_old;
+    Told_node = ctx->Told_node;
+    bubble = ctx->bubble;
+    dp = ctx->dp;
+    expt = ctx->expt;
+    ice0 = ctx->ice0;
+    kappa1 = ctx->kappa1;
+    kappa2 = ctx->kappa2;
+    max_moist = ctx->max_moist;
+    moist = ctx->moist;
+
+
+    root = ctx->root;
+    CanopLayerBnd = ctx->CanopLayerBnd;
 
     /* meteorological forcing terms */
-    UnderStory = (int) va_arg(ap, int);
-    overstory = (int) va_arg(ap, int);
-
-    NetShortBare = (double) va_arg(ap, double);
-    NetShortGrnd = (double) va_arg(ap, double);
-    NetShortSnow = (double) va_arg(ap, double);
-    Tair = (double) va_arg(ap, double);
-    atmos_density = (double) va_arg(ap, double);
-    atmos_pressure = (double) va_arg(ap, double);
-    elevation = (double) va_arg(ap, double);
-    emissivity = (double) va_arg(ap, double);
-    LongBareIn = (double) va_arg(ap, double);
-    LongSnowIn = (double) va_arg(ap, double);
-    surf_atten = (double) va_arg(ap, double);
-    vp = (double) va_arg(ap, double);
-    vpd = (double) va_arg(ap, double);
-    atmos_shortwave = (double) va_arg(ap, double);
-    atmos_Catm = (double) va_arg(ap, double);
-    dryFrac = (double) va_arg(ap, double);
-
-    Wdew = (double *) va_arg(ap, double *);
-    displacement = (double *) va_arg(ap, double *);
-    ra = (double *) va_arg(ap, double *);
-    ra_veg = (double *) va_arg(ap, double *);
-    ra_used = (double *) va_arg(ap, double *);
-    rainfall = (double) va_arg(ap, double);
-    ref_height = (double *) va_arg(ap, double *);
-    roughness = (double *) va_arg(ap, double *);
-    wind = (double *) va_arg(ap, double *);
+    UnderStory = ctx->UnderStory;
+    overstory = ctx->overstory;
+
+    NetShortBare = ctx->NetShortBare;
+    NetShortGrnd = ctx->NetShortGrnd;
+    NetShortSnow = ctx->NetShortSnow;
+    Tair = ctx->Tair;
+    atmos_density = ctx->atmos_density;
+    atmos_pressure = ctx->atmos_pressure;
+    emissivity = ctx->emissivity;
+    LongBareIn = ctx->LongBareIn;
+    LongSnowIn = ctx->LongSnowIn;
+    surf_atten = ctx->surf_atten;
+    vp = ctx->vp;
+    vpd = ctx->vpd;
+    atmos_shortwave = ctx->shortwave;
+    atmos_Catm = ctx->Catm;
+    dryFrac = *ctx->dryFrac;
+
+    Wdew = ctx->Wdew;
+    displacement = ctx->displacement;
+    ra = ctx->ra;
+    ra_veg = ctx->Ra_veg;
+    ra_used = ctx->Ra_used;
+    rainfall = ctx->rainfall;
+    ref_height = ctx->ref_height;
+    roughness = ctx->roughness;
+    wind = ctx->wind;
 
     /* latent heat terms */
-    Le = (double) va_arg(ap, double);
+    Le = ctx->Le;
 
     /* snowpack terms */
-    Advection = (double) va_arg(ap, double);
-    OldTSurf = (double) va_arg(ap, double);
-    TPack = (double) va_arg(ap, double);
-    Tsnow_surf = (double) va_arg(ap, double);
-    kappa_snow = (double) va_arg(ap, double);
-    melt_energy = (double) va_arg(ap, double);
-    snow_coverage = (double) va_arg(ap, double);
-    snow_density = (double) va_arg(ap, double);
-    snow_swq = (double) va_arg(ap, double);
-    snow_water = (double) va_arg(ap, double);
-
-    deltaCC = (double *) va_arg(ap, double *);
-    refreeze_energy = (double *) va_arg(ap, double *);
-    VaporMassFlux = (double *) va_arg(ap, double *);
+    Advection = ctx->Advection;
+    OldTSurf = ctx->OldTSurf;
+    Tsnow_surf = ctx->Tsnow_surf;
+    kappa_snow = ctx->kappa_snow;
+    melt_energy = ctx->melt_energy;
+    snow_coverage = ctx->snow_coverage;
+    snow_density = ctx->snow_density;
+    snow_swq = ctx->snow_swq;
+    snow_water = ctx->snow_water;
+
+    deltaCC = ctx->deltaCC;
+    refreeze_energy = ctx->refreeze_energy;
+    VaporMassFlux = ctx->vapor_flux;
 
     /* soil node terms */
-    Nnodes = (int) va_arg(ap, int);
-
-    Cs_node = (double *) va_arg(ap, double *);
-    T_node = (double *) va_arg(ap, double *);
-    Tnew_node = (double *) va_arg(ap, double *);
-    alpha = (double *) va_arg(ap, double *);
-    beta = (double *) va_arg(ap, double *);
-    bubble_node = (double *) va_arg(ap, double *);
-    Zsum_node = (double *) va_arg(ap, double *);
-    expt_node = (double *) va_arg(ap, double *);
-    gamma = (double *) va_arg(ap, double *);
-    ice_node = (double *) va_arg(ap, double *);
-    kappa_node = (double *) va_arg(ap, double *);
-    max_moist_node = (double *) va_arg(ap, double *);
-    moist_node = (double *) va_arg(ap, double *);
-    frost_fract = (double *) va_arg(ap, double *);
+    Nnodes = ctx->Nnodes;
+
+    Cs_node = ctx->Cs_node;
+    T_node = ctx->T_node;
+    Tnew_node = ctx->Tnew_node;
+    alpha = ctx->alpha;
+    beta = ctx->beta;
+    bubble_node = ctx->bubble_node;
+    Zsum_node = ctx->Zsum_node;
+    expt_node = ctx->expt_node;
+    gamma = ctx->gamma;
+    ice_node = ctx->ice_node;
+    kappa_node = ctx->kappa_node;
+    max_moist_node = ctx->max_moist_node;
+    moist_node = ctx->moist_node;
 
     /* model structures */
-    layer = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-    veg_var = (veg_var_struct *) va_arg(ap, veg_var_struct *);
+    layer = ctx->layer;
+    veg_var = ctx->veg_var;
 
     /* control flags */
-    INCLUDE_SNOW = (int) va_arg(ap, int);
-    FS_ACTIVE = (int) va_arg(ap, int);
-    NOFLUX = (int) va_arg(ap, int);
-    EXP_TRANS = (int) va_arg(ap, int);
-    SNOWING = (int) va_arg(ap, int);
+    INCLUDE_SNOW = ctx->INCLUDE_SNOW;
+    NOFLUX = ctx->NOFLUX;
+    EXP_TRANS = ctx->EXP_TRANS;
+    SNOWING = ctx->SNOWING;
 
-    FIRST_SOLN = (int *) va_arg(ap, int *);
+    FIRST_SOLN = ctx->FIRST_SOLN;
 
     /* returned energy balance terms */
-    NetLongBare = (double *) va_arg(ap, double *);
-    NetLongSnow = (double *) va_arg(ap, double *);
-    T1 = (double *) va_arg(ap, double *);
-    deltaH = (double *) va_arg(ap, double *);
-    fusion = (double *) va_arg(ap, double *);
-    grnd_flux = (double *) va_arg(ap, double *);
-    latent_heat = (double *) va_arg(ap, double *);
-    latent_heat_sub = (double *) va_arg(ap, double *);
-    sensible_heat = (double *) va_arg(ap, double *);
-    snow_flux = (double *) va_arg(ap, double *);
-    store_error = (double *) va_arg(ap, double *);
+    NetLongBare = ctx->NetLongBare;
+    NetLongSnow = ctx->NetLongSnow;
+    T1 = ctx->T1;
+    deltaH = ctx->deltaH;
+    fusion = ctx->fusion;
+    grnd_flux = ctx->grnd_flux;
+    latent_heat = ctx->latent_heat;
+    latent_heat_sub = ctx->latent_heat_sub;
+    sensible_heat = ctx->sensible_heat;
+    snow_flux = ctx->snow_flux;
+    store_error = ctx->store_error;
+
+    /* take additional variables from soil_con structure */
+    b_infilt = ctx->soil_con->b_infilt;
+    max_infil = ctx->soil_con->max_infil;
+    Wcr = ctx->soil_con->Wcr;
+    Wpwp = ctx->soil_con->Wpwp;
+    depth = ctx->soil_con->depth;
+    resid_moist = ctx->soil_con->resid_moist;
+    elevation = (double) ctx->soil_con->elevation;
+    frost_fract = ctx->soil_con->frost_fract;
+    FS_ACTIVE = ctx->soil_con->FS_ACTIVE;
 
     /***************
        Main Routine
@@ -26,6 +26,10 @@
 
 #include <vic_run.h>
 
+/** number of canopy layers passed to photosynth_layers() at a time, which
+    sets the size of the stack arrays that hold its per-layer results */
+#define PHOTO_LAYER_BLOCK 16
+
 /******************************************************************************
  * @brief    Calculate GPP, Raut, and NPP for veg cover with multi-layer canopy
  *****************************************************************************/
@@ -60,11 +64,15 @@ canopy_assimilation(char    Ctype,
     double                   h;
     double                   pz;
     size_t                   cidx;
+    size_t                   c0;
+    size_t                   i;
+    size_t                   nlayers;
+    size_t                   mark;
     double                   dLAI;
     double                  *CiLayer = NULL;
-    double                   AgrossLayer;
-    double                   RdarkLayer;
-    double                   RphotoLayer;
+    double                   AgrossLayer[PHOTO_LAYER_BLOCK];
+    double                   RdarkLayer[PHOTO_LAYER_BLOCK];
+    double                   RphotoLayer[PHOTO_LAYER_BLOCK];
     double                   gc; /* 1/rs */
 
     /* calculate scale height based on average temperature in the column */
@@ -74,8 +82,8 @@ canopy_assimilation(char    Ctype,
        temperature is equal air_temp */
     pz = CONST_PSTD * exp(-(double) elevation / h);
 
-    CiLayer = calloc(options.Ncanopy, sizeof(*CiLayer));
-    check_alloc_status(CiLayer, "Memory allocation error.");
+    mark = scratch_mark();
+    CiLayer = scratch_calloc(options.Ncanopy, sizeof(*CiLayer));
 
     if (!strcasecmp(mode, "ci")) {
         /* Assume a default leaf-internal CO2; compute assimilation,
@@ -102,36 +110,43 @@ canopy_assimilation(char    Ctype,
         *Rdark = 0.0;
         *Rphoto = 0.0;
         gc = 0.0;
-        for (cidx = 0; cidx < options.Ncanopy; cidx++) {
-            photosynth(Ctype,
-                       MaxCarboxRate,
-                       MaxETransport,
-                       CO2Specificity,
-                       NscaleFactor[cidx],
-                       Tfoliage,
-                       SWdown / param.PHOTO_EPAR, /* note: divide by Epar to convert from W/m2 to mol(photons)/m2s */
-                       aPAR[cidx],
-                       pz,
-                       Catm,
-                       mode,
-                       &(rsLayer[cidx]),
-                       &(CiLayer[cidx]),
-                       &RdarkLayer,
-                       &RphotoLayer,
-                       &AgrossLayer);
-
-            if (cidx > 0) {
-                dLAI = LAItotal *
-                       (CanopLayerBnd[cidx] - CanopLayerBnd[cidx - 1]);
+        for (c0 = 0; c0 < options.Ncanopy; c0 += PHOTO_LAYER_BLOCK) {
+            nlayers = options.Ncanopy - c0;
+            if (nlayers > PHOTO_LAYER_BLOCK) {
+                nlayers = PHOTO_LAYER_BLOCK;
             }
-            else {
-                dLAI = LAItotal * CanopLayerBnd[cidx];
+            photosynth_layers(Ctype,
+                              MaxCarboxRate,
+                              MaxETransport,
+                              CO2Specificity,
+                              &(NscaleFactor[c0]),
+                              Tfoliage,
+                              SWdown / param.PHOTO_EPAR, /* note: divide by Epar to convert from W/m2 to mol(photons)/m2s */
+                              &(aPAR[c0]),
+                              pz,
+                              Catm,
+                              mode,
+                              nlayers,
+                              &(rsLayer[c0]),
+                              &(CiLayer[c0]),
+                              RdarkLayer,
+                              RphotoLayer,
+                              AgrossLayer);
+            for (i = 0; i < nlayers; i++) {
+                cidx = c0 + i;
+                if (cidx > 0) {
+                    dLAI = LAItotal *
+                           (CanopLayerBnd[cidx] - CanopLayerBnd[cidx - 1]);
+                }
+                else {
+                    dLAI = LAItotal * CanopLayerBnd[cidx];
+                }
+
+                *GPP += AgrossLayer[i] * dLAI;
+                *Rdark += RdarkLayer[i] * dLAI;
+                *Rphoto += RphotoLayer[i] * dLAI;
+                gc += (1 / rsLayer[cidx]) * dLAI;
             }
-
-            *GPP += AgrossLayer * dLAI;
-            *Rdark += RdarkLayer * dLAI;
-            *Rphoto += RphotoLayer * dLAI;
-            gc += (1 / rsLayer[cidx]) * dLAI;
         }
 
         if (gc < DBL_EPSILON) {
@@ -150,36 +165,43 @@ canopy_assimilation(char    Ctype,
         *Rdark = 0.0;
         *Rphoto = 0.0;
         *Ci = 0.0;
-        for (cidx = 0; cidx < options.Ncanopy; cidx++) {
-            photosynth(Ctype,
-                       MaxCarboxRate,
-                       MaxETransport,
-                       CO2Specificity,
-                       NscaleFactor[cidx],
-                       Tfoliage,
-                       SWdown / param.PHOTO_EPAR,
-                       aPAR[cidx],
-                       pz,
-                       Catm,
-                       mode,
-                       &(rsLayer[cidx]),
-                       &(CiLayer[cidx]),
-                       &RdarkLayer,
-                       &RphotoLayer,
-                       &AgrossLayer);
-
-            if (cidx > 0) {
-                dLAI = LAItotal *
-                       (CanopLayerBnd[cidx] - CanopLayerBnd[cidx - 1]);
+        for (c0 = 0; c0 < options.Ncanopy; c0 += PHOTO_LAYER_BLOCK) {
+            nlayers = options.Ncanopy - c0;
+            if (nlayers > PHOTO_LAYER_BLOCK) {
+                nlayers = PHOTO_LAYER_BLOCK;
             }
-            else {
-                dLAI = LAItotal * CanopLayerBnd[cidx];
+            photosynth_layers(Ctype,
+                              MaxCarboxRate,
+                              MaxETransport,
+                              CO2Specificity,
+                              &(NscaleFactor[c0]),
+                              Tfoliage,
+                              SWdown / param.PHOTO_EPAR,
+                              &(aPAR[c0]),
+                              pz,
+                              Catm,
+                              mode,
+                              nlayers,
+                              &(rsLayer[c0]),
+                              &(CiLayer[c0]),
+                              RdarkLayer,
+                              RphotoLayer,
+                              AgrossLayer);
+            for (i = 0; i < nlayers; i++) {
+                cidx = c0 + i;
+                if (cidx > 0) {
+                    dLAI = LAItotal *
+                           (CanopLayerBnd[cidx] - CanopLayerBnd[cidx - 1]);
+                }
+                else {
+                    dLAI = LAItotal * CanopLayerBnd[cidx];
+                }
+
+                *GPP += AgrossLayer[i] * dLAI;
+                *Rdark += RdarkLayer[i] * dLAI;
+                *Rphoto += RphotoLayer[i] * dLAI;
+                *Ci += CiLayer[cidx] * dLAI;
             }
-
-            *GPP += AgrossLayer * dLAI;
-            *Rdark += RdarkLayer * dLAI;
-            *Rphoto += RphotoLayer * dLAI;
-            *Ci += CiLayer[cidx] * dLAI;
         }
     }
 
@@ -190,5 +212,5 @@ canopy_assimilation(char    Ctype,
     *Raut = *Rmaint + *Rgrowth;
     *NPP = *GPP - *Raut;
 
-    free((char*) CiLayer);
+    scratch_release(mark);
 }
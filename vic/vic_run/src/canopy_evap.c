@@ -204,6 +204,7 @@ transpiration(layer_data_struct *layer,
     double                   gc;
     double                  *gsLayer = NULL;
     size_t                   cidx;
+    size_t                   mark = 0;
 
     /**********************************************************************
        EVAPOTRANSPIRATION
@@ -372,8 +373,8 @@ transpiration(layer_data_struct *layer,
         /* Initialize conductances for aggregation over soil layers */
         gc = 0;
         if (options.CARBON) {
-            gsLayer = calloc(options.Ncanopy, sizeof(*gsLayer));
-            check_alloc_status(gsLayer, "Memory allocation error.");
+            mark = scratch_mark();
+            gsLayer = scratch_calloc(options.Ncanopy, sizeof(*gsLayer));
             for (cidx = 0; cidx < options.Ncanopy; cidx++) {
                 gsLayer[cidx] = 0;
             }
@@ -489,7 +490,7 @@ transpiration(layer_data_struct *layer,
         }
 
         if (options.CARBON) {
-            free((char *) gsLayer);
+            scratch_release(mark);
         }
     }
 
@@ -33,7 +33,7 @@
  *****************************************************************************/
 void
 compute_derived_lake_dimensions(lake_var_struct *lake,
-                                lake_con_struct  lake_con)
+                                lake_con_struct *lake_con)
 {
     extern parameters_struct param;
 
@@ -72,7 +72,7 @@ compute_derived_lake_dimensions(lake_var_struct *lake,
         lake->ldepth = 0.0;
     }
 
-    // lake_con.basin equals the surface area at specific depths as input by
+    // lake_con->basin equals the surface area at specific depths as input by
     // the user in the lake parameter file or calculated in read_lakeparam(),
     // lake->surface equals the area at the top of each dynamic solution layer
 
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Copy the state of the energy balance structure that is used by a model with
+ * a given number of soil thermal nodes.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_run.h>
+
+/******************************************************************************
+ * @brief    Copy an energy balance structure, skipping the unused elements
+ *           of its soil thermal node arrays.
+ *
+ * @details  Replaces the structure assignment dst = src in surface_fluxes(),
+ *           which copies the energy balance at least four times per snow
+ *           step.  The node arrays are sized for MAX_NODES nodes and make up
+ *           most of the structure, but only their first Nnodes elements are
+ *           ever used.  vic_def.h declares the node arrays last, so all
+ *           other fields are copied in one block, followed by the first
+ *           Nnodes elements of each node array.  The remaining elements of
+ *           dst are left untouched.
+ *****************************************************************************/
+void
+copy_energy_bal(energy_bal_struct *dst,
+                energy_bal_struct *src,
+                size_t             Nnodes)
+{
+    if (Nnodes > MAX_NODES) {
+        Nnodes = MAX_NODES;
+    }
+
+    // all fields declared before the node arrays
+    memcpy(dst, src, offsetof(energy_bal_struct, Cs_node));
+
+    // used elements of the node arrays
+    memcpy(dst->Cs_node, src->Cs_node, Nnodes * sizeof(src->Cs_node[0]));
+    memcpy(dst->ice, src->ice, Nnodes * sizeof(src->ice[0]));
+    memcpy(dst->kappa_node, src->kappa_node,
+           Nnodes * sizeof(src->kappa_node[0]));
+    memcpy(dst->moist, src->moist, Nnodes * sizeof(src->moist[0]));
+    memcpy(dst->T, src->T, Nnodes * sizeof(src->T[0]));
+    memcpy(dst->T_fbflag, src->T_fbflag, Nnodes * sizeof(src->T_fbflag[0]));
+    memcpy(dst->T_fbcount, src->T_fbcount,
+           Nnodes * sizeof(src->T_fbcount[0]));
+}
@@ -51,10 +51,12 @@ calc_layer_average_thermal_props(energy_bal_struct *energy,
     };
     double            ***tmpT;
     double             **tmpZ;
+    size_t               mark;
 
     // allocate memory for tmpT and tmpZ
-    malloc_3d_double(tmpTshape, &tmpT);
-    malloc_2d_double(tmpZshape, &tmpZ);
+    mark = scratch_mark();
+    tmpT = scratch_3d_double(tmpTshape);
+    tmpZ = scratch_2d_double(tmpZshape);
 
     if (options.FROZEN_SOIL && soil_con->FS_ACTIVE) {
         find_0_degree_fronts(energy, soil_con->Zsum_node, T, Nnodes);
@@ -135,8 +137,7 @@ calc_layer_average_thermal_props(energy_bal_struct *energy,
     }
 
     // free memory for tmpT and tmpZ
-    free_3d_double(tmpTshape, tmpT);
-    free_2d_double(tmpZshape, tmpZ);
+    scratch_release(mark);
 
     return (0);
 }
@@ -280,16 +281,20 @@ solve_T_profile_implicit(double   *T,                               // update
                          double   *organic,                    // soil parameter
                          double   *depth)                     // soil parameter
 {
-    extern option_struct options;
-    int                  n, Error;
-    double               res[MAX_NODES];
-    void                 (*vecfunc)(double *, double *, int, int, ...);
-    int                  j;
+    extern option_struct    options;
+    int                     n, Error;
+    double                  res[MAX_NODES];
+    int                     j;
+    fda_heat_eqn_ctx_struct ctx;
 
     if (FIRST_SOLN[0]) {
         FIRST_SOLN[0] = false;
     }
 
+    // work arrays start from zero; kappa_new of the bottom boundary node is
+    // never computed
+    memset(&ctx, 0, sizeof(ctx));
+
     // initialize fda_heat_eqn:
     // pass model parameters, initial states, and soil parameters
     // it MUST be initialized before Newton-Raphson searching
@@ -300,15 +305,41 @@ solve_T_profile_implicit(double   *T,                               // update
         n = Nnodes - 1;
     }
 
-    fda_heat_eqn(&T[1], res, n, 1, deltat, NOFLUX, EXP_TRANS, T0,
-                 moist, ice, kappa, Cs, max_moist, bubble, expt,
-                 alpha, beta, gamma, Zsum, Dp, bulk_dens_min, soil_dens_min,
-                 quartz, bulk_density, soil_density, organic, depth,
-                 options.Nlayer);
+    ctx.deltat = deltat;
+    ctx.NOFLUX = NOFLUX;
+    ctx.EXP_TRANS = EXP_TRANS;
+    ctx.T0 = T0;
+    ctx.moist = moist;
+    ctx.ice = ice;
+    ctx.kappa = kappa;
+    ctx.Cs = Cs;
+    ctx.max_moist = max_moist;
+    ctx.bubble = bubble;
+    ctx.expt = expt;
+    ctx.alpha = alpha;
+    ctx.beta = beta;
+    ctx.gamma = gamma;
+    ctx.Zsum = Zsum;
+    ctx.Dp = Dp;
+    ctx.bulk_dens_min = bulk_dens_min;
+    ctx.soil_dens_min = soil_dens_min;
+    ctx.quartz = quartz;
+    ctx.bulk_density = bulk_density;
+    ctx.soil_density = soil_density;
+    ctx.organic = organic;
+    ctx.depth = depth;
+    ctx.Nlayers = options.Nlayer;
+    fda_heat_eqn(&T[1], res, n, 1, -1, &ctx);
 
     // modified Newton-Raphson to solve for new T
-    vecfunc = &(fda_heat_eqn);
-    Error = newt_raph(vecfunc, &T[1], n);
+    if (options.ANALYTIC_JACOBIAN) {
+        Error = newt_raph(fda_heat_eqn, fda_heat_eqn_jac, &T[1], n, &ctx,
+                          SOLVER_HEAT_EQN_IMPLICIT);
+    }
+    else {
+        Error = newt_raph(fda_heat_eqn, NULL, &T[1], n, &ctx,
+                          SOLVER_HEAT_EQN_IMPLICIT);
+    }
 
     // update temperature boundaries
     if (Error == 0) {
@@ -363,22 +394,26 @@ calc_soil_thermal_fluxes(int       Nnodes,
                          int       NOFLUX,
                          int       EXP_TRANS)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
-
-    int                      Error;
-    char                     Done;
-    int                      j;
-    int                      ItCount;
-    double                   threshold = 1.e-2; /* temperature profile iteration threshold */
-    double                   maxdiff;
-    double                   diff;
-    double                   oldT;
-    double                   Tlast[MAX_NODES];
+    extern option_struct        options;
+    extern parameters_struct    param;
+
+    int                         Error;
+    char                        Done;
+    int                         j;
+    int                         ItCount;
+    double                      threshold = 1.e-2; /* temperature profile iteration threshold */
+    double                      maxdiff;
+    double                      diff;
+    double                      oldT;
+    double                      Tlast[MAX_NODES];
+    soil_thermal_eqn_ctx_struct ctx;
+    solver_stats_struct        *stats;
 
     Error = 0;
     Done = false;
     ItCount = 0;
+    stats = get_solver_stats(SOLVER_SOIL_THERMAL);
+    stats->calls++;
 
     /* initialize Tlast */
     for (j = 0; j < Nnodes; j++) {
@@ -391,8 +426,26 @@ calc_soil_thermal_fluxes(int       Nnodes,
         Tfbcount[j] = 0;
     }
 
+    /* Newton iterations on the whole profile, with the Gauss-Seidel sweeps
+       below as the fallback */
+    if (options.FROZEN_NEWTON) {
+        if (calc_soil_thermal_fluxes_newton(Nnodes, T, T0, moist, max_moist,
+                                            ice, bubble, expt, A, B, C, D, E,
+                                            FS_ACTIVE, NOFLUX,
+                                            EXP_TRANS) == 0) {
+            Done = true;
+        }
+        else {
+            stats->fallbacks++;
+            for (j = 0; j < Nnodes; j++) {
+                T[j] = Tlast[j];
+            }
+        }
+    }
+
     while (!Done && Error == 0 && ItCount < param.FROZEN_MAXITER) {
         ItCount++;
+        stats->evals++;
         maxdiff = threshold;
         for (j = 1; j < Nnodes - 1; j++) {
             oldT = T[j];
@@ -416,12 +469,25 @@ calc_soil_thermal_fluxes(int       Nnodes,
                 }
             }
             else {
+                ctx.TL = T[j + 1];
+                ctx.TU = T[j - 1];
+                ctx.T0 = T0[j];
+                ctx.moist = moist[j];
+                ctx.max_moist = max_moist[j];
+                ctx.bubble = bubble[j];
+                ctx.expt = expt[j];
+                ctx.ice0 = ice[j];
+                ctx.A = A[j];
+                ctx.B = B[j];
+                ctx.C = C[j];
+                ctx.D = D[j];
+                ctx.E = E[j];
+                ctx.EXP_TRANS = EXP_TRANS;
+                ctx.j = j;
                 T[j] =
                     root_brent(T0[j] - (param.SOIL_DT), T0[j] + (param.SOIL_DT),
-                               soil_thermal_eqn,
-                               T[j + 1], T[j - 1], T0[j], moist[j],
-                               max_moist[j], bubble[j], expt[j], ice[j],
-                               A[j], B[j], C[j], D[j], E[j], EXP_TRANS, j);
+                               soil_thermal_eqn, &ctx,
+                               SOLVER_SOIL_THERMAL_NODE);
                 if (T[j] <= -998) {
                     if (options.TFALLBACK) {
                         T[j] = T0[j];
@@ -429,13 +495,7 @@ calc_soil_thermal_fluxes(int       Nnodes,
                         Tfbcount[j]++;
                     }
                     else {
-                        error_solve_T_profile(T[j], T[j + 1], T[j - 1], T0[j],
-                                              moist[j],
-                                              max_moist[j], bubble[j], expt[j],
-                                              ice[j],
-                                              gamma[j - 1], A[j], B[j], C[j],
-                                              D[j],
-                                              E[j]);
+                        error_print_solve_T_profile(T[j], &ctx, gamma[j - 1]);
                         return (ERROR);
                     }
                 }
@@ -468,17 +528,25 @@ calc_soil_thermal_fluxes(int       Nnodes,
                 }
             }
             else {
+                ctx.TL = T[Nnodes - 1];
+                ctx.TU = T[Nnodes - 2];
+                ctx.T0 = T0[Nnodes - 1];
+                ctx.moist = moist[Nnodes - 1];
+                ctx.max_moist = max_moist[Nnodes - 1];
+                ctx.bubble = bubble[j];
+                ctx.expt = expt[Nnodes - 1];
+                ctx.ice0 = ice[Nnodes - 1];
+                ctx.A = A[j];
+                ctx.B = B[j];
+                ctx.C = C[j];
+                ctx.D = D[j];
+                ctx.E = E[j];
+                ctx.EXP_TRANS = EXP_TRANS;
+                ctx.j = j;
                 T[Nnodes - 1] = root_brent(T0[Nnodes - 1] - param.SOIL_DT,
                                            T0[Nnodes - 1] + param.SOIL_DT,
-                                           soil_thermal_eqn,
-                                           T[Nnodes - 1],
-                                           T[Nnodes - 2], T0[Nnodes - 1],
-                                           moist[Nnodes - 1],
-                                           max_moist[Nnodes - 1],
-                                           bubble[j], expt[Nnodes - 1],
-                                           ice[Nnodes - 1],
-                                           A[j], B[j], C[j], D[j], E[j],
-                                           EXP_TRANS, j);
+                                           soil_thermal_eqn, &ctx,
+                                           SOLVER_SOIL_THERMAL_NODE);
                 if (T[j] <= -998) {
                     if (options.TFALLBACK) {
                         T[j] = T0[j];
@@ -486,14 +554,8 @@ calc_soil_thermal_fluxes(int       Nnodes,
                         Tfbcount[j]++;
                     }
                     else {
-                        error_solve_T_profile(T[Nnodes - 1], T[Nnodes - 1],
-                                              T[Nnodes - 2], T0[Nnodes - 1],
-                                              moist[Nnodes - 1],
-                                              max_moist[Nnodes - 1],
-                                              bubble[Nnodes - 1],
-                                              expt[Nnodes - 1], ice[Nnodes - 1],
-                                              gamma[Nnodes - 2],
-                                              A[j], B[j], C[j], D[j], E[j]);
+                        error_print_solve_T_profile(T[Nnodes - 1], &ctx,
+                                                    gamma[Nnodes - 2]);
                         return (ERROR);
                     }
                 }
@@ -530,6 +592,7 @@ calc_soil_thermal_fluxes(int       Nnodes,
     }
 
     if (!Done && !Error) {
+        stats->maxiter++;
         if (options.TFALLBACK) {
             for (j = 0; j < Nnodes; j++) {
                 T[j] = T0[j];
@@ -554,29 +617,185 @@ calc_soil_thermal_fluxes(int       Nnodes,
 }
 
 /******************************************************************************
- * @brief    Dummy function to allow calling of error_print_solve_T_profile()
+ * @brief    Solve the soil temperature profile of calc_soil_thermal_fluxes()
+ *           with Newton iterations on the full tridiagonal system.
+ *
+ * @details  The residual of each node is the finite difference equation of
+ *           soil_thermal_eqn(), including its cold nose fix for the first
+ *           node.  The phase term is linearized with the derivative of
+ *           maximum_unfrozen_water(), so that each iteration is a single
+ *           tridiagonal solve over all nodes, instead of a Gauss-Seidel
+ *           sweep with one root_brent() search per frozen node.
+ *
+ *           Iterations are counted in the SOLVER_SOIL_THERMAL statistics
+ *           of the caller.
+ *
+ * @return   0 if the profile converged, 1 otherwise.  On failure T holds the
+ *           last iterate and must be reset by the caller.
  *****************************************************************************/
-double
-error_solve_T_profile(double Tj,
-                      ...)
+int
+calc_soil_thermal_fluxes_newton(int     Nnodes,
+                                double *T,
+                                double *T0,
+                                double *moist,
+                                double *max_moist,
+                                double *ice,
+                                double *bubble,
+                                double *expt,
+                                double *A,
+                                double *B,
+                                double *C,
+                                double *D,
+                                double *E,
+                                int     FS_ACTIVE,
+                                int     NOFLUX,
+                                int     EXP_TRANS)
 {
-    va_list ap;
+    extern option_struct     options;
+    extern parameters_struct param;
+
+    double                   threshold = 1.e-2; /* same as Gauss-Seidel */
+    double                   aa[MAX_NODES];
+    double                   bb[MAX_NODES];
+    double                   cc[MAX_NODES];
+    double                   rr[MAX_NODES];
+    double                   TL;
+    double                   TU;
+    double                   unfrozen;
+    double                   ice_new;
+    double                   dice;
+    double                   value;
+    double                   dT;
+    double                   dTL;
+    double                   dTU;
+    double                   flux_term1;
+    double                   flux_term2;
+    double                   maxdiff;
+    bool                     frozen;
+    int                      ItCount;
+    int                      n;
+    int                      j;
+    int                      k;
+    solver_stats_struct     *stats;
 
-    double  error;
+    stats = get_solver_stats(SOLVER_SOIL_THERMAL);
 
-    va_start(ap, Tj);
-    error = error_print_solve_T_profile(Tj, ap);
-    va_end(ap);
+    if (NOFLUX) {
+        n = Nnodes - 1;
+    }
+    else {
+        n = Nnodes - 2;
+    }
+    if (n < 1) {
+        return (0);
+    }
 
-    return error;
+    for (ItCount = 0; ItCount < param.NEWT_RAPH_MAXTRIAL; ItCount++) {
+        stats->evals++;
+        frozen = false;
+        for (k = 0; k < n; k++) {
+            j = k + 1;
+            TU = T[j - 1];
+            if (j < Nnodes - 1) {
+                TL = T[j + 1];
+            }
+            else {
+                TL = T[j];
+            }
+
+            /* ice content and its derivative with respect to T */
+            ice_new = 0.;
+            dice = 0.;
+            if (T[j] < 0 && FS_ACTIVE && options.FROZEN_SOIL) {
+                frozen = true;
+                unfrozen = maximum_unfrozen_water(T[j], max_moist[j],
+                                                  bubble[j], expt[j]);
+                ice_new = moist[j] - unfrozen;
+                if (unfrozen > 0. && unfrozen < max_moist[j]) {
+                    dice = 2.0 / (expt[j] - 3.0) * unfrozen / T[j];
+                }
+                if (ice_new < 0.) {
+                    ice_new = 0.;
+                    dice = 0.;
+                }
+                if (ice_new > max_moist[j]) {
+                    ice_new = max_moist[j];
+                    dice = 0.;
+                }
+            }
+
+            /* residual and its derivatives with respect to T, TL and TU */
+            flux_term1 = B[j] * (TL - TU);
+            if (!EXP_TRANS) {
+                flux_term2 = C[j] * (TL - T[j]) - D[j] * (T[j] - TU);
+                dT = -A[j] - C[j] - D[j];
+                dTL = B[j] + C[j];
+                dTU = -B[j] + D[j];
+            }
+            else {
+                flux_term2 = C[j] * (TL - 2. * T[j] + TU) - D[j] * (TL - TU);
+                dT = -A[j] - 2. * C[j];
+                dTL = B[j] + C[j] - D[j];
+                dTU = -B[j] + C[j] + D[j];
+            }
+            value = -A[j] * (T[j] - T0[j]) + flux_term1 + flux_term2 +
+                    E[j] * (ice_new - ice[j]);
+            dT += E[j] * dice;
+
+            /* cold nose fix of soil_thermal_eqn() */
+            if (j == 1 && T[j] < 0 && FS_ACTIVE && options.FROZEN_SOIL &&
+                fabs(TL - TU) > 5. && T[j] < TL && T[j] < TU &&
+                flux_term1 < 0 && flux_term2 > 0 &&
+                fabs(flux_term1) > fabs(flux_term2)) {
+                value -= flux_term1;
+                dTL -= B[j];
+                dTU += B[j];
+            }
+
+            /* no flux bottom boundary: TL is the node itself */
+            if (j == Nnodes - 1) {
+                dT += dTL;
+                dTL = 0.;
+            }
+
+            aa[k] = dTU;
+            bb[k] = dT;
+            cc[k] = dTL;
+            rr[k] = -value;
+        }
+
+        tridiag(aa, bb, cc, rr, n);
+
+        maxdiff = 0.;
+        for (k = 0; k < n; k++) {
+            if (!isfinite(rr[k])) {
+                return (1);
+            }
+            T[k + 1] += rr[k];
+            if (fabs(rr[k]) > maxdiff) {
+                maxdiff = fabs(rr[k]);
+            }
+            if (T[k + 1] < 0 && FS_ACTIVE && options.FROZEN_SOIL) {
+                frozen = true;
+            }
+        }
+        /* without frozen nodes the system is linear and the step exact */
+        if (maxdiff <= threshold || !frozen) {
+            return (0);
+        }
+    }
+    stats->maxiter++;
+
+    return (1);
 }
 
 /******************************************************************************
  * @brief    Print soil temperature terms.
  *****************************************************************************/
 double
-error_print_solve_T_profile(double  T,
-                            va_list ap)
+error_print_solve_T_profile(double                       T,
+                            soil_thermal_eqn_ctx_struct *ctx,
+                            double                       gamma)
 {
     double TL;
     double TU;
@@ -586,27 +805,25 @@ error_print_solve_T_profile(double  T,
     double bubble;
     double expt;
     double ice0;
-    double gamma;
     double A;
     double B;
     double C;
     double D;
     double E;
 
-    TL = (double) va_arg(ap, double);
-    TU = (double) va_arg(ap, double);
-    T0 = (double) va_arg(ap, double);
-    moist = (double) va_arg(ap, double);
-    max_moist = (double) va_arg(ap, double);
-    bubble = (double) va_arg(ap, double);
-    expt = (double) va_arg(ap, double);
-    ice0 = (double) va_arg(ap, double);
-    gamma = (double) va_arg(ap, double);
-    A = (double) va_arg(ap, double);
-    B = (double) va_arg(ap, double);
-    C = (double) va_arg(ap, double);
-    D = (double) va_arg(ap, double);
-    E = (double) va_arg(ap, double);
+    TL = ctx->TL;
+    TU = ctx->TU;
+    T0 = ctx->T0;
+    moist = ctx->moist;
+    max_moist = ctx->max_moist;
+    bubble = ctx->bubble;
+    expt = ctx->expt;
+    ice0 = ctx->ice0;
+    A = ctx->A;
+    B = ctx->B;
+    C = ctx->C;
+    D = ctx->D;
+    E = ctx->E;
 
     log_warn("solve_T_profile failed to converge to a solution "
              "in root_brent.  Variable values will be dumped to the "
@@ -644,96 +861,72 @@ fda_heat_eqn(double T_2[],
              double res[],
              int    n,
              int    init,
-             ...)
+             int    focus,
+             void  *ctx)
 {
-    static double  deltat;
-    static int     NOFLUX;
-    static int     EXP_TRANS;
-    static double *T0;
-    static double *moist;
-    static double *ice;
-    static double *kappa;
-    static double *Cs;
-    static double *max_moist;
-    static double *bubble;
-    static double *expt;
-    static double *alpha;
-    static double *beta;
-    static double *gamma;
-    static double *Zsum;
-    static double  Dp;
-    static double *bulk_dens_min;
-    static double *soil_dens_min;
-    static double *quartz;
-    static double *bulk_density;
-    static double *soil_density;
-    static double *organic;
-    static double *depth;
-    static size_t  Nlayers;
-
-    // variables used to calculate residual of the heat equation
-    // defined here
-    static double Ts;
-    static double Tb;
-
-    // locally used variables
-    static double ice_new[MAX_NODES], Cs_new[MAX_NODES], kappa_new[MAX_NODES];
-    static double DT[MAX_NODES], DT_down[MAX_NODES], DT_up[MAX_NODES];
-    static double Dkappa[MAX_NODES];
-    static double Bexp;
-    char          PAST_BOTTOM;
-    double        storage_term, flux_term, phase_term, flux_term1, flux_term2;
-    double        Lsum;
-    int           i;
-    size_t        lidx;
-    int           focus, left, right;
-
-    // argument list handling
-    va_list       arg_addr;
+    fda_heat_eqn_ctx_struct *c = (fda_heat_eqn_ctx_struct *) ctx;
+
+    double                   deltat = c->deltat;
+    int                      NOFLUX = c->NOFLUX;
+    int                      EXP_TRANS = c->EXP_TRANS;
+    double                  *T0 = c->T0;
+    double                  *moist = c->moist;
+    double                  *ice = c->ice;
+    double                  *kappa = c->kappa;
+    double                  *Cs = c->Cs;
+    double                  *max_moist = c->max_moist;
+    double                  *bubble = c->bubble;
+    double                  *expt = c->expt;
+    double                  *alpha = c->alpha;
+    double                  *beta = c->beta;
+    double                  *gamma = c->gamma;
+    double                  *Zsum = c->Zsum;
+    double                  *bulk_dens_min = c->bulk_dens_min;
+    double                  *soil_dens_min = c->soil_dens_min;
+    double                  *quartz = c->quartz;
+    double                  *bulk_density = c->bulk_density;
+    double                  *soil_density = c->soil_density;
+    double                  *organic = c->organic;
+    double                  *depth = c->depth;
+    size_t                   Nlayers = c->Nlayers;
+
+    // locally used variables, kept in the context between calls because
+    // the focus == j updates only refresh the entries around node j
+    double                  *ice_new = c->ice_new;
+    double                  *Cs_new = c->Cs_new;
+    double                  *kappa_new = c->kappa_new;
+    double                  *DT = c->DT;
+    double                  *DT_down = c->DT_down;
+    double                  *DT_up = c->DT_up;
+    double                  *Dkappa = c->Dkappa;
+    double                   Ts;
+    double                   Tb;
+    double                   Bexp;
+    char                     PAST_BOTTOM;
+    double                   storage_term, flux_term, phase_term, flux_term1,
+                             flux_term2;
+    double                   Lsum;
+    int                      i;
+    size_t                   lidx;
+    int                      left, right;
 
     // initialize variables if init==1
     if (init == 1) {
-        va_start(arg_addr, init);
-        deltat = va_arg(arg_addr, double);
-        NOFLUX = va_arg(arg_addr, int);
-        EXP_TRANS = va_arg(arg_addr, int);
-        T0 = va_arg(arg_addr, double *);
-        moist = va_arg(arg_addr, double *);
-        ice = va_arg(arg_addr, double *);
-        kappa = va_arg(arg_addr, double *);
-        Cs = va_arg(arg_addr, double *);
-        max_moist = va_arg(arg_addr, double *);
-        bubble = va_arg(arg_addr, double *);
-        expt = va_arg(arg_addr, double *);
-        alpha = va_arg(arg_addr, double *);
-        beta = va_arg(arg_addr, double *);
-        gamma = va_arg(arg_addr, double *);
-        Zsum = va_arg(arg_addr, double *);
-        Dp = va_arg(arg_addr, double);
-        bulk_dens_min = va_arg(arg_addr, double *);
-        soil_dens_min = va_arg(arg_addr, double *);
-        quartz = va_arg(arg_addr, double *);
-        bulk_density = va_arg(arg_addr, double *);
-        soil_density = va_arg(arg_addr, double *);
-        organic = va_arg(arg_addr, double *);
-        depth = va_arg(arg_addr, double *);
-        Nlayers = va_arg(arg_addr, size_t);
-
         if (EXP_TRANS) {
             if (!NOFLUX) {
-                Bexp = logf(Dp + 1.) / (double)(n + 1);
+                c->Bexp = logf(c->Dp + 1.) / (double)(n + 1);
             }
             else {
-                Bexp = logf(Dp + 1.) / (double)(n);
+                c->Bexp = logf(c->Dp + 1.) / (double)(n);
             }
         }
 
-        Ts = T0[0];
+        c->Ts = T0[0];
         if (!NOFLUX) {
-            Tb = T0[n + 1];
+            c->Tb = T0[n + 1];
         }
         else {
-            Tb = T0[n];
+            c->Tb = T0[n];
         }
         for (i = 0; i < n; i++) {
             T_2[i] = T0[i + 1];
@@ -741,9 +934,10 @@ fda_heat_eqn(double T_2[],
     }
     // calculate residuals if init==0
     else {
-        // get the range of columns to calculate
-        va_start(arg_addr, init);
-        focus = va_arg(arg_addr, int);
+        Ts = c->Ts;
+        Tb = c->Tb;
+        Bexp = c->Bexp;
+
 
         // calculate all entries if focus == -1
         if (focus == -1) {
@@ -1015,3 +1209,174 @@ fda_heat_eqn(double T_2[],
         } // end of calculation of focus node only
     } // end of non-init
 }
+
+/******************************************************************************
+ * @brief    Tridiagonal Jacobian of fda_heat_eqn(), passed to newt_raph() in
+ *           place of the finite difference Jacobian of fdjac3()
+ *
+ * @details  The derivatives are taken of the residual as fda_heat_eqn()
+ *           computes it.  The node temperatures enter through the
+ *           temperature differences, and through the ice content given by
+ *           maximum_unfrozen_water(), whose derivative is analytic.  The ice
+ *           content changes the node heat capacity, which is linear in it,
+ *           and the node conductivity, whose slope is taken from
+ *           soil_conductivity() alone.  The work arrays of the context must
+ *           hold a full evaluation (focus == -1) of fda_heat_eqn() at T_2.
+ *****************************************************************************/
+void
+fda_heat_eqn_jac(double T_2[],
+                 double a[],
+                 double b[],
+                 double c[],
+                 int    n,
+                 void  *ctx)
+{
+    extern parameters_struct param;
+
+    fda_heat_eqn_ctx_struct *fc = (fda_heat_eqn_ctx_struct *) ctx;
+
+    double                   deltat = fc->deltat;
+    int                      NOFLUX = fc->NOFLUX;
+    int                      EXP_TRANS = fc->EXP_TRANS;
+    double                  *T0 = fc->T0;
+    double                  *moist = fc->moist;
+    double                  *Cs = fc->Cs;
+    double                  *max_moist = fc->max_moist;
+    double                  *bubble = fc->bubble;
+    double                  *expt = fc->expt;
+    double                  *alpha = fc->alpha;
+    double                  *beta = fc->beta;
+    double                  *gamma = fc->gamma;
+    double                  *Zsum = fc->Zsum;
+    double                  *ice_new = fc->ice_new;
+    double                  *Cs_new = fc->Cs_new;
+    double                  *kappa_new = fc->kappa_new;
+    double                  *DT = fc->DT;
+    double                  *DT_down = fc->DT_down;
+    double                  *DT_up = fc->DT_up;
+    double                  *Dkappa = fc->Dkappa;
+    double                   Bexp = fc->Bexp;
+    double                   dice[MAX_NODES];
+    double                   dkappa[MAX_NODES];
+    double                   dCs[MAX_NODES];
+    double                   unfrozen;
+    double                   Wu;
+    double                   kappa_Wu;
+    double                   h;
+    double                   soil_fract;
+    double                   q1;
+    double                   q2;
+    double                   G;
+    double                   H;
+    double                   flux_grad;
+    char                     PAST_BOTTOM;
+    double                   Lsum;
+    int                      i;
+    int                      m;
+    size_t                   lidx;
+
+    // derivatives of the node properties with respect to the temperature
+    // of the node, i.e. of node m with respect to T_2[m - 1]
+    lidx = 0;
+    Lsum = 0.;
+    PAST_BOTTOM = false;
+    for (m = 0; m < n + 1; m++) {
+        dice[m] = 0.;
+        dkappa[m] = 0.;
+        dCs[m] = 0.;
+        if (m >= 1 && T_2[m - 1] < 0 && ice_new[m] > 0) {
+            unfrozen = maximum_unfrozen_water(T_2[m - 1], max_moist[m],
+                                              bubble[m], expt[m]);
+            if (unfrozen > 0. && unfrozen < max_moist[m]) {
+                dice[m] = 2.0 / (expt[m] - 3.0) * unfrozen / T_2[m - 1];
+            }
+        }
+        if (dice[m] != 0.) {
+            Wu = moist[m] - ice_new[m];
+            h = param.NEWT_RAPH_EPS2 * Wu;
+            // kappa_new holds soil_conductivity() at Wu unless the ice
+            // content is unchanged
+            if (ice_new[m] != fc->ice[m]) {
+                kappa_Wu = kappa_new[m];
+            }
+            else {
+                kappa_Wu = soil_conductivity(moist[m], Wu,
+                                             fc->soil_dens_min[lidx],
+                                             fc->bulk_dens_min[lidx],
+                                             fc->quartz[lidx],
+                                             fc->soil_density[lidx],
+                                             fc->bulk_density[lidx],
+                                             fc->organic[lidx]);
+            }
+            dkappa[m] = dice[m] *
+                        (soil_conductivity(moist[m], Wu - h,
+                                           fc->soil_dens_min[lidx],
+                                           fc->bulk_dens_min[lidx],
+                                           fc->quartz[lidx],
+                                           fc->soil_density[lidx],
+                                           fc->bulk_density[lidx],
+                                           fc->organic[lidx]) -
+                         kappa_Wu) / h;
+            // heat capacity is linear in the ice fraction
+            soil_fract = fc->bulk_density[lidx] / fc->soil_density[lidx];
+            dCs[m] = dice[m] *
+                     (volumetric_heat_capacity(soil_fract, Wu - 1.,
+                                               ice_new[m] + 1.,
+                                               fc->organic[lidx]) -
+                      volumetric_heat_capacity(soil_fract, Wu, ice_new[m],
+                                               fc->organic[lidx]));
+        }
+
+        if (Zsum[m] > Lsum + fc->depth[lidx] && !PAST_BOTTOM) {
+            Lsum += fc->depth[lidx];
+            lidx++;
+            if (lidx == fc->Nlayers) {
+                PAST_BOTTOM = true;
+                lidx = fc->Nlayers - 1;
+            }
+        }
+    }
+
+    // a: d res[i] / d T_2[i - 1], b: d res[i] / d T_2[i],
+    // c: d res[i] / d T_2[i + 1]
+    for (i = 0; i < n; i++) {
+        m = i + 1;
+        if (!EXP_TRANS) {
+            q1 = 1. / (alpha[i] * alpha[i]);
+            q2 = 1. / (0.5 * alpha[i]);
+            flux_grad = (DT_down[i] / gamma[i] - DT_up[i] / beta[i]) * q2;
+            b[i] = dkappa[m] * flux_grad -
+                   kappa_new[m] * (1. / gamma[i] + 1. / beta[i]) * q2;
+            if (i > 0) {
+                a[i] = (-Dkappa[i] - dkappa[m - 1] * DT[i]) * q1 +
+                       kappa_new[m] / beta[i] * q2;
+            }
+            if (i < n - 1) {
+                c[i] = (Dkappa[i] + dkappa[m + 1] * DT[i]) * q1 +
+                       kappa_new[m] / gamma[i] * q2;
+            }
+        }
+        else { // grid transformation
+            G = 1. / (Bexp * (Zsum[m] + 1.)) / (Bexp * (Zsum[m] + 1.));
+            H = 1. / 2. / (Bexp * (Zsum[m] + 1.) * (Zsum[m] + 1.));
+            q1 = G / 4.;
+            flux_grad = G * (DT_down[i] - DT_up[i]) - H * DT[i];
+            b[i] = dkappa[m] * flux_grad - 2. * kappa_new[m] * G;
+            if (i > 0) {
+                a[i] = (-Dkappa[i] - dkappa[m - 1] * DT[i]) * q1 +
+                       kappa_new[m] * (G + H);
+            }
+            if (i < n - 1) {
+                c[i] = (Dkappa[i] + dkappa[m + 1] * DT[i]) * q1 +
+                       kappa_new[m] * (G - H);
+            }
+        }
+        if (NOFLUX && i == n - 1) {
+            // Dkappa of the bottom node includes its own conductivity
+            b[i] += dkappa[m] * DT[i] * q1;
+        }
+        b[i] += CONST_RHOICE * CONST_LATICE * dice[m] / deltat -
+                (dCs[m] * (T_2[i] - T0[m]) + Cs_new[m] +
+                 (Cs_new[m] - Cs[m]) + T_2[i] * dCs[m]) / deltat;
+    }
+}
@@ -30,31 +30,20 @@
  * @brief    This routine solves the atmospheric exchange energy balance.
  *****************************************************************************/
 double
-func_atmos_energy_bal(double  Tcanopy,
-                      va_list ap)
+func_atmos_energy_bal(double Tcanopy,
+                      void  *ctx)
 {
-    double  Ra;
-    double  Tair;
-    double  atmos_density;
-    double  InSensible;
-
-    double *SensibleHeat;
+    atmos_energy_bal_ctx_struct *c = (atmos_energy_bal_ctx_struct *) ctx;
 
     // internal routine variables
-    double  Error;
-
-    // extract variables from va_arg
-    Ra = (double)  va_arg(ap, double);
-    Tair = (double)  va_arg(ap, double);
-    atmos_density = (double)  va_arg(ap, double);
-    InSensible = (double)  va_arg(ap, double);
-    SensibleHeat = (double *)va_arg(ap, double *);
+    double                       Error;
 
     // compute sensible heat flux between canopy and atmosphere
-    (*SensibleHeat) = calc_sensible_heat(atmos_density, Tair, Tcanopy, Ra);
+    (*c->SensibleHeat) = calc_sensible_heat(c->atmos_density, c->Tair,
+                                            Tcanopy, c->Ra);
 
     // compute energy balance error
-    Error = InSensible - (*SensibleHeat);
+    Error = c->InSensible - (*c->SensibleHeat);
 
     return (Error);
 }
@@ -30,37 +30,20 @@
  * @brief    This routine solves the atmospheric exchange moisture balance.
  *****************************************************************************/
 double
-func_atmos_moist_bal(double  VPcanopy,
-                     va_list ap)
+func_atmos_moist_bal(double VPcanopy,
+                     void  *ctx)
 {
-    double  InLatentHeat;
-    double  Lv;
-    double  Ra;
-    double  atmos_density;
-    double  gamma;
-    double  vp; // atmospheric vapor pressure
-
-    double *LatentHeat;
+    atmos_moist_bal_ctx_struct *c = (atmos_moist_bal_ctx_struct *) ctx;
 
     // internal routine variables
-    double  Error;
-
-    // extract variables from va_arg
-    InLatentHeat = (double)  va_arg(ap, double);
-    Lv = (double)  va_arg(ap, double);
-    Ra = (double)  va_arg(ap, double);
-    atmos_density = (double)  va_arg(ap, double);
-    gamma = (double)  va_arg(ap, double);
-    vp = (double)  va_arg(ap, double);
-
-    LatentHeat = (double *) va_arg(ap, double *);
+    double                      Error;
 
     // compute sensible heat flux between canopy and atmosphere
-    (*LatentHeat) = Lv * calc_sensible_heat(atmos_density, vp, VPcanopy,
-                                            gamma * Ra);
+    (*c->LatentHeat) = c->Lv * calc_sensible_heat(c->atmos_density, c->vp,
+                                                  VPcanopy, c->gamma * c->Ra);
 
     // compute energy balance error
-    Error = InLatentHeat - (*LatentHeat);
+    Error = c->InLatentHeat - (*c->LatentHeat);
 
     return (Error);
 }
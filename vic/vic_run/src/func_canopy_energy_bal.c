@@ -32,139 +32,141 @@
  * @brief    Calculate the canopy energy balance.
  *****************************************************************************/
 double
-func_canopy_energy_bal(double  Tfoliage,
-                       va_list ap)
+func_canopy_energy_bal(double Tfoliage,
+                       void  *ctx)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
+    extern option_struct          options;
+    extern parameters_struct      param;
+
+    canopy_energy_bal_ctx_struct *c = (canopy_energy_bal_ctx_struct *) ctx;
 
     /* General Model Parameters */
-    double                   delta_t;
-    double                   elevation;
+    double                        delta_t;
+    double                        elevation;
 
-    double                  *Wmax;
-    double                  *Wcr;
-    double                  *Wpwp;
-    double                  *frost_fract;
+    double                       *Wmax;
+    double                       *Wcr;
+    double                       *Wpwp;
+    double                       *frost_fract;
 
     /* Atmopheric Condition and Forcings */
-    double                   AirDens;
-    double                   EactAir;
-    double                   Press;
-    double                   Le;
-    double                   Tcanopy;
-    double                   Vpd;
-    double                   shortwave;
-    double                   Catm;
-    double                  *dryFrac;
-
-    double                  *Evap;
-    double                  *Ra;
-    double                  *Ra_used;
-    double                   Rainfall;
-    double                  *Wind;
+    double                        AirDens;
+    double                        EactAir;
+    double                        Press;
+    double                        Le;
+    double                        Tcanopy;
+    double                        Vpd;
+    double                        shortwave;
+    double                        Catm;
+    double                       *dryFrac;
+
+    double                       *Evap;
+    double                       *Ra;
+    double                       *Ra_used;
+    double                        Rainfall;
+    double                       *Wind;
 
     /* Vegetation Terms */
-    int                      veg_class;
+    int                           veg_class;
 
-    double                  *displacement;
-    double                  *ref_height;
-    double                  *roughness;
+    double                       *displacement;
+    double                       *ref_height;
+    double                       *roughness;
 
-    double                  *root;
-    double                  *CanopLayerBnd;
+    double                       *root;
+    double                       *CanopLayerBnd;
 
     /* Water Flux Terms */
-    double                   IntRain;
-    double                   IntSnow;
+    double                        IntRain;
+    double                        IntSnow;
 
-    double                  *Wdew;
+    double                       *Wdew;
 
-    layer_data_struct       *layer;
-    veg_var_struct          *veg_var;
+    layer_data_struct            *layer;
+    veg_var_struct               *veg_var;
 
     /* Energy Flux Terms */
-    double                   LongOverIn;
-    double                   LongUnderOut;
-    double                   NetShortOver;
-
-    double                  *AdvectedEnergy;
-    double                  *LatentHeat;
-    double                  *LatentHeatSub;
-    double                  *LongOverOut;
-    double                  *NetLongOver;
-    double                  *NetRadiation;
-    double                  *RefreezeEnergy;
-    double                  *SensibleHeat;
-    double                  *VaporMassFlux;
+    double                        LongOverIn;
+    double                        LongUnderOut;
+    double                        NetShortOver;
+
+    double                       *AdvectedEnergy;
+    double                       *LatentHeat;
+    double                       *LatentHeatSub;
+    double                       *LongOverOut;
+    double                       *NetLongOver;
+    double                       *NetRadiation;
+    double                       *RefreezeEnergy;
+    double                       *SensibleHeat;
+    double                       *VaporMassFlux;
 
     /* Internal Variables */
-    double                   EsSnow;
-    double                   Ls;
-    double                   RestTerm;
-    double                   prec;
+    double                        EsSnow;
+    double                        Ls;
+    double                        RestTerm;
+    double                        prec;
 
-    /** Read variables from variable length argument list **/
+    /** Read variables from the solver context **/
 
     /* General Model Parameters */
-    delta_t = (double) va_arg(ap, double);
-    elevation = (double) va_arg(ap, double);
+    delta_t = c->delta_t;
+    elevation = c->elevation;
 
-    Wmax = (double *) va_arg(ap, double *);
-    Wcr = (double *) va_arg(ap, double *);
-    Wpwp = (double *) va_arg(ap, double *);
-    frost_fract = (double *) va_arg(ap, double *);
+    Wmax = c->Wmax;
+    Wcr = c->Wcr;
+    Wpwp = c->Wpwp;
+    frost_fract = c->frost_fract;
 
     /* Atmopheric Condition and Forcings */
-    AirDens = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Le = (double) va_arg(ap, double);
-    Tcanopy = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    shortwave = (double) va_arg(ap, double);
-    Catm = (double) va_arg(ap, double);
-    dryFrac = (double *) va_arg(ap, double *);
-
-    Evap = (double *) va_arg(ap, double *);
-    Ra = (double *) va_arg(ap, double *);
-    Ra_used = (double *) va_arg(ap, double *);
-    Rainfall = (double) va_arg(ap, double);
-    Wind = (double *) va_arg(ap, double *);
+    AirDens = c->AirDens;
+    EactAir = c->EactAir;
+    Press = c->Press;
+    Le = c->Le;
+    Tcanopy = c->Tcanopy;
+    Vpd = c->Vpd;
+    shortwave = c->shortwave;
+    Catm = c->Catm;
+    dryFrac = c->dryFrac;
+
+    Evap = c->Evap;
+    Ra = c->Ra;
+    Ra_used = c->Ra_used;
+    Rainfall = c->Rainfall;
+    Wind = c->Wind;
 
     /* Vegetation Terms */
-    veg_class = (unsigned int) va_arg(ap, unsigned int);
+    veg_class = c->veg_class;
 
-    displacement = (double *) va_arg(ap, double *);
-    ref_height = (double *) va_arg(ap, double *);
-    roughness = (double *) va_arg(ap, double *);
+    displacement = c->displacement;
+    ref_height = c->ref_height;
+    roughness = c->roughness;
 
-    root = (double *) va_arg(ap, double *);
-    CanopLayerBnd = (double *) va_arg(ap, double *);
+    root = c->root;
+    CanopLayerBnd = c->CanopLayerBnd;
 
     /* Water Flux Terms */
-    IntRain = (double) va_arg(ap, double);
-    IntSnow = (double) va_arg(ap, double);
+    IntRain = c->IntRain;
+    IntSnow = c->IntSnow;
 
-    Wdew = (double *) va_arg(ap, double *);
+    Wdew = c->Wdew;
 
-    layer = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-    veg_var = (veg_var_struct *) va_arg(ap, veg_var_struct *);
+    layer = c->layer;
+    veg_var = c->veg_var;
 
     /* Energy Flux Terms */
-    LongOverIn = (double) va_arg(ap, double);
-    LongUnderOut = (double) va_arg(ap, double);
-    NetShortOver = (double) va_arg(ap, double);
-
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    LongOverOut = (double *) va_arg(ap, double *);
-    NetLongOver = (double *) va_arg(ap, double *);
-    NetRadiation = (double *) va_arg(ap, double *);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    VaporMassFlux = (double *) va_arg(ap, double *);
+    LongOverIn = c->LongOverIn;
+    LongUnderOut = c->LongUnderOut;
+    NetShortOver = c->NetShortOver;
+
+    AdvectedEnergy = c->AdvectedEnergy;
+    LatentHeat = c->LatentHeat;
+    LatentHeatSub = c->LatentHeatSub;
+    LongOverOut = c->LongOverOut;
+    NetLongOver = c->NetLongOver;
+    NetRadiation = c->NetRadiation;
+    RefreezeEnergy = c->RefreezeEnergy;
+    SensibleHeat = c->SensibleHeat;
+    VaporMassFlux = c->VaporMassFlux;
 
     /* Calculate the net radiation at the canopy surface, using the canopy
        temperature.  The outgoing longwave is subtracted twice, because the
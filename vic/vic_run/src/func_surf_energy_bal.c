@@ -36,12 +36,14 @@
  * @brief    Calculate the surface energy balance.
  *****************************************************************************/
 double
-func_surf_energy_bal(double  Ts,
-                     va_list ap)
+func_surf_energy_bal(double Ts,
+                     void  *ctx)
 {
     extern parameters_struct param;
     extern option_struct     options;
 
+    surf_energy_bal_ctx_struct *c = (surf_energy_bal_ctx_struct *) ctx;
+
     /* define routine input variables */
 
     /* general model terms */
@@ -204,6 +206,7 @@ func_surf_energy_bal(double  Ts,
     double             D1_minus;
     double             D1_plus;
     double            *transp = NULL;
+    size_t             mark;
     double             Ra_bare[3];
     double             tmp_wind[3];
     double             tmp_height;
@@ -215,129 +218,129 @@ func_surf_energy_bal(double  Ts,
     double             ga_average;
 
     /************************************
-       Read variables from variable list
+       Read variables from solver context
     ************************************/
 
     /* general model terms */
-    VEG = (int) va_arg(ap, int);
-    veg_class = (int) va_arg(ap, int);
-    delta_t = (double) va_arg(ap, double);
+    VEG = c->VEG;
+    veg_class = c->veg_class;
+    delta_t = c->delta_t;
 
     /* soil layer terms */
-    Cs1 = (double) va_arg(ap, double);
-    Cs2 = (double) va_arg(ap, double);
-    D1 = (double) va_arg(ap, double);
-    D2 = (double) va_arg(ap, double);
-    T1_old = (double) va_arg(ap, double);
-    T2 = (double) va_arg(ap, double);
-    Ts_old = (double) va_arg(ap, double);
-    Told_node = (double *) va_arg(ap, double *);
-    bubble = (double) va_arg(ap, double);
-    dp = (double) va_arg(ap, double);
-    expt = (double) va_arg(ap, double);
-    ice0 = (double) va_arg(ap, double);
-    kappa1 = (double) va_arg(ap, double);
-    kappa2 = (double) va_arg(ap, double);
-    max_moist = (double) va_arg(ap, double);
-    moist = (double) va_arg(ap, double);
-
-    root = (double  *) va_arg(ap, double  *);
-    CanopLayerBnd = (double *) va_arg(ap, double *);
+    Cs1 = c->Cs1;
+    Cs2 = c->Cs2;
+    D1 = c->D1;
+    D2 = c->D2;
+    T1_old = c->T1_old;
+    T2 = c->T2;
+    Ts_old = c->Ts_old;
+    Told_node = c->Told_node;
+    bubble = c->bubble;
+    dp = c->dp;
+    expt = c->expt;
+    ice0 = c->ice0;
+    kappa1 = c->kappa1;
+    kappa2 = c->kappa2;
+    max_moist = c->max_moist;
+    moist = c->moist;
+
+    root = c->root;
+    CanopLayerBnd = c->CanopLayerBnd;
 
     /* meteorological forcing terms */
-    UnderStory = (int) va_arg(ap, int);
-    overstory = (int) va_arg(ap, int);
-
-    NetShortBare = (double) va_arg(ap, double);
-    NetShortGrnd = (double) va_arg(ap, double);
-    NetShortSnow = (double) va_arg(ap, double);
-    Tair = (double) va_arg(ap, double);
-    atmos_density = (double) va_arg(ap, double);
-    atmos_pressure = (double) va_arg(ap, double);
-    emissivity = (double) va_arg(ap, double);
-    LongBareIn = (double) va_arg(ap, double);
-    LongSnowIn = (double) va_arg(ap, double);
-    surf_atten = (double) va_arg(ap, double);
-    vp = (double) va_arg(ap, double);
-    vpd = (double) va_arg(ap, double);
-    shortwave = (double) va_arg(ap, double);
-    Catm = (double) va_arg(ap, double);
-    dryFrac = (double *) va_arg(ap, double *);
-
-    Wdew = (double *) va_arg(ap, double *);
-    displacement = (double *) va_arg(ap, double *);
-    ra = (double *) va_arg(ap, double *);
-    Ra_veg = (double *) va_arg(ap, double *);
-    Ra_used = (double *) va_arg(ap, double *);
-    rainfall = (double) va_arg(ap, double);
-    ref_height = (double *) va_arg(ap, double *);
-    roughness = (double *) va_arg(ap, double *);
-    wind = (double *) va_arg(ap, double *);
+    UnderStory = c->UnderStory;
+    overstory = c->overstory;
+
+    NetShortBare = c->NetShortBare;
+    NetShortGrnd = c->NetShortGrnd;
+    NetShortSnow = c->NetShortSnow;
+    Tair = c->Tair;
+    atmos_density = c->atmos_density;
+    atmos_pressure = c->atmos_pressure;
+    emissivity = c->emissivity;
+    LongBareIn = c->LongBareIn;
+    LongSnowIn = c->LongSnowIn;
+    surf_atten = c->surf_atten;
+    vp = c->vp;
+    vpd = c->vpd;
+    shortwave = c->shortwave;
+    Catm = c->Catm;
+    dryFrac = c->dryFrac;
+
+    Wdew = c->Wdew;
+    displacement = c->displacement;
+    ra = c->ra;
+    Ra_veg = c->Ra_veg;
+    Ra_used = c->Ra_used;
+    rainfall = c->rainfall;
+    ref_height = c->ref_height;
+    roughness = c->roughness;
+    wind = c->wind;
 
     /* latent heat terms */
-    Le = (double) va_arg(ap, double);
+    Le = c->Le;
 
     /* snowpack terms */
-    Advection = (double) va_arg(ap, double);
-    OldTSurf = (double) va_arg(ap, double);
-    Tsnow_surf = (double) va_arg(ap, double);
-    kappa_snow = (double) va_arg(ap, double);
-    melt_energy = (double) va_arg(ap, double);
-    snow_coverage = (double) va_arg(ap, double);
-    snow_density = (double) va_arg(ap, double);
-    snow_swq = (double) va_arg(ap, double);
-    snow_water = (double) va_arg(ap, double);
-
-    deltaCC = (double *) va_arg(ap, double *);
-    refreeze_energy = (double *) va_arg(ap, double *);
-    vapor_flux = (double *) va_arg(ap, double *);
-    blowing_flux = (double *) va_arg(ap, double *);
-    surface_flux = (double *) va_arg(ap, double *);
+    Advection = c->Advection;
+    OldTSurf = c->OldTSurf;
+    Tsnow_surf = c->Tsnow_surf;
+    kappa_snow = c->kappa_snow;
+    melt_energy = c->melt_energy;
+    snow_coverage = c->snow_coverage;
+    snow_density = c->snow_density;
+    snow_swq = c->snow_swq;
+    snow_water = c->snow_water;
+
+    deltaCC = c->deltaCC;
+    refreeze_energy = c->refreeze_energy;
+    vapor_flux = c->vapor_flux;
+    blowing_flux = c->blowing_flux;
+    surface_flux = c->surface_flux;
 
     /* soil node terms */
-    Nnodes = (int) va_arg(ap, int);
-
-    Cs_node = (double *) va_arg(ap, double *);
-    T_node = (double *) va_arg(ap, double *);
-    Tnew_node = (double *) va_arg(ap, double *);
-    Tnew_fbflag = (char *) va_arg(ap, char *);
-    Tnew_fbcount = (unsigned *) va_arg(ap, unsigned *);
-    alpha = (double *) va_arg(ap, double *);
-    beta = (double *) va_arg(ap, double *);
-    bubble_node = (double *) va_arg(ap, double *);
-    Zsum_node = (double *) va_arg(ap, double *);
-    expt_node = (double *) va_arg(ap, double *);
-    gamma = (double *) va_arg(ap, double *);
-    ice_node = (double *) va_arg(ap, double *);
-    kappa_node = (double *) va_arg(ap, double *);
-    max_moist_node = (double *) va_arg(ap, double *);
-    moist_node = (double *) va_arg(ap, double *);
+    Nnodes = c->Nnodes;
+
+    Cs_node = c->Cs_node;
+    T_node = c->T_node;
+    Tnew_node = c->Tnew_node;
+    Tnew_fbflag = c->Tnew_fbflag;
+    Tnew_fbcount = c->Tnew_fbcount;
+    alpha = c->alpha;
+    beta = c->beta;
+    bubble_node = c->bubble_node;
+    Zsum_node = c->Zsum_node;
+    expt_node = c->expt_node;
+    gamma = c->gamma;
+    ice_node = c->ice_node;
+    kappa_node = c->kappa_node;
+    max_moist_node = c->max_moist_node;
+    moist_node = c->moist_node;
 
     /* model structures */
-    soil_con = (soil_con_struct *) va_arg(ap, soil_con_struct *);
-    layer = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-    veg_var = (veg_var_struct *) va_arg(ap, veg_var_struct *);
+    soil_con = c->soil_con;
+    layer = c->layer;
+    veg_var = c->veg_var;
 
     /* control flags */
-    INCLUDE_SNOW = (int) va_arg(ap, int);
-    NOFLUX = (int) va_arg(ap, int);
-    EXP_TRANS = (int) va_arg(ap, int);
-    SNOWING = (int) va_arg(ap, int);
+    INCLUDE_SNOW = c->INCLUDE_SNOW;
+    NOFLUX = c->NOFLUX;
+    EXP_TRANS = c->EXP_TRANS;
+    SNOWING = c->SNOWING;
 
-    FIRST_SOLN = (int *) va_arg(ap, int *);
+    FIRST_SOLN = c->FIRST_SOLN;
 
     /* returned energy balance terms */
-    NetLongBare = (double *) va_arg(ap, double *);
-    NetLongSnow = (double *) va_arg(ap, double *);
-    T1 = (double *) va_arg(ap, double *);
-    deltaH = (double *) va_arg(ap, double *);
-    fusion = (double *) va_arg(ap, double *);
-    grnd_flux = (double *) va_arg(ap, double *);
-    latent_heat = (double *) va_arg(ap, double *);
-    latent_heat_sub = (double *) va_arg(ap, double *);
-    sensible_heat = (double *) va_arg(ap, double *);
-    snow_flux = (double *) va_arg(ap, double *);
-    store_error = (double *) va_arg(ap, double *);
+    NetLongBare = c->NetLongBare;
+    NetLongSnow = c->NetLongSnow;
+    T1 = c->T1;
+    deltaH = c->deltaH;
+    fusion = c->fusion;
+    grnd_flux = c->grnd_flux;
+    latent_heat = c->latent_heat;
+    latent_heat_sub = c->latent_heat_sub;
+    sensible_heat = c->sensible_heat;
+    snow_flux = c->snow_flux;
+    store_error = c->store_error;
 
     /* take additional variables from soil_con structure */
     b_infilt = soil_con->b_infilt;
@@ -366,8 +369,8 @@ func_surf_energy_bal(double  Ts,
 
     TMean = Ts;
 
-    transp = calloc(options.Nlayer, sizeof(*transp));
-    check_alloc_status(transp, "Memory allocation error.");
+    mark = scratch_mark();
+    transp = scratch_calloc(options.Nlayer, sizeof(*transp));
     for (i = 0; i < options.Nlayer; i++) {
         transp[i] = 0.;
     }
@@ -451,6 +454,9 @@ func_surf_energy_bal(double  Ts,
             if (FIRST_SOLN[1]) {
                 FIRST_SOLN[1] = false;
             }
+            if (Error == 1) {
+                get_solver_stats(SOLVER_HEAT_EQN_IMPLICIT)->fallbacks++;
+            }
         }
 
         /* EXPLICIT Solution, or if IMPLICIT Solution Failed */
@@ -808,7 +814,7 @@ func_surf_energy_bal(double  Ts,
         Evap = 0.;
     }
 
-    free(transp);
+    scratch_release(mark);
 
     /**********************************************************************
        Compute the Latent Heat Flux from the Surface and Covering Vegetation
@@ -62,47 +62,48 @@ ice_melt(double            z2,
          double           *save_refreeze_energy,
          double           *save_LWnet)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
-
-    double                   DeltaPackCC; /* Change in cold content of the pack */
-    double                   DeltaPackSwq; /* Change in snow water equivalent of the pack (m) */
-    double                   InitialSwq; /* Initial snow water equivalent (m) */
-    double                   InitialIce;
-    double                   MassBalanceError; /* Mass balance error (m) */
-    double                   MaxLiquidWater; /* Maximum liquid water content of pack (m) */
-    double                   OldTSurf; /* Old snow surface temperature (C) */
-    double                   Qnet; /* Net energy exchange at the surface (W/m2) */
-    double                   PackRefreezeEnergy; /* refreeze/melt energy in pack layer (W/m2) */
-    double                   RefreezeEnergy; /* refreeze energy (W/m2) */
-    double                   RefrozenWater; /* Amount of refrozen water (m) */
-    double                   SnowFallCC; /* Cold content of new snowfall (J) */
-    double                   SurfaceCC;
-    double                   PackCC;
-    double                   SurfaceSwq;
-    double                   PackSwq;
-    double                   PackIce;
-    double                   SnowMelt; /* Amount of snow melt during time interval (m water equivalent) */
-    double                   IceMelt;
-    double                   LWnet;
-    double                   avgcond;
-    double                   SWconducted;
-    double                   SnowIce;
-    double                   LakeIce;
-    double                   Ice;
-    double                   SnowFall;
-    double                   RainFall;
-    double                   vapor_flux;
-    double                   blowing_flux;
-    double                   surface_flux;
-    double                   advection;
-    double                   deltaCC;
-    double                   SnowFlux; /* thermal flux through snowpack from ground */
-    double                   latent_heat;
-    double                   latent_heat_sub;
-    double                   sensible_heat;
-    double                   Ls;
-    double                   melt_energy = 0.;
+    extern option_struct      options;
+    extern parameters_struct  param;
+
+    double                    DeltaPackCC; /* Change in cold content of the pack */
+    double                    DeltaPackSwq; /* Change in snow water equivalent of the pack (m) */
+    double                    InitialSwq; /* Initial snow water equivalent (m) */
+    double                    InitialIce;
+    double                    MassBalanceError; /* Mass balance error (m) */
+    double                    MaxLiquidWater; /* Maximum liquid water content of pack (m) */
+    double                    OldTSurf; /* Old snow surface temperature (C) */
+    double                    Qnet; /* Net energy exchange at the surface (W/m2) */
+    double                    PackRefreezeEnergy; /* refreeze/melt energy in pack layer (W/m2) */
+    double                    RefreezeEnergy; /* refreeze energy (W/m2) */
+    double                    RefrozenWater; /* Amount of refrozen water (m) */
+    double                    SnowFallCC; /* Cold content of new snowfall (J) */
+    double                    SurfaceCC;
+    double                    PackCC;
+    double                    SurfaceSwq;
+    double                    PackSwq;
+    double                    PackIce;
+    double                    SnowMelt; /* Amount of snow melt during time interval (m water equivalent) */
+    double                    IceMelt;
+    double                    LWnet;
+    double                    avgcond;
+    double                    SWconducted;
+    double                    SnowIce;
+    double                    LakeIce;
+    double                    Ice;
+    double                    SnowFall;
+    double                    RainFall;
+    double                    vapor_flux;
+    double                    blowing_flux;
+    double                    surface_flux;
+    double                    advection;
+    double                    deltaCC;
+    double                    SnowFlux; /* thermal flux through snowpack from ground */
+    double                    latent_heat;
+    double                    latent_heat_sub;
+    double                    sensible_heat;
+    double                    Ls;
+    double                    melt_energy = 0.;
+    ice_energy_bal_ctx_struct ctx;
 
     SnowFall = snowfall / MM_PER_M; /* convert to m */
     RainFall = rainfall / MM_PER_M; /* convert to m */
@@ -223,16 +224,37 @@ ice_melt(double            z2,
 
     /* Calculate the surface energy balance for snow_temp = 0.0 */
 
-    Qnet = CalcIcePackEnergyBalance((double) 0.0, delta_t, aero_resist,
-                                    aero_resist_used, z2, Z0, wind, net_short,
-                                    longwave, density, Le, air_temp,
-                                    pressure * PA_PER_KPA, vpd * PA_PER_KPA,
-                                    vp * PA_PER_KPA,
-                                    RainFall, snow->surf_water, &RefreezeEnergy,
-                                    &vapor_flux, &blowing_flux, &surface_flux,
-                                    &advection, Tcutoff, avgcond, SWconducted,
-                                    &SnowFlux, &latent_heat, &latent_heat_sub,
-                                    &sensible_heat, &LWnet);
+    ctx.Dt = delta_t;
+    ctx.Ra = aero_resist;
+    ctx.Ra_used = aero_resist_used;
+    ctx.Z = z2;
+    ctx.Z0 = Z0;
+    ctx.Wind = wind;
+    ctx.ShortRad = net_short;
+    ctx.LongRadIn = longwave;
+    ctx.AirDens = density;
+    ctx.Lv = Le;
+    ctx.Tair = air_temp;
+    ctx.Press = pressure * PA_PER_KPA;
+    ctx.Vpd = vpd * PA_PER_KPA;
+    ctx.EactAir = vp * PA_PER_KPA;
+    ctx.Rain = RainFall;
+    ctx.SurfaceLiquidWater = snow->surf_water;
+    ctx.RefreezeEnergy = &RefreezeEnergy;
+    ctx.vapor_flux = &vapor_flux;
+    ctx.blowing_flux = &blowing_flux;
+    ctx.surface_flux = &surface_flux;
+    ctx.AdvectedEnergy = &advection;
+    ctx.Tfreeze = Tcutoff;
+    ctx.AvgCond = avgcond;
+    ctx.SWconducted = SWconducted;
+    ctx.qf = &SnowFlux;
+    ctx.LatentHeat = &latent_heat;
+    ctx.LatentHeatSub = &latent_heat_sub;
+    ctx.SensibleHeat = &sensible_heat;
+    ctx.LongRadOut = &LWnet;
+
+    Qnet = IceEnergyBalance((double) 0.0, &ctx);
 
     snow->vapor_flux = vapor_flux;
     snow->surface_flux = surface_flux;
@@ -349,18 +371,7 @@ ice_melt(double            z2,
             snow->surf_temp =
                 root_brent((double) (snow->surf_temp - param.SNOW_DT),
                            (double) (snow->surf_temp + param.SNOW_DT),
-                           IceEnergyBalance, delta_t,
-                           aero_resist, aero_resist_used, z2, Z0,
-                           wind, net_short, longwave, density,
-                           Le, air_temp, pressure * PA_PER_KPA,
-                           vpd * PA_PER_KPA, vp * PA_PER_KPA,
-                           RainFall,
-                           snow->surf_water, &RefreezeEnergy,
-                           &vapor_flux, &blowing_flux,
-                           &surface_flux, &advection, Tcutoff,
-                           avgcond, SWconducted, &SnowFlux,
-                           &latent_heat, &latent_heat_sub,
-                           &sensible_heat, &LWnet);
+                           IceEnergyBalance, &ctx, SOLVER_ICE_ENERGY_BAL);
 
             if (snow->surf_temp <= -998) {
                 if (options.TFALLBACK) {
@@ -369,26 +380,13 @@ ice_melt(double            z2,
                     snow->surf_temp_fbcount++;
                 }
                 else {
-                    ErrorIcePackEnergyBalance(snow->surf_temp, delta_t,
-                                              aero_resist,
-                                              aero_resist_used, z2,
-                                              displacement, Z0, wind, net_short,
-                                              longwave, density, Le, air_temp,
-                                              pressure * PA_PER_KPA,
-                                              vpd * PA_PER_KPA,
-                                              vp * PA_PER_KPA,
-                                              RainFall, SurfaceSwq,
-                                              snow->surf_water, OldTSurf,
-                                              &RefreezeEnergy,
-                                              &vapor_flux, &blowing_flux,
-                                              &surface_flux,
-                                              &advection, deltaCC, Tcutoff,
-                                              avgcond, SWconducted,
-                                              snow->swq * CONST_RHOFW / param.LAKE_RHOSNOW,
-                                              param.LAKE_RHOSNOW, surf_atten,
-                                              &SnowFlux, &latent_heat,
-                                              &latent_heat_sub,
-                                              &sensible_heat, &LWnet);
+                    ErrorPrintIcePackEnergyBalance(snow->surf_temp, &ctx,
+                                                   displacement, SurfaceSwq,
+                                                   OldTSurf, deltaCC,
+                                                   snow->swq * CONST_RHOFW /
+                                                   param.LAKE_RHOSNOW,
+                                                   param.LAKE_RHOSNOW,
+                                                   surf_atten);
                     return(ERROR);
                 }
             }
@@ -397,19 +395,7 @@ ice_melt(double            z2,
             snow->surf_temp = 999;
         }
         if (snow->surf_temp > -998 && snow->surf_temp < 999) {
-            Qnet = CalcIcePackEnergyBalance(snow->surf_temp, delta_t,
-                                            aero_resist, aero_resist_used, z2,
-                                            Z0, wind, net_short, longwave,
-                                            density, Le, air_temp,
-                                            pressure * PA_PER_KPA,
-                                            vpd * PA_PER_KPA,
-                                            vp * PA_PER_KPA, RainFall,
-                                            snow->surf_water, &RefreezeEnergy,
-                                            &vapor_flux, &blowing_flux,
-                                            &surface_flux, &advection, Tcutoff,
-                                            avgcond, SWconducted, &SnowFlux,
-                                            &latent_heat, &latent_heat_sub,
-                                            &sensible_heat, &LWnet);
+            Qnet = IceEnergyBalance(snow->surf_temp, &ctx);
 
             snow->vapor_flux = vapor_flux;
             snow->surface_flux = surface_flux;
@@ -609,58 +595,24 @@ ice_melt(double            z2,
     return (0);
 }
 
-/******************************************************************************
- * @brief    Dummy function to make a direct call to IceEnergyBalance()
- *           possible.
- *****************************************************************************/
-double
-CalcIcePackEnergyBalance(double Tsurf,
-                         ...)
-{
-    va_list ap;                 /* Used in traversing variable argument list
-                                 */
-    double  Qnet;                /* Net energy exchange at the IcePack snow
-                                    surface (W/m^2) */
-
-    va_start(ap, Tsurf);
-    Qnet = IceEnergyBalance(Tsurf, ap);
-    va_end(ap);
-
-    return Qnet;
-}
-
-/******************************************************************************
- * @brief    Dummy function to make a direct call to
- *           ErrorPrintIcePackEnergyBalance() possible.
- *****************************************************************************/
-double
-ErrorIcePackEnergyBalance(double Tsurf,
-                          ...)
-{
-    va_list ap;                 /* Used in traversing variable argument list
-                                 */
-    double  Qnet;                /* Net energy exchange at the IcePack snow
-                                    surface (W/m^2) */
-
-    va_start(ap, Tsurf);
-    Qnet = ErrorPrintIcePackEnergyBalance(Tsurf, ap);
-    va_end(ap);
-
-    return Qnet;
-}
-
 /******************************************************************************
  * @brief    Print ice pack energy balance terms
  *****************************************************************************/
 double
-ErrorPrintIcePackEnergyBalance(double  TSurf,
-                               va_list ap)
+ErrorPrintIcePackEnergyBalance(double                     TSurf,
+                               ice_energy_bal_ctx_struct *ctx,
+                               double                     Displacement,
+                               double                     SweSurfaceLayer,
+                               double                     OldTSurf,
+                               double                     DeltaColdContent,
+                               double                     SnowDepth,
+                               double                     SnowDensity,
+                               double                     SurfAttenuation)
 {
     double  Dt;                  /* Model time step (seconds) */
     double  Ra;                  /* Aerodynamic resistance (s/m) */
     double *Ra_used;             /* Aerodynamic resistance (s/m) after stability correction */
     double  Z;                   /* Reference height (m) */
-    double  Displacement;        /* Displacement height (m) */
     double  Z0;                  /* surface roughness height (m) */
     double  Wind;                /* Wind speed (m/s) */
     double  ShortRad;            /* Net incident shortwave radiation (W/m2) */
@@ -672,11 +624,7 @@ ErrorPrintIcePackEnergyBalance(double  TSurf,
     double  Vpd;                /* Vapor pressure deficit (Pa) */
     double  EactAir;             /* Actual vapor pressure of air (Pa) */
     double  Rain;                /* Rain fall (m/timestep) */
-    double  SweSurfaceLayer;     /* Snow water equivalent in surface layer (m)
-                                  */
     double  SurfaceLiquidWater;  /* Liquid water in the surface layer (m) */
-    double  OldTSurf;            /* Surface temperature during previous time
-                                    step */
     double *RefreezeEnergy;      /* Refreeze energy (W/m2) */
     double *vapor_flux;          /* Total mass flux of water vapor to or from
                                     snow (m/timestep) */
@@ -685,58 +633,45 @@ ErrorPrintIcePackEnergyBalance(double  TSurf,
     double *surface_flux;        /* Mass flux of water vapor to or from
                                     snow pack (m/timestep) */
     double *AdvectedEnergy;      /* Energy advected by precipitation (W/m2) */
-    double  DeltaColdContent;    /* Change in cold content (W/m2) */
     double  Tfreeze;
     double  AvgCond;
     double  SWconducted;
-    double  SnowDepth;
-    double  SnowDensity;
-    double  SurfAttenuation;
-
-    /* end of list of arguments in variable argument list */
     double *GroundFlux;
     double *LatentHeat;         /* Latent heat exchange at surface (W/m2) */
     double *LatentHeatSub;      /* Latent heat exchange at surface (W/m2) due to sublimation */
     double *SensibleHeat;       /* Sensible heat exchange at surface (W/m2) */
     double *LWnet;
 
-    /* initialize variables */
-    Dt = (double) va_arg(ap, double);
-    Ra = (double) va_arg(ap, double);
-    Ra_used = (double *) va_arg(ap, double *);
-    Z = (double) va_arg(ap, double);
-    Displacement = (double) va_arg(ap, double);
-    Z0 = (double) va_arg(ap, double);
-    Wind = (double) va_arg(ap, double);
-    ShortRad = (double) va_arg(ap, double);
-    LongRadIn = (double) va_arg(ap, double);
-    AirDens = (double) va_arg(ap, double);
-    Lv = (double) va_arg(ap, double);
-    Tair = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    Rain = (double) va_arg(ap, double);
-    SweSurfaceLayer = (double) va_arg(ap, double);
-    SurfaceLiquidWater = (double) va_arg(ap, double);
-    OldTSurf = (double) va_arg(ap, double);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    vapor_flux = (double *) va_arg(ap, double *);
-    blowing_flux = (double *) va_arg(ap, double *);
-    surface_flux = (double *) va_arg(ap, double *);
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    DeltaColdContent = (double) va_arg(ap, double);
-    Tfreeze = (double) va_arg(ap, double);
-    AvgCond = (double) va_arg(ap, double);
-    SWconducted = (double) va_arg(ap, double);
-    SnowDepth = (double) va_arg(ap, double);
-    SnowDensity = (double) va_arg(ap, double);
-    SurfAttenuation = (double) va_arg(ap, double);
-    GroundFlux = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    LWnet = (double *) va_arg(ap, double *);
+    /* read variables from the solver context */
+    Dt = ctx->Dt;
+    Ra = ctx->Ra;
+    Ra_used = ctx->Ra_used;
+    Z = ctx->Z;
+    Z0 = ctx->Z0;
+    Wind = ctx->Wind;
+    ShortRad = ctx->ShortRad;
+    LongRadIn = ctx->LongRadIn;
+    AirDens = ctx->AirDens;
+    Lv = ctx->Lv;
+    Tair = ctx->Tair;
+    Press = ctx->Press;
+    Vpd = ctx->Vpd;
+    EactAir = ctx->EactAir;
+    Rain = ctx->Rain;
+    SurfaceLiquidWater = ctx->SurfaceLiquidWater;
+    RefreezeEnergy = ctx->RefreezeEnergy;
+    vapor_flux = ctx->vapor_flux;
+    blowing_flux = ctx->blowing_flux;
+    surface_flux = ctx->surface_flux;
+    AdvectedEnergy = ctx->AdvectedEnergy;
+    Tfreeze = ctx->Tfreeze;
+    AvgCond = ctx->AvgCond;
+    SWconducted = ctx->SWconducted;
+    GroundFlux = ctx->qf;
+    LatentHeat = ctx->LatentHeat;
+    LatentHeatSub = ctx->LatentHeatSub;
+    SensibleHeat = ctx->SensibleHeat;
+    LWnet = ctx->LongRadOut;
 
     /* print variables */
     log_warn("ice_melt failed to converge to a solution in root_brent.  "
@@ -26,14 +26,67 @@
 
 #include <vic_run.h>
 
+/******************************************************************************
+ * @brief    Number of leading elements of a decreasing array of n elements
+ *           that are larger than x, or larger than or equal to x if
+ *           inclusive is true.
+ *****************************************************************************/
+static size_t
+count_lake_nodes_above(double *ar,
+                       size_t  n,
+                       double  x,
+                       bool    inclusive)
+{
+    size_t lo;
+    size_t hi;
+    size_t mid;
+
+    lo = 0;
+    hi = n;
+    while (lo < hi) {
+        mid = (lo + hi) / 2;
+        if (ar[mid] > x || (inclusive && ar[mid] == x)) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    return lo;
+}
+
+/******************************************************************************
+ * @brief    Function to compute the liquid water volume stored below each
+ *           lake node, from the depth-area profile of the lake basin.
+ *
+ * @details  Must be called whenever lake_con->z or lake_con->basin change,
+ *           before any of the other routines of this file.  The volumes are
+ *           summed from the bottom of the lake up, in the same order as the
+ *           volume of the lake was summed without the table.
+ *****************************************************************************/
+void
+compute_lake_basin_volume(lake_con_struct *lake_con)
+{
+    int i;
+
+    lake_con->basin_volume[lake_con->numnod] = 0.0;
+    for (i = lake_con->numnod - 1; i >= 0; i--) {
+        lake_con->basin_volume[i] = lake_con->basin_volume[i + 1] +
+                                    (lake_con->basin[i] +
+                                     lake_con->basin[i + 1]) *
+                                    (lake_con->z[i] - lake_con->z[i + 1]) / 2.;
+    }
+}
+
 /******************************************************************************
  * @brief    Function to compute surface area of liquid water in the lake,
  *           given the current depth of liquid water.
  *****************************************************************************/
 int
-get_sarea(lake_con_struct lake_con,
-          double          depth,
-          double         *sarea)
+get_sarea(lake_con_struct *lake_con,
+          double           depth,
+          double          *sarea)
 {
     size_t i;
     int    status;
@@ -41,22 +94,19 @@ get_sarea(lake_con_struct lake_con,
     status = 0;
     *sarea = 0.0;
 
-    if (depth > lake_con.z[0]) {
-        *sarea = lake_con.basin[0];
+    if (depth > lake_con->z[0]) {
+        *sarea = lake_con->basin[0];
     }
     else {
-        for (i = 0; i < lake_con.numnod; i++) {
-            if (depth <= lake_con.z[i] && depth > lake_con.z[i + 1]) {
-                *sarea =
-                    lake_con.basin[i +
-                                   1] +
-                    (depth -
-                     lake_con.z[i +
-                                1]) *
-                    (lake_con.basin[i] -
-                     lake_con.basin[i +
-                                    1]) / (lake_con.z[i] - lake_con.z[i + 1]);
-            }
+        // segment between nodes i and i + 1, with z[i + 1] < depth <= z[i]
+        i = count_lake_nodes_above(lake_con->z, lake_con->numnod + 1, depth,
+                                   true);
+        if (i > 0 && i <= lake_con->numnod) {
+            i--;
+            *sarea = lake_con->basin[i + 1] +
+                     (depth - lake_con->z[i + 1]) *
+                     (lake_con->basin[i] - lake_con->basin[i + 1]) /
+                     (lake_con->z[i] - lake_con->z[i + 1]);
         }
         if (*sarea == 0.0 && depth != 0.0) {
             status = ERROR;
@@ -71,39 +121,37 @@ get_sarea(lake_con_struct lake_con,
  *           basin, given the current depth of liquid water.
  *****************************************************************************/
 int
-get_volume(lake_con_struct lake_con,
-           double          depth,
-           double         *volume)
+get_volume(lake_con_struct *lake_con,
+           double           depth,
+           double          *volume)
 {
-    int    i;
+    size_t i;
     int    status;
     double m;
 
     status = 0;
     *volume = 0.0;
 
-    if (depth > lake_con.z[0]) {
+    if (depth > lake_con->z[0]) {
         status = 1;
-        *volume = lake_con.maxvolume;
+        *volume = lake_con->maxvolume;
+        return status;
     }
 
-    for (i = lake_con.numnod - 1; i >= 0; i--) {
-        if (depth >= lake_con.z[i]) {
-            *volume +=
-                (lake_con.basin[i] +
-                 lake_con.basin[i +
-                                1]) * (lake_con.z[i] - lake_con.z[i + 1]) / 2.;
-        }
-        else if (depth < lake_con.z[i] && depth >= lake_con.z[i + 1]) {
-            m =
-                (lake_con.basin[i] -
-                 lake_con.basin[i + 1]) / (lake_con.z[i] - lake_con.z[i + 1]);
-            *volume +=
-                (depth -
-                 lake_con.z[i +
-                            1]) *
-                (m * (depth - lake_con.z[i + 1]) / 2. + lake_con.basin[i + 1]);
-        }
+    // segment between nodes i and i + 1, with z[i + 1] <= depth < z[i]
+    i = count_lake_nodes_above(lake_con->z, lake_con->numnod + 1, depth,
+                               false);
+    if (i == 0) {
+        *volume = lake_con->basin_volume[0];
+    }
+    else if (i <= lake_con->numnod) {
+        i--;
+        m = (lake_con->basin[i] - lake_con->basin[i + 1]) /
+            (lake_con->z[i] - lake_con->z[i + 1]);
+        *volume = lake_con->basin_volume[i + 1] +
+                  (depth - lake_con->z[i + 1]) *
+                  (m * (depth - lake_con->z[i + 1]) / 2. +
+                   lake_con->basin[i + 1]);
     }
 
     if (*volume == 0.0 && depth != 0.0) {
@@ -117,15 +165,23 @@ get_volume(lake_con_struct lake_con,
  * @brief    Function to compute the depth of liquid water in the lake
  *           (distance between surface and deepest point), given volume of
  *           liquid water currently stored in lake.
+ *
+ * @details  The segment of the basin that contains the lake surface is found
+ *           in the table of volumes below the lake nodes.  Within it, the
+ *           area varies linearly with depth, A = b + m * h, so the volume
+ *           above its lower node is V = b * h + m * h^2 / 2, which is solved
+ *           for h in the form h = 2 V / (b + sqrt(b^2 + 2 m V)) that does not
+ *           lose precision when m * V is small compared to b^2 or when m = 0.
  *****************************************************************************/
 int
-get_depth(lake_con_struct lake_con,
-          double          volume,
-          double         *depth)
+get_depth(lake_con_struct *lake_con,
+          double           volume,
+          double          *depth)
 {
-    int    k;
+    size_t i;
     int    status;
     double m;
+    double b;
     double tempvolume;
 
     status = 0;
@@ -135,54 +191,32 @@ get_depth(lake_con_struct lake_con,
         status = 1;
     }
 
-    if (volume >= lake_con.maxvolume) {
-        *depth = lake_con.maxdepth;
-        *depth += (volume - lake_con.maxvolume) / lake_con.basin[0];
+    if (volume >= lake_con->maxvolume) {
+        *depth = lake_con->maxdepth;
+        *depth += (volume - lake_con->maxvolume) / lake_con->basin[0];
     }
     else if (volume < DBL_EPSILON) {
         *depth = 0.0;
     }
     else {
-        // Update lake depth
-        *depth = 0.0;
-        tempvolume = volume;
-        for (k = lake_con.numnod - 1; k >= 0; k--) {
-            if (tempvolume > ((lake_con.z[k] - lake_con.z[k + 1]) *
-                              (lake_con.basin[k] +
-                               lake_con.basin[k + 1]) / 2.)) {
-                // current layer completely filled
-                tempvolume -=
-                    (lake_con.z[k] -
-                     lake_con.z[k +
-                                1]) *
-                    (lake_con.basin[k] + lake_con.basin[k + 1]) / 2.;
-                *depth += lake_con.z[k] - lake_con.z[k + 1];
-            }
-            else if (tempvolume > 0.0) {
-                if (lake_con.basin[k] == lake_con.basin[k + 1]) {
-                    *depth += tempvolume / lake_con.basin[k + 1];
-                    tempvolume = 0.0;
-                }
-                else {
-                    m =
-                        (lake_con.basin[k] -
-                         lake_con.basin[k +
-                                        1]) /
-                        (lake_con.z[k] - lake_con.z[k + 1]);
-                    *depth +=
-                        ((-1 *
-                          lake_con.basin[k +
-                                         1]) +
-                         sqrt(lake_con.basin[k +
-                                             1] *
-                              lake_con.basin[k + 1] + 2. * m * tempvolume)) / m;
-                    tempvolume = 0.0;
-                }
-            }
-        }
-        if (tempvolume / lake_con.basin[0] > DBL_EPSILON) {
+        if ((volume - lake_con->basin_volume[0]) / lake_con->basin[0] >
+            DBL_EPSILON) {
             status = ERROR;
         }
+
+        // segment between nodes i and i + 1, with the volume below node
+        // i + 1 < volume <= the volume below node i
+        i = count_lake_nodes_above(lake_con->basin_volume,
+                                   lake_con->numnod + 1, volume, true);
+        if (i > 0) {
+            i--;
+        }
+        tempvolume = volume - lake_con->basin_volume[i + 1];
+        b = lake_con->basin[i + 1];
+        m = (lake_con->basin[i] - lake_con->basin[i + 1]) /
+            (lake_con->z[i] - lake_con->z[i + 1]);
+        *depth = lake_con->z[i + 1] +
+                 2. * tempvolume / (b + sqrt(b * b + 2. * m * tempvolume));
     }
 
     if (*depth < 0.0 || (*depth == 0.0 && volume >= DBL_EPSILON)) {
@@ -41,10 +41,10 @@ solve_lake(double           snowfall,
            double           pressure,
            double           air_density,
            lake_var_struct *lake,
-           soil_con_struct  soil_con,
+           soil_con_struct *soil_con,
            double           dt,
            double           wind_h,
-           dmy_struct       dmy,
+           dmy_struct      *dmy,
            double           fracprv)
 {
     extern parameters_struct param;
@@ -186,8 +186,8 @@ solve_lake(double           snowfall,
 
         alblake(Tcutoff, tair, &lake->SAlbedo, &tempalbs, &albi, &albw,
                 snowfall, lake_snow->coldcontent, dt, &lake_snow->last_snow,
-                lake_snow->swq, &lake_snow->MELTING, dmy.day_in_year,
-                soil_con.lat);
+                lake_snow->swq, &lake_snow->MELTING, dmy->day_in_year,
+                soil_con->lat);
 
         /* --------------------------------------------------------------------
          * Calculate the incoming solar radiaton for both the ice fraction
@@ -234,7 +234,7 @@ solve_lake(double           snowfall,
                                              &lake->evapw,
                                              dt, lake->dz,
                                              lake->surfdz,
-                                             soil_con.lat, Tcutoff,
+                                             soil_con->lat, Tcutoff,
                                              tair, windw,
                                              pressure, vp, air_density, longin,
                                              sw_water, wind_h, &Qhw, &Qew,
@@ -290,8 +290,9 @@ solve_lake(double           snowfall,
         *  6. Calculate initial energy balance over ice.
         **********************************************************************/
 
-        windi = (wind * log((2. + soil_con.snow_rough) / soil_con.snow_rough) /
-                 log(wind_h / soil_con.snow_rough));
+        windi = (wind *
+                 log((2. + soil_con->snow_rough) / soil_con->snow_rough) /
+                 log(wind_h / soil_con->snow_rough));
         if (windi < 1.0) {
             windi = 1.0;
         }
@@ -301,17 +302,17 @@ solve_lake(double           snowfall,
             Le = calc_latent_heat_of_sublimation(tair); /* ice*/
 
             lake->aero_resist =
-                (log((2. + soil_con.snow_rough) / soil_con.snow_rough) *
+                (log((2. + soil_con->snow_rough) / soil_con->snow_rough) *
                  log(wind_h /
-                     soil_con.snow_rough) /
+                     soil_con->snow_rough) /
                  (CONST_KARMAN * CONST_KARMAN)) / windi;
 
             /* Calculate snow/ice temperature and change in ice thickness from
                surface melting. */
-            ErrorFlag = ice_melt(wind_h + soil_con.snow_rough,
+            ErrorFlag = ice_melt(wind_h + soil_con->snow_rough,
                                  lake->aero_resist, &(lake->aero_resist),
                                  Le, lake_snow, lake, dt, 0.0,
-                                 soil_con.snow_rough, 1.0,
+                                 soil_con->snow_rough, 1.0,
                                  rainfall, snowfall, windi, Tcutoff, tair,
                                  sw_ice,
                                  longin, air_density, pressure, vpd, vp,
@@ -337,7 +338,7 @@ solve_lake(double           snowfall,
             if (lake->activenod > 0) {
                 ErrorFlag = water_under_ice(freezeflag, sw_ice, wind, Ti,
                                             water_density,
-                                            soil_con.lat,
+                                            soil_con->lat,
                                             lake->activenod, lake->dz,
                                             lake->surfdz,
                                             Tcutoff, &qw, lake->surface,
@@ -1807,14 +1808,14 @@ energycalc(double *finaltemp,
  *****************************************************************************/
 int
 water_balance(lake_var_struct *lake,
-              lake_con_struct  lake_con,
+              lake_con_struct *lake_con,
               double           dt,
               all_vars_struct *all_vars,
               int              iveg,
               int              band,
               double           lakefrac,
-              soil_con_struct  soil_con,
-              veg_con_struct   veg_con)
+              soil_con_struct *soil_con,
+              veg_con_struct  *veg_con)
 {
     extern option_struct       options;
     extern parameters_struct   param;
@@ -1843,6 +1844,7 @@ water_balance(lake_var_struct *lake,
     double                     volume_save;
     double                    *delta_moist = NULL;
     double                    *moist = NULL;
+    size_t                     mark;
     double                     max_newfraction;
 
     cell = all_vars->cell;
@@ -1850,12 +1852,11 @@ water_balance(lake_var_struct *lake,
     snow = all_vars->snow;
     energy = all_vars->energy;
 
-    frost_fract = soil_con.frost_fract;
+    frost_fract = soil_con->frost_fract;
 
-    delta_moist = calloc(options.Nlayer, sizeof(*delta_moist));
-    check_alloc_status(delta_moist, "Memory allocation error.");
-    moist = calloc(options.Nlayer, sizeof(*moist));
-    check_alloc_status(moist, "Memory allocation error.");
+    mark = scratch_mark();
+    delta_moist = scratch_calloc(options.Nlayer, sizeof(*delta_moist));
+    moist = scratch_calloc(options.Nlayer, sizeof(*moist));
 
     /**********************************************************************
     * 1. Preliminary stuff
@@ -1909,7 +1910,7 @@ water_balance(lake_var_struct *lake,
     if (lake->new_ice_area > surfacearea) {
         surfacearea = lake->new_ice_area;
     }
-    newfraction = surfacearea / lake_con.basin[0];
+    newfraction = surfacearea / lake_con->basin[0];
 
     // Save this estimate of the new lake fraction for use later
     max_newfraction = newfraction;
@@ -1951,13 +1952,13 @@ water_balance(lake_var_struct *lake,
         // Lake must fill soil to saturation in the newly-flooded area
         for (j = 0; j < options.Nlayer; j++) {
             delta_moist[j] +=
-                (soil_con.max_moist[j] -
+                (soil_con->max_moist[j] -
                  cell[iveg][band].layer[j].moist) *
                 (max_newfraction - lakefrac) / (1 - lakefrac);                                                           // mm over (1-lakefrac)
         }
         for (j = 0; j < options.Nlayer; j++) {
             lake->recharge += (delta_moist[j]) / MM_PER_M *
-                              (1 - lakefrac) * lake_con.basin[0];                    // m^3
+                              (1 - lakefrac) * lake_con->basin[0];                    // m^3
         }
 
         // Above-ground storage in newly-flooded area is liberated and goes to lake
@@ -1965,7 +1966,7 @@ water_balance(lake_var_struct *lake,
             (veg_var[iveg][band].Wdew / MM_PER_M +
              snow[iveg][band].snow_canopy +
              snow[iveg][band].swq) *
-            (max_newfraction - lakefrac) * lake_con.basin[0];
+            (max_newfraction - lakefrac) * lake_con->basin[0];
         lake->recharge -= abovegrnd_storage;
 
         // Fill the soil to saturation if possible in inundated area
@@ -1980,19 +1981,20 @@ water_balance(lake_var_struct *lake,
             Recharge = MM_PER_M * lake->recharge /
                        ((max_newfraction -
                          lakefrac) *
-                        lake_con.basin[0]) +
+                        lake_con->basin[0]) +
                        (veg_var[iveg][band].Wdew +
                         snow[iveg][band].snow_canopy * MM_PER_M +
                         snow[iveg][band].swq * MM_PER_M);                                                                                                                               // mm over area that has been flooded
 
             for (j = 0; j < options.Nlayer; j++) {
                 if (Recharge >
-                    (soil_con.max_moist[j] - cell[iveg][band].layer[j].moist)) {
+                    (soil_con->max_moist[j] -
+                     cell[iveg][band].layer[j].moist)) {
                     Recharge -=
-                        (soil_con.max_moist[j] -
+                        (soil_con->max_moist[j] -
                          cell[iveg][band].layer[j].moist);
                     delta_moist[j] =
-                        (soil_con.max_moist[j] -
+                        (soil_con->max_moist[j] -
                          cell[iveg][band].layer[j].moist) *
                         (max_newfraction - lakefrac) / (1 - lakefrac);                                                      // mm over (1-lakefrac)
                 }
@@ -2013,29 +2015,29 @@ water_balance(lake_var_struct *lake,
     *    wetland.  Outgoing runoff and baseflow are in m3.
     **********************************************************************/
 
-    Dsmax = soil_con.Dsmax / global_param.model_steps_per_day;
+    Dsmax = soil_con->Dsmax / global_param.model_steps_per_day;
     lindex = options.Nlayer - 1;
     liq = 0;
     for (frost_area = 0; frost_area < options.Nfrost; frost_area++) {
         liq +=
-            (soil_con.max_moist[lindex] -
+            (soil_con->max_moist[lindex] -
              cell[iveg][band].layer[lindex].ice[frost_area]) *
             frost_fract[frost_area];
     }
-    resid_moist = soil_con.resid_moist[lindex] * soil_con.depth[lindex] *
+    resid_moist = soil_con->resid_moist[lindex] * soil_con->depth[lindex] *
                   MM_PER_M;
 
     /** Compute relative moisture **/
     rel_moist =
-        (liq - resid_moist) / (soil_con.max_moist[lindex] - resid_moist);
+        (liq - resid_moist) / (soil_con->max_moist[lindex] - resid_moist);
 
     /** Compute baseflow as function of relative moisture **/
-    frac = Dsmax * soil_con.Ds / soil_con.Ws;
+    frac = Dsmax * soil_con->Ds / soil_con->Ws;
     baseflow_out_mm = frac * rel_moist;
-    if (rel_moist > soil_con.Ws) {
-        frac = (rel_moist - soil_con.Ws) / (1 - soil_con.Ws);
-        baseflow_out_mm += Dsmax * (1 - soil_con.Ds / soil_con.Ws) * pow(frac,
-                                                                         soil_con.c);
+    if (rel_moist > soil_con->Ws) {
+        frac = (rel_moist - soil_con->Ws) / (1 - soil_con->Ws);
+        baseflow_out_mm += Dsmax * (1 - soil_con->Ds / soil_con->Ws) *
+                           pow(frac, soil_con->c);
     }
     if (baseflow_out_mm < 0) {
         baseflow_out_mm = 0;
@@ -2070,24 +2072,24 @@ water_balance(lake_var_struct *lake,
     }
 
     // Compute runoff volume in m^3 and extract runoff volume from lake
-    if (ldepth <= lake_con.mindepth) {
+    if (ldepth <= lake_con->mindepth) {
         lake->runoff_out = 0.0;
     }
     else {
         circum = 2 * CONST_PI * pow(surfacearea / CONST_PI, 0.5);
-        lake->runoff_out = lake_con.wfrac * circum * dt *
-                           1.6 * pow(ldepth - lake_con.mindepth, 1.5);
+        lake->runoff_out = lake_con->wfrac * circum * dt *
+                           1.6 * pow(ldepth - lake_con->mindepth, 1.5);
         if ((lake->volume - lake->ice_water_eq) >= lake->runoff_out) {
             /*liquid water is available */
-            if ((lake->volume - lake->runoff_out) < lake_con.minvolume) {
-                lake->runoff_out = lake->volume - lake_con.minvolume;
+            if ((lake->volume - lake->runoff_out) < lake_con->minvolume) {
+                lake->runoff_out = lake->volume - lake_con->minvolume;
             }
             lake->volume -= lake->runoff_out;
         }
         else {
             lake->runoff_out = lake->volume - lake->ice_water_eq;
-            if ((lake->volume - lake->runoff_out) < lake_con.minvolume) {
-                lake->runoff_out = lake->volume - lake_con.minvolume;
+            if ((lake->volume - lake->runoff_out) < lake_con->minvolume) {
+                lake->runoff_out = lake->volume - lake_con->minvolume;
             }
             lake->volume -= lake->runoff_out;
         }
@@ -2103,14 +2105,14 @@ water_balance(lake_var_struct *lake,
     }
 
     // check that lake volume does not exceed its maximum
-    if (lake->volume - lake_con.maxvolume > DBL_EPSILON) {
-        if (lake->ice_water_eq > lake_con.maxvolume) {
+    if (lake->volume - lake_con->maxvolume > DBL_EPSILON) {
+        if (lake->ice_water_eq > lake_con->maxvolume) {
             lake->runoff_out += (lake->volume - lake->ice_water_eq);
             lake->volume = lake->ice_water_eq;
         }
         else {
-            lake->runoff_out += (lake->volume - lake_con.maxvolume);
-            lake->volume = lake_con.maxvolume;
+            lake->runoff_out += (lake->volume - lake_con->maxvolume);
+            lake->volume = lake_con->maxvolume;
         }
     }
     else if (lake->volume < DBL_EPSILON) {
@@ -2143,7 +2145,7 @@ water_balance(lake_var_struct *lake,
     else {
         lake->sarea = lake->surface[0];
     }
-    newfraction = lake->sarea / lake_con.basin[0];
+    newfraction = lake->sarea / lake_con->basin[0];
 
     /*******************************************************************/
 
@@ -2171,7 +2173,7 @@ water_balance(lake_var_struct *lake,
     }
 
     if (lake->activenod == isave_n && isave_n == 0) {
-        lake->temp[k] = all_vars->energy[iveg][band].Tsurf;
+        lake->temp[0] = all_vars->energy[iveg][band].Tsurf;
     }
 
     /**********************************************************************
@@ -2182,7 +2184,7 @@ water_balance(lake_var_struct *lake,
     // Wetland
     if (newfraction < 1.0) { // wetland exists at end of time step
         advect_soil_veg_storage(lakefrac, max_newfraction, newfraction,
-                                delta_moist, &soil_con, &veg_con,
+                                delta_moist, soil_con, veg_con,
                                 &(cell[iveg][band]), &(veg_var[iveg][band]),
                                 lake_con);
         rescale_soil_veg_fluxes((1 - lakefrac), (1 - newfraction),
@@ -2198,20 +2200,20 @@ water_balance(lake_var_struct *lake,
             energy[iveg][band].moist, energy[iveg][band].ice,
             energy[iveg][band].kappa_node,
             energy[iveg][band].Cs_node,
-            soil_con.Zsum_node,
+            soil_con->Zsum_node,
             energy[iveg][band].T,
-            soil_con.max_moist_node,
-            soil_con.expt_node,
-            soil_con.bubble_node,
-            moist, soil_con.depth,
-            soil_con.soil_dens_min,
-            soil_con.bulk_dens_min,
-            soil_con.quartz,
-            soil_con.soil_density,
-            soil_con.bulk_density,
-            soil_con.organic, options.Nnode,
+            soil_con->max_moist_node,
+            soil_con->expt_node,
+            soil_con->bubble_node,
+            moist, soil_con->depth,
+            soil_con->soil_dens_min,
+            soil_con->bulk_dens_min,
+            soil_con->quartz,
+            soil_con->soil_density,
+            soil_con->bulk_density,
+            soil_con->organic, options.Nnode,
             options.Nlayer,
-            soil_con.FS_ACTIVE);
+            soil_con->FS_ACTIVE);
         if (ErrorFlag == ERROR) {
             return (ERROR);
         }
@@ -2220,14 +2222,14 @@ water_balance(lake_var_struct *lake,
         if (lakefrac > 0.0) { // lake also existed at beginning of step
             for (j = 0; j < options.Nlayer; j++) {
                 lake->evapw += cell[iveg][band].layer[j].evap / MM_PER_M *
-                               (1. - lakefrac) * lake_con.basin[0];
+                               (1. - lakefrac) * lake_con->basin[0];
             }
             lake->evapw += veg_var[iveg][band].canopyevap / MM_PER_M *
-                           (1. - lakefrac) * lake_con.basin[0];
+                           (1. - lakefrac) * lake_con->basin[0];
             lake->evapw += snow[iveg][band].canopy_vapor_flux *
-                           (1. - lakefrac) * lake_con.basin[0];
+                           (1. - lakefrac) * lake_con->basin[0];
             lake->evapw += snow[iveg][band].vapor_flux *
-                           (1. - lakefrac) * lake_con.basin[0];
+                           (1. - lakefrac) * lake_con->basin[0];
         }
     }
 
@@ -2235,16 +2237,16 @@ water_balance(lake_var_struct *lake,
     if (newfraction > 0.0) { // lake exists at end of time step
         // Copy moisture fluxes into lake->soil structure, mm over end-of-step lake area
         lake->soil.runoff = lake->runoff_out * MM_PER_M /
-                            (newfraction * lake_con.basin[0]);
+                            (newfraction * lake_con->basin[0]);
         lake->soil.baseflow = lake->baseflow_out * MM_PER_M /
-                              (newfraction * lake_con.basin[0]);
+                              (newfraction * lake_con->basin[0]);
         lake->soil.inflow = lake->baseflow_out * MM_PER_M /
-                            (newfraction * lake_con.basin[0]);
+                            (newfraction * lake_con->basin[0]);
         for (lindex = 0; lindex < options.Nlayer; lindex++) {
             lake->soil.layer[lindex].evap = 0;
         }
         lake->soil.layer[0].evap += lake->evapw * MM_PER_M /
-                                    (newfraction * lake_con.basin[0]);
+                                    (newfraction * lake_con->basin[0]);
         // Rescale other fluxes and storages to mm over end-of-step lake area
         if (lakefrac > 0.0) { // lake existed at beginning of time step
             rescale_snow_storage(lakefrac, newfraction, &(lake->snow));
@@ -2259,7 +2261,7 @@ water_balance(lake_var_struct *lake,
         }
         else { // lake didn't exist at beginning of time step; create new lake
                // Reset all non-essential lake variables
-            initialize_lake(lake, lake_con, &soil_con, &(cell[iveg][band]),
+            initialize_lake(lake, lake_con, soil_con, &(cell[iveg][band]),
                             true);
 
             // Compute lake dimensions from current lake depth
@@ -2284,14 +2286,16 @@ water_balance(lake_var_struct *lake,
             cell[iveg][band].layer[0].evap += MM_PER_M * lake->evapw /
                                               ((1. -
                                                 newfraction) *
-                                               lake_con.basin[0]);
+                                               lake_con->basin[0]);
             cell[iveg][band].runoff += MM_PER_M * lake->runoff_out /
-                                       ((1. - newfraction) * lake_con.basin[0]);
+                                       ((1. - newfraction) *
+                                        lake_con->basin[0]);
             cell[iveg][band].baseflow += MM_PER_M * lake->baseflow_out /
                                          ((1. -
-                                           newfraction) * lake_con.basin[0]);
+                                           newfraction) * lake_con->basin[0]);
             cell[iveg][band].inflow += MM_PER_M * lake->baseflow_out /
-                                       ((1. - newfraction) * lake_con.basin[0]);
+                                       ((1. - newfraction) *
+                                        lake_con->basin[0]);
         }
     }
 
@@ -2299,8 +2303,7 @@ water_balance(lake_var_struct *lake,
         advect_carbon_storage(lakefrac, newfraction, lake, &(cell[iveg][band]));
     }
 
-    free((char*) delta_moist);
-    free((char*) moist);
+    scratch_release(mark);
 
     return(0);
 }
@@ -2318,7 +2321,7 @@ advect_soil_veg_storage(double            lakefrac,
                         veg_con_struct   *veg_con,
                         cell_data_struct *cell,
                         veg_var_struct   *veg_var,
-                        lake_con_struct   lake_con)
+                        lake_con_struct  *lake_con)
 {
     extern option_struct options;
     int                  ilidx;
@@ -2366,7 +2369,7 @@ advect_soil_veg_storage(double            lakefrac,
         // Any recharge that cannot be accomodated by wetland goes to baseflow
         if (delta_moist[0] > 0) {
             cell->baseflow += delta_moist[0] / MM_PER_M *
-                              (1 - lakefrac) * lake_con.basin[0];            // m^3
+                              (1 - lakefrac) * lake_con->basin[0];            // m^3
             delta_moist[0] = 0;
         }
 
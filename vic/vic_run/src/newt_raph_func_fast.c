@@ -34,23 +34,39 @@
 /******************************************************************************
  * @brief    Newton-Raphson method to solve non-linear system adapted from
  *           "Numerical Recipes"
+ *
+ * @details  The tridiagonal Jacobian is computed by jacfunc, or by the
+ *           forward differences of fdjac3() if jacfunc is NULL.  It is
+ *           recomputed every NEWT_RAPH_JAC_REUSE iterations and reused in
+ *           between (chord method).  Each iteration counts as one residual
+ *           evaluation in the solver statistics of the call site.
  *****************************************************************************/
 int
-newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
+newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init,
+                          int focus, void *ctx),
+          void (*jacfunc)(double x[], double a[], double b[], double c[],
+                          int n, void *ctx),
           double x[],
-          int n)
+          int n,
+          void *ctx,
+          size_t site)
 {
     extern parameters_struct param;
 
     int                      k, i, Error;
     double                   errx, errf, fvec[MAX_NODES], p[MAX_NODES];
     double                   a[MAX_NODES], b[MAX_NODES], c[MAX_NODES];
+    double                   ja[MAX_NODES], jb[MAX_NODES], jc[MAX_NODES];
+    solver_stats_struct     *stats;
 
     Error = 0;
+    stats = get_solver_stats(site);
+    stats->calls++;
 
     for (k = 0; k < param.NEWT_RAPH_MAXTRIAL; k++) {
         // calculate function value for all nodes, i.e. focus = -1
-        (*vecfunc)(x, fvec, n, 0, -1);
+        (*vecfunc)(x, fvec, n, 0, -1, ctx);
+        stats->evals++;
 
         // stop if TOLF is satisfied
         errf = 0.0;
@@ -61,10 +77,21 @@ newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
             return (Error);
         }
 
-        // calculate the Jacobian
-        fdjac3(x, fvec, a, b, c, vecfunc, n);
+        // calculate the Jacobian, or reuse the last one in chord mode
+        if (k % param.NEWT_RAPH_JAC_REUSE == 0) {
+            if (jacfunc != NULL) {
+                (*jacfunc)(x, ja, jb, jc, n, ctx);
+            }
+            else {
+                fdjac3(x, fvec, ja, jb, jc, vecfunc, n, ctx);
+            }
+        }
 
+        // tridiag() overwrites the matrix with its factors
         for (i = 0; i < n; i++) {
+            a[i] = ja[i];
+            b[i] = jb[i];
+            c[i] = jc[i];
             p[i] = -fvec[i];
         }
 
@@ -98,6 +125,7 @@ newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
             return (Error);
         }
     }
+    stats->maxiter++;
     Error = 1;
 
     return (Error);
@@ -113,8 +141,10 @@ fdjac3(double x[],
        double a[],
        double b[],
        double c[],
-       void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
-       int n)
+       void (*vecfunc)(double x[], double fvec[], int n, int init,
+                       int focus, void *ctx),
+       int n,
+       void *ctx)
 {
     extern parameters_struct param;
 
@@ -131,7 +161,7 @@ fdjac3(double x[],
         h = x[j] - temp;
 
         // only update column j-1, j and j+1, caused by change in x[j]
-        (*vecfunc)(x, f, n, 0, j);
+        (*vecfunc)(x, f, n, 0, j, ctx);
 
         x[j] = temp;
 
@@ -48,31 +48,84 @@ photosynth(char    Ctype,
            double *Rdark,
            double *Rphoto,
            double *Agross)
+{
+    photosynth_layers(Ctype, MaxCarboxRate, MaxETransport, CO2Specificity,
+                      &NscaleFactor, Tfoliage, PIRRIN, &aPAR, Psurf, Catm,
+                      mode, 1, rs, Ci, Rdark, Rphoto, Agross);
+}
+
+/******************************************************************************
+ * @brief    Calculate photosynthesis for all layers of a multi-layer canopy
+ *
+ * @details  The layers of the canopy share the foliage temperature, the
+ *           irradiance and the surface pressure, and differ only in their
+ *           nitrogen scaling factor, absorbed PAR and (if mode is "rs")
+ *           stomatal resistance.  The temperature dependence of the rates,
+ *           the compensation point and the inhibition factors are therefore
+ *           computed once for all layers, and the remaining arithmetic is
+ *           done in a single loop over the layers that the compiler can
+ *           vectorize.  The arithmetic of each layer is that of a separate
+ *           call of photosynth(), in the same order.
+ *
+ *           NscaleFactor, aPAR, rs, Ci, Rdark, Rphoto and Agross hold one
+ *           value per layer.
+ *****************************************************************************/
+void
+photosynth_layers(char    Ctype,
+                  double  MaxCarboxRate,
+                  double  MaxETransport,
+                  double  CO2Specificity,
+                  double *NscaleFactor,
+                  double  Tfoliage,
+                  double  PIRRIN,
+                  double *aPAR,
+                  double  Psurf,
+                  double  Catm,
+                  char   *mode,
+                  size_t  nlayers,
+                  double *rs,
+                  double *Ci,
+                  double *Rdark,
+                  double *Rphoto,
+                  double *Agross)
 {
     extern parameters_struct param;
 
+    bool                     ci_mode;
+    bool                     rs_mode;
+    size_t                   l;
     double                   T;
     double                   T1;
     double                   T0;
+    double                   Vfactor;
+    double                   Rfactor;
+    double                   Kfactor = 0.;
+    double                   inhib;
+    double                   dark;
+    double                   RdarkC;
+    double                   rsFactor;
     double                   Vcmax;
-    double                   KC;
-    double                   KO;
-    double                   gamma;
+    double                   KC = 0.;
+    double                   KO = 0.;
+    double                   K2 = 0.;
+    double                   gamma = 0.;
     double                   Jmax;
-    double                   K;
+    double                   K = 0.;
     double                   JE = 0.;
     double                   JC = 0.;
     double                   J0;
-    double                   J1;
+    double                   J1 = 0.;
     double                   K1;
-    double                   K2;
     double                   W1;
     double                   W2;
-    double                   r0;
+    double                   r0 = 0.;
     double                   B;
     double                   C;
     double                   tmp;
 
+    ci_mode = !strcasecmp(mode, "ci");
+    rs_mode = !strcasecmp(mode, "rs");
+
     T1 = 25 + CONST_TKFRZ;
     T = Tfoliage + CONST_TKFRZ;     // Canopy or Vegetation Temperature in Kelvin
     T0 = T - T1;               // T relative to 25 degree Celsius, means T - 25
@@ -84,13 +137,32 @@ photosynth(char    Ctype,
        ! most Rubisco. Therefore, it is assumed that the Rubisco content falls
        ! exponentially inside the canopy. This is reflected directly in the values of Vcmax
        ! and Jmax at 25 Celsius (Vcmax * nscl),  Knorr (107/108)
+       ! Only the nitrogen scaling differs between the layers, so the temperature
+       ! dependence is computed once here.
     ********************************************************************************/
-    Vcmax = MaxCarboxRate * NscaleFactor *
-            exp(param.PHOTO_EV * (T0 / T1) / (CONST_RGAS * T));
+    Vfactor = exp(param.PHOTO_EV * (T0 / T1) / (CONST_RGAS * T));
 
     /********************************************************************************
-       ! Determine temperature-dependent rates, compensation point, and 'dark' respiration
+       ! Temperature dependence of the 'dark' respiration, and the high temperature and
+       ! dark inhibition factors, which are the same for all layers
     ********************************************************************************/
+    Rfactor = exp(param.PHOTO_ER * (T0 / T1) / (CONST_RGAS * T));
+    inhib = hiTinhib(Tfoliage);
+    dark = darkinhib(PIRRIN);
+    RdarkC = 0.;
+    if (Ctype == PHOTO_C3) {
+        RdarkC = param.PHOTO_FRDC3;
+    }
+    else if (Ctype == PHOTO_C4) {
+        RdarkC = param.PHOTO_FRDC4;
+    }
+
+    /********************************************************************************
+       ! Conversion from net assimilation to stomatal conductance, see the end of the
+       ! layer loop
+    ********************************************************************************/
+    rsFactor = Psurf / (CONST_RGAS * T);
+
     if (Ctype == PHOTO_C3) {
         /********************************************************************************
            ! C3 Plants
@@ -112,6 +184,7 @@ photosynth(char    Ctype,
              exp(param.PHOTO_EC * (T0 / T1) / (CONST_RGAS * T));
         KO = param.PHOTO_KO *
              exp(param.PHOTO_EO * (T0 / T1) / (CONST_RGAS * T));
+        K2 = KC * (1. + param.PHOTO_OX / KO);
 
         /********************************************************************************
            ! CO2 compensation point without leaf respiration, gamma* is assumed to be linearly
@@ -122,38 +195,6 @@ photosynth(char    Ctype,
         if (gamma < 0) {
             gamma = 0;
         }
-
-        /********************************************************************************
-           ! The temperature dependence of the electron transport capacity follows
-           ! Farquhar(1988) with a linear temperature dependence according to the vegetation
-           ! temperature
-           !  J = J(25C) * TC / 25 WHERE J(25) = J0 * NscaleFactor
-           ! minMaxETransport=1E-12
-        ********************************************************************************/
-        Jmax = MaxETransport * NscaleFactor * Tfoliage / 25.;
-        if (Jmax < param.PHOTO_MINMAXETRANS) {
-            Jmax = param.PHOTO_MINMAXETRANS;
-        }
-        if (Jmax > param.PHOTO_MINMAXETRANS) {
-            J1 = param.PHOTO_ALC3 * aPAR * Jmax /
-                 sqrt(Jmax * Jmax +
-                      (param.PHOTO_ALC3 * aPAR) * (param.PHOTO_ALC3 * aPAR));
-        }
-        else {
-            J1 = 0.;
-        }
-
-        /********************************************************************************
-           !  Compute 'dark' respiration
-           ! Following Farquhar et al. (1980), the dark respiration at 25C is proportional
-           ! to Vcmax at 25C, therefore Rdark = const * Vcmax, but the temperature dependence
-           ! goes with ER (for respiration) and not with EV (for Vcmax)
-        ********************************************************************************/
-        *Rdark = param.PHOTO_FRDC3 * MaxCarboxRate * NscaleFactor *
-                 exp(param.PHOTO_ER *
-                     (T0 /
-                      T1) / (CONST_RGAS * T)) * hiTinhib(Tfoliage) * darkinhib(
-            PIRRIN);
     }
     else if (Ctype == PHOTO_C4) {
         /********************************************************************************
@@ -183,265 +224,275 @@ photosynth(char    Ctype,
            !   which is not considered in INITVEGDATA
            ! K scales of course with EK
         ********************************************************************************/
-        K = CO2Specificity * 1.E3 * NscaleFactor * exp(
-            param.PHOTO_EK * (T0 / T1) / (CONST_RGAS * T));
+        Kfactor = exp(param.PHOTO_EK * (T0 / T1) / (CONST_RGAS * T));
+    }
 
-        /********************************************************************************
-           !  Compute 'dark' respiration
-           !  same as C3, just the 25 degree Celsius proportional factor is different
-           !    0.011 for C3,  0.0042 for C4
-        ********************************************************************************/
-        *Rdark = param.PHOTO_FRDC4 * MaxCarboxRate * NscaleFactor *
-                 exp(param.PHOTO_ER *
-                     (T0 /
-                      T1) / (CONST_RGAS * T)) * hiTinhib(Tfoliage) * darkinhib(
-            PIRRIN);
-    } // End computation of T-dependent rates and dark respiration
-
-    if (!strcasecmp(mode, "ci")) {
-        /********************************************************************************
-           ! If Ci given, compute gross photosynthesis components at given leaf-internal CO2
-        ********************************************************************************/
-        if (Ctype == PHOTO_C3) {
-            /********************************************************************************
-               ! C3 Plants
-            ********************************************************************************/
+    for (l = 0; l < nlayers; l++) {
+        Vcmax = MaxCarboxRate * NscaleFactor[l] * Vfactor;
 
+        if (Ctype == PHOTO_C3) {
             /********************************************************************************
-               !  The assimilation follows the Farquhar (1980) formulation for C3 plants
-               !  A = min{JC, JE} - Rdark
-               !  JC = Vcmax * (Ci - gamma) / (Ci + KC * (1 + OX/KO))
-               !  JE = J * (Ci - gamma) / 4 / (Ci + 2 * gamma)      with
-               !   J = alpha * I * Jmax / sqrt(Jmax^2 + alpha^2 * I^2) with I=aPAR in Mol(Photons)
-               !        Knorr (102a-c, 103)
-               !  Here J = J1 and A is the gross photosynthesis (Agross), i.e. still including the
-               !          respiratory part Rdark
+               ! The temperature dependence of the electron transport capacity follows
+               ! Farquhar(1988) with a linear temperature dependence according to the vegetation
+               ! temperature
+               !  J = J(25C) * TC / 25 WHERE J(25) = J0 * NscaleFactor
+               ! minMaxETransport=1E-12
             ********************************************************************************/
-            JE = J1 * ((*Ci) - gamma) / 4. / ((*Ci) + 2. * gamma);
-            JC = Vcmax *
-                 ((*Ci) - gamma) / ((*Ci) + KC * (1. + param.PHOTO_OX / KO));
+            Jmax = MaxETransport * NscaleFactor[l] * Tfoliage / 25.;
+            if (Jmax < param.PHOTO_MINMAXETRANS) {
+                Jmax = param.PHOTO_MINMAXETRANS;
+            }
+            if (Jmax > param.PHOTO_MINMAXETRANS) {
+                J1 = param.PHOTO_ALC3 * aPAR[l] * Jmax /
+                     sqrt(Jmax * Jmax +
+                          (param.PHOTO_ALC3 * aPAR[l]) *
+                          (param.PHOTO_ALC3 * aPAR[l]));
+            }
+            else {
+                J1 = 0.;
+            }
         }
         else if (Ctype == PHOTO_C4) {
-            /********************************************************************************
-               ! C4 Plants
-            ********************************************************************************/
-
-            /********************************************************************************
-               !  JE = 1/2/Theta *[Vcmax + Ji - sqrt((Vcmax+Ji)^2 - 4*Theta*Vcmax*Ji)]
-               !    Ji = ALC4 * aPAR
-               !  J0 is the sum of the first two terms in JE
-            ********************************************************************************/
-            J0 = (param.PHOTO_ALC4 * aPAR + Vcmax) / 2. / param.PHOTO_THETA;
-
-            /********************************************************************************
-               !  last 2 terms:  with J0^2 = 1/4/Theta^2*(Vcmax+Ji)^2
-               !       sqrt(1/4/Theta^2)*sqrt((Vcmax+Ji)^2 - 4*Theta*Vcmax*Ji))
-               !   = sqrt (J0^2 - Vcmax*Ji/Theta)
-            ********************************************************************************/
-            JE = J0 - sqrt(
-                J0 * J0 - Vcmax * param.PHOTO_ALC4 * aPAR / param.PHOTO_THETA);
-
-            /********************************************************************************
-               !         see above
-            ********************************************************************************/
-            JC = K * (*Ci);
+            K = CO2Specificity * 1.E3 * NscaleFactor[l] * Kfactor;
         }
-    } // End computation of gross photosynthesis components at given Ci
-    else {
+
         /********************************************************************************
-           ! If rs given, compute gross photosynthesis components at given stomatal resistance
+           !  Compute 'dark' respiration
+           ! Following Farquhar et al. (1980), the dark respiration at 25C is proportional
+           ! to Vcmax at 25C, therefore Rdark = const * Vcmax, but the temperature dependence
+           ! goes with ER (for respiration) and not with EV (for Vcmax)
+           !  same for C4, just the 25 degree Celsius proportional factor is different
+           !    0.011 for C3,  0.0042 for C4
         ********************************************************************************/
-        if (Ctype == PHOTO_C3) {
-            /********************************************************************************
-               ! C3 Plants
-            ********************************************************************************/
-
-            /********************************************************************************
-               !  Remember:
-               !  A = min{JC, JE} - Rdark
-               !  JC = Vcmax * (Ci - gamma) / (Ci + KC * (1 + OX/KO))
-               !  JE = J * (Ci - gamma) / 4 / (Ci + 2 * gamma)      with
-               !   J = alpha * I * Jmax / sqrt(Jmax^2 + alpha^2 * I^2) with I=aPAR in Mol(Photons)
-               !        Knorr (102a-c, 103)
-               ! J = J1
-            ********************************************************************************/
-
-            /********************************************************************************
-               !         Helping friends K1, W1, W2, K2
-            ********************************************************************************/
-            K1 = 2. * gamma;
-            W1 = J1 / 4.;
-            W2 = Vcmax;
-            K2 = KC * (1. + param.PHOTO_OX / KO);
-
-            /********************************************************************************
-               ! A = gs / 1.6 * (Catm - Ci) * Psurf / Rgas / T
-               ! <=> Ci = Catm - 1.6 * Rgas * T / Psurf / gs * A = Catm - A / G0
-               ! Let rs = 1/gs, where gs = stomatal conductance
-               ! and r0 = 1/G0
-               ! So Ci = Catm - 1.6*(Rgas*T/Psurf)*rs * A = Catm - A * r0
-            ********************************************************************************/
-            r0 = (*rs) * 1.6 * CONST_RGAS * T / Psurf;
-
-            /********************************************************************************
-               ! A = min{JC, JE} - Rdark
-               ! => A = JC - Rdark OR A = JE - Rdark
-               ! Set this (A =) in Ci formula above
-               ! Set Ci in
-               !  JE = J * (Ci - gamma) / 4 / (Ci + 2 * gamma)
-               ! => quadratic formula in JE
-               ! 0 = JE^2 -(Rdark+J/4+(Catm+2*gamma)/r0)*JE +J/(4*r0)*(Catm-gamma)+J/4*Rdark
-            ********************************************************************************/
-            B = (*Rdark) + W1 + (Catm + K1) / r0;
-            C = W1 * (Catm - gamma) / r0 + W1 * (*Rdark);
+        Rdark[l] = RdarkC * MaxCarboxRate * NscaleFactor[l] * Rfactor *
+                   inhib * dark;
 
+        if (ci_mode) {
             /********************************************************************************
-               ! with 0 = x^2 + bx + c
-               !      x1/2 = -b/2 +/- sqrt(b^2/4 - c)
-               !  take '-' as minimum value of formula
+               ! If Ci given, compute gross photosynthesis components at given leaf-internal CO2
             ********************************************************************************/
-            tmp = B * B / 4 - C;
-            if (tmp < 0) {
-                tmp = 0;
+            if (Ctype == PHOTO_C3) {
+                /********************************************************************************
+                   !  The assimilation follows the Farquhar (1980) formulation for C3 plants
+                   !  A = min{JC, JE} - Rdark
+                   !  JC = Vcmax * (Ci - gamma) / (Ci + KC * (1 + OX/KO))
+                   !  JE = J * (Ci - gamma) / 4 / (Ci + 2 * gamma)      with
+                   !   J = alpha * I * Jmax / sqrt(Jmax^2 + alpha^2 * I^2) with I=aPAR in Mol(Photons)
+                   !        Knorr (102a-c, 103)
+                   !  Here J = J1 and A is the gross photosynthesis (Agross), i.e. still including the
+                   !          respiratory part Rdark
+                ********************************************************************************/
+                JE = J1 * (Ci[l] - gamma) / 4. / (Ci[l] + 2. * gamma);
+                JC = Vcmax * (Ci[l] - gamma) / (Ci[l] + K2);
             }
-            JE = B / 2. - sqrt(tmp);
-
+            else if (Ctype == PHOTO_C4) {
+                /********************************************************************************
+                   !  JE = 1/2/Theta *[Vcmax + Ji - sqrt((Vcmax+Ji)^2 - 4*Theta*Vcmax*Ji)]
+                   !    Ji = ALC4 * aPAR
+                   !  J0 is the sum of the first two terms in JE
+                ********************************************************************************/
+                J0 = (param.PHOTO_ALC4 * aPAR[l] + Vcmax) / 2. /
+                     param.PHOTO_THETA;
+
+                /********************************************************************************
+                   !  last 2 terms:  with J0^2 = 1/4/Theta^2*(Vcmax+Ji)^2
+                   !       sqrt(1/4/Theta^2)*sqrt((Vcmax+Ji)^2 - 4*Theta*Vcmax*Ji))
+                   !   = sqrt (J0^2 - Vcmax*Ji/Theta)
+                ********************************************************************************/
+                JE = J0 - sqrt(J0 * J0 - Vcmax * param.PHOTO_ALC4 * aPAR[l] /
+                               param.PHOTO_THETA);
+
+                /********************************************************************************
+                   !         see above
+                ********************************************************************************/
+                JC = K * Ci[l];
+            }
+        } // End computation of gross photosynthesis components at given Ci
+        else {
             /********************************************************************************
-               ! Set Ci in
-               !  JC = Vcmax * (Ci - gamma) / (Ci + KC * (1 + OX/KO))
-               ! WRITE JC = Vcmax * (Ci - gamma) / (Ci + K2)
-               ! => quadratic formula in JC
-               ! 0 = JC^2 -(Rdark+Vcmax+(Catm+K2)/r0)*JC +Vcmax/r0*(Catm-gamma)+Rdark*Vcmax
+               ! If rs given, compute gross photosynthesis components at given stomatal resistance
             ********************************************************************************/
-            B = (*Rdark) + W2 + (Catm + K2) / r0;
-            C = W2 * (Catm - gamma) / r0 + W2 * (*Rdark);
-            tmp = B * B / 4 - C;
-            if (tmp < 0) {
-                tmp = 0;
+            if (Ctype == PHOTO_C3) {
+                /********************************************************************************
+                   !  Remember:
+                   !  A = min{JC, JE} - Rdark
+                   !  JC = Vcmax * (Ci - gamma) / (Ci + KC * (1 + OX/KO))
+                   !  JE = J * (Ci - gamma) / 4 / (Ci + 2 * gamma)      with
+                   !   J = alpha * I * Jmax / sqrt(Jmax^2 + alpha^2 * I^2) with I=aPAR in Mol(Photons)
+                   !        Knorr (102a-c, 103)
+                   ! J = J1
+                ********************************************************************************/
+
+                /********************************************************************************
+                   !         Helping friends K1, W1, W2, K2
+                ********************************************************************************/
+                K1 = 2. * gamma;
+                W1 = J1 / 4.;
+                W2 = Vcmax;
+
+                /********************************************************************************
+                   ! A = gs / 1.6 * (Catm - Ci) * Psurf / Rgas / T
+                   ! <=> Ci = Catm - 1.6 * Rgas * T / Psurf / gs * A = Catm - A / G0
+                   ! Let rs = 1/gs, where gs = stomatal conductance
+                   ! and r0 = 1/G0
+                   ! So Ci = Catm - 1.6*(Rgas*T/Psurf)*rs * A = Catm - A * r0
+                ********************************************************************************/
+                r0 = rs[l] * 1.6 * CONST_RGAS * T / Psurf;
+
+                /********************************************************************************
+                   ! A = min{JC, JE} - Rdark
+                   ! => A = JC - Rdark OR A = JE - Rdark
+                   ! Set this (A =) in Ci formula above
+                   ! Set Ci in
+                   !  JE = J * (Ci - gamma) / 4 / (Ci + 2 * gamma)
+                   ! => quadratic formula in JE
+                   ! 0 = JE^2 -(Rdark+J/4+(Catm+2*gamma)/r0)*JE +J/(4*r0)*(Catm-gamma)+J/4*Rdark
+                ********************************************************************************/
+                B = Rdark[l] + W1 + (Catm + K1) / r0;
+                C = W1 * (Catm - gamma) / r0 + W1 * Rdark[l];
+
+                /********************************************************************************
+                   ! with 0 = x^2 + bx + c
+                   !      x1/2 = -b/2 +/- sqrt(b^2/4 - c)
+                   !  take '-' as minimum value of formula
+                ********************************************************************************/
+                tmp = B * B / 4 - C;
+                if (tmp < 0) {
+                    tmp = 0;
+                }
+                JE = B / 2. - sqrt(tmp);
+
+                /********************************************************************************
+                   ! Set Ci in
+                   !  JC = Vcmax * (Ci - gamma) / (Ci + KC * (1 + OX/KO))
+                   ! WRITE JC = Vcmax * (Ci - gamma) / (Ci + K2)
+                   ! => quadratic formula in JC
+                   ! 0 = JC^2 -(Rdark+Vcmax+(Catm+K2)/r0)*JC +Vcmax/r0*(Catm-gamma)+Rdark*Vcmax
+                ********************************************************************************/
+                B = Rdark[l] + W2 + (Catm + K2) / r0;
+                C = W2 * (Catm - gamma) / r0 + W2 * Rdark[l];
+                tmp = B * B / 4 - C;
+                if (tmp < 0) {
+                    tmp = 0;
+                }
+                JC = B / 2. - sqrt(tmp);
+            }
+            else if (Ctype == PHOTO_C4) {
+                /********************************************************************************
+                   ! Recall:
+                   !  Collatz et al. 1992:
+                   !  A = min{JC, JE} - Rdark
+                   !  JC = k * Ci
+                   !  JE = 1/2/Theta *[Vcmax + Ji - sqrt((Vcmax+Ji)^2 - 4*Theta*Vcmax*Ji)]      with
+                   !   Ji = alphai * Ipar / Epar with Ji=aPAR in Mol(Photons)           and
+                   !   aPAR = Ipar / Epar;  ALC4=alphai; J0=1/2/Theta *(Vcmax + Ji);
+                   !   Ci = Catm - 1.6 * Rgas * T / Psurf / gs * A = Catm - A / G0                and
+                   !   => A = JC - Rdark OR A = JE - Rdark
+                   ! Let rs = 1/gs, where gs = stomatal conductance
+                   ! and r0 = 1/G0
+                   ! So Ci = Catm - 1.6*(Rgas*T/Psurf)*rs * A = Catm - A * r0
+                ********************************************************************************/
+                r0 = rs[l] * 1.6 * CONST_RGAS * T / Psurf;
+
+                /********************************************************************************
+                   !  J0=1/2/Theta *(Vcmax + Ji) = (alphai * aPAR + Vcmax) / 2 / Theta
+                ********************************************************************************/
+                J0 = (param.PHOTO_ALC4 * aPAR[l] + Vcmax) / 2. /
+                     param.PHOTO_THETA;
+
+                /********************************************************************************
+                   !  JE = J0 - sqrt( J0^2 - Vcmax*alphai*aPAR/Theta)
+                ********************************************************************************/
+                JE = J0 - sqrt(J0 * J0 - Vcmax * param.PHOTO_ALC4 * aPAR[l] /
+                               param.PHOTO_THETA);
+
+                /********************************************************************************
+                   !  JC = (Catm/r0 + Rdark) / (1 + 1/(K*r0))
+                ********************************************************************************/
+                JC = (Catm / r0 + Rdark[l]) / (1. + 1 / (K * r0));
             }
-            JC = B / 2. - sqrt(tmp);
+        } // End computation of gross photosynthesis components at given rs
+
+        /********************************************************************************
+           ! Compute gross assimilation (photosynthesis)
+        ********************************************************************************/
+        if (JE < JC) {
+            /* light limitation */
+            Agross[l] = JE * inhib;
+        }
+        else {
+            /* CO2 limitation */
+            Agross[l] = JC * inhib;
         }
-        else if (Ctype == PHOTO_C4) {
-            /********************************************************************************
-               ! C4 Plants
-            ********************************************************************************/
 
+        /********************************************************************************
+           ! If rs given, compute leaf-internal CO2 concentration
+        ********************************************************************************/
+        if (rs_mode) {
             /********************************************************************************
-               ! Recall:
-               !  Collatz et al. 1992:
-               !  A = min{JC, JE} - Rdark
-               !  JC = k * Ci
-               !  JE = 1/2/Theta *[Vcmax + Ji - sqrt((Vcmax+Ji)^2 - 4*Theta*Vcmax*Ji)]      with
-               !   Ji = alphai * Ipar / Epar with Ji=aPAR in Mol(Photons)           and
-               !   aPAR = Ipar / Epar;  ALC4=alphai; J0=1/2/Theta *(Vcmax + Ji);
-               !   Ci = Catm - 1.6 * Rgas * T / Psurf / gs * A = Catm - A / G0                and
-               !   => A = JC - Rdark OR A = JE - Rdark
+               ! A = gs / 1.6 * (Catm - Ci) * p / Rgas / T
+               ! <=> Ci = Catm - 1.6 * Rgas * T / p / gs * A = Catm - A / G0
                ! Let rs = 1/gs, where gs = stomatal conductance
                ! and r0 = 1/G0
                ! So Ci = Catm - 1.6*(Rgas*T/Psurf)*rs * A = Catm - A * r0
+               !   with A = Net assimilation = NPP
+               ! (Catm is the CO2 mixing ratio)
             ********************************************************************************/
-            r0 = (*rs) * 1.6 * CONST_RGAS * T / Psurf;
-
-            /********************************************************************************
-               !  J0=1/2/Theta *(Vcmax + Ji) = (alphai * aPAR + Vcmax) / 2 / Theta
-            ********************************************************************************/
-            J0 = (param.PHOTO_ALC4 * aPAR + Vcmax) / 2. / param.PHOTO_THETA;
-
-            /********************************************************************************
-               !  JE = J0 - sqrt( J0^2 - Vcmax*alphai*aPAR/Theta)
-            ********************************************************************************/
-            JE = J0 - sqrt(
-                J0 * J0 - Vcmax * param.PHOTO_ALC4 * aPAR / param.PHOTO_THETA);
-
-            /********************************************************************************
-               !  JC = (Catm/r0 + Rdark) / (1 + 1/(K*r0))
-            ********************************************************************************/
-            JC = (Catm / r0 + (*Rdark)) / (1. + 1 / (K * r0));
+            if (r0 > 1.e6) {
+                r0 = 1.e6;
+            }
+            Ci[l] = Catm - (Agross[l] - Rdark[l]) * r0;
+            if (Ci[l] < 0) {
+                Ci[l] = 0;
+            }
         }
-    } // End computation of gross photosynthesis components at given rs
 
-    /********************************************************************************
-       ! Compute gross assimilation (photosynthesis)
-    ********************************************************************************/
-    if (JE < JC) {
-        /* light limitation */
-        *Agross = JE * hiTinhib(Tfoliage);
-    }
-    else {
-        /* CO2 limitation */
-        *Agross = JC * hiTinhib(Tfoliage);
-    }
-
-    /********************************************************************************
-       ! If rs given, compute leaf-internal CO2 concentration
-    ********************************************************************************/
-    if (!strcasecmp(mode, "rs")) {
         /********************************************************************************
-           ! A = gs / 1.6 * (Catm - Ci) * p / Rgas / T
-           ! <=> Ci = Catm - 1.6 * Rgas * T / p / gs * A = Catm - A / G0
-           ! Let rs = 1/gs, where gs = stomatal conductance
-           ! and r0 = 1/G0
-           ! So Ci = Catm - 1.6*(Rgas*T/Psurf)*rs * A = Catm - A * r0
-           !   with A = Net assimilation = NPP
-           ! (Catm is the CO2 mixing ratio)
+           ! Compute photorespiration
         ********************************************************************************/
-        if (r0 > 1.e6) {
-            r0 = 1.e6;
+        if (Ctype == PHOTO_C3) {
+            /********************************************************************************
+               ! Photorespiration for C3 plants: Carboxylation controlled assimilation
+               ! JC = Assimilation - Photorespiration
+               ! JC = Vcmax * (Ci - gamma) / (Ci + K2)
+               ! Photorespiration = Vcmax * gamma / (Ci + K2)
+            ********************************************************************************/
+            Rphoto[l] = Vcmax * gamma / (Ci[l] + K2) * inhib;
         }
-        *Ci = Catm - ((*Agross) - (*Rdark)) * r0;
-        if (*Ci < 0) {
-            *Ci = 0;
+        else {
+            /********************************************************************************
+               ! Photorespiration is 0 for C4 plants
+            ********************************************************************************/
+            Rphoto[l] = 0.;
         }
-    }
 
-    /********************************************************************************
-       ! Compute photorespiration
-    ********************************************************************************/
-    if (Ctype == PHOTO_C3) {
         /********************************************************************************
-           ! Photorespiration for C3 plants: Carboxylation controlled assimilation
-           ! JC = Assimilation - Photorespiration
-           ! JC = Vcmax * (Ci - gamma) / (Ci + K2)
-           ! Photorespiration = Vcmax * gamma / (Ci + K2)
+           ! If ci given, compute stomatal resistance
         ********************************************************************************/
-        *Rphoto = Vcmax * gamma /
-                  ((*Ci) + KC * (1. + param.PHOTO_OX / KO)) * hiTinhib(
-            Tfoliage);
-    }
-    else {
-        /********************************************************************************
-           ! Photorespiration is 0 for C4 plants
-        ********************************************************************************/
-        *Rphoto = 0.;
-    }
-
-    /********************************************************************************
-       ! If ci given, compute stomatal resistance
-    ********************************************************************************/
-    if (!strcasecmp(mode, "ci")) {
-        /********************************************************************************
-           ! Diffusion equation Flux = (Catm - CI) / resistence, rs
-           !   conductance gs = 1 / rs  =>  Flux = (Catm-CI) * gs
-           !   (Catm ... CO2mixingRatio)
-           !   Flux of CO2 is Agross * amount, Assimilation rate * amount
-           !   Agross is here, Gross Assimilation, though Agross-Rdark = (net) Assimilation rate
-           !   the amount comes from the ideal gas equation pV=nRgasT => n/V = p / RgasT
-           !   the stomatal conductance for CO2 is less { the conductance of H2O by
-           !   the factor of 1.6: gs(CO2) = gs(H2O) / 1.6, due to its lower mobiblity due
-           !   to its higher mass
-           !   => A (net) = gs/1.6 * (Catm-CI) * p/RgasT
-           !   => gs = A(net)*1.6*RgasT/p/(Catm-CI)
-        ********************************************************************************/
-        if ((*Agross) - (*Rdark) < DBL_EPSILON) {
-            *rs = param.HUGE_RESIST;
-        }
-        else {
-            *rs = 0.625 *
-                  (Catm -
-                   (*Ci)) / ((*Agross) - (*Rdark)) * (Psurf / (CONST_RGAS * T));
-        }
-        if (*rs > param.HUGE_RESIST) {
-            *rs = param.HUGE_RESIST;
+        if (ci_mode) {
+            /********************************************************************************
+               ! Diffusion equation Flux = (Catm - CI) / resistence, rs
+               !   conductance gs = 1 / rs  =>  Flux = (Catm-CI) * gs
+               !   (Catm ... CO2mixingRatio)
+               !   Flux of CO2 is Agross * amount, Assimilation rate * amount
+               !   Agross is here, Gross Assimilation, though Agross-Rdark = (net) Assimilation rate
+               !   the amount comes from the ideal gas equation pV=nRgasT => n/V = p / RgasT
+               !   the stomatal conductance for CO2 is less { the conductance of H2O by
+               !   the factor of 1.6: gs(CO2) = gs(H2O) / 1.6, due to its lower mobiblity due
+               !   to its higher mass
+               !   => A (net) = gs/1.6 * (Catm-CI) * p/RgasT
+               !   => gs = A(net)*1.6*RgasT/p/(Catm-CI)
+            ********************************************************************************/
+            if (Agross[l] - Rdark[l] < DBL_EPSILON) {
+                rs[l] = param.HUGE_RESIST;
+            }
+            else {
+                rs[l] = 0.625 * (Catm - Ci[l]) / (Agross[l] - Rdark[l]) *
+                        rsFactor;
+            }
+            if (rs[l] > param.HUGE_RESIST) {
+                rs[l] = param.HUGE_RESIST;
+            }
         }
     }
 }
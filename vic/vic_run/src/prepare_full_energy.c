@@ -44,9 +44,10 @@ prepare_full_energy(int              iveg,
 
     size_t               i, band;
     layer_data_struct   *layer = NULL;
+    size_t               mark;
 
-    layer = calloc(options.Nlayer, sizeof(*layer));
-    check_alloc_status(layer, "Memory allocation error.");
+    mark = scratch_mark();
+    layer = scratch_calloc(options.Nlayer, sizeof(*layer));
 
     for (band = 0; band < options.SNOW_BAND; band++) {
         if (soil_con->AreaFract[band] > 0.0) {
@@ -107,5 +108,5 @@ prepare_full_energy(int              iveg,
         }
     }
 
-    free((char *) layer);
+    scratch_release(mark);
 }
@@ -59,19 +59,20 @@
 *
 * @param LowerBound Lower bound for root
 * @param UpperBound Upper bound for root
-* @param Function
-* @param ap Variable arguments
+* @param Function Residual function of the estimate and solver context
+* @param ctx Typed solver context, filled once by the caller for each solve
+* @param site Call site whose solver statistics are updated
 * @return b
 ******************************************************************************/
 double
 root_brent(double LowerBound,
            double UpperBound,
-           double (*Function)(double Estimate, va_list ap),
-           ...)
+           double (*Function)(double Estimate, void *ctx),
+           void *ctx,
+           size_t site)
 {
     extern parameters_struct param;
 
-    va_list                  ap; /* Used in traversing variable argument list */
     double                   a;
     double                   b;
     double                   c;
@@ -91,14 +92,17 @@ root_brent(double LowerBound,
     int                      which_err;
     int                      i;
     int                      j;
+    solver_stats_struct     *stats;
 
-    /* initialize variable argument list */
+    stats = get_solver_stats(site);
+    stats->calls++;
+
+    /* evaluate the function at the initial bounds */
     a = LowerBound;
     b = UpperBound;
-    va_start(ap, Function);
-    fa = Function(a, ap);
-    va_start(ap, Function);
-    fb = Function(b, ap);
+    fa = Function(a, ctx);
+    fb = Function(b, ctx);
+    stats->evals += 2;
 
     which_err = 0;
 
@@ -107,7 +111,6 @@ root_brent(double LowerBound,
         log_warn("lower and upper bounds %f and %f "
                  "failed to bracket the root because the given function was "
                  "not defined at either point.", a, b);
-        va_end(ap);
         return(ERROR);
     }
 
@@ -126,16 +129,16 @@ root_brent(double LowerBound,
         }
 
         c = 0.5 * (last_bad + last_good);
-        va_start(ap, Function);
-        fc = Function(c, ap);
+        fc = Function(c, ctx);
+        stats->evals++;
 
         /* search for valid point via bisection */
         j = 0;
         while (fc == ERROR && j < param.ROOT_BRENT_MAXITER) {
             last_bad = c;
             c = 0.5 * (last_bad + last_good);
-            va_start(ap, Function);
-            fc = Function(c, ap);
+            fc = Function(c, ctx);
+            stats->evals++;
             j++;
         }
 
@@ -145,8 +148,7 @@ root_brent(double LowerBound,
             log_warn("the given function produced "
                      "undefined values while attempting to "
                      "bracket the root between %f and %f. Driver info: %s.",
-                     LowerBound, UpperBound, vic_run_ref_str);
-            va_end(ap);
+                     LowerBound, UpperBound, run_context_str());
             return(ERROR);
         }
         else {
@@ -167,44 +169,42 @@ root_brent(double LowerBound,
     /*  if root not bracketed attempt to bracket the root */
     j = 0;
     while ((fa * fb) >= 0 && j < param.ROOT_BRENT_MAXTRIES) {
+        stats->expansions++;
         /* Expansion of bounds depends on whether initial bounds encountered
            undefined function values */
         if (which_err == 0) { // No undefined values were encountered
             a -= param.ROOT_BRENT_TSTEP;
             b += param.ROOT_BRENT_TSTEP;
-            va_start(ap, Function);
-            fa = Function(a, ap);
-            va_start(ap, Function);
-            fb = Function(b, ap);
+            fa = Function(a, ctx);
+            fb = Function(b, ctx);
+            stats->evals += 2;
         }
         else { // Undefined values were encountered
             if (which_err == -1) { // Undefined values encountered in the lower direction
                 b += param.ROOT_BRENT_TSTEP;
-                va_start(ap, Function);
-                fb = Function(b, ap);
+                fb = Function(b, ctx);
+                stats->evals++;
                 if (fb == ERROR) {
                     /* Undefined function values in both directions - give up */
                     log_warn("the given function "
                              "produced undefined values while "
                              "attempting to bracket the root "
                              "between %f and %f. Driver info: %s.",
-                             LowerBound, UpperBound, vic_run_ref_str);
-                    va_end(ap);
+                             LowerBound, UpperBound, run_context_str());
                     return(ERROR);
                 }
                 last_good = a;
             }
             else { // Undefined values encountered in the upper direction
                 a -= param.ROOT_BRENT_TSTEP;
-                va_start(ap, Function);
-                fa = Function(a, ap);
+                fa = Function(a, ctx);
+                stats->evals++;
                 if (fa == ERROR) {
                     /* Undefined function values in both directions - give up */
                     log_warn("the given function produced undefined "
                              "values while attempting to bracket the root "
                              "between %f and %f. Driver info: %s.",
-                             LowerBound, UpperBound, vic_run_ref_str);
-                    va_end(ap);
+                             LowerBound, UpperBound, run_context_str());
                     return(ERROR);
                 }
                 last_good = b;
@@ -212,14 +212,14 @@ root_brent(double LowerBound,
 
             /* search for valid point via bisection */
             c = 0.5 * (last_good + last_bad);
-            va_start(ap, Function);
-            fc = Function(c, ap);
+            fc = Function(c, ctx);
+            stats->evals++;
             i = 0;
             while (fc == ERROR && i < param.ROOT_BRENT_MAXITER) {
                 last_bad = c;
                 c = 0.5 * (last_bad + last_good);
-                va_start(ap, Function);
-                fc = Function(c, ap);
+                fc = Function(c, ctx);
+                stats->evals++;
                 i++;
             }
 
@@ -228,8 +228,7 @@ root_brent(double LowerBound,
                 log_warn("the given function produced undefined "
                          "values while attempting to bracket the root between "
                          "%f and %f. Driver info: %s.",
-                         LowerBound, UpperBound, vic_run_ref_str);
-                va_end(ap);
+                         LowerBound, UpperBound, run_context_str());
                 return(ERROR);
             }
             else {
@@ -248,10 +247,10 @@ root_brent(double LowerBound,
     }
     if ((fa * fb) >= 0) {
         /* if we get here, the lower and upper bounds did not bracket the root */
+        stats->maxiter++;
         log_warn("lower and upper bounds %f and %f failed to "
                  "bracket the root. Driver info: %s.",
-                 a, b, vic_run_ref_str);
-        va_end(ap);
+                 a, b, run_context_str());
         return(ERROR);
     }
 
@@ -282,7 +281,6 @@ root_brent(double LowerBound,
         m = 0.5 * (c - b);
 
         if (fabs(m) <= tol || fb == 0) {
-            va_end(ap);
             return b;
         }
         else {
@@ -328,21 +326,20 @@ root_brent(double LowerBound,
             a = b;
             fa = fb;
             b += (fabs(d) > tol) ? d : ((m > 0) ? tol : -tol);
-            va_start(ap, Function);
-            fb = Function(b, ap);
+            fb = Function(b, ctx);
+            stats->evals++;
 
             // Catch ERROR values returned from Function
             if (fb == ERROR) {
                 log_warn("iteration %d: temperature = %.4f. Driver info: %s.",
-                         i + 1, b, vic_run_ref_str);
-                va_end(ap);
+                         i + 1, b, run_context_str());
                 return(ERROR);
             }
         }
     }
     /* If we get here, there were too many iterations */
+    stats->maxiter++;
     log_warn("too many iterations. Driver info: %s.",
-             vic_run_ref_str);
-    va_end(ap);
+             run_context_str());
     return(ERROR);
 }
@@ -0,0 +1,196 @@
+/******************************************************************************
+* @section DESCRIPTION
+*
+* Safeguarded secant root finding algorithm with warm start
+*
+* @section LICENSE
+*
+* The Variable Infiltration Capacity (VIC) macroscale hydrological model
+* Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+* and Environmental Engineering, University of Washington.
+*
+* The VIC model is free software; you can redistribute it and/or
+* modify it under the terms of the GNU General Public License
+* as published by the Free Software Foundation; either version 2
+* of the License, or (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along with
+* this program; if not, write to the Free Software Foundation, Inc.,
+* 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+******************************************************************************/
+
+#include <vic_run.h>
+
+/******************************************************************************
+* @brief Safeguarded secant root finding algorithm, warm-started from an
+*        estimate of the root, with root_brent() as the fallback
+*
+* @details
+*
+* The iteration starts at Estimate (usually the temperature found in the
+* previous time step) and takes a first step of ROOT_SECANT_TSTEP in the
+* direction of a residual that decreases with temperature, as the energy
+* balance residuals do.  Later steps use the secant slope between the last
+* two evaluations as the estimate of dE/dT.  Once two evaluations have
+* opposite signs the root is bracketed, and any secant step that leaves the
+* bracket is replaced by bisection.  Before the root is bracketed a step may
+* not exceed ROOT_BRENT_TSTEP, and the iterate may not leave the interval
+* that root_brent() could reach by expanding [LowerBound, UpperBound].
+*
+* The root is accepted when the secant step is smaller than the root_brent()
+* tolerance (2 * DBL_EPSILON * |T| + ROOT_BRENT_T).  If the residual function
+* returns ERROR, the step limits are violated, the slope vanishes, or the
+* solution takes more than ROOT_SECANT_MAXITER iterations, the root is
+* searched again with root_brent(LowerBound, UpperBound), which logs its own
+* warnings and returns ERROR if it fails too.
+*
+* @param Estimate Starting estimate of the root
+* @param LowerBound Lower bound passed to root_brent() on fallback
+* @param UpperBound Upper bound passed to root_brent() on fallback
+* @param Function Residual function of the estimate and solver context
+* @param ctx Typed solver context, filled once by the caller for each solve
+* @param site Call site whose solver statistics are updated
+* @return root of Function, or ERROR
+******************************************************************************/
+double
+root_secant(double Estimate,
+            double LowerBound,
+            double UpperBound,
+            double (*Function)(double Estimate, void *ctx),
+            void *ctx,
+            size_t site)
+{
+    extern parameters_struct param;
+
+    double                   x0;
+    double                   x1;
+    double                   x2;
+    double                   f0;
+    double                   f1;
+    double                   f2;
+    double                   a;
+    double                   b;
+    double                   fa;
+    double                   xmin;
+    double                   xmax;
+    double                   d;
+    double                   tol;
+    bool                     bracketed;
+    int                      i;
+    solver_stats_struct     *stats;
+
+    stats = get_solver_stats(site);
+    stats->calls++;
+
+    xmin = LowerBound - param.ROOT_BRENT_MAXTRIES * param.ROOT_BRENT_TSTEP;
+    xmax = UpperBound + param.ROOT_BRENT_MAXTRIES * param.ROOT_BRENT_TSTEP;
+
+    /* evaluate the function at the warm start */
+    x0 = Estimate;
+    if (x0 < xmin || x0 > xmax) {
+        x0 = 0.5 * (LowerBound + UpperBound);
+    }
+    f0 = Function(x0, ctx);
+    stats->evals++;
+    if (f0 == ERROR) {
+        stats->fallbacks++;
+        return root_brent(LowerBound, UpperBound, Function, ctx, site);
+    }
+    if (f0 == 0) {
+        return x0;
+    }
+
+    /* first step is taken downhill for a residual decreasing with T */
+    if (f0 > 0) {
+        x1 = x0 + param.ROOT_SECANT_TSTEP;
+    }
+    else {
+        x1 = x0 - param.ROOT_SECANT_TSTEP;
+    }
+    f1 = Function(x1, ctx);
+    stats->evals++;
+    if (f1 == ERROR) {
+        stats->fallbacks++;
+        return root_brent(LowerBound, UpperBound, Function, ctx, site);
+    }
+
+    bracketed = false;
+    a = b = fa = 0.;
+
+    for (i = 0; i < param.ROOT_SECANT_MAXITER; i++) {
+        if (f1 == 0) {
+            return x1;
+        }
+
+        /* keep the tightest bracket found so far */
+        if (f0 * f1 < 0) {
+            bracketed = true;
+            a = x0;
+            b = x1;
+            fa = f0;
+        }
+        else if (bracketed) {
+            if (f1 * fa > 0) {
+                a = x1;
+                fa = f1;
+            }
+            else {
+                b = x1;
+            }
+        }
+
+        /* secant step, safeguarded by the bracket or the step limit */
+        if (f1 == f0) {
+            if (!bracketed) {
+                break;
+            }
+            x2 = 0.5 * (a + b);
+        }
+        else {
+            x2 = x1 - f1 * (x1 - x0) / (f1 - f0);
+        }
+        if (bracketed) {
+            if ((x2 - a) * (x2 - b) >= 0) {
+                x2 = 0.5 * (a + b);
+            }
+        }
+        else {
+            d = x2 - x1;
+            if (fabs(d) > param.ROOT_BRENT_TSTEP) {
+                x2 = x1 + ((d > 0) ? param.ROOT_BRENT_TSTEP :
+                           -param.ROOT_BRENT_TSTEP);
+            }
+            if (x2 < xmin || x2 > xmax) {
+                break;
+            }
+        }
+
+        tol = 2 * DBL_EPSILON * fabs(x2) + param.ROOT_BRENT_T;
+        if (fabs(x2 - x1) <= tol || (bracketed && fabs(b - a) <= 2 * tol)) {
+            return x2;
+        }
+
+        f2 = Function(x2, ctx);
+        stats->evals++;
+        if (f2 == ERROR) {
+            break;
+        }
+
+        x0 = x1;
+        f0 = f1;
+        x1 = x2;
+        f1 = f2;
+    }
+
+    /* the warm start failed, search the full bracket */
+    if (i == param.ROOT_SECANT_MAXITER) {
+        stats->maxiter++;
+    }
+    stats->fallbacks++;
+    return root_brent(LowerBound, UpperBound, Function, ctx, site);
+}
@@ -0,0 +1,78 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Grid cell and time step that vic_run is working on, for diagnostics.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_run.h>
+
+/******************************************************************************
+ * @brief    Run context of this thread, and the buffer it is formatted in.
+ *****************************************************************************/
+static run_context_struct run_context;
+static char               run_context_buf[MAXSTRING];
+#ifdef _OPENMP
+#pragma omp threadprivate(run_context, run_context_buf)
+#endif
+
+/******************************************************************************
+ * @brief    Record the grid cell and time step of the next vic_run() call of
+ *           this thread.
+ *
+ * @details  Called by the drivers for every grid cell and time step, so it
+ *           only stores the values; they are formatted by run_context_str()
+ *           when a message is actually written.
+ *****************************************************************************/
+void
+set_run_context(size_t      cell,
+                size_t      step,
+                dmy_struct *dmy)
+{
+    run_context.cell = cell;
+    run_context.step = step;
+    run_context.dmy = dmy;
+}
+
+/******************************************************************************
+ * @brief    Format the run context of this thread for a diagnostic message.
+ *
+ * @details  The returned string is overwritten by the next call from the
+ *           same thread.
+ *****************************************************************************/
+char *
+run_context_str(void)
+{
+    if (run_context.dmy == NULL) {
+        snprintf(run_context_buf, MAXSTRING, "Gridcell: %zu, timestep: %zu",
+                 run_context.cell, run_context.step);
+    }
+    else {
+        snprintf(run_context_buf, MAXSTRING,
+                 "Gridcell: %zu, timestep: %zu (%04d-%02hu-%02hu-%05u)",
+                 run_context.cell, run_context.step, run_context.dmy->year,
+                 run_context.dmy->month, run_context.dmy->day,
+                 run_context.dmy->dayseconds);
+    }
+
+    return run_context_buf;
+}
@@ -0,0 +1,256 @@
+/******************************************************************************
+ * @section DESCRIPTION
+ *
+ * Scratch memory for the temporary arrays of vic_run.
+ *
+ * @section LICENSE
+ *
+ * The Variable Infiltration Capacity (VIC) macroscale hydrological model
+ * Copyright (C) 2016 The Computational Hydrology Group, Department of Civil
+ * and Environmental Engineering, University of Washington.
+ *
+ * The VIC model is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *****************************************************************************/
+
+#include <vic_run.h>
+
+#define SCRATCH_ALIGN    16   /**< alignment of every scratch array (bytes) */
+#define SCRATCH_MAX_HEAP 256  /**< maximum number of live heap fallbacks */
+
+/******************************************************************************
+ * @brief    Scratch arena.
+ *
+ * @details  Arrays are carved from a single block in last in, first out
+ *           order.  Offsets count every allocation, including the ones that
+ *           did not fit in the block and were taken from the heap instead, so
+ *           that scratch_release() knows which heap allocations to free.
+ *****************************************************************************/
+typedef struct {
+    char *base;                     /**< start of the block */
+    size_t size;                    /**< size of the block (bytes) */
+    size_t used;                    /**< current offset (bytes) */
+    size_t nheap;                   /**< number of live heap fallbacks */
+    size_t heap_allocs;             /**< total number of heap fallbacks */
+    void *heap[SCRATCH_MAX_HEAP];   /**< live heap fallbacks */
+    size_t heap_offset[SCRATCH_MAX_HEAP]; /**< offsets of the heap fallbacks */
+} scratch_struct;
+
+static scratch_struct scratch;
+#ifdef _OPENMP
+#pragma omp threadprivate(scratch)
+#endif
+
+/******************************************************************************
+ * @brief    Size of a scratch array of n elements of the given size, rounded
+ *           up to the scratch alignment
+ *****************************************************************************/
+static size_t
+scratch_bytes(size_t n,
+              size_t size)
+{
+    return (n * size + SCRATCH_ALIGN - 1) / SCRATCH_ALIGN * SCRATCH_ALIGN;
+}
+
+/******************************************************************************
+ * @brief    Allocate the scratch arena of this thread, or empty it if it is
+ *           already allocated.
+ *
+ * @details  The arena is sized once, from the model dimensions in options, to
+ *           hold the temporary arrays of all routines of vic_run at the same
+ *           time, so that vic_run makes no heap allocations.  Called at the
+ *           start of every vic_run() call, which also recovers the space of
+ *           any routine that returned an error without releasing its arrays.
+ *****************************************************************************/
+void
+initialize_scratch(void)
+{
+    extern option_struct options;
+
+    size_t               size;
+    size_t               i;
+
+    if (scratch.base == NULL) {
+        size = 0;
+
+        // surface_fluxes, canopy_evap and canopy_assimilation
+        size += 5 * scratch_bytes(options.Ncanopy, sizeof(double));
+
+        // forcing of adaptive snow steps (surface_fluxes)
+        if (options.ADAPTIVE_SNOW_STEP) {
+            size += 15 * scratch_bytes(1, sizeof(double));
+        }
+
+        // func_surf_energy_bal and water_balance (lakes)
+        size += 3 * scratch_bytes(options.Nlayer, sizeof(double));
+
+        // prepare_full_energy
+        size += scratch_bytes(options.Nlayer, sizeof(layer_data_struct));
+
+        // soil_carbon_balance and compute_soil_resp
+        size += 11 * scratch_bytes(options.Nnode, sizeof(double));
+
+        // calc_layer_average_thermal_props
+        size += scratch_bytes(options.Nlayer, sizeof(double **));
+        size += options.Nlayer * scratch_bytes(options.Nnode,
+                                               sizeof(double *));
+        size += options.Nlayer * options.Nnode *
+                scratch_bytes(options.Nfrost + 1, sizeof(double));
+        size += scratch_bytes(options.Nlayer, sizeof(double *));
+        size += options.Nlayer * scratch_bytes(options.Nnode,
+                                               sizeof(double));
+
+        scratch.base = malloc(size);
+        check_alloc_status(scratch.base, "Memory allocation error.");
+        scratch.size = size;
+    }
+
+    for (i = 0; i < scratch.nheap; i++) {
+        free(scratch.heap[i]);
+    }
+    scratch.nheap = 0;
+    scratch.used = 0;
+}
+
+/******************************************************************************
+ * @brief    Free the scratch arena of this thread.
+ *****************************************************************************/
+void
+free_scratch(void)
+{
+    size_t i;
+
+    for (i = 0; i < scratch.nheap; i++) {
+        free(scratch.heap[i]);
+    }
+    free(scratch.base);
+    scratch.base = NULL;
+    scratch.size = 0;
+    scratch.used = 0;
+    scratch.nheap = 0;
+}
+
+/******************************************************************************
+ * @brief    Return the current position of the scratch arena, to be passed to
+ *           scratch_release() when the arrays allocated after it are no
+ *           longer needed.
+ *****************************************************************************/
+size_t
+scratch_mark(void)
+{
+    return scratch.used;
+}
+
+/******************************************************************************
+ * @brief    Free all scratch arrays allocated after mark.
+ *****************************************************************************/
+void
+scratch_release(size_t mark)
+{
+    while (scratch.nheap > 0 &&
+           scratch.heap_offset[scratch.nheap - 1] >= mark) {
+        scratch.nheap--;
+        free(scratch.heap[scratch.nheap]);
+    }
+    scratch.used = mark;
+}
+
+/******************************************************************************
+ * @brief    Allocate a zeroed scratch array of nmemb elements of the given
+ *           size.
+ *
+ * @details  Falls back to the heap, and counts the heap allocation, if the
+ *           array does not fit in the arena.  The array lives until
+ *           scratch_release() is called with a mark taken before it was
+ *           allocated.
+ *****************************************************************************/
+void *
+scratch_calloc(size_t nmemb,
+               size_t size)
+{
+    size_t bytes;
+    void  *ptr;
+
+    bytes = scratch_bytes(nmemb, size);
+    if (bytes == 0) {
+        bytes = SCRATCH_ALIGN;
+    }
+
+    if (scratch.used + bytes <= scratch.size) {
+        ptr = scratch.base + scratch.used;
+        memset(ptr, 0, bytes);
+    }
+    else {
+        if (scratch.nheap == SCRATCH_MAX_HEAP) {
+            log_err("Too many scratch arrays outside of the scratch arena.");
+        }
+        ptr = calloc(1, bytes);
+        check_alloc_status(ptr, "Memory allocation error.");
+        scratch.heap[scratch.nheap] = ptr;
+        scratch.heap_offset[scratch.nheap] = scratch.used;
+        scratch.nheap++;
+        scratch.heap_allocs++;
+    }
+    scratch.used += bytes;
+
+    return ptr;
+}
+
+/******************************************************************************
+ * @brief    Allocate a zeroed 2-dimensional scratch array
+ *****************************************************************************/
+double **
+scratch_2d_double(size_t *shape)
+{
+    size_t   i;
+    double **array;
+
+    array = scratch_calloc(shape[0], sizeof(*array));
+    for (i = 0; i < shape[0]; i++) {
+        array[i] = scratch_calloc(shape[1], sizeof(*(array[i])));
+    }
+
+    return array;
+}
+
+/******************************************************************************
+ * @brief    Allocate a zeroed 3-dimensional scratch array
+ *****************************************************************************/
+double ***
+scratch_3d_double(size_t *shape)
+{
+    size_t    i;
+    size_t    j;
+    double ***array;
+
+    array = scratch_calloc(shape[0], sizeof(*array));
+    for (i = 0; i < shape[0]; i++) {
+        array[i] = scratch_calloc(shape[1], sizeof(*(array[i])));
+        for (j = 0; j < shape[1]; j++) {
+            array[i][j] = scratch_calloc(shape[2], sizeof(*(array[i][j])));
+        }
+    }
+
+    return array;
+}
+
+/******************************************************************************
+ * @brief    Return the number of scratch arrays that did not fit in the
+ *           scratch arena of this thread and were allocated on the heap.
+ *****************************************************************************/
+size_t
+scratch_heap_allocs(void)
+{
+    return scratch.heap_allocs;
+}
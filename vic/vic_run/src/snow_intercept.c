@@ -79,51 +79,52 @@ snow_intercept(double             Dt,
                soil_con_struct   *soil_con,
                veg_var_struct    *veg_var)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
+    extern option_struct         options;
+    extern parameters_struct     param;
 
     /* double AdvectedEnergy; */         /* Energy advected by the rain (W/m2) */
-    double                   BlownSnow; /* Depth of snow blown of the canopy (m) */
-    double                   DeltaSnowInt; /* Change in the physical swe of snow
-                                              interceped on the branches. (m) */
-    double                   Drip; /* Amount of drip from intercepted snow as a
-                                      result of snowmelt (m) */
-    double                   ExcessSnowMelt; /* Snowmelt in excess of the water holding
-                                                capacity of the tree (m) */
-    double                   InitialSnowInt; /* Initial intercepted snow (m) */
-    double                   IntRainOrg;
-    double                   MaxWaterInt; /* Water interception capacity (m) */
-    double                   MaxSnowInt; /* Snow interception capacity (m) */
-    double                   NetRadiation;
-    double                   PotSnowMelt; /* Potential snow melt (m) */
-    double                   RainThroughFall; /* Amount of rain reaching to the ground (m)
-                                               */
-    double                   RefreezeEnergy; /* Energy available for refreezing or melt */
-    double                   ReleasedMass; /* Amount of mass release of intercepted snow
-                                              (m) */
+    double                       BlownSnow; /* Depth of snow blown of the canopy (m) */
+    double                       DeltaSnowInt; /* Change in the physical swe of snow
+                                                  interceped on the branches. (m) */
+    double                       Drip; /* Amount of drip from intercepted snow as a
+                                          result of snowmelt (m) */
+    double                       ExcessSnowMelt; /* Snowmelt in excess of the water holding
+                                                    capacity of the tree (m) */
+    double                       InitialSnowInt; /* Initial intercepted snow (m) */
+    double                       IntRainOrg;
+    double                       MaxWaterInt; /* Water interception capacity (m) */
+    double                       MaxSnowInt; /* Snow interception capacity (m) */
+    double                       NetRadiation;
+    double                       PotSnowMelt; /* Potential snow melt (m) */
+    double                       RainThroughFall; /* Amount of rain reaching to the ground (m)
+                                                   */
+    double                       RefreezeEnergy; /* Energy available for refreezing or melt */
+    double                       ReleasedMass; /* Amount of mass release of intercepted snow
+                                                  (m) */
     /* double SensibleHeat; */           /* Sensible heat flux (W/m2) */
-    double                   SnowThroughFall; /* Amount of snow reaching to the ground (m)
-                                               */
-    double                   Imax1; /* maxium water intecept regardless of temp */
-    double                   IntRainFract; /* Fraction of intercpeted water which is
-                                              liquid */
-    double                   IntSnowFract; /* Fraction of intercepted water which is
-                                              solid */
-    double                   Overload; /* temp variable to calculated structural
-                                          overloading */
-    double                   Qnet; /* temporary storage of energy balance
-                                      error */
-    double                   Tupper;
-    double                   Tlower;
-    double                   Evap;
-    double                   OldTfoliage;
-
-    double                   AirDens;
-    double                   EactAir;
-    double                   Press; // atmospheric pressure
-    double                   Vpd; // vapor pressure defficit
-    double                   shortwave; //
-    double                   Catm; //
+    double                       SnowThroughFall; /* Amount of snow reaching to the ground (m)
+                                                   */
+    double                       Imax1; /* maxium water intecept regardless of temp */
+    double                       IntRainFract; /* Fraction of intercpeted water which is
+                                                  liquid */
+    double                       IntSnowFract; /* Fraction of intercepted water which is
+                                                  solid */
+    double                       Overload; /* temp variable to calculated structural
+                                              overloading */
+    double                       Qnet; /* temporary storage of energy balance
+                                          error */
+    double                       Tupper;
+    double                       Tlower;
+    double                       Evap;
+    double                       OldTfoliage;
+    canopy_energy_bal_ctx_struct ctx;
+
+    double                       AirDens;
+    double                       EactAir;
+    double                       Press; // atmospheric pressure
+    double                       Vpd; // vapor pressure defficit
+    double                       shortwave; //
+    double                       Catm; //
 
     AirDens = force->density[hidx];
     EactAir = force->vp[hidx];
@@ -292,26 +293,57 @@ snow_intercept(double             Dt,
 
     Tupper = Tlower = MISSING;
 
+    ctx.delta_t = Dt;
+    ctx.elevation = soil_con->elevation;
+    ctx.Wmax = soil_con->max_moist;
+    ctx.Wcr = soil_con->Wcr;
+    ctx.Wpwp = soil_con->Wpwp;
+    ctx.frost_fract = soil_con->frost_fract;
+    ctx.AirDens = AirDens;
+    ctx.EactAir = EactAir;
+    ctx.Press = Press;
+    ctx.Le = Le;
+    ctx.Tcanopy = Tcanopy;
+    ctx.Vpd = Vpd;
+    ctx.shortwave = shortwave;
+    ctx.Catm = Catm;
+    ctx.dryFrac = dryFrac;
+    ctx.Evap = &Evap;
+    ctx.Ra = Ra;
+    ctx.Ra_used = Ra_used;
+    ctx.Rainfall = *RainFall;
+    ctx.Wind = Wind;
+    ctx.veg_class = veg_class;
+    ctx.displacement = displacement;
+    ctx.ref_height = ref_height;
+    ctx.roughness = roughness;
+    ctx.root = root;
+    ctx.CanopLayerBnd = CanopLayerBnd;
+    ctx.IntRain = IntRainOrg;
+    ctx.IntSnow = *IntSnow;
+    ctx.Wdew = IntRain;
+    ctx.layer = layer;
+    ctx.veg_var = veg_var;
+    ctx.LongOverIn = LongOverIn;
+    ctx.LongUnderOut = LongUnderOut;
+    ctx.AdvectedEnergy = AdvectedEnergy;
+    ctx.LatentHeat = LatentHeat;
+    ctx.LatentHeatSub = LatentHeatSub;
+    ctx.LongOverOut = LongOverOut;
+    ctx.NetLongOver = NetLongOver;
+    ctx.NetRadiation = &NetRadiation;
+    ctx.RefreezeEnergy = &RefreezeEnergy;
+    ctx.SensibleHeat = SensibleHeat;
+    ctx.VaporMassFlux = VaporMassFlux;
+
     if (*IntSnow > 0 || *SnowFall > 0) {
         /* Snow present or accumulating in the canopy */
 
         *AlbedoOver = param.SNOW_NEW_SNOW_ALB; // albedo of intercepted snow in canopy
         *NetShortOver = (1. - *AlbedoOver) * ShortOverIn; // net SW in canopy
+        ctx.NetShortOver = *NetShortOver;
 
-        Qnet = solve_canopy_energy_bal(0., Dt, soil_con->elevation,
-                                       soil_con->max_moist, soil_con->Wcr,
-                                       soil_con->Wpwp, soil_con->frost_fract,
-                                       AirDens, EactAir, Press, Le, Tcanopy,
-                                       Vpd, shortwave, Catm, dryFrac, &Evap,
-                                       Ra, Ra_used, *RainFall, Wind, veg_class,
-                                       displacement, ref_height, roughness,
-                                       root, CanopLayerBnd, IntRainOrg,
-                                       *IntSnow, IntRain, layer, veg_var,
-                                       LongOverIn, LongUnderOut, *NetShortOver,
-                                       AdvectedEnergy, LatentHeat,
-                                       LatentHeatSub, LongOverOut, NetLongOver,
-                                       &NetRadiation, &RefreezeEnergy,
-                                       SensibleHeat, VaporMassFlux);
+        Qnet = func_canopy_energy_bal(0., &ctx);
 
         if (Qnet != 0) {
             /* Intercepted snow not melting - need to find temperature */
@@ -331,31 +363,15 @@ snow_intercept(double             Dt,
         /* No snow in canopy */
         *AlbedoOver = bare_albedo;
         *NetShortOver = (1. - *AlbedoOver) * ShortOverIn; // net SW in canopy
+        ctx.NetShortOver = *NetShortOver;
         Qnet = -9999;
         Tupper = (*Tfoliage) + param.SNOW_DT;
         Tlower = (*Tfoliage) - param.SNOW_DT;
     }
 
     if (Tupper != MISSING && Tlower != MISSING) {
-        *Tfoliage = root_brent(Tlower, Tupper,
-                               func_canopy_energy_bal, Dt,
-                               soil_con->elevation, soil_con->max_moist,
-                               soil_con->Wcr, soil_con->Wpwp,
-                               soil_con->frost_fract,
-                               AirDens, EactAir, Press, Le,
-                               Tcanopy, Vpd, shortwave, Catm, dryFrac,
-                               &Evap, Ra, Ra_used, *RainFall, Wind,
-                               veg_class, displacement, ref_height,
-                               roughness, root, CanopLayerBnd, IntRainOrg,
-                               *IntSnow,
-                               IntRain, layer, veg_var,
-                               LongOverIn, LongUnderOut,
-                               *NetShortOver,
-                               AdvectedEnergy,
-                               LatentHeat, LatentHeatSub,
-                               LongOverOut, NetLongOver, &NetRadiation,
-                               &RefreezeEnergy, SensibleHeat,
-                               VaporMassFlux);
+        *Tfoliage = root_brent(Tlower, Tupper, func_canopy_energy_bal, &ctx,
+                               SOLVER_CANOPY_ENERGY_BAL);
 
         if (*Tfoliage <= -998) {
             if (options.TFALLBACK) {
@@ -364,52 +380,14 @@ snow_intercept(double             Dt,
                 (*Tfoliage_fbcount)++;
             }
             else {
-                Qnet = error_calc_canopy_energy_bal(*Tfoliage, band, month, Dt,
-                                                    soil_con->elevation,
-                                                    soil_con->max_moist,
-                                                    soil_con->Wcr,
-                                                    soil_con->Wpwp,
-                                                    soil_con->depth,
-                                                    soil_con->frost_fract,
-                                                    AirDens, EactAir, Press, Le,
-                                                    Tcanopy, Vpd, shortwave,
-                                                    Catm, dryFrac,
-                                                    &Evap, Ra, Ra_used,
-                                                    *RainFall, Wind, UnderStory,
-                                                    iveg,
-                                                    veg_class, displacement,
-                                                    ref_height,
-                                                    roughness, root,
-                                                    CanopLayerBnd, IntRainOrg,
-                                                    *IntSnow,
-                                                    IntRain, layer, veg_var,
-                                                    LongOverIn, LongUnderOut,
-                                                    *NetShortOver,
-                                                    AdvectedEnergy,
-                                                    LatentHeat, LatentHeatSub,
-                                                    LongOverOut, NetLongOver,
-                                                    &NetRadiation,
-                                                    &RefreezeEnergy,
-                                                    SensibleHeat,
-                                                    VaporMassFlux);
+                Qnet = error_print_canopy_energy_bal(*Tfoliage, &ctx, band,
+                                                     month, UnderStory, iveg,
+                                                     soil_con->depth);
                 return(ERROR);
             }
         }
 
-        Qnet = solve_canopy_energy_bal(*Tfoliage, Dt, soil_con->elevation,
-                                       soil_con->max_moist, soil_con->Wcr,
-                                       soil_con->Wpwp, soil_con->frost_fract,
-                                       AirDens, EactAir, Press, Le, Tcanopy,
-                                       Vpd, shortwave, Catm, dryFrac, &Evap,
-                                       Ra, Ra_used, *RainFall, Wind, veg_class,
-                                       displacement, ref_height, roughness,
-                                       root, CanopLayerBnd, IntRainOrg,
-                                       *IntSnow, IntRain, layer, veg_var,
-                                       LongOverIn, LongUnderOut, *NetShortOver,
-                                       AdvectedEnergy, LatentHeat,
-                                       LatentHeatSub, LongOverOut, NetLongOver,
-                                       &NetRadiation, &RefreezeEnergy,
-                                       SensibleHeat, VaporMassFlux);
+        Qnet = func_canopy_energy_bal(*Tfoliage, &ctx);
     }
 
     if (*IntSnow <= 0) {
@@ -560,62 +538,27 @@ snow_intercept(double             Dt,
     return(0);
 }
 
-/******************************************************************************
-* @brief    Dummy function to make a direct call to func_canopy_energy_bal()
-*           possible.
-******************************************************************************/
-double
-solve_canopy_energy_bal(double Tfoliage,
-                        ...)
-{
-    va_list ap;
-    double  Qnet;
-
-    va_start(ap, Tfoliage);
-    Qnet = func_canopy_energy_bal(Tfoliage, ap);
-    va_end(ap);
-
-    return Qnet;
-}
-
-/******************************************************************************
-* @brief    Dummy function to make a direct call to
-*           error_print_canopy_energy_bal() possible.
-******************************************************************************/
-double
-error_calc_canopy_energy_bal(double Tfoliage,
-                             ...)
-{
-    va_list ap;
-    double  Qnet;
-
-    va_start(ap, Tfoliage);
-    Qnet = error_print_canopy_energy_bal(Tfoliage, ap);
-    va_end(ap);
-
-    return Qnet;
-}
-
 /******************************************************************************
 * @brief    Print snow pack energy balance terms
 ******************************************************************************/
 double
-error_print_canopy_energy_bal(double  Tfoliage,
-                              va_list ap)
+error_print_canopy_energy_bal(double                        Tfoliage,
+                              canopy_energy_bal_ctx_struct *ctx,
+                              int                           band,
+                              int                           month,
+                              int                           UnderStory,
+                              int                           iveg,
+                              double                       *depth)
 {
     extern option_struct options;
 
     /* General Model Parameters */
-    int                  band;
-    int                  month;
-
     double               delta_t;
     double               elevation;
 
     double              *Wmax;
     double              *Wcr;
     double              *Wpwp;
-    double              *depth;
     double              *frost_fract;
 
     /* Atmopheric Condition and Forcings */
@@ -636,8 +579,6 @@ error_print_canopy_energy_bal(double  Tfoliage,
     double              *Wind;
 
     /* Vegetation Terms */
-    int                  UnderStory;
-    int                  iveg;
     unsigned int         veg_class;
 
     double              *displacement;
@@ -673,73 +614,67 @@ error_print_canopy_energy_bal(double  Tfoliage,
 
     size_t               cidx;
 
-    /** Read variables from variable length argument list **/
+    /** Read variables from the solver context **/
 
     /* General Model Parameters */
-    band = (int) va_arg(ap, int);
-    month = (int) va_arg(ap, int);
-
-    delta_t = (double) va_arg(ap, double);
-    elevation = (double) va_arg(ap, double);
+    delta_t = ctx->delta_t;
+    elevation = ctx->elevation;
 
-    Wmax = (double *) va_arg(ap, double *);
-    Wcr = (double *) va_arg(ap, double *);
-    Wpwp = (double *) va_arg(ap, double *);
-    depth = (double *) va_arg(ap, double *);
-    frost_fract = (double *) va_arg(ap, double *);
+    Wmax = ctx->Wmax;
+    Wcr = ctx->Wcr;
+    Wpwp = ctx->Wpwp;
+    frost_fract = ctx->frost_fract;
 
     /* Atmopheric Condition and Forcings */
-    AirDens = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Le = (double) va_arg(ap, double);
-    Tcanopy = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    shortwave = (double) va_arg(ap, double);
-    Catm = (double) va_arg(ap, double);
-    dryFrac = (double *) va_arg(ap, double *);
-
-    Evap = (double *) va_arg(ap, double *);
-    Ra = (double *) va_arg(ap, double *);
-    Ra_used = (double *) va_arg(ap, double *);
-    Rainfall = (double) va_arg(ap, double);
-    Wind = (double *) va_arg(ap, double *);
+    AirDens = ctx->AirDens;
+    EactAir = ctx->EactAir;
+    Press = ctx->Press;
+    Le = ctx->Le;
+    Tcanopy = ctx->Tcanopy;
+    Vpd = ctx->Vpd;
+    shortwave = ctx->shortwave;
+    Catm = ctx->Catm;
+    dryFrac = ctx->dryFrac;
+
+    Evap = ctx->Evap;
+    Ra = ctx->Ra;
+    Ra_used = ctx->Ra_used;
+    Rainfall = ctx->Rainfall;
+    Wind = ctx->Wind;
 
     /* Vegetation Terms */
-    UnderStory = (int) va_arg(ap, int);
-    iveg = (int) va_arg(ap, int);
-    veg_class = (unsigned int) va_arg(ap, unsigned int);
+    veg_class = ctx->veg_class;
 
-    displacement = (double *) va_arg(ap, double *);
-    ref_height = (double *) va_arg(ap, double *);
-    roughness = (double *) va_arg(ap, double *);
+    displacement = ctx->displacement;
+    ref_height = ctx->ref_height;
+    roughness = ctx->roughness;
 
-    root = (double *) va_arg(ap, double *);
-    CanopLayerBnd = (double *) va_arg(ap, double *);
+    root = ctx->root;
+    CanopLayerBnd = ctx->CanopLayerBnd;
 
     /* Water Flux Terms */
-    IntRain = (double) va_arg(ap, double);
-    IntSnow = (double) va_arg(ap, double);
+    IntRain = ctx->IntRain;
+    IntSnow = ctx->IntSnow;
 
-    Wdew = (double *) va_arg(ap, double *);
+    Wdew = ctx->Wdew;
 
-    layer = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-    veg_var = (veg_var_struct *) va_arg(ap, veg_var_struct *);
+    layer = ctx->layer;
+    veg_var = ctx->veg_var;
 
     /* Energy Flux Terms */
-    LongOverIn = (double) va_arg(ap, double);
-    LongUnderOut = (double) va_arg(ap, double);
-    NetShortOver = (double) va_arg(ap, double);
-
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    LongOverOut = (double *) va_arg(ap, double *);
-    NetLongOver = (double *) va_arg(ap, double *);
-    NetRadiation = (double *) va_arg(ap, double *);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    VaporMassFlux = (double *) va_arg(ap, double *);
+    LongOverIn = ctx->LongOverIn;
+    LongUnderOut = ctx->LongUnderOut;
+    NetShortOver = ctx->NetShortOver;
+
+    AdvectedEnergy = ctx->AdvectedEnergy;
+    LatentHeat = ctx->LatentHeat;
+    LatentHeatSub = ctx->LatentHeatSub;
+    LongOverOut = ctx->LongOverOut;
+    NetLongOver = ctx->NetLongOver;
+    NetRadiation = ctx->NetRadiation;
+    RefreezeEnergy = ctx->RefreezeEnergy;
+    SensibleHeat = ctx->SensibleHeat;
+    VaporMassFlux = ctx->VaporMassFlux;
 
     /** Print variable info */
     log_warn("snow_intercept failed to converge to a solution "
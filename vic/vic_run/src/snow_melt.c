@@ -68,37 +68,38 @@ snow_melt(double            Le,
           int               band,
           snow_data_struct *snow)
 {
-    extern option_struct     options;
-    extern parameters_struct param;
-
-    double                   error;
-    double                   DeltaPackCC; /* Change in cold content of the pack */
-    double                   DeltaPackSwq; /* Change in snow water equivalent of the
-                                              pack (m) */
-    double                   Ice; /* Ice content of snow pack (m)*/
-    double                   InitialSwq; /* Initial snow water equivalent (m) */
-    double                   MassBalanceError; /* Mass balance error (m) */
-    double                   MaxLiquidWater; /* Maximum liquid water content of pack (m) */
-    double                   PackCC; /* Cold content of snow pack (J) */
-    double                   PackSwq; /* Snow pack snow water equivalent (m) */
-    double                   Qnet; /* Net energy exchange at the surface (W/m2) */
-    double                   RefreezeEnergy; /* refreeze/melt energy in surface layer (W/m2) */
-    double                   PackRefreezeEnergy; /* refreeze/melt energy in pack layer (W/m2) */
-    double                   RefrozenWater; /* Amount of refrozen water (m) */
-    double                   SnowFallCC; /* Cold content of new snowfall (J) */
-    double                   SnowMelt; /* Amount of snow melt during time interval
-                                          (m water equivalent) */
-    double                   SurfaceCC; /* Cold content of snow pack (J) */
-    double                   SurfaceSwq; /* Surface layer snow water equivalent (m) */
-    double                   SnowFall;
-    double                   RainFall;
-    double                   advection;
-    double                   deltaCC;
-    double                   latent_heat;
-    double                   latent_heat_sub;
-    double                   sensible_heat;
-    double                   advected_sensible_heat;
-    double                   melt_energy = 0.;
+    extern option_struct            options;
+    extern parameters_struct        param;
+
+    double                          error;
+    double                          DeltaPackCC; /* Change in cold content of the pack */
+    double                          DeltaPackSwq; /* Change in snow water equivalent of the
+                                                     pack (m) */
+    double                          Ice; /* Ice content of snow pack (m)*/
+    double                          InitialSwq; /* Initial snow water equivalent (m) */
+    double                          MassBalanceError; /* Mass balance error (m) */
+    double                          MaxLiquidWater; /* Maximum liquid water content of pack (m) */
+    double                          PackCC; /* Cold content of snow pack (J) */
+    double                          PackSwq; /* Snow pack snow water equivalent (m) */
+    double                          Qnet; /* Net energy exchange at the surface (W/m2) */
+    double                          RefreezeEnergy; /* refreeze/melt energy in surface layer (W/m2) */
+    double                          PackRefreezeEnergy; /* refreeze/melt energy in pack layer (W/m2) */
+    double                          RefrozenWater; /* Amount of refrozen water (m) */
+    double                          SnowFallCC; /* Cold content of new snowfall (J) */
+    double                          SnowMelt; /* Amount of snow melt during time interval
+                                                 (m water equivalent) */
+    double                          SurfaceCC; /* Cold content of snow pack (J) */
+    double                          SurfaceSwq; /* Surface layer snow water equivalent (m) */
+    double                          SnowFall;
+    double                          RainFall;
+    double                          advection;
+    double                          deltaCC;
+    double                          latent_heat;
+    double                          latent_heat_sub;
+    double                          sensible_heat;
+    double                          advected_sensible_heat;
+    double                          melt_energy = 0.;
+    snow_pack_energy_bal_ctx_struct ctx;
 
     SnowFall = snowfall / MM_PER_M; /* convet to m */
     RainFall = rainfall / MM_PER_M; /* convet to m */
@@ -169,21 +170,42 @@ snow_melt(double            Le,
 
     /* Calculate the surface energy balance for snow_temp = 0.0 */
 
-    Qnet = CalcSnowPackEnergyBalance((double) 0.0, delta_t, aero_resist,
-                                     aero_resist_used, z2, Z0,
-                                     density, vp, LongSnowIn, Le, pressure,
-                                     RainFall, NetShortSnow, vpd,
-                                     wind, (*OldTSurf), coverage,
-                                     snow->depth, snow->density,
-                                     snow->surf_water, SurfaceSwq,
-                                     Tcanopy, Tgrnd,
-                                     &advection, &advected_sensible_heat,
-                                     &deltaCC,
-                                     &grnd_flux, &latent_heat,
-                                     &latent_heat_sub, NetLongSnow,
-                                     &RefreezeEnergy, &sensible_heat,
-                                     &snow->vapor_flux, &snow->blowing_flux,
-                                     &snow->surface_flux);
+    ctx.Dt = delta_t;
+    ctx.Ra = aero_resist;
+    ctx.Ra_used = aero_resist_used;
+    ctx.Z = z2;
+    ctx.Z0 = Z0;
+    ctx.AirDens = density;
+    ctx.EactAir = vp;
+    ctx.LongSnowIn = LongSnowIn;
+    ctx.Lv = Le;
+    ctx.Press = pressure;
+    ctx.Rain = RainFall;
+    ctx.NetShortUnder = NetShortSnow;
+    ctx.Vpd = vpd;
+    ctx.Wind = wind;
+    ctx.OldTSurf = (*OldTSurf);
+    ctx.SnowCoverFract = coverage;
+    ctx.SnowDepth = snow->depth;
+    ctx.SnowDensity = snow->density;
+    ctx.SurfaceLiquidWater = snow->surf_water;
+    ctx.SweSurfaceLayer = SurfaceSwq;
+    ctx.Tair = Tcanopy;
+    ctx.TGrnd = Tgrnd;
+    ctx.AdvectedEnergy = &advection;
+    ctx.AdvectedSensibleHeat = &advected_sensible_heat;
+    ctx.DeltaColdContent = &deltaCC;
+    ctx.GroundFlux = &grnd_flux;
+    ctx.LatentHeat = &latent_heat;
+    ctx.LatentHeatSub = &latent_heat_sub;
+    ctx.NetLongUnder = NetLongSnow;
+    ctx.RefreezeEnergy = &RefreezeEnergy;
+    ctx.SensibleHeat = &sensible_heat;
+    ctx.vapor_flux = &snow->vapor_flux;
+    ctx.blowing_flux = &snow->blowing_flux;
+    ctx.surface_flux = &snow->surface_flux;
+
+    Qnet = SnowPackEnergyBalance((double) 0.0, &ctx);
 
     /* Check that snow swq exceeds minimum value for model stability */
     if (!UNSTABLE_SNOW) {
@@ -262,26 +284,24 @@ snow_melt(double            Le,
         }
         /* Else, SnowPackEnergyBalance(T=0.0) <= 0.0 */
         else {
-            /* Calculate surface layer temperature using "Brent method" */
+            /* Calculate surface layer temperature using "Brent method",
+               or the warm-started secant method if SECANT_SOLVE is set */
             if (SurfaceSwq > param.SNOW_MIN_SWQ_EB_THRES) {
-                snow->surf_temp = root_brent(
-                    (double) (snow->surf_temp - param.SNOW_DT),
-                    (double) (snow->surf_temp + param.SNOW_DT),
-                    SnowPackEnergyBalance,
-                    delta_t, aero_resist, aero_resist_used, z2, Z0,
-                    density, vp, LongSnowIn, Le, pressure,
-                    RainFall, NetShortSnow, vpd,
-                    wind, (*OldTSurf), coverage,
-                    snow->depth, snow->density,
-                    snow->surf_water, SurfaceSwq,
-                    Tcanopy, Tgrnd,
-                    &advection, &advected_sensible_heat,
-                    &deltaCC,
-                    &grnd_flux, &latent_heat,
-                    &latent_heat_sub, NetLongSnow,
-                    &RefreezeEnergy, &sensible_heat,
-                    &snow->vapor_flux, &snow->blowing_flux,
-                    &snow->surface_flux);
+                if (options.SECANT_SOLVE) {
+                    snow->surf_temp = root_secant(
+                        snow->surf_temp,
+                        (double) (snow->surf_temp - param.SNOW_DT),
+                        (double) (snow->surf_temp + param.SNOW_DT),
+                        SnowPackEnergyBalance, &ctx,
+                        SOLVER_SNOW_PACK_ENERGY_BAL);
+                }
+                else {
+                    snow->surf_temp = root_brent(
+                        (double) (snow->surf_temp - param.SNOW_DT),
+                        (double) (snow->surf_temp + param.SNOW_DT),
+                        SnowPackEnergyBalance, &ctx,
+                        SOLVER_SNOW_PACK_ENERGY_BAL);
+                }
 
                 if (snow->surf_temp <= -998) {
                     if (options.TFALLBACK) {
@@ -290,31 +310,8 @@ snow_melt(double            Le,
                         snow->surf_temp_fbcount++;
                     }
                     else {
-                        error = ErrorSnowPackEnergyBalance(snow->surf_temp,
-                                                           iveg, band,
-                                                           delta_t, aero_resist,
-                                                           aero_resist_used,
-                                                           z2, Z0, density, vp,
-                                                           LongSnowIn, Le,
-                                                           pressure,
-                                                           RainFall,
-                                                           NetShortSnow, vpd,
-                                                           wind, (*OldTSurf),
-                                                           coverage,
-                                                           snow->depth,
-                                                           snow->density,
-                                                           snow->surf_water,
-                                                           SurfaceSwq,
-                                                           Tcanopy, Tgrnd,
-                                                           &advection,
-                                                           &advected_sensible_heat,
-                                                           &deltaCC,
-                                                           &grnd_flux, &latent_heat,
-                                                           &latent_heat_sub,
-                                                           NetLongSnow, &RefreezeEnergy,
-                                                           &sensible_heat, &snow->vapor_flux,
-                                                           &snow->blowing_flux,
-                                                           &snow->surface_flux);
+                        error = ErrorPrintSnowPackEnergyBalance(
+                            snow->surf_temp, &ctx, iveg, band);
                         return(error);
                     }
                 }
@@ -324,26 +321,7 @@ snow_melt(double            Le,
                 snow->surf_temp = 999;
             }
             if (snow->surf_temp > -998 && snow->surf_temp < 999) {
-                Qnet = CalcSnowPackEnergyBalance(snow->surf_temp,
-                                                 delta_t, aero_resist,
-                                                 aero_resist_used, z2, Z0,
-                                                 density, vp, LongSnowIn, Le,
-                                                 pressure,
-                                                 RainFall, NetShortSnow, vpd,
-                                                 wind, (*OldTSurf), coverage,
-                                                 snow->depth, snow->density,
-                                                 snow->surf_water, SurfaceSwq,
-                                                 Tcanopy, Tgrnd,
-                                                 &advection,
-                                                 &advected_sensible_heat,
-                                                 &deltaCC,
-                                                 &grnd_flux, &latent_heat,
-                                                 &latent_heat_sub,
-                                                 NetLongSnow, &RefreezeEnergy,
-                                                 &sensible_heat,
-                                                 &snow->vapor_flux,
-                                                 &snow->blowing_flux,
-                                                 &snow->surface_flux);
+                Qnet = SnowPackEnergyBalance(snow->surf_temp, &ctx);
 
                 /* since we iterated, the surface layer is below freezing and no snowmelt */
 
@@ -510,56 +488,16 @@ snow_melt(double            Le,
     return (0);
 }
 
-/******************************************************************************
- * @brief    Dummy function to make a direct call to SnowEnergyBalance()
- *           possible.
- *****************************************************************************/
-double
-CalcSnowPackEnergyBalance(double Tsurf,
-                          ...)
-{
-    va_list ap;                 /* Used in traversing variable argument list
-                                 */
-    double  Qnet;                /* Net energy exchange at the SnowPack snow
-                                    surface (W/m^2) */
-
-    va_start(ap, Tsurf);
-    Qnet = SnowPackEnergyBalance(Tsurf, ap);
-    va_end(ap);
-
-    return Qnet;
-}
-
-/******************************************************************************
- * @brief    Pass snow pack energy balance terms to
- *           ErrorPrintSnowPackEnergyBalance
- *****************************************************************************/
-int
-ErrorSnowPackEnergyBalance(double Tsurf,
-                           ...)
-{
-    va_list ap;                 /* Used in traversing variable argument list
-                                 */
-    int     error;             /* error from ErrorPrintSnowPackEnergyBalance */
-
-    va_start(ap, Tsurf);
-    error = ErrorPrintSnowPackEnergyBalance(Tsurf, ap);
-    va_end(ap);
-
-    return (error);
-}
-
 /******************************************************************************
  * @brief    Print snow pack energy balance terms
  *****************************************************************************/
 int
-ErrorPrintSnowPackEnergyBalance(double  TSurf,
-                                va_list ap)
+ErrorPrintSnowPackEnergyBalance(double                           TSurf,
+                                snow_pack_energy_bal_ctx_struct *ctx,
+                                int                              iveg,
+                                int                              band)
 {
-    /* Define Variable Argument List */
-
     /* General Model Parameters */
-    int    iveg, band;
     double Dt;                    /* Model time step (sec) */
 
     /* Vegetation Parameters */
@@ -597,8 +535,6 @@ ErrorPrintSnowPackEnergyBalance(double  TSurf,
                                      area into snow covered area (W/m^2) */
     double *DeltaColdContent;     /* Change in cold content of surface
                                      layer (W/m2) */
-    double *DeltaPackColdContent; /* Change in sold content of pack
-                                     layer (W/m^2) */
     double *GroundFlux;           /* Ground Heat Flux (W/m2) */
     double *LatentHeat;           /* Latent heat exchange at surface (W/m2) */
     double *LatentHeatSub;        /* Latent heat of sub exchange at
@@ -615,53 +551,50 @@ ErrorPrintSnowPackEnergyBalance(double  TSurf,
     double *SurfaceMassFlux;        /* Mass flux of water vapor to or from the
                                          intercepted snow */
 
-    /* Read Variable Argument List */
+    /* Read variables from the solver context */
 
     /* General Model Parameters */
-    iveg = (int) va_arg(ap, int);
-    band = (int) va_arg(ap, int);
-    Dt = (double) va_arg(ap, double);
+    Dt = ctx->Dt;
 
     /* Vegetation Parameters */
-    Ra = (double) va_arg(ap, double);
-    Z = (double) va_arg(ap, double);
-    Z0 = (double) va_arg(ap, double);
+    Ra = ctx->Ra;
+    Z = ctx->Z;
+    Z0 = *ctx->Z0;
 
     /* Atmospheric Forcing Variables */
-    AirDens = (double) va_arg(ap, double);
-    EactAir = (double) va_arg(ap, double);
-    LongSnowIn = (double) va_arg(ap, double);
-    Lv = (double) va_arg(ap, double);
-    Press = (double) va_arg(ap, double);
-    Rain = (double) va_arg(ap, double);
-    ShortRad = (double) va_arg(ap, double);
-    Vpd = (double) va_arg(ap, double);
-    Wind = (double) va_arg(ap, double);
+    AirDens = ctx->AirDens;
+    EactAir = ctx->EactAir;
+    LongSnowIn = ctx->LongSnowIn;
+    Lv = ctx->Lv;
+    Press = ctx->Press;
+    Rain = ctx->Rain;
+    ShortRad = ctx->NetShortUnder;
+    Vpd = ctx->Vpd;
+    Wind = ctx->Wind;
 
     /* Snowpack Variables */
-    OldTSurf = (double) va_arg(ap, double);
-    SnowCoverFract = (double) va_arg(ap, double);
-    SnowDensity = (double) va_arg(ap, double);
-    SurfaceLiquidWater = (double) va_arg(ap, double);
-    SweSurfaceLayer = (double) va_arg(ap, double);
+    OldTSurf = ctx->OldTSurf;
+    SnowCoverFract = ctx->SnowCoverFract;
+    SnowDensity = ctx->SnowDensity;
+    SurfaceLiquidWater = ctx->SurfaceLiquidWater;
+    SweSurfaceLayer = ctx->SweSurfaceLayer;
 
     /* Energy Balance Components */
-    Tair = (double) va_arg(ap, double);
-    TGrnd = (double) va_arg(ap, double);
-
-    AdvectedEnergy = (double *) va_arg(ap, double *);
-    AdvectedSensibleHeat = (double *)va_arg(ap, double *);
-    DeltaColdContent = (double *) va_arg(ap, double *);
-    DeltaPackColdContent = (double *) va_arg(ap, double *);
-    GroundFlux = (double *) va_arg(ap, double *);
-    LatentHeat = (double *) va_arg(ap, double *);
-    LatentHeatSub = (double *) va_arg(ap, double *);
-    NetLongSnow = (double *) va_arg(ap, double *);
-    RefreezeEnergy = (double *) va_arg(ap, double *);
-    SensibleHeat = (double *) va_arg(ap, double *);
-    VaporMassFlux = (double *) va_arg(ap, double *);
-    BlowingMassFlux = (double *) va_arg(ap, double *);
-    SurfaceMassFlux = (double *) va_arg(ap, double *);
+    Tair = ctx->Tair;
+    TGrnd = ctx->TGrnd;
+
+    AdvectedEnergy = ctx->AdvectedEnergy;
+    AdvectedSensibleHeat = ctx->AdvectedSensibleHeat;
+    DeltaColdContent = ctx->DeltaColdContent;
+    GroundFlux = ctx->GroundFlux;
+    LatentHeat = ctx->LatentHeat;
+    LatentHeatSub = ctx->LatentHeatSub;
+    NetLongSnow = ctx->NetLongUnder;
+    RefreezeEnergy = ctx->RefreezeEnergy;
+    SensibleHeat = ctx->SensibleHeat;
+    VaporMassFlux = ctx->vapor_flux;
+    BlowingMassFlux = ctx->blowing_flux;
+    SurfaceMassFlux = ctx->surface_flux;
 
     /* print variables */
     log_warn("snow_melt failed to converge to a solution in "
@@ -701,7 +634,6 @@ ErrorPrintSnowPackEnergyBalance(double  TSurf,
     fprintf(LOG_DEST, "AdvectedEnergy = %f\n", AdvectedEnergy[0]);
     fprintf(LOG_DEST, "AdvectedSensibleHeat = %f\n", AdvectedSensibleHeat[0]);
     fprintf(LOG_DEST, "DeltaColdContent = %f\n", DeltaColdContent[0]);
-    fprintf(LOG_DEST, "DeltaPackColdContent = %f\n", DeltaPackColdContent[0]);
     fprintf(LOG_DEST, "GroundFlux = %f\n", GroundFlux[0]);
     fprintf(LOG_DEST, "LatentHeat = %f\n", LatentHeat[0]);
     fprintf(LOG_DEST, "LatentHeatSub = %f\n", LatentHeatSub[0]);
@@ -53,6 +53,7 @@ soil_carbon_balance(soil_con_struct   *soil_con,
     double                     dZTot;
     double                    *T = NULL;
     double                    *w = NULL;
+    size_t                     mark;
     double                     tmp_double;
     double                     b;
     double                     wtd;
@@ -72,14 +73,11 @@ soil_carbon_balance(soil_con_struct   *soil_con,
     if (soil_con->Zsum_node[i] > dZTot) {
         Nnodes--;
     }
-    dZ = calloc(Nnodes, sizeof(*dZ));
-    check_alloc_status(dZ, "Memory allocation error");
-    dZCum = calloc(Nnodes, sizeof(*dZCum));
-    check_alloc_status(dZCum, "Memory allocation error");
-    T = calloc(Nnodes, sizeof(*T));
-    check_alloc_status(T, "Memory allocation error");
-    w = calloc(Nnodes, sizeof(*w));
-    check_alloc_status(w, "Memory allocation error");
+    mark = scratch_mark();
+    dZ = scratch_calloc(Nnodes, sizeof(*dZ));
+    dZCum = scratch_calloc(Nnodes, sizeof(*dZCum));
+    T = scratch_calloc(Nnodes, sizeof(*T));
+    w = scratch_calloc(Nnodes, sizeof(*w));
 
     // Assign node thicknesses and temperatures for subset
     dZTot = 0;
@@ -180,8 +178,5 @@ soil_carbon_balance(soil_con_struct   *soil_con,
         (1 - param.SRESP_FINTER) - cell->RhSlow;
 
     // Free temporary dynamic arrays
-    free((char *) dZ);
-    free((char *) dZCum);
-    free((char *) T);
-    free((char *) w);
+    scratch_release(mark);
 }
@@ -26,6 +26,15 @@
 
 #include <vic_run.h>
 
+// natural logarithms of the constants of soil_conductivity(), used by the
+// MATH_FUSED kernel
+#define SOIL_COND_LN_KQUARTZ     2.0412203288596382  /**< ln(7.7) */
+#define SOIL_COND_LN_KOTHER_LOW  1.0986122886681098  /**< ln(3.0) */
+#define SOIL_COND_LN_KOTHER_HIGH 0.7884573603642703  /**< ln(2.2) */
+#define SOIL_COND_LN_KI          0.7884573603642703  /**< ln(2.2) */
+#define SOIL_COND_LN_KW          -0.5621189181535413 /**< ln(0.57) */
+#define SOIL_COND_LOG10_E        0.4342944819032518  /**< log10(e) */
+
 /******************************************************************************
 * @brief    Soil thermal conductivity calculated using Johansen's method.
 *
@@ -43,6 +52,8 @@ soil_conductivity(double moist,
                   double bulk_density,
                   double organic)
 {
+    extern option_struct options;
+
     double Ke;
     double Ki = 2.2;    /* thermal conductivity of ice (W/mK) */
     double Kw = 0.57;   /* thermal conductivity of water (W/mK) */
@@ -56,6 +67,7 @@ soil_conductivity(double moist,
     double Sr;          /* fractional degree of saturation */
     double K;
     double porosity;
+    double lnKs;
 
     /* Calculate dry conductivity as weighted average of mineral and organic fractions. */
     Kdry_min =
@@ -69,6 +81,40 @@ soil_conductivity(double moist,
 
         Sr = moist / porosity;
 
+        if (options.MATH_KERNELS == MATH_FUSED) {
+            // Same as below, with every product of powers folded into a
+            // single exp() of a sum of logarithms of the constants
+            if (quartz < .2) {
+                Ks_min = exp(quartz * SOIL_COND_LN_KQUARTZ +
+                             (1.0 - quartz) * SOIL_COND_LN_KOTHER_LOW);
+            }
+            else {
+                Ks_min = exp(quartz * SOIL_COND_LN_KQUARTZ +
+                             (1.0 - quartz) * SOIL_COND_LN_KOTHER_HIGH);
+            }
+            Ks = (1 - organic) * Ks_min + organic * Ks_org;
+            lnKs = log(Ks);
+
+            if (Wu == moist) {
+                Ksat = exp((1.0 - porosity) * lnKs +
+                           porosity * SOIL_COND_LN_KW);
+                Ke = 0.7 * SOIL_COND_LOG10_E * log(Sr) + 1.0;
+            }
+            else {
+                Ksat = exp((1.0 - porosity) * lnKs +
+                           (porosity - Wu) * SOIL_COND_LN_KI +
+                           Wu * SOIL_COND_LN_KW);
+                Ke = Sr;
+            }
+
+            K = (Ksat - Kdry) * Ke + Kdry;
+            if (K < Kdry) {
+                K = Kdry;
+            }
+
+            return (K);
+        }
+
         // Compute Ks of mineral soil; here "quartz" is the fraction (quartz volume / mineral soil volume)
         if (quartz < .2) {
             Ks_min = pow(7.7, quartz) * pow(3.0, 1.0 - quartz); // when quartz is less than 0.2
@@ -798,9 +844,20 @@ maximum_unfrozen_water(double T,
                        double bubble,
                        double expt)
 {
+    extern option_struct options;
+
     double unfrozen;
 
-    if (T < 0.) {
+    if (T < 0. && options.MATH_KERNELS == MATH_FUSED) {
+        unfrozen = max_moist *
+                   exp(-(2.0 / (expt - 3.0)) *
+                       log((-CONST_LATICE * T) / (CONST_TKTRIP) /
+                           (CONST_G * bubble / (CM_PER_M))));
+        if (unfrozen > max_moist) {
+            unfrozen = max_moist;
+        }
+    }
+    else if (T < 0.) {
         unfrozen = max_moist *
                    pow((-CONST_LATICE *
                         T) / (CONST_TKTRIP) / (CONST_G * bubble / (CM_PER_M)),
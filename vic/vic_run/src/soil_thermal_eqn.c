@@ -30,9 +30,11 @@
 * @brief
 ******************************************************************************/
 double
-soil_thermal_eqn(double  T,
-                 va_list ap)
+soil_thermal_eqn(double T,
+                 void  *ctx)
 {
+    soil_thermal_eqn_ctx_struct *c = (soil_thermal_eqn_ctx_struct *) ctx;
+
     double value;
 
     double TL;
@@ -54,21 +56,21 @@ soil_thermal_eqn(double  T,
     double flux_term1;
     double flux_term2;
 
-    TL = (double) va_arg(ap, double);
-    TU = (double) va_arg(ap, double);
-    T0 = (double) va_arg(ap, double);
-    moist = (double) va_arg(ap, double);
-    max_moist = (double) va_arg(ap, double);
-    bubble = (double) va_arg(ap, double);
-    expt = (double) va_arg(ap, double);
-    ice0 = (double) va_arg(ap, double);
-    A = (double) va_arg(ap, double);
-    B = (double) va_arg(ap, double);
-    C = (double) va_arg(ap, double);
-    D = (double) va_arg(ap, double);
-    E = (double) va_arg(ap, double);
-    EXP_TRANS = (int) va_arg(ap, int);
-    node = (int) va_arg(ap, int);
+    TL = c->TL;
+    TU = c->TU;
+    T0 = c->T0;
+    moist = c->moist;
+    max_moist = c->max_moist;
+    bubble = c->bubble;
+    expt = c->expt;
+    ice0 = c->ice0;
+    A = c->A;
+    B = c->B;
+    C = c->C;
+    D = c->D;
+    E = c->E;
+    EXP_TRANS = c->EXP_TRANS;
+    node = c->j;
 
     if (T < 0.) {
         ice = moist - maximum_unfrozen_water(T, max_moist, bubble, expt);
@@ -1,7 +1,7 @@
 /******************************************************************************
  * @section DESCRIPTION
  *
- * This subroutine compresses the file "string" using a system call.
+ * Cost counters of the iterative solvers of vic_run, by call site.
  *
  * @section LICENSE
  *
@@ -24,27 +24,41 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
  *****************************************************************************/
 
-#include <vic_driver_shared_all.h>
+#include <vic_run.h>
 
 /******************************************************************************
- * @brief    This subroutine compresses the file "string" using a system call.
+ * @brief    Solver statistics of this thread, one entry per call site.
+ *****************************************************************************/
+static solver_stats_struct solver_stats[N_SOLVER_SITES];
+#ifdef _OPENMP
+#pragma omp threadprivate(solver_stats)
+#endif
+
+/******************************************************************************
+ * @brief    Zero the solver statistics of this thread.
+ *
+ * @details  Called at the start of every vic_run() call, so that the
+ *           statistics read by the driver after vic_run() returns cover that
+ *           call only.
  *****************************************************************************/
 void
-compress_files(char      string[],
-               short int level)
+reset_solver_stats(void)
 {
-    char command[MAXSTRING];
+    memset(solver_stats, 0, sizeof(solver_stats));
+}
 
-    // Compress the file
-    if (level == COMPRESSION_LVL_DEFAULT) {
-        sprintf(command, "nice gzip -f %s &", string);
-    }
-    else if (level != COMPRESSION_LVL_UNSET) {
-        sprintf(command, "nice gzip -%d -f %s &", level, string);
-    }
-    else if (level <= 0) {
-        log_err("Invalid compression level for gzip, must be an integer 1-9");
+/******************************************************************************
+ * @brief    Return the solver statistics of a call site for this thread.
+ *
+ * @details  The solvers take the entry once per solve and increment its
+ *           counters in place.  Sites out of range are a programming error.
+ *****************************************************************************/
+solver_stats_struct *
+get_solver_stats(size_t site)
+{
+    if (site >= N_SOLVER_SITES) {
+        log_err("Invalid solver call site %zu", site);
     }
 
-    system(command);
+    return &(solver_stats[site]);
 }
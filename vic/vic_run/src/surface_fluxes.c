@@ -84,9 +84,20 @@ surface_fluxes(bool                 overstory,
     size_t                   step_inc; // number of atmos array elements to skip per surface fluxes step
     size_t                   endhidx; // index of final element of atmos array
     double                   step_dt; // time length of surface fluxes step (in seconds)
+    double                   step_weight; // number of snow steps in step
+    size_t                   step_hidx; // index of step in step_force
+    force_data_struct       *step_force; // forcing of step
+    force_data_struct        block_force; // forcing of merged snow steps
+    size_t                   block_mark = 0;
+    bool                     ADAPTIVE_STEP = false;
+    double                   start_swq; // swq at start of step
+    double                   start_surf_temp; // snow surf_temp at start of step
+    unsigned int             start_last_snow; // last_snow at start of step
     size_t                   lidx;
     int                      over_iter;
     int                      under_iter;
+    solver_stats_struct     *canopy_stats; // overstory iteration statistics
+    solver_stats_struct     *grnd_stats; // understory iteration statistics
     int                      q;
     double                   Ls;
     double                   LongUnderIn; // inmoing LW to ground surface
@@ -214,6 +225,8 @@ surface_fluxes(bool                 overstory,
     double           *LAIlayer = NULL;
     double           *faPAR = NULL;
     size_t            cidx;
+    size_t            carbon_mark = 0;
+    size_t            par_mark;
     double            store_gc;
     double           *store_gsLayer = NULL;
     double            store_Ci;
@@ -231,10 +244,13 @@ surface_fluxes(bool                 overstory,
     else {
         MAX_ITER_GRND_CANOPY = 0;
     }
+    canopy_stats = get_solver_stats(SOLVER_CANOPY_ITER);
+    grnd_stats = get_solver_stats(SOLVER_GRND_FLUX_ITER);
 
     if (options.CARBON) {
-        store_gsLayer = calloc(options.Ncanopy, sizeof(*store_gsLayer));
-        check_alloc_status(store_gsLayer, "Memory allocation error.");
+        carbon_mark = scratch_mark();
+        store_gsLayer = scratch_calloc(options.Ncanopy,
+                                       sizeof(*store_gsLayer));
     }
 
     /***********************************************************************
@@ -259,9 +275,9 @@ surface_fluxes(bool                 overstory,
     }
     energy->refreeze_energy = 0;
     coverage = snow->coverage;
-    snow_energy = (*energy);
-    soil_energy = (*energy);
-    iter_soil_energy = (*energy);
+    copy_energy_bal(&snow_energy, energy, options.Nnode);
+    copy_energy_bal(&soil_energy, energy, options.Nnode);
+    copy_energy_bal(&iter_soil_energy, energy, options.Nnode);
     snow_veg_var = (*veg_var);
     soil_veg_var = (*veg_var);
     step_snow = (*snow);
@@ -287,6 +303,11 @@ surface_fluxes(bool                 overstory,
         step_inc = 1;
         endhidx = hidx + NF;
         step_dt = gp->snow_dt;
+        if (options.ADAPTIVE_SNOW_STEP && NF > 1) {
+            ADAPTIVE_STEP = true;
+            block_mark = scratch_mark();
+            alloc_snow_step_force(&block_force);
+        }
     }
     else {
         hidx = NR;
@@ -380,31 +401,53 @@ surface_fluxes(bool                 overstory,
     {
         /** Solve energy balance for all sub-model time steps **/
 
+        /* an adaptive step spanning several snow steps uses their
+           combined forcing */
+        if (step_inc > 1) {
+            average_snow_step_force(force, hidx, step_inc, &block_force);
+            step_force = &block_force;
+            step_hidx = 0;
+        }
+        else {
+            step_force = force;
+            step_hidx = hidx;
+        }
+        if (ADAPTIVE_STEP) {
+            step_dt = gp->snow_dt * (double) step_inc;
+            start_swq = step_snow.swq;
+            start_surf_temp = step_snow.surf_temp;
+            start_last_snow = step_snow.last_snow;
+            /* snow age is computed as last_snow * step_dt, so count it in
+               steps of the current length, rounded to the nearest step */
+            step_snow.last_snow = (step_snow.last_snow + step_inc / 2) /
+                                  step_inc;
+        }
+        step_weight = (double) step_inc;
 
         /* set air temperature and precipitation for this snow band */
-        Tair = force->air_temp[hidx] + soil_con->Tfactor[band];
-        step_prec = force->prec[hidx] * soil_con->Pfactor[band];
+        Tair = step_force->air_temp[step_hidx] + soil_con->Tfactor[band];
+        step_prec = step_force->prec[step_hidx] * soil_con->Pfactor[band];
 
         // initialize ground surface temperaure
         Tgrnd = energy->T[0];
 
         // initialize canopy terms
         Tcanopy = Tair;
-        VPcanopy = force->vp[hidx];
-        VPDcanopy = force->vpd[hidx];
+        VPcanopy = step_force->vp[step_hidx];
+        VPDcanopy = step_force->vpd[step_hidx];
 
         over_iter = 0;
         tol_over = 999;
+        canopy_stats->calls++;
 
         last_Tcanopy = 999;
         last_snow_flux = 999;
 
         // compute LAI and absorbed PAR per canopy layer
         if (options.CARBON && iveg < Nveg) {
-            LAIlayer = calloc(options.Ncanopy, sizeof(*LAIlayer));
-            check_alloc_status(LAIlayer, "Memory allocation error.");
-            faPAR = calloc(options.Ncanopy, sizeof(*faPAR));
-            check_alloc_status(faPAR, "Memory allocation error.");
+            par_mark = scratch_mark();
+            LAIlayer = scratch_calloc(options.Ncanopy, sizeof(*LAIlayer));
+            faPAR = scratch_calloc(options.Ncanopy, sizeof(*faPAR));
 
             /* Compute absorbed PAR per ground area per canopy layer (W/m2)
                normalized to PAR = 1 W, i.e. the canopy albedo in the PAR
@@ -412,8 +455,8 @@ surface_fluxes(bool                 overstory,
             faparl(CanopLayerBnd,
                    veg_var->LAI,
                    soil_con->AlbedoPar,
-                   force->coszen[hidx],
-                   force->fdir[hidx],
+                   step_force->coszen[step_hidx],
+                   step_force->fdir[step_hidx],
                    LAIlayer,
                    faPAR);
 
@@ -423,20 +466,20 @@ surface_fluxes(bool                 overstory,
             for (cidx = 0; cidx < options.Ncanopy; cidx++) {
                 if (LAIlayer[cidx] > 1e-10) {
                     veg_var->aPARLayer[cidx] =
-                        (force->par[hidx] /
+                        (step_force->par[step_hidx] /
                          param.PHOTO_EPAR) * faPAR[cidx] / LAIlayer[cidx];
-                    veg_var->aPAR += force->par[hidx] * faPAR[cidx] /
+                    veg_var->aPAR += step_force->par[step_hidx] * faPAR[cidx] /
                                      LAIlayer[cidx];
                 }
                 else {
-                    veg_var->aPARLayer[cidx] = force->par[hidx] /
+                    veg_var->aPARLayer[cidx] = step_force->par[step_hidx] /
                                                param.PHOTO_EPAR *
                                                faPAR[cidx] / 1e-10;
-                    veg_var->aPAR += force->par[hidx] * faPAR[cidx] / 1e-10;
+                    veg_var->aPAR += step_force->par[step_hidx] *
+                                     faPAR[cidx] / 1e-10;
                 }
             }
-            free((char*) LAIlayer);
-            free((char*) faPAR);
+            scratch_release(par_mark);
         }
 
         // Compute mass flux of blowing snow
@@ -446,8 +489,8 @@ surface_fluxes(bool                 overstory,
                                                      step_snow.last_snow,
                                                      step_snow.surf_water,
                                                      wind[2], Ls,
-                                                     force->density[hidx],
-                                                     force->vp[hidx],
+                                                     step_force->density[step_hidx],
+                                                     step_force->vp[step_hidx],
                                                      roughness[2],
                                                      ref_height[2],
                                                      step_snow.depth,
@@ -471,11 +514,13 @@ surface_fluxes(bool                 overstory,
             /** Iterate for overstory solution **/
 
             over_iter++;
+            canopy_stats->evals++;
             last_tol_over = tol_over;
 
             under_iter = 0;
             tol_under = 999;
             UnderStory = 999;
+            grnd_stats->calls++;
 
             UNSTABLE_CNT = 0;
 
@@ -490,6 +535,7 @@ surface_fluxes(bool                 overstory,
                 /** Iterate for understory solution - itererates to find snow flux **/
 
                 under_iter++;
+                grnd_stats->evals++;
                 last_tol_under = tol_under;
 
                 if (last_Tcanopy != 999) {
@@ -519,8 +565,10 @@ surface_fluxes(bool                 overstory,
                 snow_grnd_flux = -snow_flux;
 
                 // Initialize structures for new iteration
-                iter_snow_energy = snow_energy;
-                iter_soil_energy = soil_energy;
+                copy_energy_bal(&iter_snow_energy, &snow_energy,
+                                options.Nnode);
+                copy_energy_bal(&iter_soil_energy, &soil_energy,
+                                options.Nnode);
                 iter_snow_veg_var = snow_veg_var;
                 iter_soil_veg_var = soil_veg_var;
                 iter_snow = step_snow;
@@ -567,10 +615,10 @@ surface_fluxes(bool                 overstory,
                                        roughness, snow_inflow, &snowfall,
                                        &surf_atten,
                                        wind, root, UNSTABLE_SNOW,
-                                       Nveg, iveg, band, step_dt, hidx,
+                                       Nveg, iveg, band, step_dt, step_hidx,
                                        veg_class,
                                        &UnderStory, CanopLayerBnd, &dryFrac,
-                                       dmy, force, &(iter_snow_energy),
+                                       dmy, step_force, &(iter_snow_energy),
                                        iter_layer, &(iter_snow),
                                        soil_con,
                                        &(iter_snow_veg_var));
@@ -621,9 +669,10 @@ surface_fluxes(bool                 overstory,
                                              rainfall, ref_height, roughness,
                                              snowfall, wind, root, INCLUDE_SNOW,
                                              UnderStory, options.Nnode, Nveg,
-                                             step_dt, hidx, iveg,
+                                             step_dt, step_hidx, iveg,
                                              (int) overstory, veg_class,
-                                             CanopLayerBnd, &dryFrac, force,
+                                             CanopLayerBnd, &dryFrac,
+                                             step_force,
                                              dmy, &iter_soil_energy,
                                              iter_layer,
                                              &(iter_snow), soil_con,
@@ -656,7 +705,7 @@ surface_fluxes(bool                 overstory,
                         iter_snow_energy.NetShortOver,
                         iter_soil_energy.NetShortUnder,
                         iter_aero_resist_veg[1], Tair,
-                        force->density[hidx],
+                        step_force->density[step_hidx],
                         &iter_soil_energy.AtmosError,
                         &iter_soil_energy.AtmosLatent,
                         &iter_soil_energy.AtmosLatentSub,
@@ -723,10 +772,20 @@ surface_fluxes(bool                 overstory,
             }
             while ((fabs(tol_under - last_tol_under) > param.TOL_GRND) &&
                    (tol_under != 0) && (under_iter < MAX_ITER_GRND_CANOPY));
+            if (MAX_ITER_GRND_CANOPY > 0 &&
+                (fabs(tol_under - last_tol_under) > param.TOL_GRND) &&
+                (tol_under != 0)) {
+                grnd_stats->maxiter++;
+            }
         }
         while ((fabs(tol_over - last_tol_over) > param.TOL_OVER &&
                 overstory) && (tol_over != 0) &&
                (over_iter < MAX_ITER_GRND_CANOPY));
+        if (MAX_ITER_GRND_CANOPY > 0 &&
+            (fabs(tol_over - last_tol_over) > param.TOL_OVER && overstory) &&
+            (tol_over != 0)) {
+            canopy_stats->maxiter++;
+        }
 
         /**************************************
            Compute GPP, Raut, and NPP
@@ -739,10 +798,10 @@ surface_fluxes(bool                 overstory,
                                     vic_run_veg_lib[veg_class].CO2Specificity,
                                     iter_soil_veg_var.NscaleFactor,
                                     Tair,
-                                    force->shortwave[hidx],
+                                    step_force->shortwave[step_hidx],
                                     iter_soil_veg_var.aPARLayer,
                                     soil_con->elevation,
-                                    force->Catm[hidx],
+                                    step_force->Catm[step_hidx],
                                     CanopLayerBnd,
                                     veg_var->LAI,
                                     "rs",
@@ -796,7 +855,8 @@ surface_fluxes(bool                 overstory,
 
         compute_pot_evap(gp->model_steps_per_day,
                          vic_run_veg_lib[veg_class].rmin,
-                         iter_soil_veg_var.albedo, force->shortwave[hidx],
+                         iter_soil_veg_var.albedo,
+                         step_force->shortwave[step_hidx],
                          iter_soil_energy.NetLongAtmos,
                          vic_run_veg_lib[veg_class].RGL, Tair, VPDcanopy,
                          iter_soil_veg_var.LAI, soil_con->elevation,
@@ -810,14 +870,18 @@ surface_fluxes(bool                 overstory,
            Store sub-model time step variables
         **************************************/
 
-        snow_energy = iter_snow_energy;
-        soil_energy = iter_soil_energy;
+        copy_energy_bal(&snow_energy, &iter_snow_energy, options.Nnode);
+        copy_energy_bal(&soil_energy, &iter_soil_energy, options.Nnode);
         snow_veg_var = iter_snow_veg_var;
         soil_veg_var = iter_soil_veg_var;
         step_snow = iter_snow;
         for (lidx = 0; lidx < options.Nlayer; lidx++) {
             step_layer[lidx] = iter_layer[lidx];
         }
+        if (ADAPTIVE_STEP && step_snow.last_snow > 0) {
+            // count snow age in snow steps again
+            step_snow.last_snow = start_last_snow + step_inc;
+        }
 
         if (iveg != Nveg) {
             if (step_snow.snow) {
@@ -832,18 +896,19 @@ surface_fluxes(bool                 overstory,
             }
             step_Wdew = soil_veg_var.Wdew;
             if (options.CARBON) {
-                store_gc += 1 / soil_veg_var.rc;
+                store_gc += step_weight / soil_veg_var.rc;
                 for (cidx = 0; cidx < options.Ncanopy; cidx++) {
-                    store_gsLayer[cidx] += 1 / soil_veg_var.rsLayer[cidx];
+                    store_gsLayer[cidx] += step_weight /
+                                           soil_veg_var.rsLayer[cidx];
                 }
-                store_Ci += soil_veg_var.Ci;
-                store_GPP += soil_veg_var.GPP;
-                store_Rdark += soil_veg_var.Rdark;
-                store_Rphoto += soil_veg_var.Rphoto;
-                store_Rmaint += soil_veg_var.Rmaint;
-                store_Rgrowth += soil_veg_var.Rgrowth;
-                store_Raut += soil_veg_var.Raut;
-                store_NPP += soil_veg_var.NPP;
+                store_Ci += step_weight * soil_veg_var.Ci;
+                store_GPP += step_weight * soil_veg_var.GPP;
+                store_Rdark += step_weight * soil_veg_var.Rdark;
+                store_Rphoto += step_weight * soil_veg_var.Rphoto;
+                store_Rmaint += step_weight * soil_veg_var.Rmaint;
+                store_Rgrowth += step_weight * soil_veg_var.Rgrowth;
+                store_Raut += step_weight * soil_veg_var.Raut;
+                store_NPP += step_weight * soil_veg_var.NPP;
             }
         }
         for (lidx = 0; lidx < options.Nlayer; lidx++) {
@@ -851,16 +916,16 @@ surface_fluxes(bool                 overstory,
         }
         store_ppt += step_ppt;
         if (iter_aero_resist_used[0] > 0) {
-            store_aero_cond_used[0] += 1 / iter_aero_resist_used[0];
+            store_aero_cond_used[0] += step_weight / iter_aero_resist_used[0];
         }
         else {
-            store_aero_cond_used[0] += param.HUGE_RESIST;
+            store_aero_cond_used[0] += step_weight * param.HUGE_RESIST;
         }
         if (iter_aero_resist_used[1] > 0) {
-            store_aero_cond_used[1] += 1 / iter_aero_resist_used[1];
+            store_aero_cond_used[1] += step_weight / iter_aero_resist_used[1];
         }
         else {
-            store_aero_cond_used[1] += param.HUGE_RESIST;
+            store_aero_cond_used[1] += step_weight * param.HUGE_RESIST;
         }
 
         if (iveg != Nveg) {
@@ -887,67 +952,89 @@ surface_fluxes(bool                 overstory,
             snow_energy.snow_flux = soil_energy.snow_flux;
         }
 
-        store_AlbedoOver += snow_energy.AlbedoOver;
-        store_AlbedoUnder += soil_energy.AlbedoUnder;
-        store_AtmosLatent += soil_energy.AtmosLatent;
-        store_AtmosLatentSub += soil_energy.AtmosLatentSub;
-        store_AtmosSensible += soil_energy.AtmosSensible;
-        store_LongOverIn += snow_energy.LongOverIn;
-        store_LongUnderIn += LongUnderIn;
-        store_LongUnderOut += soil_energy.LongUnderOut;
-        store_NetLongAtmos += soil_energy.NetLongAtmos;
-        store_NetLongOver += snow_energy.NetLongOver;
-        store_NetLongUnder += soil_energy.NetLongUnder;
-        store_NetShortAtmos += soil_energy.NetShortAtmos;
-        store_NetShortGrnd += NetShortGrnd;
-        store_NetShortOver += snow_energy.NetShortOver;
-        store_NetShortUnder += soil_energy.NetShortUnder;
-        store_ShortOverIn += snow_energy.ShortOverIn;
-        store_ShortUnderIn += soil_energy.ShortUnderIn;
-        store_canopy_advection += snow_energy.canopy_advection;
-        store_canopy_latent += snow_energy.canopy_latent;
-        store_canopy_latent_sub += snow_energy.canopy_latent_sub;
-        store_canopy_sensible += snow_energy.canopy_sensible;
-        store_canopy_refreeze += snow_energy.canopy_refreeze;
-        store_deltaH += soil_energy.deltaH;
-        store_fusion += soil_energy.fusion;
-        store_grnd_flux += soil_energy.grnd_flux;
-        store_latent += soil_energy.latent;
-        store_latent_sub += soil_energy.latent_sub;
-        store_melt_energy += step_melt_energy;
-        store_sensible += soil_energy.sensible;
+        store_AlbedoOver += step_weight * snow_energy.AlbedoOver;
+        store_AlbedoUnder += step_weight * soil_energy.AlbedoUnder;
+        store_AtmosLatent += step_weight * soil_energy.AtmosLatent;
+        store_AtmosLatentSub += step_weight * soil_energy.AtmosLatentSub;
+        store_AtmosSensible += step_weight * soil_energy.AtmosSensible;
+        store_LongOverIn += step_weight * snow_energy.LongOverIn;
+        store_LongUnderIn += step_weight * LongUnderIn;
+        store_LongUnderOut += step_weight * soil_energy.LongUnderOut;
+        store_NetLongAtmos += step_weight * soil_energy.NetLongAtmos;
+        store_NetLongOver += step_weight * snow_energy.NetLongOver;
+        store_NetLongUnder += step_weight * soil_energy.NetLongUnder;
+        store_NetShortAtmos += step_weight * soil_energy.NetShortAtmos;
+        store_NetShortGrnd += step_weight * NetShortGrnd;
+        store_NetShortOver += step_weight * snow_energy.NetShortOver;
+        store_NetShortUnder += step_weight * soil_energy.NetShortUnder;
+        store_ShortOverIn += step_weight * snow_energy.ShortOverIn;
+        store_ShortUnderIn += step_weight * soil_energy.ShortUnderIn;
+        store_canopy_advection += step_weight * snow_energy.canopy_advection;
+        store_canopy_latent += step_weight * snow_energy.canopy_latent;
+        store_canopy_latent_sub += step_weight * snow_energy.canopy_latent_sub;
+        store_canopy_sensible += step_weight * snow_energy.canopy_sensible;
+        store_canopy_refreeze += step_weight * snow_energy.canopy_refreeze;
+        store_deltaH += step_weight * soil_energy.deltaH;
+        store_fusion += step_weight * soil_energy.fusion;
+        store_grnd_flux += step_weight * soil_energy.grnd_flux;
+        store_latent += step_weight * soil_energy.latent;
+        store_latent_sub += step_weight * soil_energy.latent_sub;
+        store_melt_energy += step_weight * step_melt_energy;
+        store_sensible += step_weight * soil_energy.sensible;
         if (step_snow.swq == 0 && INCLUDE_SNOW) {
             if (last_snow_coverage == 0 && step_prec > 0) {
                 last_snow_coverage = 1;
             }
-            store_advected_sensible += snow_energy.advected_sensible *
+            store_advected_sensible += step_weight *
+                                       snow_energy.advected_sensible *
                                        last_snow_coverage;
-            store_advection += snow_energy.advection * last_snow_coverage;
-            store_deltaCC += snow_energy.deltaCC * last_snow_coverage;
-            store_snow_flux += soil_energy.snow_flux * last_snow_coverage;
-            store_refreeze_energy += snow_energy.refreeze_energy *
+            store_advection += step_weight * snow_energy.advection *
+                               last_snow_coverage;
+            store_deltaCC += step_weight * snow_energy.deltaCC *
+                             last_snow_coverage;
+            store_snow_flux += step_weight * soil_energy.snow_flux *
+                               last_snow_coverage;
+            store_refreeze_energy += step_weight *
+                                     snow_energy.refreeze_energy *
                                      last_snow_coverage;
         }
         else if (step_snow.snow || INCLUDE_SNOW) {
-            store_advected_sensible += snow_energy.advected_sensible *
+            store_advected_sensible += step_weight *
+                                       snow_energy.advected_sensible *
                                        (step_snow.coverage + delta_coverage);
-            store_advection += snow_energy.advection *
+            store_advection += step_weight * snow_energy.advection *
                                (step_snow.coverage + delta_coverage);
-            store_deltaCC += snow_energy.deltaCC *
+            store_deltaCC += step_weight * snow_energy.deltaCC *
                              (step_snow.coverage + delta_coverage);
-            store_snow_flux += soil_energy.snow_flux *
+            store_snow_flux += step_weight * soil_energy.snow_flux *
                                (step_snow.coverage + delta_coverage);
-            store_refreeze_energy += snow_energy.refreeze_energy *
+            store_refreeze_energy += step_weight *
+                                     snow_energy.refreeze_energy *
                                      (step_snow.coverage + delta_coverage);
         }
-        store_pot_evap += iter_pot_evap;
+        store_pot_evap += step_weight * iter_pot_evap;
 
         /* increment time step */
-        N_steps++;
+        N_steps += step_inc;
         hidx += step_inc;
+
+        /* choose the length of the next adaptive step */
+        if (ADAPTIVE_STEP && hidx < endhidx) {
+            step_inc = adapt_snow_step(step_inc, step_snow.swq - start_swq,
+                                       step_snow.surf_temp - start_surf_temp,
+                                       store_tol_under, step_melt,
+                                       step_snow.coverage);
+            if (step_inc > endhidx - hidx) {
+                step_inc = endhidx - hidx;
+            }
+        }
     }
     while (hidx < endhidx);
 
+    if (ADAPTIVE_STEP) {
+        scratch_release(block_mark);
+    }
+
     /************************************************
        Store snow variables for sub-model time steps
     ************************************************/
@@ -965,7 +1052,7 @@ surface_fluxes(bool                 overstory,
        Store energy flux averages for sub-model time steps
     ******************************************************/
 
-    (*energy) = soil_energy;
+    copy_energy_bal(energy, &soil_energy, options.Nnode);
     energy->AlbedoOver = store_AlbedoOver / (double) N_steps;
     energy->AlbedoUnder = store_AlbedoUnder / (double) N_steps;
     energy->AtmosLatent = store_AtmosLatent / (double) N_steps;
@@ -1069,7 +1156,7 @@ surface_fluxes(bool                 overstory,
         veg_var->Raut = store_Raut / (double) N_steps;
         veg_var->NPP = store_NPP / (double) N_steps;
 
-        free((char *) (store_gsLayer));
+        scratch_release(carbon_mark);
 
         soil_carbon_balance(soil_con, energy, cell, veg_var);
 
@@ -93,6 +93,18 @@ vic_run(force_data_struct   *force,
     veg_var_struct         **veg_var;
     energy_bal_struct      **energy;
     snow_data_struct       **snow;
+#if LOG_LVL < 10
+    size_t                   scratch_heap_allocs0;
+#endif
+
+    // all temporary arrays of vic_run come from the scratch arena, which is
+    // allocated on the first call
+    initialize_scratch();
+    // solver statistics are read by the driver after vic_run returns
+    reset_solver_stats();
+#if LOG_LVL < 10
+    scratch_heap_allocs0 = scratch_heap_allocs();
+#endif
 
     // assign vic_run_veg_lib to veg_lib, so that the veg_lib for the correct
     // grid cell is used within vic_run. For simplicity sake, use vic_run_veg_lib
@@ -465,7 +477,7 @@ vic_run(force_data_struct   *force,
                                force->vpd[NR] / PA_PER_KPA,
                                force->pressure[NR] / PA_PER_KPA,
                                force->density[NR], lake_var,
-                               *soil_con, gp->dt, gp->wind_h, *dmy,
+                               soil_con, gp->dt, gp->wind_h, dmy,
                                fraci);
         if (ErrorFlag == ERROR) {
             return (ERROR);
@@ -475,13 +487,21 @@ vic_run(force_data_struct   *force,
            Solve the water budget for the lake.
         **********************************************************************/
 
-        ErrorFlag = water_balance(lake_var, *lake_con, gp->dt, all_vars,
-                                  iveg, band, lakefrac, *soil_con,
-                                  veg_con[iveg]);
+        ErrorFlag = water_balance(lake_var, lake_con, gp->dt, all_vars,
+                                  iveg, band, lakefrac, soil_con,
+                                  &(veg_con[iveg]));
         if (ErrorFlag == ERROR) {
             return (ERROR);
         }
     } // end if (options.LAKES && lake_con->lake_idx >= 0)
 
+#if LOG_LVL < 10
+    if (scratch_heap_allocs() != scratch_heap_allocs0) {
+        log_warn("vic_run made %zu heap allocations because the scratch "
+                 "arena was too small",
+                 scratch_heap_allocs() - scratch_heap_allocs0);
+    }
+#endif
+
     return (0);
 }